@@ -36,6 +36,13 @@ __LLBC_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The application config snapshot type define.
+ *        Snapshot is immutable, application reload will build a new snapshot and replace the old one,
+ *        old snapshot remains valid until all holders release it.
+ */
+typedef std::shared_ptr<const LLBC_Variant> LLBC_AppConfigSnapshot;
+
 /**
  * \brief The application config type enumeration.
  */
@@ -241,16 +248,28 @@ public:
     bool HasConfig() const;
 
     /**
-     * Get application config.
+     * Get application config(deep copy, prefer GetConfigSnapshot() in frequently called code).
      * @return LLBC_Variant - the application config.
      */
     LLBC_Variant GetConfig() const;
 
     /**
-     * Get application config(thread unsafety).
-     * @return const LLBC_Variant & - the application config.
+     * Get application config snapshot(no copy, the snapshot is immutable, safe to hold in any thread).
+     * @return LLBC_AppConfigSnapshot - the application config snapshot, never null.
+     */
+    LLBC_AppConfigSnapshot GetConfigSnapshot() const;
+
+    /**
+     * Get application config(deprecated, same as GetConfigSnapshot(), use GetConfigSnapshot() instead).
+     * @return LLBC_AppConfigSnapshot - the application config snapshot, never null.
      */
-    const LLBC_Variant &GetConfigUnsafe() const { return _cfg; }
+    LLBC_DEPRECATED LLBC_AppConfigSnapshot GetConfigUnsafe() const;
+
+    /**
+     * Get application config version, config version will increase when application config reloaded.
+     * @return sint64 - the application config version.
+     */
+    sint64 GetConfigVersion() const;
 
     /**
      * Get application config type.
@@ -378,9 +397,15 @@ private:
      * @return int - return 0 if success, otherwise return -1.
      */
     int ReloadConfig();
-    int ReloadIniConfig();
-    int ReloadXmlConfig();
-    int ReloadPropertyConfig();
+    int ReloadIniConfig(LLBC_Variant &cfg);
+    int ReloadXmlConfig(LLBC_Variant &cfg);
+    int ReloadPropertyConfig(LLBC_Variant &cfg);
+
+    /**
+     * Replace application config snapshot and increase config version.
+     * @param[in] cfg - the new application config, take over ownership.
+     */
+    void ReplaceConfig(LLBC_Variant *cfg);
 
 private:
     void HandleEvents();
@@ -411,7 +436,8 @@ private:
     // Load/Reload data members.
     volatile int _loading; // Loading flag.
     mutable LLBC_SpinLock _loadLock; // Load lock.
-    LLBC_Variant _cfg; // Config.
+    LLBC_AppConfigSnapshot _cfg; // Config snapshot(atomic load/store).
+    volatile sint64 _cfgVersion; // Config version.
     LLBC_String _cfgPath; // Application config path.
     LLBC_AppConfigType::ENUM _cfgType; // Application config type.
 
@@ -422,6 +448,45 @@ private:
     std::map<int, LLBC_Delegate<void(const LLBC_AppEvent &)> > _logicEventHandlers; // Logic level event handlers.
 };
 
+/**
+ * \brief The application config typed cached value encapsulation.
+ *        Value is resolved from application config snapshot by key path, and only re-resolved after
+ *        application config reloaded(config version changed), use it to access hot config keys.
+ *        Note: Not thread safe, each thread should hold it's own cached value object.
+ */
+template <typename T>
+class LLBC_AppConfigValue
+{
+public:
+    /**
+     * Construct config value by key path.
+     * @param[in] keyPath  - the config key path, use '.' to separate dict keys, eg: "app.fps"(ini),
+     *                       "Svc.Comp.maxCount"(xml, xml element value will be used).
+     * @param[in] dftValue - the default value, used when config key path not found.
+     */
+    explicit LLBC_AppConfigValue(const LLBC_String &keyPath, const T &dftValue = T());
+
+public:
+    /**
+     * Get config value.
+     * @return const T & - the config value.
+     */
+    const T &Get();
+    operator const T &() { return Get(); }
+
+private:
+    /**
+     * Resolve config value from application config snapshot.
+     */
+    void Resolve(const LLBC_App &app, sint64 cfgVersion);
+
+private:
+    LLBC_Strings _keyPath; // Config key path.
+    T _dftValue; // Default value.
+    T _value; // Cached value.
+    sint64 _cfgVersion; // Cached value config version.
+};
+
 __LLBC_NS_END
 
 #include "llbc/app/AppInl.h"
@@ -54,6 +54,21 @@ inline bool LLBC_App::IsStopping() const
     return _startPhase == LLBC_AppStartPhase::Stopping;
 }
 
+inline LLBC_AppConfigSnapshot LLBC_App::GetConfigSnapshot() const
+{
+    return std::atomic_load(&_cfg);
+}
+
+inline LLBC_AppConfigSnapshot LLBC_App::GetConfigUnsafe() const
+{
+    return GetConfigSnapshot();
+}
+
+inline sint64 LLBC_App::GetConfigVersion() const
+{
+    return LLBC_AtomicGet(const_cast<volatile sint64 *>(&_cfgVersion));
+}
+
 inline int LLBC_App::PushEvent(int evType)
 {
     return PushEvent(new LLBC_AppEvent(evType));
@@ -79,4 +94,60 @@ inline int LLBC_App::StopService(const LLBC_CString &name, bool del, bool destro
     return _services.Stop(name, del, destroyComp);
 }
 
+template <typename T>
+LLBC_AppConfigValue<T>::LLBC_AppConfigValue(const LLBC_String &keyPath, const T &dftValue)
+: _keyPath(keyPath.split('.'))
+, _dftValue(dftValue)
+, _value(dftValue)
+, _cfgVersion(-1)
+{
+}
+
+template <typename T>
+const T &LLBC_AppConfigValue<T>::Get()
+{
+    const LLBC_App *app = LLBC_App::ThisApp();
+    if (UNLIKELY(!app))
+        return _dftValue;
+
+    const sint64 cfgVersion = app->GetConfigVersion();
+    if (UNLIKELY(cfgVersion != _cfgVersion))
+        Resolve(*app, cfgVersion);
+
+    return _value;
+}
+
+template <typename T>
+void LLBC_AppConfigValue<T>::Resolve(const LLBC_App &app, sint64 cfgVersion)
+{
+    // Hold config snapshot, config snapshot loaded after config version, so it is equal to or newer than
+    // cfgVersion, if newer, will re-resolve at next Get() call.
+    const LLBC_AppConfigSnapshot cfg = app.GetConfigSnapshot();
+    _cfgVersion = cfgVersion;
+
+    const LLBC_Variant *cfgItem = cfg.get();
+    for (auto &key : _keyPath)
+    {
+        if (!cfgItem->IsDict())
+        {
+            _value = _dftValue;
+            return;
+        }
+
+        const auto it = cfgItem->DictFind(key);
+        if (it == cfgItem->DictEnd())
+        {
+            _value = _dftValue;
+            return;
+        }
+
+        cfgItem = &it->second;
+    }
+
+    if (app.GetConfigType() == LLBC_AppConfigType::Xml && cfgItem->IsDict())
+        _value = static_cast<T>((*cfgItem)[LLBC_XMLKeys::Value]);
+    else
+        _value = static_cast<T>(*cfgItem);
+}
+
 __LLBC_NS_END
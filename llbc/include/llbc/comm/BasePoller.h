@@ -119,6 +119,7 @@ protected:
     virtual void HandleEv_Monitor(LLBC_PollerEvent &ev);
     virtual void HandleEv_TakeOverSession(LLBC_PollerEvent &ev);
     virtual void HandleEv_CtrlProtocolStack(LLBC_PollerEvent &ev);
+    virtual void HandleEv_Multicast(LLBC_PollerEvent &ev);
 
     /**
      * Create new session from socket.
@@ -173,6 +174,7 @@ protected:
     int _brotherCount;
     LLBC_Service *_svc;
     LLBC_PollerMgr *_pollerMgr;
+    LLBC_EvBlockAllocator *_evBlockAllocator;
     
     typedef std::map<LLBC_SocketHandle, LLBC_Session *> _Sockets;
     _Sockets _sockets;
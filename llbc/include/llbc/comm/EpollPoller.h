@@ -67,6 +67,15 @@ public:
      */
     void Cleanup() override;
 
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    /**
+     * Push message block to poller, if poller is waiting epoll events, will wakeup it.
+     * @param[in] block - message block.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Push(LLBC_MessageBlock *block) override;
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
 protected:
     /**
      * Queued event handlers.
@@ -78,6 +87,7 @@ protected:
     void HandleEv_Monitor(LLBC_PollerEvent &ev) override;
     void HandleEv_TakeOverSession(LLBC_PollerEvent &ev) override;
     void HandleEv_CtrlProtocolStack(LLBC_PollerEvent &ev) override;
+    void HandleEv_Multicast(LLBC_PollerEvent &ev) override;
 
     /**
      * Add session to poller.
@@ -90,6 +100,28 @@ protected:
     void RemoveSession(LLBC_Session *session) override;
 
 private:
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    /**
+     * Create wakeup eventfd and add it to epoll.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int CreateWakeupFd();
+
+    /**
+     * Close wakeup eventfd, wait all in-flight wakers finished before close it.
+     */
+    void CloseWakeupFd();
+
+    /**
+     * Wakeup poller thread, if it is waiting epoll events.
+     */
+    void Wakeup();
+
+    /**
+     * Reset wakeup eventfd after poller thread wakeup.
+     */
+    void ResetWakeup();
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     /**
      * Startup monitor.
      */
@@ -104,6 +136,14 @@ private:
      * The monitor thread service method.
      */
     void MonitorSvc();
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
+    /**
+     * Handle epoll events.
+     * @param[in] evs   - the epoll events.
+     * @param[in] count - the epoll events count.
+     */
+    void HandleEpollEvents(const LLBC_EpollEvent *evs, int count);
 
     /**
      * Handle connecting sockets.
@@ -117,7 +157,13 @@ private:
 
 private:
     LLBC_Handle _epoll;
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    LLBC_Handle _wakeupFd;
+    volatile sint32 _wakeupPending;
+    volatile sint32 _wakeupRefs; // In-flight wakers count | closing flag.
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     LLBC_PollerMonitor *_monitor;
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 
     LLBC_EpollEvent _events[LLBC_CFG_COMM_MAX_EVENT_COUNT];
 };
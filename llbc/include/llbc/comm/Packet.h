@@ -234,6 +234,21 @@ public:
      */
     void SetPayloadDeleteDeleg(const LLBC_Delegate<void(LLBC_MessageBlock *)> &deleg);
 
+    /**
+     * Set payload as a slice of shared message block, no data copy.
+     * Note:
+     *  Slice payload hold one reference of shared message block until payload cleanup.
+     * @param[in] sharedBlock - the shared message block.
+     * @param[in] offset      - the slice offset in shared message block buffer.
+     * @param[in] len         - the slice length.
+     * @param[in] blockPool   - the slice block pool, if is null, slice block will be heap allocated.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetPayloadSlice(LLBC_SharedMessageBlock *sharedBlock,
+                        size_t offset,
+                        size_t len,
+                        LLBC_TypedObjPool<LLBC_MessageBlock> *blockPool = nullptr);
+
     /**
      * Reset packet payload.
      */
@@ -504,6 +519,13 @@ private:
      */
     void CleanupPayload();
 
+    /**
+     * Copy payload to self-owned message block and cleanup payload.
+     * Used to detach/giveup payload which owned by payload delete delegate(eg: shared message block slice).
+     * @return LLBC_MessageBlock * - the copied payload.
+     */
+    LLBC_MessageBlock *CopyAndCleanupPayload();
+
 private:
     size_t _length;
 
@@ -187,10 +187,12 @@ LLBC_FORCE_INLINE LLBC_MessageBlock *LLBC_Packet::GetMutablePayload(size_t ensur
 
 LLBC_FORCE_INLINE LLBC_MessageBlock * LLBC_Packet::DetachPayload()
 {
+    // Payload owned by delete delegate, detach a self-owned copy.
+    if (UNLIKELY(_payloadDeleteDeleg))
+        return CopyAndCleanupPayload();
+
     LLBC_MessageBlock *payload = _payload;
     _payload = nullptr;
-    if (_payloadDeleteDeleg)
-        _payloadDeleteDeleg = nullptr;
 
     return payload;
 }
@@ -31,6 +31,7 @@ __LLBC_NS_BEGIN
 class LLBC_Packet;
 class LLBC_Socket;
 class LLBC_Session;
+class LLBC_EvBlockAllocator;
 
 __LLBC_NS_END
 
@@ -51,13 +52,16 @@ struct LLBC_HIDDEN LLBC_PollerEvent
         Send,
         // Close session request, generate by Service layer.
         Close,
-        // Monitor event, only Iocp/Epoll poller available, generate by PollerMonitor thread.
+        // Monitor event, only Iocp/Epoll poller available, generate by PollerMonitor thread,
+        // the monitor data store after event structure.
         Monitor,
         // Take over session request, once poller found it can't process the new session,
         // poller will create this event and post to appropriate brother.
         TakeOverSession,
         // Control protocol stack, generate by Service layer.
         CtrlProtocolStack,
+        // Multicast encoded data to poller sessions, generate by Service layer.
+        Multicast,
 
         // Sentinel.
         End
@@ -79,6 +83,11 @@ struct LLBC_HIDDEN LLBC_PollerEvent
             int ctrlCmd;
             LLBC_Variant *ctrlData;
         } protocolStackCtrlInfo;
+        struct
+        {
+            LLBC_SharedMessageBlock *block;
+            int sessionCount; // The sessionIds store after event structure.
+        } multicastInfo;
     } un;
 };
 
@@ -94,51 +103,70 @@ public:
      */
     static LLBC_MessageBlock *BuildAddSockEv(LLBC_Socket *sock,
                                              int sessionId,
-                                             const LLBC_SessionOpts &sessionOpts);
+                                             const LLBC_SessionOpts &sessionOpts,
+                                             LLBC_EvBlockAllocator *allocator = nullptr);
     
     /**
      * Build Async-Conn event.
      */
     static LLBC_MessageBlock *BuildAsyncConnEv(int sessionId,
                                                const LLBC_SessionOpts &sessionOpts,
-                                               const LLBC_SockAddr_IN &peerAddr);
+                                               const LLBC_SockAddr_IN &peerAddr,
+                                               LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build Send event.
      */
-    static LLBC_MessageBlock *BuildSendEv(LLBC_Packet *packet);
+    static LLBC_MessageBlock *BuildSendEv(LLBC_Packet *packet,
+                                          LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build close event.
      */
     static LLBC_MessageBlock *BuildCloseEv(int sessionId,
-                                           const char *reason);
+                                           const char *reason,
+                                           LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build Iocp monitor event.
      */
 #if LLBC_TARGET_PLATFORM_WIN32
-    static LLBC_MessageBlock *BuildIocpMonitorEv(int ret, LLBC_POverlapped ol, int errNo, int subErrNo);
+    static LLBC_MessageBlock *BuildIocpMonitorEv(int ret,
+                                                 LLBC_POverlapped ol,
+                                                 int errNo,
+                                                 int subErrNo,
+                                                 LLBC_EvBlockAllocator *allocator = nullptr);
 #endif
     /**
      * Build Epoll monitor event.
      */
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
     static LLBC_MessageBlock *BuildEpollMonitorEv(const LLBC_EpollEvent *evs,
-                                                  int count);
+                                                  int count,
+                                                  LLBC_EvBlockAllocator *allocator = nullptr);
 #endif
 
     /**
      * Build take over session event.
      */
-    static LLBC_MessageBlock *BuildTakeOverSessionEv(LLBC_Session *session);
+    static LLBC_MessageBlock *BuildTakeOverSessionEv(LLBC_Session *session,
+                                                     LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build control protocol stack event.
      */
     static LLBC_MessageBlock *BuildCtrlProtocolStackEv(int sessionId,
                                                        int ctrlCmd,
-                                                       const LLBC_Variant &ctrlData);
+                                                       const LLBC_Variant &ctrlData,
+                                                       LLBC_EvBlockAllocator *allocator = nullptr);
+
+    /**
+     * Build multicast event, the event hold one reference of shared block.
+     */
+    static LLBC_MessageBlock *BuildMulticastEv(LLBC_SharedMessageBlock *block,
+                                               const int *sessionIds,
+                                               int sessionCount,
+                                               LLBC_EvBlockAllocator *allocator = nullptr);
 
 public:
     /**
@@ -33,6 +33,7 @@ class LLBC_Socket;
 class LLBC_Service;
 class LLBC_BasePoller;
 class LLBC_IProtocolFactory;
+class LLBC_EvBlockAllocator;
 
 __LLBC_NS_END
 
@@ -138,6 +139,17 @@ public:
      */
     int Send(LLBC_Packet *packet);
 
+    /**
+     * Multicast encoded data to sessions, sessionIds will be grouped by poller,
+     * each poller receive one multicast event.
+     * Note:
+     *  Method will not steal <block> the parameter, each posted event hold one reference of it.
+     * @param[in] block      - the shared block, readable data is the encoded data.
+     * @param[in] sessionIds - the session Ids.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Multicast(LLBC_SharedMessageBlock *block, const LLBC_SessionIds &sessionIds);
+
     /**
      * Close session.
      * @param[in] sessionId - the session Id.
@@ -192,6 +204,7 @@ private:
 private:
     int _type;
     LLBC_Service *_svc;
+    LLBC_EvBlockAllocator *_evBlockAllocator;
     int _maxSessionId;
 
     bool _inited;
@@ -0,0 +1,213 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The service ready session table class encapsulation.
+ *
+ * Ready sessions are stored in open addressing slots(linear probing, home slot index: sessionId & slotMask):
+ * - erased slot is kept as tombstone(reset to empty if followed by empty slot) and reused by later insertion,
+ *   slots never move, so IsReady() is lock-free.
+ * - lookup probe length is limited by the max probe length of inserted ready sessions.
+ * - slots are rehashed when ready sessions + tombstones reach half of slot count(slot count doubled if
+ *   ready sessions exceed third of slot count, otherwise kept), rehash drops all tombstones and
+ *   recomputes max probe length.
+ * - the replaced slots are retired, lock-free readers register themselves in reader stripes, retired
+ *   slots are freed by ReclaimRetiredSlots() once no reader may still read them(all stripes observed
+ *   zero after replacement), caller should call it at quiescent point(eg: service loop).
+ * - all ready sessions are also stored in list(erase by swap-remove), used for iterating(eg: broadcast).
+ * Find/Insert/Erase/Clear/ReclaimRetiredSlots must be called in lock, IsReady()/HasRetiredSlots() can be
+ * called without lock.
+ *
+ * SessionInfo must contain public data members: int sessionId, bool isListenSession, size_t listIndex.
+ * Session Id must be positive.
+ */
+template <typename SessionInfo>
+class LLBC_ReadySessionTable
+{
+public:
+    /**
+     * Construct ready session table.
+     * @param[in] initSlotCount - the initial slot count(round up to power of 2), slots are allocated
+     *                            when the first ready session inserted.
+     */
+    explicit LLBC_ReadySessionTable(int initSlotCount);
+    ~LLBC_ReadySessionTable();
+
+public:
+    /**
+     * Find ready session info.
+     * @param[in] sessionId - the session Id.
+     * @return SessionInfo * - the ready session info, return nullptr if not found.
+     */
+    SessionInfo *Find(int sessionId) const;
+
+    /**
+     * Insert ready session info.
+     * @param[in] sessionInfo - the ready session info.
+     * @return int - return 0 if success, otherwise return -1(invalid session Id, session already exist
+     *                     or allocate slots failed).
+     */
+    int Insert(SessionInfo *sessionInfo);
+
+    /**
+     * Erase ready session info.
+     * @param[in] sessionId - the session Id.
+     * @return SessionInfo * - the erased ready session info, return nullptr if not found.
+     */
+    SessionInfo *Erase(int sessionId);
+
+    /**
+     * Erase all ready session infos(ready session infos will not be deleted).
+     */
+    void Clear();
+
+    /**
+     * Check given session is ready or not(lock-free).
+     * @param[in] sessionId        - the session Id.
+     * @param[out] isListenSession - the listen session flag, only set when session is ready.
+     * @return bool - return true if session is ready, otherwise return false.
+     */
+    bool IsReady(int sessionId, bool &isListenSession) const;
+
+    /**
+     * Check has retired slots need to reclaim or not(lock-free).
+     * @return bool - return true if has retired slots.
+     */
+    bool HasRetiredSlots() const;
+
+    /**
+     * Free retired slots which no lock-free reader still reading.
+     * @return int - the freed retired slots count.
+     */
+    int ReclaimRetiredSlots();
+
+    /**
+     * Get all ready session infos.
+     * @return const std::vector<SessionInfo *> & - the ready session infos.
+     */
+    const std::vector<SessionInfo *> &GetSessionInfos() const;
+
+    /**
+     * Get current slot count.
+     * @return int - the slot count, return 0 if slots not allocated.
+     */
+    int GetSlotCount() const;
+
+    /**
+     * Get current erased(tombstone) slot count.
+     * @return int - the erased slot count.
+     */
+    int GetErasedSlotCount() const;
+
+    /**
+     * Get current max probe length.
+     * @return int - the max probe length, return 0 if slots not allocated.
+     */
+    int GetMaxProbeLen() const;
+
+    /**
+     * Disable assignment.
+     */
+    LLBC_DISABLE_ASSIGNMENT(LLBC_ReadySessionTable);
+
+private:
+    /**
+     * Ready session slot.
+     */
+    struct _Slot
+    {
+        std::atomic<sint64> tag; // Ready session tag((sessionId << 1) | isListenSession), 0: empty, -1: erased.
+        SessionInfo *sessionInfo; // Ready session info.
+    };
+
+    /**
+     * Ready session slots.
+     */
+    struct _Slots
+    {
+        int slotMask; // Slot count - 1.
+        std::atomic<int> maxProbeLen; // Max probe length of all inserted ready sessions.
+        _Slots *retired; // The next retired slots(only used in retired slots chain).
+        _Slot slots[1];
+    };
+
+    /**
+     * Lock-free reader stripe(cache line isolated), readers select stripe by thread.
+     */
+    struct alignas(LLBC_CFG_CORE_OBJPOOL_CACHE_LINE_SIZE) _ReaderStripe
+    {
+        std::atomic<sint64> readers;
+    };
+
+    /**
+     * Find ready session slot.
+     * @param[in] sessionId - the session Id.
+     * @return _Slot * - the ready session slot, return nullptr if not found.
+     */
+    _Slot *FindSlot(int sessionId) const;
+
+    /**
+     * Rehash slots(allocate initial slots, or rebuild ready sessions into new slots), replaced slots retired.
+     * @param[in] slotCount - the new slot count.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RehashSlots(int slotCount);
+
+    /**
+     * Place ready session info into slots(first empty or erased slot in probe sequence).
+     * @param[in] slots       - the slots.
+     * @param[in] sessionInfo - the ready session info.
+     * @return bool - return true if placed into erased slot.
+     */
+    static bool PlaceSlot(_Slots *slots, SessionInfo *sessionInfo);
+
+    /**
+     * Erased slot tag.
+     */
+    static constexpr sint64 _erasedTag = -1;
+
+    /**
+     * Lock-free reader stripe count(power of 2).
+     */
+    static constexpr int _readerStripeCount = 8;
+
+private:
+    int _initSlotCount;
+    std::atomic<_Slots *> _slots;
+    int _erasedSlotCount;
+    std::vector<SessionInfo *> _sessionInfos;
+
+    // Retired slots chain and lock-free reader stripes.
+    std::atomic<_Slots *> _retiredSlots;
+    mutable _ReaderStripe _readerStripes[_readerStripeCount];
+};
+
+__LLBC_NS_END
+
+#include "llbc/comm/ReadySessionTableInl.h"
@@ -0,0 +1,340 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+__LLBC_NS_BEGIN
+
+template <typename SessionInfo>
+LLBC_ReadySessionTable<SessionInfo>::LLBC_ReadySessionTable(int initSlotCount)
+: _initSlotCount(8)
+, _slots(nullptr)
+, _erasedSlotCount(0)
+, _retiredSlots(nullptr)
+{
+    while (_initSlotCount < initSlotCount)
+        _initSlotCount <<= 1;
+
+    for (auto &stripe : _readerStripes)
+        stripe.readers.store(0, std::memory_order_relaxed);
+}
+
+template <typename SessionInfo>
+LLBC_ReadySessionTable<SessionInfo>::~LLBC_ReadySessionTable()
+{
+    // Table destroyed, no reader any more, free slots and all retired slots.
+    free(_slots.load(std::memory_order_relaxed));
+    for (_Slots *retired = _retiredSlots.load(std::memory_order_relaxed); retired; )
+    {
+        _Slots *next = retired->retired;
+        free(retired);
+        retired = next;
+    }
+}
+
+template <typename SessionInfo>
+SessionInfo *LLBC_ReadySessionTable<SessionInfo>::Find(int sessionId) const
+{
+    const _Slot *slot = FindSlot(sessionId);
+    return slot ? slot->sessionInfo : nullptr;
+}
+
+template <typename SessionInfo>
+int LLBC_ReadySessionTable<SessionInfo>::Insert(SessionInfo *sessionInfo)
+{
+    // Session Id must be positive(slot tag <= 0 means empty/erased slot).
+    if (UNLIKELY(sessionInfo->sessionId <= 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    if (UNLIKELY(FindSlot(sessionInfo->sessionId)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return LLBC_FAILED;
+    }
+
+    // Rehash slots, if ready sessions + tombstones will exceed half of slot count,
+    // double slot count only when ready sessions exceed third of slot count, otherwise only drop tombstones
+    // (at least slot count / 6 insertions between two same size rehashes).
+    _Slots *slots = _slots.load(std::memory_order_relaxed);
+    if (UNLIKELY(!slots))
+    {
+        if (RehashSlots(_initSlotCount) != LLBC_OK)
+            return LLBC_FAILED;
+    }
+    else
+    {
+        const size_t slotCount = static_cast<size_t>(slots->slotMask) + 1;
+        const size_t readyCount = _sessionInfos.size() + 1;
+        if (UNLIKELY((readyCount + _erasedSlotCount) * 2 > slotCount))
+        {
+            if (RehashSlots(static_cast<int>(readyCount * 3 > slotCount ? slotCount * 2 : slotCount)) != LLBC_OK)
+                return LLBC_FAILED;
+        }
+    }
+
+    if (PlaceSlot(_slots.load(std::memory_order_relaxed), sessionInfo))
+        --_erasedSlotCount;
+
+    sessionInfo->listIndex = _sessionInfos.size();
+    _sessionInfos.push_back(sessionInfo);
+
+    return LLBC_OK;
+}
+
+template <typename SessionInfo>
+SessionInfo *LLBC_ReadySessionTable<SessionInfo>::Erase(int sessionId)
+{
+    // Mark slot erased(keep probe sequence of other ready sessions unchanged).
+    _Slot *slot = FindSlot(sessionId);
+    if (!slot)
+        return nullptr;
+
+    SessionInfo *sessionInfo = slot->sessionInfo;
+    slot->tag.store(_erasedTag, std::memory_order_release);
+    slot->sessionInfo = nullptr;
+    ++_erasedSlotCount;
+
+    // If next slot is empty, no probe sequence pass through the tailing erased slots, reset them to empty.
+    _Slots *slots = _slots.load(std::memory_order_relaxed);
+    const int slotMask = slots->slotMask;
+    int slotIdx = static_cast<int>(slot - slots->slots);
+    if (slots->slots[(slotIdx + 1) & slotMask].tag.load(std::memory_order_relaxed) == 0)
+    {
+        for (int i = 0;
+             i <= slotMask && slots->slots[slotIdx].tag.load(std::memory_order_relaxed) == _erasedTag;
+             ++i)
+        {
+            slots->slots[slotIdx].tag.store(0, std::memory_order_release);
+            --_erasedSlotCount;
+            slotIdx = (slotIdx - 1) & slotMask;
+        }
+    }
+
+    // Erase from ready session info list(swap with last one).
+    SessionInfo *lastSessionInfo = _sessionInfos.back();
+    lastSessionInfo->listIndex = sessionInfo->listIndex;
+    _sessionInfos[sessionInfo->listIndex] = lastSessionInfo;
+    _sessionInfos.pop_back();
+
+    return sessionInfo;
+}
+
+template <typename SessionInfo>
+void LLBC_ReadySessionTable<SessionInfo>::Clear()
+{
+    // All ready sessions erased, reset slots to empty(no probe sequence need to keep).
+    _Slots *slots = _slots.load(std::memory_order_relaxed);
+    if (slots)
+    {
+        for (int i = 0; i <= slots->slotMask; ++i)
+        {
+            _Slot &slot = slots->slots[i];
+            if (slot.tag.load(std::memory_order_relaxed) != 0)
+            {
+                slot.tag.store(0, std::memory_order_release);
+                slot.sessionInfo = nullptr;
+            }
+        }
+
+        slots->maxProbeLen.store(0, std::memory_order_release);
+    }
+
+    _erasedSlotCount = 0;
+    _sessionInfos.clear();
+}
+
+template <typename SessionInfo>
+bool LLBC_ReadySessionTable<SessionInfo>::IsReady(int sessionId, bool &isListenSession) const
+{
+    // Register as lock-free reader before loading slots, so that the slots loaded are never freed
+    // until leave(see ReclaimRetiredSlots()), stripe selected by thread to avoid cache line contention.
+    static std::atomic<int> nextStripeIdx(0);
+    static thread_local const int stripeIdx =
+        nextStripeIdx.fetch_add(1, std::memory_order_relaxed) & (_readerStripeCount - 1);
+    std::atomic<sint64> &readers = _readerStripes[stripeIdx].readers;
+    readers.fetch_add(1, std::memory_order_seq_cst);
+
+    bool ready = false;
+    const _Slots *slots = _slots.load(std::memory_order_seq_cst);
+    if (LIKELY(slots))
+    {
+        // Tag packed sessionId and listen flag, so tag load is enough to check ready.
+        const int maxProbeLen = slots->maxProbeLen.load(std::memory_order_acquire);
+        for (int probe = 0; probe <= maxProbeLen; ++probe)
+        {
+            const sint64 tag =
+                slots->slots[(static_cast<uint32>(sessionId) + probe) & slots->slotMask].tag.load(std::memory_order_acquire);
+            if (tag == 0)
+                break;
+
+            if (tag > 0 && (tag >> 1) == sessionId)
+            {
+                isListenSession = (tag & 1) != 0;
+                ready = true;
+                break;
+            }
+        }
+    }
+
+    readers.fetch_sub(1, std::memory_order_release);
+
+    return ready;
+}
+
+template <typename SessionInfo>
+bool LLBC_ReadySessionTable<SessionInfo>::HasRetiredSlots() const
+{
+    return _retiredSlots.load(std::memory_order_relaxed) != nullptr;
+}
+
+template <typename SessionInfo>
+int LLBC_ReadySessionTable<SessionInfo>::ReclaimRetiredSlots()
+{
+    _Slots *retired = _retiredSlots.load(std::memory_order_relaxed);
+    if (!retired)
+        return 0;
+
+    // All retired slots were replaced before now, a reader which may still reading them must registered
+    // before replacement and not leave yet, if every stripe observed zero, no such reader.
+    for (auto &stripe : _readerStripes)
+    {
+        if (stripe.readers.load(std::memory_order_seq_cst) != 0)
+            return 0;
+    }
+
+    int freedCount = 0;
+    _retiredSlots.store(nullptr, std::memory_order_relaxed);
+    while (retired)
+    {
+        _Slots *next = retired->retired;
+        free(retired);
+        retired = next;
+
+        ++freedCount;
+    }
+
+    return freedCount;
+}
+
+template <typename SessionInfo>
+const std::vector<SessionInfo *> &LLBC_ReadySessionTable<SessionInfo>::GetSessionInfos() const
+{
+    return _sessionInfos;
+}
+
+template <typename SessionInfo>
+int LLBC_ReadySessionTable<SessionInfo>::GetSlotCount() const
+{
+    const _Slots *slots = _slots.load(std::memory_order_relaxed);
+    return slots ? slots->slotMask + 1 : 0;
+}
+
+template <typename SessionInfo>
+int LLBC_ReadySessionTable<SessionInfo>::GetErasedSlotCount() const
+{
+    return _erasedSlotCount;
+}
+
+template <typename SessionInfo>
+int LLBC_ReadySessionTable<SessionInfo>::GetMaxProbeLen() const
+{
+    const _Slots *slots = _slots.load(std::memory_order_relaxed);
+    return slots ? slots->maxProbeLen.load(std::memory_order_relaxed) : 0;
+}
+
+template <typename SessionInfo>
+typename LLBC_ReadySessionTable<SessionInfo>::_Slot *
+LLBC_ReadySessionTable<SessionInfo>::FindSlot(int sessionId) const
+{
+    _Slots *slots = _slots.load(std::memory_order_relaxed);
+    if (UNLIKELY(!slots))
+        return nullptr;
+
+    const int maxProbeLen = slots->maxProbeLen.load(std::memory_order_relaxed);
+    for (int probe = 0; probe <= maxProbeLen; ++probe)
+    {
+        _Slot &slot = slots->slots[(static_cast<uint32>(sessionId) + probe) & slots->slotMask];
+        const sint64 tag = slot.tag.load(std::memory_order_relaxed);
+        if (tag == 0)
+            return nullptr;
+
+        if (tag > 0 && (tag >> 1) == sessionId)
+            return &slot;
+    }
+
+    return nullptr;
+}
+
+template <typename SessionInfo>
+int LLBC_ReadySessionTable<SessionInfo>::RehashSlots(int slotCount)
+{
+    _Slots *newSlots = LLBC_Calloc(_Slots, sizeof(_Slots) + sizeof(_Slot) * (slotCount - 1));
+    if (UNLIKELY(!newSlots))
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    // New slots have no tombstone, max probe length recomputed by placement.
+    newSlots->slotMask = slotCount - 1;
+    for (SessionInfo *sessionInfo : _sessionInfos)
+        PlaceSlot(newSlots, sessionInfo);
+
+    // Publish new slots, old slots retired(lock-free readers maybe still reading it, see ReclaimRetiredSlots()).
+    _Slots *oldSlots = _slots.exchange(newSlots, std::memory_order_seq_cst);
+    if (oldSlots)
+    {
+        oldSlots->retired = _retiredSlots.load(std::memory_order_relaxed);
+        _retiredSlots.store(oldSlots, std::memory_order_relaxed);
+    }
+
+    _erasedSlotCount = 0;
+
+    return LLBC_OK;
+}
+
+template <typename SessionInfo>
+bool LLBC_ReadySessionTable<SessionInfo>::PlaceSlot(_Slots *slots, SessionInfo *sessionInfo)
+{
+    const int sessionId = sessionInfo->sessionId;
+    for (int probe = 0; ; ++probe)
+    {
+        _Slot &slot = slots->slots[(static_cast<uint32>(sessionId) + probe) & slots->slotMask];
+        const sint64 tag = slot.tag.load(std::memory_order_relaxed);
+        if (tag > 0)
+            continue;
+
+        // Update max probe length before slot tag set, make lock-free readers can find it.
+        if (probe > slots->maxProbeLen.load(std::memory_order_relaxed))
+            slots->maxProbeLen.store(probe, std::memory_order_release);
+
+        slot.sessionInfo = sessionInfo;
+        slot.tag.store((static_cast<sint64>(sessionId) << 1) | (sessionInfo->isListenSession ? 1 : 0),
+                       std::memory_order_release);
+
+        return tag == _erasedTag;
+    }
+}
+
+__LLBC_NS_END
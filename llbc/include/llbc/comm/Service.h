@@ -36,6 +36,7 @@ class LLBC_ComponentFactory;
 class LLBC_IProtocolFactory;
 class LLBC_ProtocolStack;
 class LLBC_ServiceEventFirer;
+class LLBC_EvBlockAllocator;
 
 __LLBC_NS_END
 
@@ -251,6 +252,21 @@ public:
      */
     virtual int GetFrameInterval() const = 0;
 
+    /**
+     * Check service is event wakeup or not.
+     * If service is event wakeup, service will wait queued events until frame end instead of sleeping,
+     * and handle the arrived events(eg: DataArrival) immediately.
+     * @return bool - the event wakeup flag.
+     */
+    virtual bool IsEventWakeup() const = 0;
+
+    /**
+     * Set service event wakeup flag.
+     * @param[in] eventWakeup - the event wakeup flag.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetEventWakeup(bool eventWakeup) = 0;
+
 public:
     /**
      * Create a session and listening.
@@ -653,6 +669,16 @@ public:
      */
     virtual LLBC_ObjPool &GetThreadUnsafeObjPool() = 0;
 
+    /**
+     * Get service event block statistics, service events and poller events are constructed in
+     * message blocks acquired from service thread-safe object pool.
+     * Note: Under steady load, heapAllocCount should not grow, object pool self allocations
+     *       can be observed by GetThreadSafeObjPool().GetStatistics().
+     * @param[out] acquiredCount  - the acquired event blocks count.
+     * @param[out] heapAllocCount - the event block heap allocations count(pool disabled or block grown).
+     */
+    virtual void GetEvBlockStatistics(sint64 &acquiredCount, sint64 &heapAllocCount) const = 0;
+
 public:
     /**
      * One time service call routine, if service drive mode is ExternalDrive, you must manual call this method.
@@ -677,6 +703,7 @@ protected:
      *  Access method list:
      *      CreateFullStack()
      *      CreatePackStack()
+     *      GetEvBlockAllocator()
      */
     friend class LLBC_Session;
 
@@ -697,6 +724,7 @@ protected:
      * Declare friend class: LLBC_BasePoller.
      *  Access method list:
      *      AddReadySession()
+     *      GetEvBlockAllocator()
      */
     friend class LLBC_BasePoller;
 
@@ -726,6 +754,7 @@ protected:
      * Declare friend class: LLBC_pollerMgr.
      *  Access method list:
      *      AddSessionProtocolFactory()
+     *      GetEvBlockAllocator()
      */
     friend class LLBC_PollerMgr;
 
@@ -735,6 +764,20 @@ protected:
     virtual void AddSessionProtocolFactory(int sessionId, LLBC_IProtocolFactory *protoFactory) = 0;
     virtual LLBC_IProtocolFactory *FindSessionProtocolFactory(int sessionId) = 0;
     virtual void RemoveSessionProtocolFactory(int sessionId) = 0;
+
+protected:
+    /**
+     * Declare friend class: LLBC_IProtocol.
+     *  Access method list:
+     *      GetEvBlockAllocator()
+     */
+    friend class LLBC_IProtocol;
+
+protected:
+    /**
+     * Get event block allocator(call by session, poller, poller manager and protocol class).
+     */
+    virtual LLBC_EvBlockAllocator &GetEvBlockAllocator() = 0;
 };
 
 __LLBC_NS_END
@@ -122,10 +122,12 @@ struct LLBC_HIDDEN LLBC_SvcEv_AsyncConn : public LLBC_ServiceEvent
 
 /**
  * \brief The data-arrival event structure encapsulation.
+ *        Carry all packets parsed from one session recv, packet pointers store after event structure.
  */
 struct LLBC_HIDDEN LLBC_SvcEv_DataArrival : public LLBC_ServiceEvent
 {
-    LLBC_Packet *packet;
+    LLBC_Packet **packets;
+    size_t packetCount;
 
     LLBC_SvcEv_DataArrival();
     ~LLBC_SvcEv_DataArrival() override;
@@ -194,7 +196,7 @@ struct LLBC_HIDDEN LLBC_SvcEv_AppPhaseEv : public LLBC_ServiceEvent
     bool willStop;
 
     int cfgType;
-    LLBC_Variant cfg;
+    std::shared_ptr<const LLBC_Variant> cfg; // Application config snapshot.
 
     LLBC_SvcEv_AppPhaseEv();
 };
@@ -205,7 +207,7 @@ struct LLBC_HIDDEN LLBC_SvcEv_AppPhaseEv : public LLBC_ServiceEvent
 struct LLBC_HIDDEN LLBC_SvcEv_AppReloadedEv : public LLBC_ServiceEvent
 {
     int cfgType;
-    LLBC_Variant cfg;
+    std::shared_ptr<const LLBC_Variant> cfg; // Application config snapshot.
 
     LLBC_SvcEv_AppReloadedEv();
 };
@@ -221,6 +223,58 @@ struct LLBC_HIDDEN LLBC_SvcEv_ComponentEventEv : public LLBC_ServiceEvent
     LLBC_SvcEv_ComponentEventEv();
 };
 
+/**
+ * \brief The event block allocator class encapsulation.
+ *        Service events and poller events are constructed in message blocks, allocator acquire these
+ *        blocks from service thread-safe object pool, so steady-state event path has no heap allocation.
+ */
+class LLBC_HIDDEN LLBC_EvBlockAllocator
+{
+public:
+    LLBC_EvBlockAllocator(LLBC_ObjPool &objPool, LLBC_ObjPool &sliceObjPool);
+
+public:
+    /**
+     * Acquire event block, the acquired block capacity at least size bytes, use Release() to release it.
+     * @param[in] allocator - the event block allocator, if is null, block will be heap allocated.
+     * @param[in] size      - the event size, in bytes.
+     * @return LLBC_MessageBlock * - the event block.
+     */
+    static LLBC_MessageBlock *Acquire(LLBC_EvBlockAllocator *allocator, size_t size);
+
+    /**
+     * Release event block, pooled block buffer greater than LLBC_CFG_COMM_POOLED_EVENT_BLOCK_MAX_KEEP_SIZE
+     * will be freed before recycle.
+     * @param[in] block - the event block.
+     */
+    static void Release(LLBC_MessageBlock *block);
+
+    /**
+     * Get slice block pool, use for create shared message block slices(payload slice, multicast slice).
+     * @return LLBC_TypedObjPool<LLBC_MessageBlock> * - the slice block pool, return null if pooled event
+     *                                                  block disabled.
+     */
+    LLBC_TypedObjPool<LLBC_MessageBlock> *GetSliceBlockPool() const;
+
+public:
+    /**
+     * Get acquired event blocks count.
+     */
+    sint64 GetAcquiredCount() const;
+
+    /**
+     * Get event block heap allocations count(pool disabled or block buffer grown).
+     */
+    sint64 GetHeapAllocCount() const;
+
+private:
+    LLBC_TypedObjPool<LLBC_MessageBlock> *_blockPool;
+    LLBC_TypedObjPool<LLBC_MessageBlock> *_sliceBlockPool;
+
+    volatile sint64 _acquiredCount;
+    volatile sint64 _heapAllocCount;
+};
+
 /**
  * \brief The service event util class encapsulation.
  *        Use for Build/Destroy service events.
@@ -236,7 +290,8 @@ public:
                                                    bool isListen,
                                                    int sessionId,
                                                    int acceptSessionId,
-                                                   LLBC_SocketHandle handle);
+                                                   LLBC_SocketHandle handle,
+                                                   LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build session destroy event.
@@ -247,7 +302,8 @@ public:
                                                     int sessionId,
                                                     int acceptSessionId,
                                                     LLBC_SocketHandle handle,
-                                                    LLBC_SessionCloseInfo *closeInfo);
+                                                    LLBC_SessionCloseInfo *closeInfo,
+                                                    LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build async-connect result event.
@@ -255,12 +311,15 @@ public:
     static LLBC_MessageBlock *BuildAsyncConnResultEv(int sessionId,
                                                      bool connected,
                                                      const LLBC_String &reason,
-                                                     const LLBC_SockAddr_IN &peer);
+                                                     const LLBC_SockAddr_IN &peer,
+                                                     LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
-     * Build Data-Arrival event.
+     * Build Data-Arrival event, all packets must belong to same session.
      */
-    static LLBC_MessageBlock *BuildDataArrivalEv(LLBC_Packet *packet);
+    static LLBC_MessageBlock *BuildDataArrivalEv(LLBC_Packet * const *packets,
+                                                 size_t packetCount,
+                                                 LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build subscribe-event event.
@@ -268,7 +327,8 @@ public:
     static LLBC_MessageBlock *BuildSubscribeEventEv(int id,
                                                     const LLBC_ListenerStub &stub,
                                                     const LLBC_Delegate<void(LLBC_Event &)> &deleg,
-                                                    LLBC_EventListener *listener);
+                                                    LLBC_EventListener *listener,
+                                                    LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build proto-report event.
@@ -277,19 +337,22 @@ public:
                                                  int opcode,
                                                  int layer,
                                                  int level,
-                                                 const LLBC_String &report);
+                                                 const LLBC_String &report,
+                                                 LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build unsubscribe-event event.
      */
     static LLBC_MessageBlock *BuildUnsubscribeEventEv(int id,
-                                                      const LLBC_ListenerStub &stub);
+                                                      const LLBC_ListenerStub &stub,
+                                                      LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build fire-event event.
      */
     static LLBC_MessageBlock *BuildFireEventEv(LLBC_Event *ev,
-                                               const LLBC_Delegate<void(LLBC_Event *)> &dequeueHandler);
+                                               const LLBC_Delegate<void(LLBC_Event *)> &dequeueHandler,
+                                               LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build application phase event.
@@ -299,23 +362,26 @@ public:
                                               bool startFinished,
                                               bool willStop,
                                               int cfgType,
-                                              const LLBC_Variant &cfg = LLBC_Variant::nil);
+                                              const std::shared_ptr<const LLBC_Variant> &cfg = nullptr,
+                                              LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build application reloaded event.
      */
     static LLBC_MessageBlock *BuildAppReloadedEv(int cfgType,
-                                                 const LLBC_Variant &cfg);
+                                                 const std::shared_ptr<const LLBC_Variant> &cfg,
+                                                 LLBC_EvBlockAllocator *allocator = nullptr);
 
     /**
      * Build component event ev.
      */
     static LLBC_MessageBlock *BuildComponentEventEv(int eventType,
-                                                    const LLBC_Variant &eventParams);
+                                                    const LLBC_Variant &eventParams,
+                                                    LLBC_EvBlockAllocator *allocator = nullptr);
 
 public:
     /**
-     * Destroy service event block.
+     * Destroy service event block, the block will be recycled.
      */
     static void DestroyEvBlock(LLBC_MessageBlock *block);
 };
@@ -28,6 +28,25 @@
 
 __LLBC_NS_BEGIN
 
+inline sint64 LLBC_EvBlockAllocator::GetAcquiredCount() const
+{
+    return LLBC_AtomicGet(const_cast<volatile sint64 *>(&_acquiredCount));
+}
+
+inline sint64 LLBC_EvBlockAllocator::GetHeapAllocCount() const
+{
+    return LLBC_AtomicGet(const_cast<volatile sint64 *>(&_heapAllocCount));
+}
+
+inline LLBC_TypedObjPool<LLBC_MessageBlock> *LLBC_EvBlockAllocator::GetSliceBlockPool() const
+{
+    #if LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+    return _sliceBlockPool;
+    #else // !LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+    return nullptr;
+    #endif // LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+}
+
 inline LLBC_ServiceEvent::LLBC_ServiceEvent(int type)
 : type(type)
 {
@@ -68,14 +87,18 @@ inline LLBC_SvcEv_AsyncConn::LLBC_SvcEv_AsyncConn()
 
 inline LLBC_SvcEv_DataArrival::LLBC_SvcEv_DataArrival()
 : LLBC_ServiceEvent(LLBC_ServiceEventType::DataArrival)
-, packet(nullptr)
+, packets(nullptr)
+, packetCount(0)
 {
 }
 
 inline LLBC_SvcEv_DataArrival::~LLBC_SvcEv_DataArrival()
 {
-    if (packet)
-        LLBC_Recycle(packet);
+    for (size_t i = 0; i < packetCount; ++i)
+    {
+        if (packets[i])
+            LLBC_Recycle(packets[i]);
+    }
 }
 
 inline LLBC_SvcEv_ProtoReport::LLBC_SvcEv_ProtoReport()
@@ -25,6 +25,7 @@
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/ServiceEventFirer.h"
 #include "llbc/comm/PollerMgr.h"
+#include "llbc/comm/ReadySessionTable.h"
 #include "llbc/comm/protocol/ProtocolStack.h"
 
 __LLBC_NS_BEGIN
@@ -147,6 +148,19 @@ public:
      */
     int GetFrameInterval() const override;
 
+    /**
+     * Check service is event wakeup or not.
+     * @return bool - the event wakeup flag.
+     */
+    bool IsEventWakeup() const override;
+
+    /**
+     * Set service event wakeup flag.
+     * @param[in] eventWakeup - the event wakeup flag.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetEventWakeup(bool eventWakeup) override;
+
 public:
     /**
      * Create a session and listening.
@@ -417,6 +431,13 @@ public:
      */
     LLBC_ObjPool &GetThreadUnsafeObjPool() override;
 
+    /**
+     * Get service event block statistics.
+     * @param[out] acquiredCount  - the acquired event blocks count.
+     * @param[out] heapAllocCount - the event block heap allocations count.
+     */
+    void GetEvBlockStatistics(sint64 &acquiredCount, sint64 &heapAllocCount) const override;
+
 public:
     /**
      * One time service call routine, if service drive mode is ExternalDrive, you must manual call this method.
@@ -483,6 +504,12 @@ protected:
     void RemoveReadySession(int sessionId);
     void RemoveAllReadySessions();
 
+protected:
+    /**
+     * Get event block allocator(call by session, poller and poller manager class).
+     */
+    LLBC_EvBlockAllocator &GetEvBlockAllocator() override;
+
 protected:
     /**
      * Task entry method.
@@ -524,6 +551,8 @@ private:
      * Queued event operation methods.
      */
     void HandleQueuedEvents();
+    void HandleQueuedEvent(LLBC_MessageBlock *block);
+    void WaitQueuedEvents(sint64 frameEndTime);
     void HandleEv_SessionCreate(LLBC_ServiceEvent &ev);
     void HandleEv_SessionDestroy(LLBC_ServiceEvent &ev);
     void HandleEv_AsyncConnResult(LLBC_ServiceEvent &ev);
@@ -535,6 +564,14 @@ private:
     void HandleEv_AppPhaseEv(LLBC_ServiceEvent &ev);
     void HandleEv_AppReloaded(LLBC_ServiceEvent &ev);
     void HandleEv_ComponentEvent(LLBC_ServiceEvent &ev);
+    void HandleArrivedPacket(LLBC_Packet *packet);
+
+    /**
+     * Packet handlers dispatch table operation methods.
+     */
+    struct _PacketHandlers;
+    _PacketHandlers &GetOrCreatePacketHandlers(int opcode);
+    _PacketHandlers *FindPacketHandlers(int opcode);
 
     /**
      * Component operation methods.
@@ -568,6 +605,11 @@ private:
      */
     void ProcessIdle();
 
+    /**
+     * Object pools trim method, trim service object pools and current thread object pools in interval.
+     */
+    void TrimObjPools();
+
 private:
     /**
      * Internal helper methods.
@@ -586,6 +628,19 @@ private:
                      bool checkRunningPhase = true,
                      bool checkSessionValidity = true);
 
+    /**
+     * Multicast helper method, must be called in service lock and running phase checked.
+     * If enabled encode-once multicast option, the packet will be encoded only once and the encoded
+     * data will be shared to all stateless-send protocol factory created sessions.
+     */
+    void LockedMulticast(const LLBC_SessionIds &sessionIds,
+                         int opcode,
+                         const void *bytes,
+                         size_t len,
+                         int status,
+                         uint32 flags,
+                         bool checkSessionValidity);
+
 private:
     static int _maxId; // Max service Id.
 
@@ -619,6 +674,7 @@ private:
     bool _suppressedCoderNotFoundWarning; // Suppress coder not found warning flag.
     LLBC_IProtocolFactory *_dftProtocolFactory; // Default protocol factory.
     std::map<int, LLBC_IProtocolFactory *> _sessionProtoFactory; // Specific protocol factory.
+    LLBC_ProtocolStack *_multicastStack; // Encode-once multicast full protocol stack(default protocol factory).
     class _ReadySessionInfo // Ready session information.
     {
     public:
@@ -626,6 +682,7 @@ private:
         int acceptSessionId;
         bool isListenSession;
         LLBC_ProtocolStack *codecStack;
+        size_t listIndex; // Index in ready session info list.
 
     public:
         _ReadySessionInfo(int sessionId,
@@ -634,11 +691,12 @@ private:
                           LLBC_ProtocolStack *codecStack = nullptr);
         ~_ReadySessionInfo();
     };
-    std::map<int, _ReadySessionInfo *> _readySessionInfos; // Ready sessions set.
+    LLBC_ReadySessionTable<_ReadySessionInfo> _readySessionInfos; // Ready sessions set(IsReady() is lock-free).
     mutable LLBC_SpinLock _readySessionInfosLock; // Ready session set lock.
 
     // FPS about members.
     volatile int _fps; // Service FPS.
+    volatile bool _eventWakeup; // Event wakeup flag.
     sint64 _begSvcTime; // Begin heartbeat time, update on every heartbeat begin.
 
 private:
@@ -651,14 +709,19 @@ private:
 
     // Coder & Handler about members.
     std::map<int, LLBC_CoderFactory *> _coderFactories; // Coder Factories.
-    std::map<int, LLBC_Delegate<void(LLBC_Packet &)> > _handlers; // Packet handlers.
-    std::map<int, LLBC_Delegate<bool(LLBC_Packet &)> > _preHandlers; // Packet pre-handlers.
+    struct _PacketHandlers
+    {
+        LLBC_Delegate<bool(LLBC_Packet &)> preHandler; // Packet pre-handler.
+        LLBC_Delegate<void(LLBC_Packet &)> handler; // Packet handler.
+        #if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
+        std::map<int, LLBC_Delegate<void(LLBC_Packet &)> > statusHandlers; // Status handlers(status->handler).
+        #endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
+    };
+    std::unordered_map<int, _PacketHandlers> _packetHandlers; // Packet handlers(opcode->handlers).
+    std::vector<_PacketHandlers *> _directIndexedPacketHandlers; // Direct-indexed packet handlers(index: opcode).
     #if LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
     LLBC_Delegate<bool(LLBC_Packet &)> _unifyPreHandler; // Unify packet pre-handler.
     #endif // LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
-    #if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
-    std::map<int, std::map<int, LLBC_Delegate<void(LLBC_Packet &)> > > _statusHandlers; // Status handlers.
-    #endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
 
 private:
     // Service extend functions about members.
@@ -669,8 +732,11 @@ private:
     LLBC_AutoReleasePoolStack *_releasePoolStack; // Auto-Release pool stack.
 
     // - ObjPool support members.
+    LLBC_ObjPool _sliceBlockObjPool; // Slice block object pool(must outlive packets in thread-safe object pool).
     LLBC_ObjPool _threadSafeObjPool; // Thread-safe object pool.
     LLBC_ObjPool _threadUnsafeObjPool; // Thread-unsafe object pool.
+    sint64 _lastTrimObjPoolsTime; // Last trim object pools time.
+    LLBC_EvBlockAllocator _evBlockAllocator; // Service/Poller event block allocator.
 
     // - Timer scheduler.
     LLBC_TimerScheduler *_timerScheduler; // Timer scheduler.
@@ -69,11 +69,29 @@ inline int LLBC_ServiceImpl::GetFrameInterval() const
     return fps != static_cast<int>(LLBC_INFINITE) ? 1000 / fps : 0;
 }
 
+inline bool LLBC_ServiceImpl::IsEventWakeup() const
+{
+    return _eventWakeup;
+}
+
 inline LLBC_EventMgr &LLBC_ServiceImpl::GetEventManager()
 {
     return _evManager;
 }
 
+inline LLBC_ServiceImpl::_PacketHandlers *LLBC_ServiceImpl::FindPacketHandlers(int opcode)
+{
+    // Direct-indexed dispatch.
+    if (static_cast<size_t>(opcode) < _directIndexedPacketHandlers.size())
+        return _directIndexedPacketHandlers[opcode];
+    else if (opcode >= 0 && opcode < LLBC_CFG_COMM_PACKET_HANDLERS_DIRECT_INDEX_LIMIT)
+        return nullptr;
+
+    // Hash dispatch(opcode out of direct-indexed range).
+    const auto it = _packetHandlers.find(opcode);
+    return it != _packetHandlers.end() ? &it->second : nullptr;
+}
+
 inline LLBC_ObjPool &LLBC_ServiceImpl::GetThreadSafeObjPool()
 {
     return _threadSafeObjPool;
@@ -84,6 +102,17 @@ inline LLBC_ObjPool &LLBC_ServiceImpl::GetThreadUnsafeObjPool()
     return _threadUnsafeObjPool;
 }
 
+inline void LLBC_ServiceImpl::GetEvBlockStatistics(sint64 &acquiredCount, sint64 &heapAllocCount) const
+{
+    acquiredCount = _evBlockAllocator.GetAcquiredCount();
+    heapAllocCount = _evBlockAllocator.GetHeapAllocCount();
+}
+
+inline LLBC_EvBlockAllocator &LLBC_ServiceImpl::GetEvBlockAllocator()
+{
+    return _evBlockAllocator;
+}
+
 inline void LLBC_ServiceImpl::LockService()
 {
     _lock.Lock();
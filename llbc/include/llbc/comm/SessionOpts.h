@@ -109,6 +109,21 @@ public:
      */
     void SetSessionRecvBufSize(size_t sessionRecvBufSize);
 
+    /**
+     * Check session recv buffer reuse option.
+     * @return bool - return true if session reuse recv buffer, otherwise return false.
+     */
+    bool IsSessionRecvBufReuse() const;
+
+    /**
+     * Set session recv buffer reuse option.
+     * Note:
+     *  If enabled, session socket keep one recv buffer and reuse it in every recv operation,
+     *  otherwise session socket allocate new recv buffer in every recv operation.
+     * @param[in] reuse - the option value.
+     */
+    void SetSessionRecvBufReuse(bool reuse);
+
 public:
     /**
      * Get max packet size.
@@ -130,6 +145,7 @@ public:
 
 private:
     bool _noDelay; // No-delay option, default is true.
+    bool _sessionRecvBufReuse; // session recv buffer reuse option, default is LLBC_CFG_COMM_DFT_SESSION_RECV_BUF_REUSE.
     size_t _sockSendBufSize; // socket send buffer size, in bytes, default is 0, it means use os default.
     size_t _sockRecvBufSize; // socket recv buffer size, in bytes, default is 0, it means use os default.
     size_t _sessionSendBufSize; // session send buffer size, in bytes, default is LLBC_CFG_COMM_DFT_SESSION_SEND_BUF_SIZE
@@ -30,6 +30,7 @@ inline LLBC_SessionOpts::LLBC_SessionOpts(bool noDelay,
                                           size_t sessionRecvBufSize,
                                           size_t maxPacketSize)
 : _noDelay(noDelay)
+, _sessionRecvBufReuse(LLBC_CFG_COMM_DFT_SESSION_RECV_BUF_REUSE)
 , _sockSendBufSize(sockSendBufSize)
 , _sockRecvBufSize(sockRecvBufSize)
 , _sessionSendBufSize(sessionSendBufSize)
@@ -92,9 +93,25 @@ inline void LLBC_SessionOpts::SetSessionRecvBufSize(size_t sessionRecvBufSize)
     _sessionRecvBufSize = sessionRecvBufSize;
 }
 
+inline bool LLBC_SessionOpts::IsSessionRecvBufReuse() const
+{
+    return _sessionRecvBufReuse;
+}
+
+inline void LLBC_SessionOpts::SetSessionRecvBufReuse(bool reuse)
+{
+    _sessionRecvBufReuse = reuse;
+}
+
 inline bool LLBC_SessionOpts::operator==(const LLBC_SessionOpts &another) const
 {
-    return memcmp(this, &another, sizeof(LLBC_SessionOpts)) == 0;
+    return _noDelay == another._noDelay &&
+           _sessionRecvBufReuse == another._sessionRecvBufReuse &&
+           _sockSendBufSize == another._sockSendBufSize &&
+           _sockRecvBufSize == another._sockRecvBufSize &&
+           _sessionSendBufSize == another._sessionSendBufSize &&
+           _sessionRecvBufSize == another._sessionRecvBufSize &&
+           _maxPacketSize == another._maxPacketSize;
 }
 
 inline size_t LLBC_SessionOpts::GetMaxPacketSize() const
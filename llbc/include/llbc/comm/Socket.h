@@ -222,6 +222,25 @@ public:
      */
     int SetMaxPacketSize(size_t size);
 
+public:
+    /**
+     * Check given message block is this socket's reusable recv buffer or not.
+     * Note:
+     *  The reusable recv buffer always owned by socket, protocols can't recycle it.
+     * @param[in] block - the message block.
+     * @return bool - return true if is reusable recv buffer, otherwise return false.
+     */
+    bool IsRecvBuf(const LLBC_MessageBlock *block) const;
+
+    /**
+     * Get reusable recv buffer, protocols can create payload slices from it.
+     * Note:
+     *  If any slice still alive after recv data processed, socket will give up this
+     *  recv buffer and create new one in next recv operation.
+     * @return LLBC_SharedMessageBlock * - the reusable recv buffer, maybe nullptr.
+     */
+    LLBC_SharedMessageBlock *GetRecvBuf() const;
+
 public:
     /**
      * Bind current socket to specific ip address and port.
@@ -469,6 +488,13 @@ private:
     int PostZeroWSARecv();
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+    /**
+     * Reset reusable recv buffer, if recv buffer expanded too large or still referenced by
+     * payload slices, will release it.
+     * @param[in] recvBufSize - the session recv buffer size.
+     */
+    void ResetRecvBuf(size_t recvBufSize);
+
 private:
     LLBC_SocketHandle _handle;
 
@@ -482,6 +508,8 @@ private:
     LLBC_MessageBuffer _willSend;
     size_t _maxPacketSize;
 
+    LLBC_SharedMessageBlock *_recvBuf;
+
 #if LLBC_TARGET_PLATFORM_WIN32
     bool _nonBlocking;
     LLBC_OverlappedGroup _olGroup;
@@ -30,6 +30,7 @@ __LLBC_NS_BEGIN
  */
 class LLBC_Packet;
 class LLBC_Session;
+class LLBC_MessageBlock;
 class LLBC_CoderFactory;
 class LLBC_ProtocolStack;
 class LLBC_IProtocolFilter;
@@ -121,6 +122,17 @@ protected:
      */
     LLBC_Service *GetService();
 
+    /**
+     * Set received packet payload from block readable data([read pos, read pos + len)).
+     * If block is socket reusable recv buffer and len >= LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE,
+     * use recv buffer slice as payload(no copy), otherwise copy data to payload, small payloads never
+     * pin recv buffer, so recv buffer can be reused in next recv.
+     * @param[in] packet - the received packet.
+     * @param[in] block  - the block which contain payload data.
+     * @param[in] len    - the payload length.
+     */
+    void SetRecvPayload(LLBC_Packet *packet, LLBC_MessageBlock *block, size_t len);
+
 private:
     /**
      * Friend class: LLBC_ProtocolStack.
@@ -164,6 +176,7 @@ protected:
     LLBC_IProtocolFilter *_filter;
     const Coders *_coders;
     LLBC_TypedObjPool<LLBC_Packet> *_pktObjPool;
+    LLBC_TypedObjPool<LLBC_MessageBlock> *_sliceBlockPool;
 };
 
 __LLBC_NS_END
@@ -48,6 +48,14 @@ public:
      * @return LLBC_IProtocol * - the protocol pointer.
      */
     virtual LLBC_IProtocol *Create(int layer) const = 0;
+
+    /**
+     * Check the created protocols send logic is stateless(not depend on session) or not.
+     * If is stateless, service can encode multicast/broadcast packet once and share the
+     * encoded data to all target sessions.
+     * @return bool - the stateless flag, default return false.
+     */
+    virtual bool IsStatelessSend() const { return false; }
 };
 
 __LLBC_NS_END
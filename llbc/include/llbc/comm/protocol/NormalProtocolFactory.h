@@ -36,6 +36,12 @@ public:
      * @return LLBC_IProtocol * - the protocol pointer.
      */
     LLBC_IProtocol *Create(int layer) const override;
+
+    /**
+     * Check the created protocols send logic is stateless or not.
+     * @return bool - always return true.
+     */
+    bool IsStatelessSend() const override;
 };
 
 __LLBC_NS_END
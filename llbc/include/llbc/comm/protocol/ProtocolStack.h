@@ -184,7 +184,8 @@ public:
     /**
      * When packet recv, will use this protocol stack method to convert message-block type to packets.
      * @param[in] block          - the message block.
-     * @param[in] packets        - the converted packet list.
+     * @param[in] packets        - the converted packet list, if decode failed and need remove session,
+     *                             still hold the packets decoded before the failed one.
      * @param[out] removeSession - when error occurred, this out param determine remove session or not.
      * @return int - return 0 if success, otherwise return -1.
      */
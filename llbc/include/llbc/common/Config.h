@@ -66,6 +66,8 @@
 #define LLBC_CFG_CORE_VARIANT_FAST_NUM_AS_STR_BEGIN         ((int)-256)
 // Define variant number as string method fast access end number(included).
 #define LLBC_CFG_CORE_VARIANT_FAST_NUM_AS_STR_END           ((int)256)
+// Define compact variant arena default block size, in bytes, default is 16KB.
+#define LLBC_CFG_CORE_VARIANT_COMPACT_ARENA_BLOCK_SIZE      16384
 
 /**
  * \brief core/file about config options define.
@@ -91,6 +93,9 @@
 #define LLBC_CFG_CORE_UTILS_IMPL__UI64TOA                   0
 // Determine define win32-styled string datatypes or not, eg:LPSTR/LPTSTR/...
 #define LLBC_CFG_CORE_UTILS_DEF_WIN32_STYLED_STR_DATATYPES  0
+// Delegate inline storage size(bytes), callable objects(object method, lambda, ...) that fit in it
+// are stored inline without heap allocation, default is 6 pointers(delegate object fills one cache line).
+#define LLBC_CFG_CORE_UTILS_DELEGATE_INLINE_SIZE            (sizeof(void *) * 6)
 
 /**
  * \brief core/sampler about config options define.
@@ -130,6 +135,17 @@
 #define LLBC_CFG_LOG_FORMAT_BUF_SIZE                        16 * 1024
 // Default log level is set to TRACE(TRACE:0, DEBUG:1, INFO:2, WARN:3, ERROR:4, FATAL:5).
 #define LLBC_CFG_LOG_DEFAULT_LEVEL                          0
+// Compile time min log level, LLOG/LSLOG/LDLOG family log statements which level less than this
+// level will be compiled out(arguments never be evaluated), can be overrided by compiler option.
+#ifndef LLBC_CFG_LOG_COMPILE_MIN_LEVEL
+#define LLBC_CFG_LOG_COMPILE_MIN_LEVEL                      0
+#endif
+// Enable per-call-site cached log level check in LLOG/LSLOG/LDLOG family macros(only available
+// when logger name and log level are compile time constants, non-Win32 only).
+// Note: constant is judged by __builtin_constant_p(), literal logger name/log level always can be
+//       cached, but logger name passed by variable(even const variable) usually is not constant
+//       in -O0/-O1 builds, these call sites fall back to uncached log level check.
+#define LLBC_CFG_LOG_CALL_SITE_LEVEL_CACHE                  1
 // Default DEBUG/INFO level log to console flush attr.
 # define LLBC_CFG_LOG_DIRECT_FLUSH_TO_CONSOLE               0
 // Default log asynchronous mode is set to false.
@@ -175,10 +191,48 @@
 #define LLBC_CFG_LOG_ROOT_LOGGER_TAKE_OVER_UNCONFIGED       1
 // Default logfile create option
 #define LLBC_CFG_LOG_LAZY_CREATE_LOG_FILE                   0
+// Default binary log file option, if enabled, log file content is compact binary records(see tools/log_decoder).
+#define LLBC_CFG_LOG_DEFAULT_BINARY_LOG_FILE                0
+// Default mmap log file option, if enabled, log file is written through memory mapped, preallocated file segments.
+#define LLBC_CFG_LOG_DEFAULT_MMAP_LOG_FILE                  0
+// Default mmap log file segment size(file preallocate & map unit), in bytes.
+#define LLBC_CFG_LOG_DEFAULT_MMAP_SEGMENT_SIZE              (16 * 1024 * 1024)
+// Default is not log to network.
+#define LLBC_CFG_LOG_DEFAULT_LOG_TO_NETWORK                 0
+// Default network log pattern: time file:line@[Logger Name][Log Level] - Message\n.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_LOG_PATTERN            "%T %f:%l@[%N][%L] - %m%n"
+// Default network log protocol(TCP/UDP).
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_PROTOCOL               "TCP"
+// Default network log frame size(log records are batched into frames), in bytes.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_FRAME_SIZE             (64 * 1024)
+// Max network log frame size when using UDP protocol, in bytes.
+#define LLBC_CFG_LOG_MAX_NETWORK_UDP_FRAME_SIZE             (63 * 1024)
+// Default network log buffer size(pending frames when collector slow or disconnected), in bytes.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_BUFFER_SIZE            (8 * 1024 * 1024)
+// Network log buffer usage percent, when reached, the log records which level less than keep level will be dropped.
+#define LLBC_CFG_LOG_NETWORK_BUFFER_DROP_WATERMARK          75
+// The log level which only be dropped when network log buffer full(WARN).
+#define LLBC_CFG_LOG_NETWORK_BUFFER_KEEP_LEVEL              3
+// Network log collector connect timeout, in milli-seconds.
+#define LLBC_CFG_LOG_NETWORK_CONNECT_TIMEOUT                5000
+// Network log collector min/max reconnect interval(exponential backoff), in milli-seconds.
+#define LLBC_CFG_LOG_NETWORK_MIN_RECONNECT_INTERVAL         100
+#define LLBC_CFG_LOG_NETWORK_MAX_RECONNECT_INTERVAL         10000
+// Network log appender max send time when finalize(send pending frames), in milli-seconds.
+#define LLBC_CFG_LOG_NETWORK_FINALIZE_SEND_TIMEOUT          1000
 // Default log config item not config use default or root config(root/default).
 #define LLBC_CFG_LOG_DEFAULT_NOT_CONFIG_OPTION_USE          "root"
 // Log data object pool units size per stripe.
 #define LLBC_CFG_LOG_LOG_DATA_OBJPOOL_UNIT_SIZE_PER_BLOCK   512
+// Asynchronous log queue shard count, producer threads are assigned to shards round-robin(thread index % shard count),
+// so when more threads than shards are logging, several threads share one shard.
+#define LLBC_CFG_LOG_ASYNC_QUEUE_SHARD_COUNT                8
+// Asynchronous log queue capacity(all shards), in log data count.
+#define LLBC_CFG_LOG_ASYNC_QUEUE_CAPACITY                   (256 * 1024)
+// Default asynchronous log queue full policy(0:Block, 1:DropLowLevel, 2:SyncOutput).
+#define LLBC_CFG_LOG_DEFAULT_ASYNC_QUEUE_FULL_POLICY        0
+// The log level which never be dropped when using DropLowLevel queue full policy(WARN).
+#define LLBC_CFG_LOG_ASYNC_QUEUE_FULL_KEEP_LEVEL            3
 
 /**
  * \brief core/timer about configs.
@@ -187,6 +241,12 @@
 #define LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE                 0
 // Long timeout time, in milli-seconds, when a timer timeout time >= <this value>, when call Cancel(), will force remove from binary heap.
 #define LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME               864000000 // 10 days
+// Default timer scheduler type(0: Heap, 1: TimingWheel), thread timer schedulers use this type.
+// Note:
+// - timer scheduler type can be changed by LLBC_TimerScheduler::SetType() when no timer scheduled.
+#define LLBC_CFG_CORE_TIMER_DFT_SCHEDULER_TYPE              0
+// Per thread free timer data limit, timer data released to free list and reused by next schedule.
+#define LLBC_CFG_CORE_TIMER_DATA_FREE_LIST_LIMIT            16384
 
 /**
 * \brief core/objectpool about configs.
@@ -197,6 +257,8 @@
 #define LLBC_CFG_CORE_OBJPOOL_STRIPE_CAPACITY               1024
 // Object pool debug option.
 #define LLBC_CFG_CORE_OBJPOOL_DEBUG                         1
+// Object pool cache line size, use for cache line isolated objects(see LLBC_ObjReflector::IsCacheLineIsolated()).
+#define LLBC_CFG_CORE_OBJPOOL_CACHE_LINE_SIZE               64
 // Object reset match methods control.
 #define LLBC_CFG_CORE_OBJPOOL_OBJ_REUSE_MATCH_METH_clear    1
 #define LLBC_CFG_CORE_OBJPOOL_OBJ_REUSE_MATCH_METH_Clear    1
@@ -206,6 +268,26 @@
 #define LLBC_CFG_CORE_OBJPOOL_OBJ_REUSE_MATCH_METH_Reuse    1
 // Object pool use malloc instead.
 #define LLBC_CFG_CORE_OBJPOOL_USE_MALLOC_INSTEAD            0
+// Thread safe object pool max magazine size(0 means not support magazine), this option is performance option.
+// Note:
+// - magazine is opt-in per object pool, enable it by LLBC_ObjPool::SetMagazineSize().
+// - thread safe typed object pool caches free objects in per-thread(thread local) magazines,
+//   Acquire()/Release() hit magazine don't lock typed object pool.
+// - magazine refill/flush from/to stripes in batch(half magazine size), when thread exit, it's magazines
+//   drained to stripes.
+#define LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE             64
+// Thread safe object pool default magazine size(0 means disable magazine).
+#define LLBC_CFG_CORE_OBJPOOL_DFT_MAGAZINE_SIZE             0
+// Object pool default trim policy: idle stripes high watermark(0 means never trim by watermark).
+// Note:
+// - idle stripe is the stripe that all objects are free, trim destroy idle stripes and return memory to system.
+// - if idle stripes count exceed high watermark, trim idle stripes down to low watermark.
+// - default disabled, trim is opt-in by LLBC_ObjPool::SetTrimPolicy() or this option.
+#define LLBC_CFG_CORE_OBJPOOL_DFT_TRIM_IDLE_STRIPES_HIGH_WATERMARK  0
+// Object pool default trim policy: idle stripes low watermark.
+#define LLBC_CFG_CORE_OBJPOOL_DFT_TRIM_IDLE_STRIPES_LOW_WATERMARK   0
+// Object pool default trim policy: max retained idle stripes memory per typed object pool, in bytes(0 means no limit).
+#define LLBC_CFG_CORE_OBJPOOL_DFT_TRIM_MAX_RETAINED_IDLE_BYTES      0
 
 /**
  * \brief ObjBase about configs.
@@ -224,6 +306,12 @@
 #define LLBC_CFG_COMM_MAX_EVENT_COUNT                       100
 // The epool max listen socket fd size(LINUX platform specific, only available before 2.6.8 version kernel before).
 #define LLBC_CFG_EPOLL_MAX_LISTEN_FD_SIZE                   10000
+// Epoll poller inline wait option(LINUX/Android platform specific).
+// Note:
+// - if enabled, epoll poller thread call epoll_wait() itself and use an eventfd to wakeup
+//   when other threads push events to poller, no PollerMonitor thread will be created.
+// - if disabled, epoll poller use PollerMonitor thread to wait epoll events and post it to poller.
+#define LLBC_CFG_COMM_EPOLL_INLINE_WAIT                     1
 // Default socket send buffer size(0 means use system default and allow system dynamic adjust send buffer size, if supported).
 #define LLBC_CFG_COMM_DFT_SOCK_SEND_BUF_SIZE                0
 // Default socket recv buffer size(0 means use system default and allow system dynamic adjust recv buffer size, if supported).
@@ -237,6 +325,20 @@
 // Note:
 // - this buffer size is initialize recv buffer size, if not enough to recv socket data, will auto expand.
 #define LLBC_CFG_COMM_DFT_SESSION_RECV_BUF_SIZE             1024
+// Default session recv buffer reuse option, this option is performance option.
+// Note:
+// - if enabled, session socket keep one recv buffer and reuse it in every recv operation,
+//   packets are parsed out of it in place, no message block allocation per recv.
+// - can be changed at runtime, see LLBC_SessionOpts::SetSessionRecvBufReuse().
+#define LLBC_CFG_COMM_DFT_SESSION_RECV_BUF_REUSE            1
+// Session reusable recv buffer max keep size, if expanded over this size, will shrink to session recv buffer size after used.
+#define LLBC_CFG_COMM_SESSION_RECV_BUF_REUSE_MAX_SIZE       (64 * 1024)
+// Packet payload slice min size, this option is performance option.
+// Note:
+// - if session reuse recv buffer, the packets which payload size greater than or equal to this value and 
+//   completely received in recv buffer, will use recv buffer slice as payload, no payload data copy.
+// - 0 means disable payload slice.
+#define LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE         1024
 // Default max packet size
 // Note:
 // - this packet size is PacketProcol limit, the size is only used for PacketProcol
@@ -247,6 +349,40 @@
 //   but once you turn on this option, your server memory will be streteched very large.
 // - if enabled, LLBC_CFG_COMM_DFT_SESSION_RECV_BUF_SIZE will no effect.
 #define LLBC_CFG_COMM_SESSION_RECV_BUF_USE_OBJ_POOL         0
+// Session gather send option, this option is performance option.
+// Note:
+// - if enabled, socket will submit multiple pending send blocks in one sendmsg()/WSASend() call,
+//   and advance send buffer by the bytes actually sent, no merge copy required.
+// - IOCP poller model not use this option, it still merge all pending blocks and post overlapped send.
+#define LLBC_CFG_COMM_USE_GATHER_SEND                       1
+// Session gather send max buffer count per call(will be limited to IOV_MAX, if defined).
+#define LLBC_CFG_COMM_GATHER_SEND_MAX_BUF_COUNT             1024
+// Service encode-once multicast/broadcast option, this option is performance option.
+// Note:
+// - if enabled, Multicast()/Broadcast() encode packet only once and share the encoded data block to all
+//   target sessions(no per session copy), and post one event to each poller instead of one event per session.
+// - only available for the sessions which protocol factory IsStatelessSend() return true,
+//   other sessions still encode packet per session.
+#define LLBC_CFG_COMM_USE_ENCODE_ONCE_MULTICAST             1
+// Service/Poller event block pooling option, this option is performance option.
+// Note:
+// - if enabled, service events and poller events are constructed in message blocks acquired from
+//   service thread-safe object pool, steady-state event path has no heap allocation.
+// - the allocation counters can be get by LLBC_Service::GetEvBlockStatistics().
+#define LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK                1
+// Pooled event block max keep size, pooled event block grown by big event(eg: big data-arrival batch,
+// big multicast) will free it's buffer when release if buffer size greater than this value.
+#define LLBC_CFG_COMM_POOLED_EVENT_BLOCK_MAX_KEEP_SIZE      4096
+// Service/Poller lock-free message queue option, this option is performance option.
+// Note:
+// - if enabled, service and pollers use LLBC_MessageQueueType::MPSC message queue, event push
+//   is lock-free and consumer thread batch fetch events, only sleep when queue is empty.
+#define LLBC_CFG_COMM_USE_MPSC_MSG_QUEUE                    1
+// Service object pools trim interval, in milli-seconds(0 means disable service trim object pools).
+// Note:
+// - service trim it's object pools and it's thread object pools in frame idle time, use object pool's trim policy.
+// - default disabled, set it(eg: 60000) and object pool trim policy watermarks to enable.
+#define LLBC_CFG_COMM_OBJPOOL_TRIM_INTERVAL                 0
 // Message buffer element(stripe) allow resize limit.
 #define LLBC_CFG_COMM_MSG_BUFFER_ELEM_RESIZE_LIMIT          (8 * 1024)
 // Default service FPS value.
@@ -255,12 +391,24 @@
 #define LLBC_CFG_COMM_MIN_SERVICE_FPS                       1
 // Max service FPS value.
 #define LLBC_CFG_COMM_MAX_SERVICE_FPS                       1000
+// Default service event wakeup option, this option is performance option.
+// Note:
+// - if enabled, service will wait queued events until frame end instead of sleeping, and handle the
+//   arrived events(eg: DataArrival) immediately, components update and timers still on schedule.
+#define LLBC_CFG_COMM_DFT_SERVICE_EVENT_WAKEUP              0
 // Per thread drive max services count.
 #define LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT        16
 // Determine enable the service has status handler support or not.
 #define LLBC_CFG_COMM_ENABLE_STATUS_HANDLER                 1
 // Determine enable the unify pre-subscribe handler support or not.
 #define LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE             1
+// Packet handlers direct-indexed dispatch opcode limit, opcodes in [0, limit) are dispatched through
+// direct-indexed table(one indexed load), other opcodes are dispatched through hash table.
+// - if set to 0, direct-indexed dispatch will be disabled.
+#define LLBC_CFG_COMM_PACKET_HANDLERS_DIRECT_INDEX_LIMIT    65536
+// Service ready session table initial slot count(round up to power of 2), ready sessions are stored in open addressing
+// slots(home slot index: sessionId & (slot count - 1)), slots grow(double) when ready sessions reach half of slot count.
+#define LLBC_CFG_COMM_READY_SESSION_INIT_SLOT_COUNT         1024
 // Dynamic create comp create method prefix name.
 #define LLBC_CFG_COMM_CREATE_COMP_FROM_LIB_FUNC_PREFIX      "llbc_create_comp_"
 // The poller model config(Platform specific).
@@ -44,12 +44,14 @@
  #include <pthread.h>
  #include <sys/time.h>
  #include <sys/socket.h>
+ #include <sys/uio.h>
  #include <netdb.h>
  #include <semaphore.h>
  #include <arpa/inet.h>
 
  #if LLBC_TARGET_PLATFORM_LINUX
   #include <sys/epoll.h>
+  #include <sys/eventfd.h>
  #endif
 
  #if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
@@ -76,15 +76,27 @@ __LLBC_NS_BEGIN
 #endif
 
 #if LLBC_TARGET_PLATFORM_NON_WIN32
+ // Note: Non-WIN32 platform LLBC_SockBuf memory layout is compatible with struct iovec.
  struct LLBC_SockBuf
  {
-     ulong len;
      char *buf;
+     size_t len;
  };
 #else
  typedef WSABUF LLBC_SockBuf;
 #endif
 
+// The max buffers count of one gather send operation.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ #ifdef IOV_MAX
+  #define LLBC_SOCK_BUF_MAX_COUNT IOV_MAX
+ #else
+  #define LLBC_SOCK_BUF_MAX_COUNT 1024
+ #endif
+#else
+ #define LLBC_SOCK_BUF_MAX_COUNT 1024
+#endif
+
 /**
  * \brief The internal socket address structure encapsulation.
  */
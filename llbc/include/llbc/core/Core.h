@@ -68,6 +68,7 @@
 
 // core/variant
 #include "llbc/core/variant/Variant.h"
+#include "llbc/core/variant/CompactVariant.h"
 
 // core/rapidjson
 #include "llbc/core/rapidjson/json.h"
@@ -103,6 +104,7 @@
 #include "llbc/core/thread/Tls.h"
 #include "llbc/core/thread/MessageBlock.h"
 #include "llbc/core/thread/MessageBuffer.h"
+#include "llbc/core/thread/SharedMessageBlock.h"
 #include "llbc/core/thread/MessageQueue.h"
 #include "llbc/core/thread/ThreadMgr.h"
 #include "llbc/core/thread/Task.h"
@@ -113,6 +115,7 @@
 // core/log
 #include "llbc/core/log/LogData.h"
 #include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogQueueFullPolicy.h"
 #include "llbc/core/log/BaseLogAppender.h"
 #include "llbc/core/log/Logger.h"
 #include "llbc/core/log/LoggerMgr.h"
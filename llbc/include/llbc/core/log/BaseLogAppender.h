@@ -51,6 +51,7 @@ public:
         Console = Begin,        // console type appender.
         File,                   // file type appender.
         Network,                // network type appender.
+        BinaryFile,             // binary file type appender.
 
         End
     };
@@ -71,16 +72,21 @@ struct LLBC_LogAppenderInitInfo
     LLBC_String pattern;            // output pattern.
     bool colourfulOutput;           // colourful output flag.
 
-    LLBC_String filePath;           // log file path, used in File type appender.
-    LLBC_String fileSuffix;         // log file suffix name, used in File type appender.
-    int fileRollingMode;            // file rolling mode flag, used in File type appender.
-    sint64 maxFileSize;             // max log file size, int bytes, used in File type appender.
-    int maxBackupIndex;             // max backup index, used in File type appender.
-    int fileBufferSize;             // file buffer size, used in File type appender.
-    bool lazyCreateLogFile;         // logfile create option, used in File type appender
+    LLBC_String filePath;           // log file path, used in File/BinaryFile type appender.
+    LLBC_String fileSuffix;         // log file suffix name, used in File/BinaryFile type appender.
+    int fileRollingMode;            // file rolling mode flag, used in File/BinaryFile type appender.
+    sint64 maxFileSize;             // max log file size, int bytes, used in File/BinaryFile type appender.
+    int maxBackupIndex;             // max backup index, used in File/BinaryFile type appender.
+    int fileBufferSize;             // file buffer size, used in File/BinaryFile type appender.
+    bool lazyCreateLogFile;         // logfile create option, used in File/BinaryFile type appender
+    sint64 mmapSegmentSize;         // mmap file segment size, 0 means not use mmap, used in File/BinaryFile type appender.
 
     LLBC_String ip;                 // Ip address, used in Network type appender.
     uint16 port;                    // port, used in Network type appender.
+    bool udp;                       // use UDP protocol(otherwise use TCP), used in Network type appender.
+    int frameSize;                  // log records batch frame size, in bytes, used in Network type appender.
+    int networkBufferSize;          // pending frames buffer size, in bytes, used in Network type appender.
+    int flushInterval;              // flush interval, in milli-seconds, used in Network type appender.
 };
 
 /**
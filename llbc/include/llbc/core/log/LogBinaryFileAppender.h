@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/log/LogFileAppender.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief Binary file log appender class encapsulation.
+ *
+ * Binary file appender use same file rolling/backup rules with file appender, but log file content
+ * is compact, length-prefixed binary records, instead of formatted text, use tools/log_decoder to
+ * render binary log file to text(using configured file pattern).
+ *
+ * Binary log file format(all integers are LEB128 varints, unless specified):
+ *   file    := session+
+ *   session := <session record> (<dict record> | <log record>)*
+ *   record  := length(varint, include type byte) + type(1 byte) + body
+ *   - session record(type 1): magic("LLBCBLOG", 8 bytes) + version(1 byte) + pid +
+ *                             exec name(str) + logger name(str) + file pattern(str)
+ *   - dict record(type 2):    string id + string(str)
+ *   - log record(type 3):     time delta(zigzag, in micro-seconds, relative to previous log record in session) +
+ *                             level(1 byte) + thread id + file id + line + function id + tag id +
+ *                             message(raw bytes, until record end)
+ *   - str:                    length + bytes
+ * String ids(file/function/tag) are interned per session, string id 0 means empty string.
+ * Every (re)opened log file begins a new session, so every log file can be decoded independently.
+ */
+class LLBC_HIDDEN LLBC_LogBinaryFileAppender : public LLBC_LogFileAppender
+{
+    typedef LLBC_LogFileAppender _Base;
+
+public:
+    LLBC_LogBinaryFileAppender();
+    ~LLBC_LogBinaryFileAppender() override;
+
+public:
+    /**
+     * Get log appender type, see LLBC_LogAppenderType.
+     * @return int - log appender type.
+     */
+    int GetType() const override;
+
+public:
+    /**
+     * Initialize the log appender.
+     * @param[in] initInfo - log appender initialize info structure.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Initialize(const LLBC_LogAppenderInitInfo &initInfo) override;
+
+    /**
+     * Finalize the appender.
+     */
+    void Finalize() override;
+
+protected:
+    /**
+     * Format log data to binary records.
+     * @param[in] data - the log data.
+     * @param[out] buf - the binary records.
+     */
+    void FormatLogData(const LLBC_LogData &data, LLBC_String &buf) override;
+
+    /**
+     * Log file opened event method, begin new binary log session.
+     */
+    void OnLogFileOpened() override;
+
+private:
+    /**
+     * Get interned string id, if string not interned, intern it and append dict record to buf.
+     * @param[in] str    - the string.
+     * @param[in] strLen - the string length.
+     * @param[out] buf   - the binary records buffer.
+     * @return uint32 - the string id, 0 if string is empty.
+     */
+    uint32 InternString(const char *str, int strLen, LLBC_String &buf);
+
+    /**
+     * Append session record to buf.
+     * @param[in] data - the log data.
+     * @param[out] buf - the binary records buffer.
+     */
+    void AppendSessionRecord(const LLBC_LogData &data, LLBC_String &buf);
+
+private:
+    LLBC_String _pattern;
+
+    bool _sessionBegan;
+    sint64 _lastLogTime;
+
+    std::deque<std::string> _internedStrs;
+    std::unordered_map<std::string_view, uint32> _internedStrIds;
+};
+
+__LLBC_NS_END
@@ -61,6 +61,15 @@ struct LLBC_EXPORT LLBC_LogData
 
     LLBC_ThreadId threadId; // Log native thread Id.
 
+    LLBC_LogData *next;     // Next log data, used by asynchronous log queue.
+
+    const char *fmt;        // Deferred formatting format control string.
+    int (*deferredFormatter)(const char *fmt,
+                             const char *record,
+                             char *fmtBuf,
+                             size_t fmtBufSize); // Deferred formatter, nullptr if msg formatted,
+                                                 // otherwise msg hold the encoded arguments record.
+
 public:
     /**
      * Constructor & Destructor.
@@ -68,6 +77,12 @@ public:
     LLBC_LogData();
     ~LLBC_LogData();
 
+public:
+    /**
+     * Format deferred formatting message(if has), after formatted, msg hold the formatted message.
+     */
+    void FormatDeferredMsg();
+
 public:
     /**
      * Object pool support methods.
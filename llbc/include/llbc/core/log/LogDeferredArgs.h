@@ -0,0 +1,68 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The deferred formatting log arguments codec.
+ *        Encode printf-style arguments to compact binary record in caller thread,
+ *        and decode/format the record in log thread.
+ *        Supported argument types:
+ *        - arithmetic/enum/pointer types: encoded by value.
+ *        - c-string(char * or const char *) types: the string content will be copied.
+ */
+template <typename ...Args>
+class LLBC_LogDeferredArgs
+{
+public:
+    /**
+     * Get the encoded record size.
+     * @param[in] args - the arguments.
+     * @return size_t - the encoded size, in bytes.
+     */
+    static size_t GetEncodedSize(const Args &...args);
+
+    /**
+     * Encode arguments to buffer, the buffer size must be greater than or equal to GetEncodedSize().
+     * @param[in] buf  - the buffer.
+     * @param[in] args - the arguments.
+     */
+    static void Encode(char *buf, const Args &...args);
+
+    /**
+     * Decode arguments from encoded record and format message.
+     * @param[in] fmt        - the format control string.
+     * @param[in] record     - the encoded record.
+     * @param[in] fmtBuf     - the formatted message buffer.
+     * @param[in] fmtBufSize - the formatted message buffer size.
+     * @return int - the formatted message length(same as snprintf).
+     */
+    static int Format(const char *fmt, const char *record, char *fmtBuf, size_t fmtBufSize);
+};
+
+__LLBC_NS_END
+
+#include "llbc/core/log/LogDeferredArgsInl.h"
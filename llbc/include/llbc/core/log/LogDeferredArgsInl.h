@@ -0,0 +1,150 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * \brief The deferred log argument codec, encode arithmetic/enum/pointer argument by value.
+ */
+template <typename Arg>
+struct __LLBC_LogDeferredArgCodec
+{
+    static_assert(std::is_arithmetic<Arg>::value || std::is_enum<Arg>::value || std::is_pointer<Arg>::value,
+                  "llbc library deferred formatting log only support arithmetic/enum/pointer/c-string arguments");
+
+    typedef Arg DecodedType;
+
+    static size_t GetSize(const Arg &)
+    {
+        return sizeof(Arg);
+    }
+
+    static char *Encode(char *buf, const Arg &arg)
+    {
+        memcpy(buf, &arg, sizeof(Arg));
+        return buf + sizeof(Arg);
+    }
+
+    static DecodedType Decode(const char *&record)
+    {
+        Arg arg;
+        memcpy(&arg, record, sizeof(Arg));
+        record += sizeof(Arg);
+
+        return arg;
+    }
+};
+
+/**
+ * \brief The deferred log argument codec, encode c-string argument by content.
+ *        Layout: [uint32 length][string content][\0], length is 0xffffffff if string is nullptr.
+ */
+struct __LLBC_LogDeferredCStrArgCodec
+{
+    typedef const char *DecodedType;
+
+    static size_t GetSize(const char *arg)
+    {
+        return sizeof(LLBC_NS uint32) + (arg ? GetLength(arg) + 1 : 0);
+    }
+
+    static char *Encode(char *buf, const char *arg)
+    {
+        const LLBC_NS uint32 len = arg ? GetLength(arg) : UINT_MAX;
+        memcpy(buf, &len, sizeof(len));
+        buf += sizeof(len);
+        if (!arg)
+            return buf;
+
+        memcpy(buf, arg, len);
+        buf[len] = '\0';
+
+        return buf + len + 1;
+    }
+
+    static DecodedType Decode(const char *&record)
+    {
+        LLBC_NS uint32 len;
+        memcpy(&len, record, sizeof(len));
+        record += sizeof(len);
+        if (len == UINT_MAX)
+            return nullptr;
+
+        const char *arg = record;
+        record += len + 1;
+
+        return arg;
+    }
+
+private:
+    static LLBC_NS uint32 GetLength(const char *arg)
+    {
+        return static_cast<LLBC_NS uint32>(strnlen(arg, LLBC_CFG_LOG_FORMAT_BUF_SIZE - 1));
+    }
+};
+
+template <>
+struct __LLBC_LogDeferredArgCodec<char *> : public __LLBC_LogDeferredCStrArgCodec
+{
+};
+
+template <>
+struct __LLBC_LogDeferredArgCodec<const char *> : public __LLBC_LogDeferredCStrArgCodec
+{
+};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+template <typename ...Args>
+LLBC_FORCE_INLINE size_t LLBC_LogDeferredArgs<Args...>::GetEncodedSize(const Args &...args)
+{
+    return (LLBC_INTERNAL_NS __LLBC_LogDeferredArgCodec<std::decay_t<Args> >::GetSize(args) + ... + 0);
+}
+
+template <typename ...Args>
+LLBC_FORCE_INLINE void LLBC_LogDeferredArgs<Args...>::Encode(char *buf, const Args &...args)
+{
+    // Zero arguments: nothing to encode.
+    LLBC_UNUSED_PARAM(buf);
+    ((buf = LLBC_INTERNAL_NS __LLBC_LogDeferredArgCodec<std::decay_t<Args> >::Encode(buf, args)), ...);
+}
+
+template <typename ...Args>
+int LLBC_LogDeferredArgs<Args...>::Format(const char *fmt, const char *record, char *fmtBuf, size_t fmtBufSize)
+{
+    // Zero arguments: nothing to decode.
+    LLBC_UNUSED_PARAM(record);
+
+    // Note: braced-init-list guarantees arguments decode in order.
+    std::tuple<typename LLBC_INTERNAL_NS __LLBC_LogDeferredArgCodec<std::decay_t<Args> >::DecodedType...> decodedArgs {
+        LLBC_INTERNAL_NS __LLBC_LogDeferredArgCodec<std::decay_t<Args> >::Decode(record)...};
+
+    return std::apply([fmt, fmtBuf, fmtBufSize](const auto &...args) {
+        return snprintf(fmtBuf, fmtBufSize, fmt, args...);
+    }, decodedArgs);
+}
+
+__LLBC_NS_END
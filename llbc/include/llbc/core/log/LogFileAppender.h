@@ -37,6 +37,14 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief File log appender class encapsulation.
+ *
+ * If mmap segment size configured(mmapLogFile), log file is written through memory mapped file segments:
+ * - file space is preallocated segment by segment, log records are appended to mapping by memcpy, no
+ *   write/flush syscalls are issued until current segment used up.
+ * - written log records reside in the page cache immediately, so they survive process crash.
+ * - the logical file size(write offset) is persisted in a mapped position file(<log file>.mmpos), when log
+ *   file closed(rolling/backup/finalize), the unused preallocated space is truncated and the position file
+ *   is removed, if process crashed, the log file is truncated to the persisted size when it reopened.
  */
 class LLBC_HIDDEN LLBC_LogFileAppender : public LLBC_BaseLogAppender
 {
@@ -79,6 +87,18 @@ protected:
      */
     void Flush() override;
 
+    /**
+     * Format log data to log file content, default format as text, using appender token chain.
+     * @param[in] data - the log data.
+     * @param[out] buf - the formatted log file content.
+     */
+    virtual void FormatLogData(const LLBC_LogData &data, LLBC_String &buf);
+
+    /**
+     * Log file opened event method, called when log file opened or reopened(rolling, backup, ...).
+     */
+    virtual void OnLogFileOpened();
+
 private:
     /**
      * Check and update log file.
@@ -126,6 +146,43 @@ private:
      */
     int GetBackupFilesCount(const LLBC_String &logFileName) const;
 
+    /**
+     * Write data to log file(write through mapping in mmap mode).
+     * @param[in] buf  - the data buffer.
+     * @param[in] size - the data size.
+     * @return sint64 - the actually wrote size, if failed, return -1.
+     */
+    sint64 WriteFile(const void *buf, size_t size);
+
+    /**
+     * Close log file(in mmap mode, will unmap file segment and truncate unused preallocated space).
+     */
+    void CloseFile();
+
+    /**
+     * Map the log file segment which contains the given file offset(mmap mode only).
+     * @param[in] offset - the file offset.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int MapFileSegment(sint64 offset);
+
+    /**
+     * Unmap current mapped log file segment(mmap mode only).
+     */
+    void UnmapFileSegment();
+
+    /**
+     * Open and map the log file position file(mmap mode only), if position file left by crashed process,
+     * truncate log file to the persisted logical file size.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int OpenMmapPosFile();
+
+    /**
+     * Unmap and remove the log file position file(mmap mode only).
+     */
+    void CloseMmapPosFile();
+
 private:
     LLBC_String _fileDir;
     LLBC_String _fileBasePath;
@@ -137,10 +194,18 @@ private:
     sint64 _maxFileSize;
     int _maxBackupIndex;
 
+    sint64 _mmapSegmentSize;
+
 private:
     LLBC_File _file;
     sint64 _fileSize;
 
+    char *_mmapSeg;
+    sint64 _mmapSegOffset;
+
+    int _mmapPosFd;
+    volatile sint64 *_mmapPos;
+
     sint64 _notFlushLogCount;
     sint64 _logFileLastCheckTime;
 };
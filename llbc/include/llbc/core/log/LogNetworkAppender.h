@@ -27,6 +27,12 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief Network log appender class encapsulation.
+ *
+ * Network appender ships formatted log records to log collector over TCP or UDP, log records are batched
+ * into frames, every frame is: payload length(4 bytes, big-endian) + log records(formatted by pattern).
+ * Appender never blocks the log thread: socket is non-blocking, collector reconnect use exponential backoff,
+ * and when collector slow or disconnected, frames are buffered in a bounded memory buffer, if buffer usage
+ * reach watermark, low level log records will be dropped(see LLBC_CFG_LOG_NETWORK_BUFFER_XXX configs).
  */
 class LLBC_HIDDEN LLBC_LogNetworkAppender : public LLBC_BaseLogAppender
 {
@@ -63,9 +69,80 @@ public:
      */
     int Output(const LLBC_LogData &data) override;
 
+protected:
+    /**
+     * Flush method, seal current frame and send pending frames.
+     */
+    void Flush() override;
+
+private:
+    /**
+     * Append formatted log record to current frame.
+     * Note: in TCP mode, the record larger than frame payload size will be split to consecutive frames,
+     *       collector should concat frame payloads to restore the record.
+     *       in UDP mode, the record has been truncated to frame payload size by Output(), so every
+     *       datagram is self-contained and a lost datagram never corrupts other records.
+     * @param[in] record    - the formatted log record.
+     * @param[in] recordLen - the log record length.
+     */
+    void AppendRecord(const char *record, size_t recordLen);
+
+    /**
+     * Seal current frame(fill frame header), sealed frame can be send.
+     */
+    void SealFrame();
+
+    /**
+     * Try send pending frames(non-blocking).
+     * @param[in] now       - now time, in milli-seconds.
+     * @param[in] sealFrame - seal current frame before send or not.
+     */
+    void TrySend(sint64 now, bool sealFrame);
+
+    /**
+     * Try connect to collector(non-blocking).
+     * @param[in] now - now time, in milli-seconds.
+     * @return bool - return true if connected, otherwise return false.
+     */
+    bool TryConnect(sint64 now);
+
+    /**
+     * Close collector connection, and schedule reconnect.
+     * @param[in] now - now time, in milli-seconds.
+     */
+    void Disconnect(sint64 now);
+
+    /**
+     * Connection state enumeration.
+     */
+    enum
+    {
+        Disconnected,
+        Connecting,
+        Connected,
+    };
+
 private:
     LLBC_String _ip;
     uint16 _port;
+    bool _udp;
+
+    size_t _frameSize;
+    size_t _bufferSize;
+    int _flushInterval;
+
+    LLBC_SocketHandle _sock;
+    int _connState;
+    sint64 _connBeginTime;
+    sint64 _nextConnTime;
+    int _reconnInterval;
+
+    std::deque<LLBC_String> _frames;
+    bool _lastFrameSealed;
+    size_t _frontFrameSent;
+    size_t _bufferedSize;
+    sint64 _lastSendTime;
+    sint64 _droppedCount;
 };
 
 __LLBC_NS_END
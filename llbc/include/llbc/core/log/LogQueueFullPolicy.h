@@ -0,0 +1,69 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The asynchronous log queue full policy enumeration.
+ *        Describe what the producer thread should do when the log queue is full.
+ */
+struct LLBC_EXPORT LLBC_LogQueueFullPolicy
+{
+public:
+    enum
+    {
+        Begin,
+
+        Block = Begin, // Block the producer thread until the log queue has free space.
+        DropLowLevel,  // Drop the log data whose level is lower than LLBC_CFG_LOG_ASYNC_QUEUE_FULL_KEEP_LEVEL,
+                       // others will block the producer thread.
+        SyncOutput,    // Output log data in the producer thread.
+
+        End
+    };
+
+    /**
+     * Get queue full policy string representation.
+     * @param[in] policy - the queue full policy.
+     * @return const LLBC_CString & - the queue full policy string representation.
+     */
+    static const LLBC_CString &GetPolicyStr(int policy);
+
+    /**
+     * Get queue full policy by policy string.
+     * @param[in] policyStr - the queue full policy string.
+     * @return int - the queue full policy.
+     */
+    static int Str2Policy(const LLBC_CString &policyStr);
+
+    /**
+     * Check given queue full policy is validate or not.
+     * @param[in] policy - the queue full policy.
+     */
+    static bool IsValid(int policy);
+};
+
+__LLBC_NS_END
@@ -22,7 +22,7 @@
 #pragma once
 
 #include "llbc/core/thread/Task.h"
-#include "llbc/core/thread/SpinLock.h"
+#include "llbc/core/thread/Semaphore.h"
 
 __LLBC_NS_BEGIN
 
@@ -62,10 +62,13 @@ public:
     void Stop();
 
     /**
-     * Push log data.
-     * @param[in] logData - the log data.
+     * Push log data, the queue full policy will be applied when log queue is full.
+     * Note: thread safe, lock free if log queue not full.
+     * @param[in] logData         - the log data.
+     * @param[in] queueFullPolicy - the queue full policy, see LLBC_LogQueueFullPolicy.
+     * @return int - return 0 if success, otherwise return -1.
      */
-    void PushLogData(LLBC_LogData *logData);
+    int PushLogData(LLBC_LogData *logData, int queueFullPolicy);
 
 public:
     /**
@@ -85,6 +88,64 @@ private:
      */
     bool TryPopAndProcLogDatas();
 
+    /**
+     * Try push log data to log queue shard.
+     * @param[in] logData - the log data.
+     * @return bool - return true if push success, return false if log queue shard full.
+     */
+    bool TryPushLogData(LLBC_LogData *logData);
+
+    /**
+     * Handle log queue full.
+     * @param[in] logData         - the log data.
+     * @param[in] queueFullPolicy - the queue full policy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int HandleQueueFull(LLBC_LogData *logData, int queueFullPolicy);
+
+    /**
+     * Output log data in caller thread and recycle it.
+     * @param[in] logData - the log data.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SyncOutputLogData(LLBC_LogData *logData);
+
+    /**
+     * Check has any log data in log queue or not.
+     * @return bool - return true if has log data.
+     */
+    bool HasLogDatas() const;
+
+    /**
+     * Wait for log datas push or stop signal.
+     * @param[in] timeout - the wait timeout, in milli-seconds.
+     */
+    void WaitLogDatas(int timeout);
+
+    /**
+     * Wakeup log runnable thread, if it is waiting log datas.
+     */
+    void WakeupIfWaiting();
+
+    /**
+     * Get idle wait timeout, determine by all loggers flush interval.
+     * @return int - the idle wait timeout, in milli-seconds.
+     */
+    int GetIdleWaitTimeout() const;
+
+    /**
+     * Wakeup the producers which blocked on log queue full, call by log runnable thread after log queue drained.
+     */
+    void WakeupBlockedProducers();
+
+    /**
+     * Get current thread log queue shard index.
+     * Note: threads are assigned to shards round-robin, modulo LLBC_CFG_LOG_ASYNC_QUEUE_SHARD_COUNT,
+     *       so when more threads than shards are logging, several threads share one shard.
+     * @return int - the log queue shard index.
+     */
+    static int GetThreadShardIndex();
+
     /**
      * Flush all loggers.
      * @param[in] force - force or not.
@@ -93,11 +154,27 @@ private:
     void FlushLoggers(bool force, sint64 now);
 
 private:
+    /**
+     * \brief The log queue shard, an intrusive multi-producer/single-consumer stack.
+     *        Producers push log data by CAS, consumer detach the whole stack once.
+     */
+    struct alignas(64) _LogQueueShard
+    {
+        LLBC_LogData * volatile head;
+        volatile sint32 count;
+    };
+
     volatile bool _stopping;
     std::vector<LLBC_Logger *> _loggers;
+    LLBC_ThreadId _svcThreadId;
+
+    _LogQueueShard _shards[LLBC_CFG_LOG_ASYNC_QUEUE_SHARD_COUNT];
+
+    volatile sint32 _waiting;
+    LLBC_Semaphore _waitSem;
 
-    LLBC_SpinLock _logDataLock;
-    std::vector<LLBC_LogData *> _logDatas[2];
+    volatile sint32 _blockedProducers;
+    LLBC_Semaphore _spaceSem;
 };
 
 __LLBC_NS_END
@@ -26,6 +26,7 @@
 #include "llbc/core/objpool/ObjPool.h"
 
 #include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogDeferredArgs.h"
 
 __LLBC_NS_BEGIN
 
@@ -239,6 +240,31 @@ public:
                         const char *msg,
                         size_t msgLen);
 
+    /**
+     * Like Output() method, but message formatting is deferred, the arguments are captured into
+     * a compact binary record in caller thread, and the message formatting is done in log thread
+     * (in asynchronous mode).
+     * Note:
+     * - fmt must be a string literal(or live longer than logger).
+     * - Only arithmetic/enum/pointer/c-string arguments are supported, c-string content will be copied.
+     * @param[in] level - log level.
+     * @param[in] tag   - log tag, can set to nullptr.
+     * @param[in] file  - log file name.
+     * @param[in] line  - log file line.
+     * @param[in] func  - log function.
+     * @param[in] fmt   - format control string.
+     * @param[in] args  - the arguments.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    template <typename ...Args>
+    int DeferredOutput(int level,
+                       const char *tag,
+                       const char *file,
+                       int line,
+                       const char *func,
+                       const char *fmt,
+                       const Args &...args);
+
 private:
     /**
      * Build log data by format control string and variable parameter list.
@@ -299,12 +325,40 @@ private:
                                   LLBC_LogData *logData,
                                   __LLBC_LibTls *libTls);
 
+    /**
+     * Build deferred formatting log data, the msg capacity will be adjusted to hold the encoded arguments record.
+     * @param[in] level      - log level.
+     * @param[in] tag        - log tag.
+     * @param[in] file       - log file name.
+     * @param[in] line       - log file line.
+     * @param[in] func       - log function.
+     * @param[in] fmt        - log format control string.
+     * @param[in] recordSize - the encoded arguments record size.
+     * @return LLBC_LogData * - the log data.
+     */
+    LLBC_LogData *BuildDeferredLogData(int level,
+                                       const char *tag,
+                                       const char *file,
+                                       int line,
+                                       const char *func,
+                                       const char *fmt,
+                                       size_t recordSize);
+
+    /**
+     * Output deferred formatting log data.
+     * @param[in] data - the log data(encoded arguments record filled).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int OutputDeferredLogData(LLBC_LogData *data);
+
 private:
     /**
      * Friend classs: LLBC_LogRunnable.
      * Asset method/data-members:
-     * - OutputLogData(const LLBC_LogData &data):int
+     * - OutputLogData(LLBC_LogData &data):int
      * - Flush(bool force, sint64 now):void
+     * - _outputLock:LLBC_SpinLock
+     * - _flushInterval:sint64
      */
     friend class LLBC_LogRunnable;
 
@@ -315,10 +369,10 @@ private:
     void AddAppender(LLBC_BaseLogAppender *appender);
 
     /**
-     * Output log data.
+     * Output log data, if is deferred formatting log data, will format it first.
      * @param[in] data - log data.
      */
-    int OutputLogData(const LLBC_LogData &data);
+    int OutputLogData(LLBC_LogData &data);
 
     /**
     * Flush logger(for now, just only need flush all appenders).
@@ -343,6 +397,8 @@ private:
     LLBC_String _name;
     // Logger lock.
     mutable LLBC_SpinLock _lock;
+    // Logger output lock, serialize appenders output/flush in asynchronous mode.
+    LLBC_SpinLock _outputLock;
 
     // Log level.
     volatile int _logLevel;
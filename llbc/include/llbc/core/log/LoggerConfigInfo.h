@@ -102,6 +102,12 @@ public:
      */
     int GetFlushInterval() const;
 
+    /**
+     * Get asynchronous log queue full policy, only available in Async-Mode.
+     * @return int - the queue full policy, see LLBC_LogQueueFullPolicy.
+     */
+    int GetAsyncQueueFullPolicy() const;
+
 public:
     /**
      * Add timestamp in json log.
@@ -213,6 +219,55 @@ public:
      */
     int GetFileBufferSize() const;
 
+public:
+    /**
+     * Get log to network switch.
+     * @return bool - log to network switch.
+     */
+    bool IsLogToNetwork() const;
+
+    /**
+     * Get network log level.
+     * @return int - network log level.
+     */
+    int GetNetworkLogLevel() const;
+
+    /**
+     * Get network log pattern.
+     * @return const LLBC_String & - network log pattern.
+     */
+    const LLBC_String &GetNetworkPattern() const;
+
+    /**
+     * Get network log protocol is UDP or not.
+     * @return bool - return true if use UDP protocol, otherwise use TCP protocol.
+     */
+    bool IsNetworkUdp() const;
+
+    /**
+     * Get network log collector ip.
+     * @return const LLBC_String & - the collector ip.
+     */
+    const LLBC_String &GetNetworkIp() const;
+
+    /**
+     * Get network log collector port.
+     * @return uint16 - the collector port.
+     */
+    uint16 GetNetworkPort() const;
+
+    /**
+     * Get network log frame size.
+     * @return int - the network log frame size, in bytes.
+     */
+    int GetNetworkFrameSize() const;
+
+    /**
+     * Get network log buffer size.
+     * @return int - the network log buffer size, in bytes.
+     */
+    int GetNetworkBufferSize() const;
+
 public:
     /**
      * Get take over option.
@@ -227,6 +282,24 @@ public:
      */
     bool IsLazyCreateLogFile() const;
 
+    /**
+     * Get binary log file option.
+     * @return bool - binary log file option, if true, log to file in binary format(LLBC_LogBinaryFileAppender).
+     */
+    bool IsBinaryLogFile() const;
+
+    /**
+     * Get mmap log file option.
+     * @return bool - mmap log file option, if true, log file is written through memory mapped file segments.
+     */
+    bool IsMmapLogFile() const;
+
+    /**
+     * Get mmap log file segment size.
+     * @return sint64 - the mmap log file segment size, in bytes.
+     */
+    sint64 GetMmapSegmentSize() const;
+
 private:
     /**
      * Normalize the log file name.
@@ -247,6 +320,7 @@ private:
     bool _asyncMode;
     bool _independentThread;
     int _flushInterval;
+    int _asyncQueueFullPolicy;
 
     bool _addTimestampInJsonLog;
 
@@ -269,6 +343,18 @@ private:
     int _maxBackupIndex;
     int _fileBufferSize;
     bool _lazyCreateLogFile;
+    bool _binaryLogFile;
+    bool _mmapLogFile;
+    sint64 _mmapSegmentSize;
+
+    bool _logToNetwork;
+    int _networkLogLevel;
+    LLBC_String _networkPattern;
+    bool _networkUdp;
+    LLBC_String _networkIp;
+    uint16 _networkPort;
+    int _networkFrameSize;
+    int _networkBufferSize;
 
     bool _takeOver;
 };
@@ -35,7 +35,7 @@ inline bool LLBC_LoggerConfigInfo::IsNotConfigUseRoot() const
 
 inline int LLBC_LoggerConfigInfo::GetLogLevel() const
 {
-    return MIN(_consoleLogLevel, _fileLogLevel);
+    return MIN(MIN(_consoleLogLevel, _fileLogLevel), _networkLogLevel);
 }
 
 inline bool LLBC_LoggerConfigInfo::IsAsyncMode() const
@@ -53,6 +53,11 @@ inline int LLBC_LoggerConfigInfo::GetFlushInterval() const
     return _flushInterval;
 }
 
+inline int LLBC_LoggerConfigInfo::GetAsyncQueueFullPolicy() const
+{
+    return _asyncQueueFullPolicy;
+}
+
 inline bool LLBC_LoggerConfigInfo::IsAddTimestampInJsonLog() const
 {
     return _addTimestampInJsonLog;
@@ -143,6 +148,46 @@ inline int LLBC_LoggerConfigInfo::GetFileBufferSize() const
     return _fileBufferSize;
 }
 
+inline bool LLBC_LoggerConfigInfo::IsLogToNetwork() const
+{
+    return _logToNetwork;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkLogLevel() const
+{
+    return _networkLogLevel;
+}
+
+inline const LLBC_String &LLBC_LoggerConfigInfo::GetNetworkPattern() const
+{
+    return _networkPattern;
+}
+
+inline bool LLBC_LoggerConfigInfo::IsNetworkUdp() const
+{
+    return _networkUdp;
+}
+
+inline const LLBC_String &LLBC_LoggerConfigInfo::GetNetworkIp() const
+{
+    return _networkIp;
+}
+
+inline uint16 LLBC_LoggerConfigInfo::GetNetworkPort() const
+{
+    return _networkPort;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkFrameSize() const
+{
+    return _networkFrameSize;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkBufferSize() const
+{
+    return _networkBufferSize;
+}
+
 inline bool LLBC_LoggerConfigInfo::IsTakeOver() const
 {
     return _takeOver;
@@ -153,4 +198,19 @@ inline bool LLBC_LoggerConfigInfo::IsLazyCreateLogFile() const
     return _lazyCreateLogFile;
 }
 
+inline bool LLBC_LoggerConfigInfo::IsBinaryLogFile() const
+{
+    return _binaryLogFile;
+}
+
+inline bool LLBC_LoggerConfigInfo::IsMmapLogFile() const
+{
+    return _mmapLogFile;
+}
+
+inline sint64 LLBC_LoggerConfigInfo::GetMmapSegmentSize() const
+{
+    return _mmapSegmentSize;
+}
+
 __LLBC_NS_END
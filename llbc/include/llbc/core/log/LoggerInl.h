@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include "llbc/core/log/LogData.h"
+
 __LLBC_NS_BEGIN
 
 LLBC_FORCE_INLINE const LLBC_String &LLBC_Logger::GetLoggerName() const
@@ -84,4 +86,30 @@ inline int LLBC_Logger::Output(int level,
     return ret;
 }
 
+template <typename ...Args>
+int LLBC_Logger::DeferredOutput(int level,
+                                const char *tag,
+                                const char *file,
+                                int line,
+                                const char *func,
+                                const char *fmt,
+                                const Args &...args)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    // Build log data and encode arguments record to msg.
+    LLBC_LogData *data = BuildDeferredLogData(level,
+                                              tag,
+                                              file,
+                                              line,
+                                              func,
+                                              fmt,
+                                              LLBC_LogDeferredArgs<Args...>::GetEncodedSize(args...));
+    LLBC_LogDeferredArgs<Args...>::Encode(data->msg, args...);
+    data->deferredFormatter = &LLBC_LogDeferredArgs<Args...>::Format;
+
+    return OutputDeferredLogData(data);
+}
+
 __LLBC_NS_END
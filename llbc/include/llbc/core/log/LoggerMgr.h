@@ -127,7 +127,26 @@ public:
                                const char *func,
                                const char *msg,
                                size_t msgLen);    
-                               
+
+public:
+    /**
+     * Get log level version, the version will be changed when logger manager initialized/reloaded/finalized
+     * or any logger's log level changed, use to invalidate log call site cached log level check.
+     * @return sint32 - the log level version.
+     */
+    static sint32 GetLogLevelVersion();
+
+    /**
+     * Update log level version, must call it after any logger's log level changed.
+     */
+    static void UpdateLogLevelVersion();
+
+    /**
+     * The log level version key mask, log call site cache the masked log level version(version key),
+     * version key 0 is reserved for never refreshed log call site.
+     */
+    static constexpr uint32 LogLevelVersionKeyMask = 0x3fffffff;
+
 
 private:
     mutable LLBC_DummyLock _lock;
@@ -141,6 +160,7 @@ private:
     std::map<LLBC_CString, LLBC_Logger *>::const_iterator _cstr2LoggersEnd;
 
     static LLBC_FastLock _uninitColorfulOutputLock;
+    static volatile sint32 _logLevelVersion;
 };
 
 __LLBC_NS_END
@@ -151,6 +171,32 @@ __LLBC_NS_END
 template class LLBC_EXPORT LLBC_NS LLBC_Singleton<LLBC_NS LLBC_LoggerMgr>;
 #define LLBC_LoggerMgrSingleton LLBC_NS LLBC_Singleton<LLBC_NS LLBC_LoggerMgr>::Instance()
 
+/**
+ * @brief The llbc library log macros pre-check helper macro, only can use in do {} while (false) block.
+ *        - Compile time min log level check(see LLBC_CFG_LOG_COMPILE_MIN_LEVEL).
+ *        - Per-call-site cached log level check(see LLBC_CFG_LOG_CALL_SITE_LEVEL_CACHE), only
+ *          cached when __builtin_constant_p() proves logger name and log level are constants,
+ *          otherwise(eg: logger name passed by variable in -O0/-O1 builds) not cached.
+ * @param[in] loggerName - the logger name, nullptr if log to root.
+ * @param[in] level      - log level.
+ */
+#if LLBC_CFG_LOG_CALL_SITE_LEVEL_CACHE && LLBC_TARGET_PLATFORM_NON_WIN32
+ #define __LLBC_LOG_PRE_CHECK(loggerName, level)                            \
+    if ((level) < LLBC_CFG_LOG_COMPILE_MIN_LEVEL)                          \
+        break;                                                             \
+    if (__builtin_constant_p(loggerName) && __builtin_constant_p(level)) { \
+        static LLBC_INTERNAL_NS __LLBC_LogCallSite __callSite__;           \
+        if (!__callSite__.IsEnabled(loggerName, level))                    \
+            break;                                                         \
+    }                                                                      \
+
+#else // !LLBC_CFG_LOG_CALL_SITE_LEVEL_CACHE || Win32
+ #define __LLBC_LOG_PRE_CHECK(loggerName, level)                            \
+    if ((level) < LLBC_CFG_LOG_COMPILE_MIN_LEVEL)                          \
+        break;                                                             \
+
+#endif // LLBC_CFG_LOG_CALL_SITE_LEVEL_CACHE && LLBC_TARGET_PLATFORM_NON_WIN32
+
 /**
  * @brief The llbc library log macro define.
  * @param[in] loggerName - the logger name, nullptr if log to root.
@@ -161,6 +207,7 @@ template class LLBC_EXPORT LLBC_NS LLBC_Singleton<LLBC_NS LLBC_LoggerMgr>;
  */
 #define LLOG(loggerName, tag, level, fmt, ...)            \
     do {                                                  \
+        __LLBC_LOG_PRE_CHECK(loggerName, level)           \
         auto __loggerMgr__ = LLBC_LoggerMgrSingleton;     \
         if (LIKELY(__loggerMgr__->IsInited())) {          \
             LLBC_NS LLBC_Logger *__l__;                   \
@@ -283,6 +330,7 @@ template class LLBC_EXPORT LLBC_NS LLBC_Singleton<LLBC_NS LLBC_LoggerMgr>;
  */
 #define LSLOG(loggerName, tag, level, streamMsg)               \
     do {                                                       \
+        __LLBC_LOG_PRE_CHECK(loggerName, level)                \
         auto __loggerMgr__ = LLBC_LoggerMgrSingleton;          \
         if (LIKELY(__loggerMgr__->IsInited())) {               \
             LLBC_NS LLBC_Logger *__l__;                        \
@@ -354,8 +402,200 @@ template class LLBC_EXPORT LLBC_NS LLBC_Singleton<LLBC_NS LLBC_LoggerMgr>;
 
 #endif // LLBC_CFG_LOG_USING_WITH_STREAM
 
+/**
+ * @brief The llbc library deferred formatting log macro define, the message will be formatted
+ *        in log thread(in asynchronous mode), see LLBC_Logger::DeferredOutput().
+ * @param[in] loggerName - the logger name, nullptr if log to root.
+ * @param[in] tag        - the log tag, nullptr if no tag.
+ * @param[in] level      - log level.
+ * @param[in] fmt        - the log message format string(must be string literal).
+ * @param[in] ...        - the variadic log message parameters(arithmetic/enum/pointer/c-string).
+ */
+#define LDLOG(loggerName, tag, level, fmt, ...)           \
+    do {                                                  \
+        if (false)                                        \
+            LLBC_INTERNAL_NS __LLBC_CheckDeferredLogFmt(fmt, ##__VA_ARGS__); \
+                                                          \
+        __LLBC_LOG_PRE_CHECK(loggerName, level)           \
+        auto __loggerMgr__ = LLBC_LoggerMgrSingleton;     \
+        if (LIKELY(__loggerMgr__->IsInited())) {          \
+            LLBC_NS LLBC_Logger *__l__;                   \
+            if (loggerName != nullptr) {                  \
+                __l__ = __loggerMgr__->GetLogger(loggerName); \
+                if (UNLIKELY(__l__ == nullptr))           \
+                    break;                                \
+            }                                             \
+            else {                                        \
+                __l__ = __loggerMgr__->GetRootLogger();   \
+            }                                             \
+                                                          \
+            if ((level) < __l__->GetLogLevel())           \
+                break;                                    \
+                                                          \
+            __l__->DeferredOutput(level,                  \
+                                  tag,                    \
+                                  __FILE__,               \
+                                  __LINE__,               \
+                                  __FUNCTION__,           \
+                                  fmt,                    \
+                                  ##__VA_ARGS__);         \
+        }                                                 \
+        else {                                            \
+            __loggerMgr__->UnInitOutput(level,            \
+                                        tag,              \
+                                        __FILE__,         \
+                                        __LINE__,         \
+                                        __FUNCTION__,     \
+                                        fmt,              \
+                                        ##__VA_ARGS__);   \
+        }                                                 \
+    } while (false)                                       \
+
+#define LDLOG_DEBUG(fmt, ...) LDLOG(nullptr, nullptr, LLBC_NS LLBC_LogLevel::Debug, fmt, ##__VA_ARGS__)
+#define LDLOG_DEBUG2(loggerName, fmt, ...) LDLOG(loggerName, nullptr, LLBC_NS LLBC_LogLevel::Debug, fmt, ##__VA_ARGS__)
+#define LDLOG_DEBUG3(tag, fmt, ...) LDLOG(nullptr, tag, LLBC_NS LLBC_LogLevel::Debug, fmt, ##__VA_ARGS__)
+#define LDLOG_DEBUG4(loggerName, tag, fmt, ...) LDLOG(loggerName, tag, LLBC_NS LLBC_LogLevel::Debug, fmt, ##__VA_ARGS__)
+
+#define LDLOG_TRACE(fmt, ...) LDLOG(nullptr, nullptr, LLBC_NS LLBC_LogLevel::Trace, fmt, ##__VA_ARGS__)
+#define LDLOG_TRACE2(loggerName, fmt, ...) LDLOG(loggerName, nullptr, LLBC_NS LLBC_LogLevel::Trace, fmt, ##__VA_ARGS__)
+#define LDLOG_TRACE3(tag, fmt, ...) LDLOG(nullptr, tag, LLBC_NS LLBC_LogLevel::Trace, fmt, ##__VA_ARGS__)
+#define LDLOG_TRACE4(loggerName, tag, fmt, ...) LDLOG(loggerName, tag, LLBC_NS LLBC_LogLevel::Trace, fmt, ##__VA_ARGS__)
+
+#define LDLOG_INFO(fmt, ...) LDLOG(nullptr, nullptr, LLBC_NS LLBC_LogLevel::Info, fmt, ##__VA_ARGS__)
+#define LDLOG_INFO2(loggerName, fmt, ...) LDLOG(loggerName, nullptr, LLBC_NS LLBC_LogLevel::Info, fmt, ##__VA_ARGS__)
+#define LDLOG_INFO3(tag, fmt, ...) LDLOG(nullptr, tag, LLBC_NS LLBC_LogLevel::Info, fmt, ##__VA_ARGS__)
+#define LDLOG_INFO4(loggerName, tag, fmt, ...) LDLOG(loggerName, tag, LLBC_NS LLBC_LogLevel::Info, fmt, ##__VA_ARGS__)
+
+#define LDLOG_WARN(fmt, ...) LDLOG(nullptr, nullptr, LLBC_NS LLBC_LogLevel::Warn, fmt, ##__VA_ARGS__)
+#define LDLOG_WARN2(loggerName, fmt, ...) LDLOG(loggerName, nullptr, LLBC_NS LLBC_LogLevel::Warn, fmt, ##__VA_ARGS__)
+#define LDLOG_WARN3(tag, fmt, ...) LDLOG(nullptr, tag, LLBC_NS LLBC_LogLevel::Warn, fmt, ##__VA_ARGS__)
+#define LDLOG_WARN4(loggerName, tag, fmt, ...) LDLOG(loggerName, tag, LLBC_NS LLBC_LogLevel::Warn, fmt, ##__VA_ARGS__)
+
+#define LDLOG_ERROR(fmt, ...) LDLOG(nullptr, nullptr, LLBC_NS LLBC_LogLevel::Error, fmt, ##__VA_ARGS__)
+#define LDLOG_ERROR2(loggerName, fmt, ...) LDLOG(loggerName, nullptr, LLBC_NS LLBC_LogLevel::Error, fmt, ##__VA_ARGS__)
+#define LDLOG_ERROR3(tag, fmt, ...) LDLOG(nullptr, tag, LLBC_NS LLBC_LogLevel::Error, fmt, ##__VA_ARGS__)
+#define LDLOG_ERROR4(loggerName, tag, fmt, ...) LDLOG(loggerName, tag, LLBC_NS LLBC_LogLevel::Error, fmt, ##__VA_ARGS__)
+
+#define LDLOG_FATAL(fmt, ...) LDLOG(nullptr, nullptr, LLBC_NS LLBC_LogLevel::Fatal, fmt, ##__VA_ARGS__)
+#define LDLOG_FATAL2(loggerName, fmt, ...) LDLOG(loggerName, nullptr, LLBC_NS LLBC_LogLevel::Fatal, fmt, ##__VA_ARGS__)
+#define LDLOG_FATAL3(tag, fmt, ...) LDLOG(nullptr, tag, LLBC_NS LLBC_LogLevel::Fatal, fmt, ##__VA_ARGS__)
+#define LDLOG_FATAL4(loggerName, tag, fmt, ...) LDLOG(loggerName, tag, LLBC_NS LLBC_LogLevel::Fatal, fmt, ##__VA_ARGS__)
+
 __LLBC_INTERNAL_NS_BEGIN
 
+/**
+ * \brief The log call site cached log level check helper class.
+ *        The check result is cached together with the log level version, so it will be
+ *        invalidated when logger manager reloaded or any logger's log level changed.
+ * Note: The call site is bound to the first checked (logger name, log level) pair, one call site
+ *       expansion may see different constant pairs after inlining/loop unrolling, the checks of
+ *       not bound pairs are not cached(always return true, let caller do the real check).
+ */
+class __LLBC_LogCallSite
+{
+public:
+    /**
+     * Check the call site log enabled or not.
+     * @param[in] loggerName - the logger name, nullptr if log to root.
+     * @param[in] level      - log level.
+     * @return bool - return false if log disabled, otherwise return true(enabled or not cached).
+     */
+    LLBC_FORCE_INLINE bool IsEnabled(const char *loggerName, int level)
+    {
+        const LLBC_NS uint32 state = static_cast<LLBC_NS uint32>(LLBC_NS LLBC_AtomicGet(&_state));
+        if (LIKELY((state & _BoundFlag) &&
+                   _loggerName == loggerName &&
+                   _level == level))
+        {
+            if (LIKELY((state >> 2) == GetVersionKey()))
+                return (state & _EnabledFlag) != 0;
+
+            return Refresh(loggerName, level);
+        }
+
+        return Bind(loggerName, level);
+    }
+
+private:
+    /**
+     * Bind call site to the logger name and log level, if call site not bound.
+     * @param[in] loggerName - the logger name, nullptr if log to root.
+     * @param[in] level      - log level.
+     * @return bool - return false if log disabled, otherwise return true(enabled or not cached).
+     */
+    bool Bind(const char *loggerName, int level)
+    {
+        // Bound(or binding) by other logger name/log level, don't cache.
+        if (LLBC_NS LLBC_AtomicCompareAndExchange(&_binding, 1, 0) != 0)
+            return true;
+
+        _loggerName = loggerName;
+        _level = level;
+
+        return Refresh(loggerName, level);
+    }
+
+    /**
+     * Refresh the call site cached check result.
+     * @param[in] loggerName - the logger name, nullptr if log to root.
+     * @param[in] level      - log level.
+     * @return bool - return true if enabled, otherwise return false.
+     */
+    bool Refresh(const char *loggerName, int level)
+    {
+        // Fetch version before check, if version changed during check, will refresh again in next time.
+        const LLBC_NS uint32 versionKey = GetVersionKey();
+
+        bool enabled = true;
+        auto loggerMgr = LLBC_LoggerMgrSingleton;
+        if (LIKELY(loggerMgr->IsInited()))
+        {
+            LLBC_NS LLBC_Logger *logger =
+                loggerName != nullptr ? loggerMgr->GetLogger(loggerName) : loggerMgr->GetRootLogger();
+            enabled = logger && level >= logger->GetLogLevel();
+        }
+
+        // Publish state after logger name/log level bound(atomic set is full barrier).
+        (void)LLBC_NS LLBC_AtomicSet(&_state,
+            static_cast<LLBC_NS sint32>((versionKey << 2) | _BoundFlag | (enabled ? _EnabledFlag : 0x0)));
+
+        return enabled;
+    }
+
+    /**
+     * Get current log level version key(30 bits, see LLBC_LoggerMgr::LogLevelVersionKeyMask).
+     */
+    static LLBC_NS uint32 GetVersionKey()
+    {
+        return static_cast<LLBC_NS uint32>(LLBC_NS LLBC_LoggerMgr::GetLogLevelVersion()) &
+            LLBC_NS LLBC_LoggerMgr::LogLevelVersionKeyMask;
+    }
+
+private:
+    enum
+    {
+        _EnabledFlag = 0x1,
+        _BoundFlag = 0x2,
+    };
+
+    // Cached state: (version key << 2) | bound flag | enabled flag.
+    volatile LLBC_NS sint32 _state;
+    // Binding flag, call site only bind once.
+    volatile LLBC_NS sint32 _binding;
+    // Bound logger name/log level, available after bound flag set.
+    const char *_loggerName;
+    int _level;
+};
+
+/**
+ * Deferred formatting log format string check helper, never be called.
+ */
+inline void __LLBC_CheckDeferredLogFmt(const char *fmt, ...) LLBC_STRING_FORMAT_CHECK(1, 2);
+inline void __LLBC_CheckDeferredLogFmt(const char *fmt, ...)
+{
+    LLBC_UNUSED_PARAM(fmt);
+}
+
 /**
  * Log operator for condition judge helper macros.
  */
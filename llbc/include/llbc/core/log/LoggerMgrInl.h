@@ -28,4 +28,9 @@ inline bool LLBC_LoggerMgr::IsInited() const
     return _rootLogger != nullptr;
 }
 
+LLBC_FORCE_INLINE sint32 LLBC_LoggerMgr::GetLogLevelVersion()
+{
+    return _logLevelVersion;
+}
+
 __LLBC_NS_END
@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "llbc/core/rapidjson/json.h"
+#include "llbc/core/thread/SpinLock.h"
 
 // Disable some warnings.
 #if LLBC_TARGET_PLATFORM_WIN32
@@ -92,6 +95,10 @@ private:
  *
  * - [Advance] Stripe control:
  *   - GetStripeCapacity(): Get stripe capacity, in object.
+ *
+ * - [Advance] Memory layout control:
+ *   - IsCacheLineIsolated(constexpr): Check object is cache line isolated or not, cache line isolated
+ *                                     object exclusive occupy cache lines in pool(avoid false sharing).
  */
 class LLBC_ObjReflector
 {
@@ -400,6 +407,31 @@ private:
         return LLBC_CFG_CORE_OBJPOOL_STRIPE_CAPACITY;
     }
 
+public:
+    // IsCacheLineIsolated.
+    template <typename Obj>
+    static constexpr bool IsCacheLineIsolated()
+    {
+        return IsCacheLineIsolatedInl<Obj>(0);
+    }
+
+private:
+    template <typename Obj, bool (*)()>
+    struct cache_line_isolated_detectable_type;
+
+    template <typename Obj>
+    static constexpr bool IsCacheLineIsolatedInl(
+        cache_line_isolated_detectable_type<Obj, &Obj::IsCacheLineIsolated> *)
+    {
+        return Obj::IsCacheLineIsolated();
+    }
+
+    template <typename Obj>
+    static constexpr bool IsCacheLineIsolatedInl(...)
+    {
+        return false;
+    }
+
 public:
     template <typename Obj>
     static void OnTypedObjPoolCreated(LLBC_TypedObjPool<Obj> *typedObjPool)
@@ -501,6 +533,42 @@ public:
     };
 };
 
+/**
+ * \brief The object pool trim policy encapsulation.
+ */
+struct LLBC_ObjPoolTrimPolicy
+{
+    // Idle stripes high watermark, if idle stripes count exceed it, trim idle stripes
+    // down to low watermark(0 means never trim by watermark).
+    size_t idleStripesHighWatermark = LLBC_CFG_CORE_OBJPOOL_DFT_TRIM_IDLE_STRIPES_HIGH_WATERMARK;
+    // Idle stripes low watermark.
+    size_t idleStripesLowWatermark = LLBC_CFG_CORE_OBJPOOL_DFT_TRIM_IDLE_STRIPES_LOW_WATERMARK;
+    // Max retained idle stripes memory per typed object pool, in bytes(0 means no limit).
+    size_t maxRetainedIdleBytes = LLBC_CFG_CORE_OBJPOOL_DFT_TRIM_MAX_RETAINED_IDLE_BYTES;
+};
+
+#if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+/**
+ * \brief The object pool thread magazine encapsulation(internal use).
+ *        Magazine referenced by it's owner thread(thread local) and it's owner thread safe typed object pool,
+ *        deleted when both released it.
+ */
+struct LLBC_ObjPoolMagazine
+{
+    LLBC_SpinLock lock; // Magazine lock.
+    std::atomic<void *> typedObjPool; // Owner typed object pool, null if typed object pool destroyed.
+    void (*Drain)(void *, LLBC_ObjPoolMagazine *); // Drain all objects to typed object pool, call in lock.
+    std::atomic<int> refCount; // Reference count.
+    std::atomic<bool> threadExited; // Owner thread exited flag.
+
+    int objCount; // Cached free object count.
+    uint64 hits; // Acquire hit count.
+    uint64 misses; // Acquire miss count(refill from stripes).
+    uint64 flushes; // Flush to stripes count.
+    void *objs[LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE]; // Cached free objects.
+};
+#endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
 /**
  * The guarded pool object encapsulation.
  */
@@ -582,12 +650,20 @@ class LLBC_TypedObjPool final
     LLBC_DISABLE_ASSIGNMENT(LLBC_TypedObjPool);
     LLBC_DISABLE_MOVE_ASSIGNMENT(LLBC_TypedObjPool);
 
-    #pragma pack(push, 1)
-    // Pre-declare object stripe structure.
+    // Object alignment in pool, honor alignof(Obj), cache line isolated object aligned to cache line.
+    static constexpr size_t _objAlign =
+        LLBC_ObjReflector::IsCacheLineIsolated<Obj>() ?
+            MAX(alignof(Obj), static_cast<size_t>(LLBC_CFG_CORE_OBJPOOL_CACHE_LINE_SIZE)) :
+            MAX(alignof(Obj), alignof(void *));
+
+    // Pre-declare object stripe/wrapped object structures.
     struct _ObjStripe;
+    struct _WrappedObj;
 
-     // The wrapped object structure encapsulation.
-    struct _WrappedObj
+    // The pool object head structure encapsulation, object head always adjacent to object(stored
+    // before object begin address), so object head can be located by any base class pointer of object,
+    // no matter object alignment.
+    struct _ObjHead
     {
         // Object flags.
         union
@@ -596,17 +672,17 @@ class LLBC_TypedObjPool final
             {
                 bool constructed:1; // Constructed flag.
                 bool inUsing:1; // Using flag.
-                uint8 reserved:6; // Reserved flags.
+                bool inMagazine:1; // Cached in thread magazine flag.
+                uint8 reserved:5; // Reserved flags.
             } flags;
             uint8 flagsVal;
         }unFlags;
 
+        uint8 __unused1__;
         uint16 magicNum; // Pool object magic number.
 
         #if LLBC_64BIT_PROCESSOR
-        uint8 __unused__[5];
-        #else
-        uint8 __unused__[1];
+        uint8 __unused2__[4];
         #endif
 
         void *typedObjPool; // Typed object pool.
@@ -617,12 +693,20 @@ class LLBC_TypedObjPool final
             _ObjStripe *stripe; // Owned object stripe, if in using.
             _WrappedObj *nextFreeObj; // Next free object, if not in using.
         } stripeOrNextFreeObj;
+    };
 
-        #if LLBC_64BIT_PROCESSOR
-        uint8 buff[(sizeof(Obj) + 7) & (-8)]; // Object begin address, aligned to 8.
-        #else
-        uint8 buff[(sizeof(Obj) + 3) & (-4)]; // Object begin address, aligned to 4.
-        #endif
+     // The wrapped object structure encapsulation.
+    struct _WrappedObj
+    {
+        // Object head area, object head stored at the end of head area.
+        alignas(_objAlign) uint8 headArea[(sizeof(_ObjHead) + _objAlign - 1) / _objAlign * _objAlign];
+
+        // Object begin address, aligned to _objAlign(wrapped object size is multiple of _objAlign,
+        // so cache line isolated objects never share cache line with other objects).
+        alignas(_objAlign) uint8 buff[sizeof(Obj)];
+
+        // Get object head.
+        _ObjHead *Head() { return reinterpret_cast<_ObjHead *>(buff) - 1; }
     };
 
     // The object stripe structure encapsulation.
@@ -630,16 +714,14 @@ class LLBC_TypedObjPool final
     {
         uint16 cap; // Stripe capacity, in object.
         uint16 used; // Used stripe memory, in object.
-        #if LLBC_64BIT_PROCESSOR
-        uint8 __unused__[4]; // Uunused.
-        #endif
+        uint16 usingCount; // Using object count(included magazine cached objects).
+        uint8 __unused__[2]; // Uunused.
 
         _WrappedObj *freeObjs; // Free objects.
         _ObjStripe *nextFreeStripe; // Next stripe, if free.
 
         _WrappedObj objs[0]; // objs.
     };
-    #pragma pack(pop)
 
 private:
     friend class LLBC_ObjPool;
@@ -662,6 +744,9 @@ public:
     // Collect.
     void Collect(bool deep);
 
+    // Trim idle stripes, return trimmed memory size, in bytes.
+    size_t Trim(const LLBC_ObjPoolTrimPolicy &policy);
+
 private:
     // Release object static method.
     static void ReleaseObj_s(void *typedObjPool, void *obj);
@@ -672,15 +757,50 @@ private:
     // Collect typed object pool static method.
     static void Collect_s(void *typedObjPool, bool deep);
 
+    // Trim typed object pool static method.
+    static size_t Trim_s(void *typedObjPool, const LLBC_ObjPoolTrimPolicy &policy);
+
     // Get typed object pool statistics static method.
     static LLBC_Json::Value GetStatistics_s(void *typedObjPool,
                                             LLBC_Json::MemoryPoolAllocator<> &jsonAlloc);
 
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Drain magazine static method, call in magazine lock.
+    static void DrainMagazine_s(void *typedObjPool, LLBC_ObjPoolMagazine *magazine);
+    #endif
+
     // Find free stripe.
     _ObjStripe *FindFreeStripe();
     // Delete stripe.
     void DeleteStripe(_ObjStripe *stripe);
 
+    // Allocate stripe memory(aligned to _objAlign).
+    static _ObjStripe *AllocStripeMemory(size_t size);
+    // Free stripe memory.
+    static void FreeStripeMemory(_ObjStripe *stripe);
+
+    // Pop free object from stripes, must call in lock.
+    _WrappedObj *PopFromStripes();
+    // Push released object to stripes, must call in lock.
+    void PushToStripes(_WrappedObj *wrappedObj);
+
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Get current thread magazine, create if not exist(return null if thread magazines destroyed).
+    LLBC_ObjPoolMagazine *GetMagazine();
+    // Create current thread magazine.
+    LLBC_ObjPoolMagazine *CreateMagazine();
+    // Pop free object from current thread magazine, refill magazine if empty.
+    _WrappedObj *PopFromMagazine(int magazineSize);
+    // Push released object to current thread magazine, flush magazine if full.
+    void PushToMagazine(_WrappedObj *wrappedObj, int magazineSize);
+    // Flush magazine oldest objects to stripes, must call in magazine lock.
+    void FlushMagazine(LLBC_ObjPoolMagazine *magazine, int flushCount);
+    // Flush all magazines objects to stripes.
+    void FlushMagazines();
+    // Release owner thread exited magazines, must call in magazines lock.
+    void ReleaseExitedMagazines();
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
     // Get statistics.
     LLBC_Json::Value GetStatistics(LLBC_Json::MemoryPoolAllocator<> &jsonAlloc) const;
 
@@ -696,6 +816,15 @@ private:
     size_t _usingObjCount; // Using object count.
     int _reusableObjCount; // Reusable object count.
 
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    int _magazineIdx; // Thread magazine index, only available in thread safe pool.
+    mutable LLBC_SpinLock _magazinesLock; // Magazines lock(lock order: magazines -> magazine -> pool).
+    std::vector<LLBC_ObjPoolMagazine *> _magazines; // Threads magazines.
+    uint64 _releasedMagazineHits; // Released(owner thread exited) magazines hit count.
+    uint64 _releasedMagazineMisses; // Released(owner thread exited) magazines miss count.
+    uint64 _releasedMagazineFlushes; // Released(owner thread exited) magazines flush count.
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
     static constexpr size_t _objOffset = offsetof(_WrappedObj, buff); // Object offset in _WrappedObj.
 };
 
@@ -750,6 +879,47 @@ public:
      */
     void Collect(bool deep);
 
+    /**
+     * Set trim policy.
+     * @param[in] policy - the trim policy.
+     */
+    void SetTrimPolicy(const LLBC_ObjPoolTrimPolicy &policy);
+
+    /**
+     * Get trim policy.
+     * @return LLBC_ObjPoolTrimPolicy - the trim policy.
+     */
+    LLBC_ObjPoolTrimPolicy GetTrimPolicy() const;
+
+    /**
+     * Set thread magazine size, only thread safe object pool support magazine.
+     * Note: Default magazine size is LLBC_CFG_CORE_OBJPOOL_DFT_MAGAZINE_SIZE, new size
+     *       effect on next Acquire()/Release().
+     * @param[in] magazineSize - the magazine size, 0 means disable magazine,
+     *                           max is LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetMagazineSize(int magazineSize);
+
+    /**
+     * Get thread magazine size.
+     * @return int - the magazine size.
+     */
+    int GetMagazineSize() const { return _magazineSize.load(std::memory_order_relaxed); }
+
+    /**
+     * Trim object pool(trim all typed object pools idle stripes according to trim policy).
+     * @return size_t - the trimmed memory size, in bytes.
+     */
+    size_t Trim();
+
+    /**
+     * Trim all thread-safe object pools in process.
+     * Note: Thread-unsafe object pools must be trimmed by it's using thread, call Trim().
+     * @return size_t - the trimmed memory size, in bytes.
+     */
+    static size_t TrimAll();
+
     /**
      * Get typed object pool.
      * @return LLBC_TypedObjPool<Obj> * - the typed object pool.
@@ -794,6 +964,9 @@ public:
     void SetName(const LLBC_CString &poolName);
 
 private:
+    template <typename Obj>
+    friend class LLBC_TypedObjPool;
+
     // The wrapped TypedObjPool structure encapsulation.
     struct _WrappedTypedObjPool
     {
@@ -801,6 +974,7 @@ private:
         void (*ReleaseObj)(void *, void *);
         void (*Destruct)(void *);
         void (*Collect)(void *, bool);
+        size_t (*Trim)(void *, const LLBC_ObjPoolTrimPolicy &);
         LLBC_Json::Value (*GetStatistics)(void *, LLBC_Json::MemoryPoolAllocator<> &);
 
         uint8 typedObjPool[0];
@@ -812,6 +986,77 @@ private:
      */
     void DelTypedObjPool(_WrappedTypedObjPool *wrappedTypedObjPool);
 
+    /**
+     * Get object type index, dense index assigned when first use.
+     * Note: Same object type in different modules(exe/dll/so) maybe get different indexes.
+     * @return int - the object type index.
+     */
+    template <typename Obj>
+    static int GetTypeIndex();
+
+    /**
+     * Allocate new object type index.
+     * @return int - the new object type index.
+     */
+    static int AllocTypeIndex();
+
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    /**
+     * Allocate thread magazine index, per thread safe typed object pool.
+     * @return int - the thread magazine index.
+     */
+    static int AllocMagazineIndex();
+
+    /**
+     * Free thread magazine index, all magazines of this index must be detached.
+     * @param[in] magazineIdx - the thread magazine index.
+     */
+    static void FreeMagazineIndex(int magazineIdx);
+
+    /**
+     * Get current thread magazine.
+     * @param[in] magazineIdx - the thread magazine index.
+     * @return LLBC_ObjPoolMagazine * - the magazine, maybe detached from typed object pool.
+     */
+    static LLBC_ObjPoolMagazine *GetThreadMagazine(int magazineIdx);
+
+    /**
+     * Create current thread magazine, old magazine of this index will be released.
+     * @param[in] magazineIdx  - the thread magazine index.
+     * @param[in] typedObjPool - the owner typed object pool.
+     * @param[in] drain        - the drain magazine method.
+     * @return LLBC_ObjPoolMagazine * - the new magazine, null if current thread magazines destroyed(thread exiting).
+     */
+    static LLBC_ObjPoolMagazine *CreateThreadMagazine(int magazineIdx,
+                                                      void *typedObjPool,
+                                                      void (*drain)(void *, LLBC_ObjPoolMagazine *));
+
+    /**
+     * Release magazine reference, delete magazine if no reference.
+     * @param[in] magazine - the magazine.
+     */
+    static void ReleaseMagazine(LLBC_ObjPoolMagazine *magazine);
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
+    /**
+     * Add thread-safe object pool to process object pools registry.
+     * @param[in] objPool - the thread-safe object pool.
+     */
+    static void AddToRegistry(LLBC_ObjPool *objPool);
+
+    /**
+     * Remove thread-safe object pool from process object pools registry.
+     * @param[in] objPool - the thread-safe object pool.
+     */
+    static void RemoveFromRegistry(LLBC_ObjPool *objPool);
+
+    /**
+     * Add wrapped typed object pool to type indexed table, must call in lock.
+     * @param[in] typeIdx             - the object type index.
+     * @param[in] wrappedTypedObjPool - the wrapped typed object pool.
+     */
+    void AddToTypeIndexedTable(int typeIdx, _WrappedTypedObjPool *wrappedTypedObjPool);
+
 private:
     // The ordered deletion node encapsulation.
     class _OrderedDeleteNode
@@ -868,6 +1113,23 @@ private:
     // Typed object pools.
     std::map<LLBC_CString, _WrappedTypedObjPool *> _typedObjPools;
 
+    // Trim policy.
+    LLBC_ObjPoolTrimPolicy _trimPolicy;
+    // Thread magazine size.
+    std::atomic<int> _magazineSize;
+
+    // Type indexed typed object pools table(two levels: page -> slot), support lock-free lookup.
+    enum
+    {
+        _TypeIndexPageBits = 6,
+        _TypeIndexPageSize = 1 << _TypeIndexPageBits,
+        _TypeIndexPageCount = 64,
+        _MaxTypeIndex = _TypeIndexPageSize * _TypeIndexPageCount,
+    };
+
+    typedef _WrappedTypedObjPool * volatile _TypeIndexedSlot;
+    _TypeIndexedSlot * volatile _typeIndexedPages[_TypeIndexPageCount];
+
     // Ordered delete nodes & node tree.
     std::map<LLBC_CString, _OrderedDeleteNode *> *_orderedDeleteNodes;
     std::map<LLBC_CString, _OrderedDeleteNode *> *_orderedDeleteNodeTree;
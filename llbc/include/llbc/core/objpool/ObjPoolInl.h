@@ -22,6 +22,7 @@
 #pragma once
 
 #include "llbc/core/thread/Guard.h"
+#include "llbc/core/os/OS_Atomic.h"
 #include "llbc/core/os/OS_Thread.h"
 
 // The object pool lock operation macros define.
@@ -143,11 +144,38 @@ LLBC_TypedObjPool<Obj>::LLBC_TypedObjPool(LLBC_ObjPool *objPool, bool threadSafe
 {
     // Init lock.
     __LLBC_INL_InitObjPoolLock();
+
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Magazines created when thread first use.
+    _magazineIdx = _threadSafe ? LLBC_ObjPool::AllocMagazineIndex() : -1;
+    _releasedMagazineHits = _releasedMagazineMisses = _releasedMagazineFlushes = 0;
+    #endif
 }
 
 template <typename Obj>
 LLBC_TypedObjPool<Obj>::~LLBC_TypedObjPool()
 {
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Detach & Release all magazines, magazines cached objects destructed in DeleteStripe().
+    if (_threadSafe)
+    {
+        _magazinesLock.Lock();
+        for (auto &magazine : _magazines)
+        {
+            magazine->lock.Lock();
+            magazine->typedObjPool.store(nullptr, std::memory_order_release);
+            magazine->objCount = 0;
+            magazine->lock.Unlock();
+
+            LLBC_ObjPool::ReleaseMagazine(magazine);
+        }
+        _magazines.clear();
+        _magazinesLock.Unlock();
+
+        LLBC_ObjPool::FreeMagazineIndex(_magazineIdx);
+    }
+    #endif
+
     // Delete all stripes.
     __LLBC_INL_LockObjPool();
     for (auto &stripe : _stripes)
@@ -166,54 +194,31 @@ Obj *LLBC_TypedObjPool<Obj>::Acquire()
     #else // Don't use malloc instead.
     _WrappedObj *wrappedObj;
 
-    // Lock & Find _WrappedObj.
-    __LLBC_INL_LockObjPool();
-    auto stripe = FindFreeStripe();
-    if (LIKELY(stripe->freeObjs))
+    // Find _WrappedObj from magazine(thread safe pool & magazine enabled) or stripes.
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    int magazineSize;
+    if (_threadSafe && (magazineSize = _objPool->GetMagazineSize()) > 0)
     {
-        wrappedObj = stripe->freeObjs;
-        stripe->freeObjs = wrappedObj->stripeOrNextFreeObj.nextFreeObj;
-        ASSERT(!wrappedObj->unFlags.flags.inUsing && "llbc framework internal error");
+        wrappedObj = PopFromMagazine(magazineSize);
     }
     else
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
     {
-        wrappedObj = reinterpret_cast<_WrappedObj *>(stripe->objs + stripe->used++);
-        wrappedObj->unFlags.flagsVal = 0;
-        wrappedObj->magicNum = LLBC_CFG_CORE_OBJPOOL_OBJ_MAGIC_NUMBER;
-        wrappedObj->typedObjPool = this;
-    }
-
-    // Set wrappedObj owner: stripe
-    wrappedObj->stripeOrNextFreeObj.stripe = stripe;
-
-    // If stripe is full, erase from _freeStripes.
-    if (!stripe->freeObjs && stripe->used == stripe->cap)
-    {
-        _freeStripes = stripe->nextFreeStripe;
-        #if LLBC_CFG_CORE_OBJECT_POOL_DEBUG
-        stripe->nextFreeStripe = nullptr;
-        #endif
+        __LLBC_INL_LockObjPool();
+        wrappedObj = PopFromStripes();
+        __LLBC_INL_UnlockObjPool();
     }
 
-    // Incr using object count.
-    ++_usingObjCount;
-
     // Construct _Obj.
-    if (!wrappedObj->unFlags.flags.constructed)
+    if (!wrappedObj->Head()->unFlags.flags.constructed)
     {
-        __LLBC_INL_UnlockObjPool();
         LLBC_ObjReflector::New<Obj>(wrappedObj->buff);
         LLBC_ObjReflector::SetTypedObjPool<Obj>(wrappedObj->buff, this);
-        wrappedObj->unFlags.flags.constructed = true;
-    }
-    else
-    {
-        --_reusableObjCount;
-        __LLBC_INL_UnlockObjPool();
+        wrappedObj->Head()->unFlags.flags.constructed = true;
     }
 
     // Mask obj in using.
-    wrappedObj->unFlags.flags.inUsing = true;
+    wrappedObj->Head()->unFlags.flags.inUsing = true;
 
     // Return obj.
     return reinterpret_cast<Obj *>(wrappedObj->buff);
@@ -230,8 +235,8 @@ void LLBC_TypedObjPool<Obj>::Release(Obj *obj)
     auto wrappedObj = reinterpret_cast<_WrappedObj *>(reinterpret_cast<uint8 *>(obj) - _objOffset);
 
     // Exec required checks.
-    ASSERT(wrappedObj->unFlags.flags.inUsing && "Repeated release object");
-    ASSERT(wrappedObj->magicNum == LLBC_CFG_CORE_OBJPOOL_OBJ_MAGIC_NUMBER &&
+    ASSERT(wrappedObj->Head()->unFlags.flags.inUsing && "Repeated release object");
+    ASSERT(wrappedObj->Head()->magicNum == LLBC_CFG_CORE_OBJPOOL_OBJ_MAGIC_NUMBER &&
            "The object is not a objpool object");
 
     // Reuse/Delete obj.
@@ -242,36 +247,28 @@ void LLBC_TypedObjPool<Obj>::Release(Obj *obj)
     else
     {
         LLBC_ObjReflector::Delete<Obj>(wrappedObj->buff);
-        wrappedObj->unFlags.flags.constructed = false;
+        wrappedObj->Head()->unFlags.flags.constructed = false;
     }
-    wrappedObj->unFlags.flags.inUsing = false;
-
-    // Get stripe.
-    auto stripe = wrappedObj->stripeOrNextFreeObj.stripe;
-
-    // Lock.
-    __LLBC_INL_LockObjPool();
-
-    // Stat reusable object count.
-    if constexpr (LLBC_ObjReflector::IsReusable<Obj>())
-        ++_reusableObjCount;
-
-    // Link to stripe->freeObjs.
-    const auto stripeIsFull = (stripe->used == stripe->cap && !stripe->freeObjs);
-    wrappedObj->stripeOrNextFreeObj.nextFreeObj = stripe->freeObjs;
-    stripe->freeObjs = wrappedObj;
 
-    // If stripe is full before release obj, add to _freeStripes.
-    if (UNLIKELY(stripeIsFull))
+    // Thread safe pool & magazine enabled: Push to magazine(mask inMagazine before unmask inUsing,
+    // avoid Collect() destruct it).
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    int magazineSize;
+    if (_threadSafe && (magazineSize = _objPool->GetMagazineSize()) > 0)
     {
-        stripe->nextFreeStripe = _freeStripes;
-        _freeStripes = stripe;
+        wrappedObj->Head()->unFlags.flags.inMagazine = true;
+        wrappedObj->Head()->unFlags.flags.inUsing = false;
+        PushToMagazine(wrappedObj, magazineSize);
+
+        return;
     }
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
 
-    // Decr using object count.
-    --_usingObjCount;
+    wrappedObj->Head()->unFlags.flags.inUsing = false;
 
-    // Unlock.
+    // Push to stripes.
+    __LLBC_INL_LockObjPool();
+    PushToStripes(wrappedObj);
     __LLBC_INL_UnlockObjPool();
     #endif // LLBC_CFG_CORE_OBJPOOL_USE_MALLOC_INSTEAD
 }
@@ -279,6 +276,12 @@ void LLBC_TypedObjPool<Obj>::Release(Obj *obj)
 template <typename Obj>
 void LLBC_TypedObjPool<Obj>::Collect(bool deep)
 {
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Flush magazines, let magazines cached objects can be collected.
+    if (_threadSafe)
+        FlushMagazines();
+    #endif
+
     // Lock & Defer unlock.
     __LLBC_INL_LockObjPool();
     LLBC_Defer(__LLBC_INL_UnlockObjPool());
@@ -292,16 +295,17 @@ void LLBC_TypedObjPool<Obj>::Collect(bool deep)
         for (uint16 objIdx = 0; objIdx < stripe->used; ++objIdx)
         {
             auto wrappedObj = &stripe->objs[objIdx];
-            if (wrappedObj->unFlags.flags.inUsing)
+            if (wrappedObj->Head()->unFlags.flags.inUsing ||
+                wrappedObj->Head()->unFlags.flags.inMagazine)
             {
                 hasUsingObjs = true;
                 continue;
             }
 
-            if (wrappedObj->unFlags.flags.constructed)
+            if (wrappedObj->Head()->unFlags.flags.constructed)
             {
                 LLBC_ObjReflector::Delete<Obj>(wrappedObj->buff);
-                wrappedObj->unFlags.flags.constructed = false;
+                wrappedObj->Head()->unFlags.flags.constructed = false;
                 --_reusableObjCount;
             }
         }
@@ -352,8 +356,79 @@ void LLBC_TypedObjPool<Obj>::Collect(bool deep)
         }
 
         // Free stripe memory.
-        free(stripe);
+        FreeStripeMemory(stripe);
+    }
+}
+
+template <typename Obj>
+size_t LLBC_TypedObjPool<Obj>::Trim(const LLBC_ObjPoolTrimPolicy &policy)
+{
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Flush magazines, let magazines cached objects not hold stripes.
+    if (_threadSafe)
+        FlushMagazines();
+    #endif
+
+    // Lock & Defer unlock.
+    __LLBC_INL_LockObjPool();
+    LLBC_Defer(__LLBC_INL_UnlockObjPool());
+
+    // Count idle stripes.
+    size_t idleStripeCount = 0;
+    for (auto &stripe : _stripes)
+    {
+        if (stripe->usingCount == 0)
+            ++idleStripeCount;
+    }
+
+    // Calculate retain idle stripe count.
+    size_t retainCount = idleStripeCount;
+    if (policy.idleStripesHighWatermark != 0 &&
+        idleStripeCount > policy.idleStripesHighWatermark)
+        retainCount = MIN(policy.idleStripesLowWatermark, idleStripeCount);
+
+    const size_t stripeSize =
+        sizeof(_ObjStripe) + sizeof(_WrappedObj) * LLBC_ObjReflector::GetStripeCapacity<Obj>();
+    if (policy.maxRetainedIdleBytes != 0)
+        retainCount = MIN(retainCount, policy.maxRetainedIdleBytes / stripeSize);
+
+    if (retainCount == idleStripeCount)
+        return 0;
+
+    // Delete idle stripes(latest created stripe first).
+    size_t trimCount = idleStripeCount - retainCount;
+    for (size_t stripeIdx = _stripes.size(); stripeIdx > 0 && trimCount > 0; --stripeIdx)
+    {
+        auto &stripe = _stripes[stripeIdx - 1];
+        if (stripe->usingCount != 0)
+            continue;
+
+        for (uint16 objIdx = 0; objIdx < stripe->used; ++objIdx)
+        {
+            if (stripe->objs[objIdx].Head()->unFlags.flags.constructed)
+                --_reusableObjCount;
+        }
+
+        DeleteStripe(stripe);
+        stripe = nullptr;
+        --trimCount;
+    }
+
+    _stripes.erase(std::remove(_stripes.begin(), _stripes.end(), nullptr), _stripes.end());
+
+    // Rebuild free stripes.
+    _freeStripes = nullptr;
+    for (auto it = _stripes.rbegin(); it != _stripes.rend(); ++it)
+    {
+        auto &stripe = *it;
+        if (stripe->freeObjs || stripe->used != stripe->cap)
+        {
+            stripe->nextFreeStripe = _freeStripes;
+            _freeStripes = stripe;
+        }
     }
+
+    return (idleStripeCount - retainCount) * stripeSize;
 }
 
 template <typename Obj>
@@ -374,6 +449,12 @@ void LLBC_TypedObjPool<Obj>::Collect_s(void *typedObjPool, bool deep)
     reinterpret_cast<LLBC_TypedObjPool<Obj> *>(typedObjPool)->Collect(deep);
 }
 
+template <typename Obj>
+size_t LLBC_TypedObjPool<Obj>::Trim_s(void *typedObjPool, const LLBC_ObjPoolTrimPolicy &policy)
+{
+    return reinterpret_cast<LLBC_TypedObjPool<Obj> *>(typedObjPool)->Trim(policy);
+}
+
 template <typename Obj>
 LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics_s(void *typedObjPool,
                                                          LLBC_Json::MemoryPoolAllocator<> &jsonAlloc)
@@ -381,6 +462,14 @@ LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics_s(void *typedObjPool,
     return reinterpret_cast<LLBC_TypedObjPool<Obj> *>(typedObjPool)->GetStatistics(jsonAlloc);
 }
 
+#if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+template <typename Obj>
+void LLBC_TypedObjPool<Obj>::DrainMagazine_s(void *typedObjPool, LLBC_ObjPoolMagazine *magazine)
+{
+    reinterpret_cast<LLBC_TypedObjPool<Obj> *>(typedObjPool)->FlushMagazine(magazine, magazine->objCount);
+}
+#endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
 template <typename Obj>
 LLBC_FORCE_INLINE
 typename LLBC_TypedObjPool<Obj>::_ObjStripe *LLBC_TypedObjPool<Obj>::FindFreeStripe()
@@ -389,7 +478,7 @@ typename LLBC_TypedObjPool<Obj>::_ObjStripe *LLBC_TypedObjPool<Obj>::FindFreeStr
         return _freeStripes;
 
     const auto stripeCap = LLBC_ObjReflector::GetStripeCapacity<Obj>();
-    auto stripe = LLBC_Malloc(_ObjStripe, sizeof(_ObjStripe) + sizeof(_WrappedObj) * stripeCap);
+    auto stripe = AllocStripeMemory(sizeof(_ObjStripe) + sizeof(_WrappedObj) * stripeCap);
     memset(stripe, 0, sizeof(_ObjStripe));
     stripe->cap = static_cast<uint16>(stripeCap);
 
@@ -406,11 +495,11 @@ void LLBC_TypedObjPool<Obj>::DeleteStripe(_ObjStripe *stripe)
     for (sint16 objIdx = 0; objIdx < stripe->used; ++objIdx)
     {
         auto wrappedObj = reinterpret_cast<_WrappedObj *>(stripe->objs + objIdx);
-        if (!wrappedObj->unFlags.flags.constructed)
+        if (!wrappedObj->Head()->unFlags.flags.constructed)
             continue;
 
-        // ASSERT(!wrappedObj->unFlags.flags.inUsing && "Object leak");
-        if (wrappedObj->unFlags.flags.inUsing &&
+        // ASSERT(!wrappedObj->Head()->unFlags.flags.inUsing && "Object leak");
+        if (wrappedObj->Head()->unFlags.flags.inUsing &&
             LLBC_ObjReflector::IsReusable<Obj>())
             LLBC_ObjReflector::Reuse<Obj>(wrappedObj->buff);
 
@@ -418,15 +507,308 @@ void LLBC_TypedObjPool<Obj>::DeleteStripe(_ObjStripe *stripe)
     }
 
     // Delete stripe.
-    free(stripe);
+    FreeStripeMemory(stripe);
+}
+
+template <typename Obj>
+typename LLBC_TypedObjPool<Obj>::_ObjStripe *LLBC_TypedObjPool<Obj>::AllocStripeMemory(size_t size)
+{
+    if constexpr (alignof(_ObjStripe) > alignof(std::max_align_t))
+        return reinterpret_cast<_ObjStripe *>(::operator new(size, std::align_val_t(alignof(_ObjStripe))));
+    else
+        return LLBC_Malloc(_ObjStripe, size);
+}
+
+template <typename Obj>
+void LLBC_TypedObjPool<Obj>::FreeStripeMemory(_ObjStripe *stripe)
+{
+    if constexpr (alignof(_ObjStripe) > alignof(std::max_align_t))
+        ::operator delete(stripe, std::align_val_t(alignof(_ObjStripe)));
+    else
+        free(stripe);
+}
+
+template <typename Obj>
+LLBC_FORCE_INLINE
+typename LLBC_TypedObjPool<Obj>::_WrappedObj *LLBC_TypedObjPool<Obj>::PopFromStripes()
+{
+    _WrappedObj *wrappedObj;
+
+    // Find _WrappedObj.
+    auto stripe = FindFreeStripe();
+    if (LIKELY(stripe->freeObjs))
+    {
+        wrappedObj = stripe->freeObjs;
+        stripe->freeObjs = wrappedObj->Head()->stripeOrNextFreeObj.nextFreeObj;
+        ASSERT(!wrappedObj->Head()->unFlags.flags.inUsing && "llbc framework internal error");
+    }
+    else
+    {
+        wrappedObj = reinterpret_cast<_WrappedObj *>(stripe->objs + stripe->used++);
+        wrappedObj->Head()->unFlags.flagsVal = 0;
+        wrappedObj->Head()->magicNum = LLBC_CFG_CORE_OBJPOOL_OBJ_MAGIC_NUMBER;
+        wrappedObj->Head()->typedObjPool = this;
+    }
+
+    // Set wrappedObj owner: stripe
+    wrappedObj->Head()->stripeOrNextFreeObj.stripe = stripe;
+    ++stripe->usingCount;
+
+    // If stripe is full, erase from _freeStripes.
+    if (!stripe->freeObjs && stripe->used == stripe->cap)
+    {
+        _freeStripes = stripe->nextFreeStripe;
+        #if LLBC_CFG_CORE_OBJECT_POOL_DEBUG
+        stripe->nextFreeStripe = nullptr;
+        #endif
+    }
+
+    // Incr using object count, decr reusable object count(if constructed).
+    ++_usingObjCount;
+    if (wrappedObj->Head()->unFlags.flags.constructed)
+        --_reusableObjCount;
+
+    return wrappedObj;
 }
 
+template <typename Obj>
+LLBC_FORCE_INLINE
+void LLBC_TypedObjPool<Obj>::PushToStripes(_WrappedObj *wrappedObj)
+{
+    // Get stripe.
+    auto stripe = wrappedObj->Head()->stripeOrNextFreeObj.stripe;
+
+    // Stat reusable object count.
+    if constexpr (LLBC_ObjReflector::IsReusable<Obj>())
+        ++_reusableObjCount;
+
+    // Link to stripe->freeObjs.
+    const auto stripeIsFull = (stripe->used == stripe->cap && !stripe->freeObjs);
+    wrappedObj->Head()->stripeOrNextFreeObj.nextFreeObj = stripe->freeObjs;
+    stripe->freeObjs = wrappedObj;
+
+    // If stripe is full before release obj, add to _freeStripes.
+    if (UNLIKELY(stripeIsFull))
+    {
+        stripe->nextFreeStripe = _freeStripes;
+        _freeStripes = stripe;
+    }
+
+    // Decr using object count.
+    --stripe->usingCount;
+    --_usingObjCount;
+}
+
+#if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
+template <typename Obj>
+LLBC_FORCE_INLINE LLBC_ObjPoolMagazine *LLBC_TypedObjPool<Obj>::GetMagazine()
+{
+    // Thread magazine not exist or detached from old typed object pool(which used same magazine index), create it.
+    LLBC_ObjPoolMagazine *magazine = LLBC_ObjPool::GetThreadMagazine(_magazineIdx);
+    if (LIKELY(magazine && magazine->typedObjPool.load(std::memory_order_acquire) == this))
+        return magazine;
+
+    return CreateMagazine();
+}
+
+template <typename Obj>
+LLBC_NO_INLINE LLBC_ObjPoolMagazine *LLBC_TypedObjPool<Obj>::CreateMagazine()
+{
+    LLBC_ObjPoolMagazine *magazine = LLBC_ObjPool::CreateThreadMagazine(_magazineIdx, this, &DrainMagazine_s);
+    if (UNLIKELY(!magazine))
+        return nullptr;
+
+    _magazinesLock.Lock();
+    ReleaseExitedMagazines();
+    _magazines.push_back(magazine);
+    _magazinesLock.Unlock();
+
+    return magazine;
+}
+
+template <typename Obj>
+LLBC_FORCE_INLINE
+typename LLBC_TypedObjPool<Obj>::_WrappedObj *LLBC_TypedObjPool<Obj>::PopFromMagazine(int magazineSize)
+{
+    // Thread magazines destroyed(thread exiting), pop from stripes.
+    auto magazine = GetMagazine();
+    if (UNLIKELY(!magazine))
+    {
+        __LLBC_INL_LockObjPool();
+        auto wrappedObj = PopFromStripes();
+        __LLBC_INL_UnlockObjPool();
+
+        return wrappedObj;
+    }
+
+    magazine->lock.Lock();
+
+    // If magazine is empty, refill from stripes in batch.
+    if (UNLIKELY(magazine->objCount == 0))
+    {
+        ++magazine->misses;
+
+        const int refillCount = (magazineSize + 1) / 2;
+        __LLBC_INL_LockObjPool();
+        for (int i = 0; i < refillCount; ++i)
+        {
+            auto wrappedObj = PopFromStripes();
+            wrappedObj->Head()->unFlags.flags.inMagazine = true;
+            magazine->objs[magazine->objCount++] = wrappedObj;
+        }
+        __LLBC_INL_UnlockObjPool();
+    }
+    else
+    {
+        ++magazine->hits;
+    }
+
+    // Pop object(mask inUsing before unmask inMagazine, avoid Collect() destruct it).
+    auto wrappedObj = reinterpret_cast<_WrappedObj *>(magazine->objs[--magazine->objCount]);
+    wrappedObj->Head()->unFlags.flags.inUsing = true;
+    wrappedObj->Head()->unFlags.flags.inMagazine = false;
+
+    magazine->lock.Unlock();
+
+    return wrappedObj;
+}
+
+template <typename Obj>
+LLBC_FORCE_INLINE
+void LLBC_TypedObjPool<Obj>::PushToMagazine(_WrappedObj *wrappedObj, int magazineSize)
+{
+    // Thread magazines destroyed(thread exiting), push to stripes.
+    auto magazine = GetMagazine();
+    if (UNLIKELY(!magazine))
+    {
+        wrappedObj->Head()->unFlags.flags.inMagazine = false;
+
+        __LLBC_INL_LockObjPool();
+        PushToStripes(wrappedObj);
+        __LLBC_INL_UnlockObjPool();
+
+        return;
+    }
+
+    magazine->lock.Lock();
+
+    // If magazine is full, flush oldest objects to stripes in batch(magazine size maybe reduced, flush all
+    // exceeded objects too).
+    if (UNLIKELY(magazine->objCount >= magazineSize))
+    {
+        ++magazine->flushes;
+        FlushMagazine(magazine, magazine->objCount - magazineSize + (magazineSize + 1) / 2);
+    }
+
+    magazine->objs[magazine->objCount++] = wrappedObj;
+
+    magazine->lock.Unlock();
+}
+
+template <typename Obj>
+void LLBC_TypedObjPool<Obj>::FlushMagazine(LLBC_ObjPoolMagazine *magazine, int flushCount)
+{
+    if (flushCount <= 0)
+        return;
+
+    // Push oldest objects to stripes.
+    __LLBC_INL_LockObjPool();
+    for (int i = 0; i < flushCount; ++i)
+    {
+        auto wrappedObj = reinterpret_cast<_WrappedObj *>(magazine->objs[i]);
+        wrappedObj->Head()->unFlags.flags.inMagazine = false;
+        PushToStripes(wrappedObj);
+    }
+    __LLBC_INL_UnlockObjPool();
+
+    // Move remain objects to magazine bottom.
+    magazine->objCount -= flushCount;
+    if (magazine->objCount > 0)
+        memmove(magazine->objs,
+                magazine->objs + flushCount,
+                sizeof(void *) * magazine->objCount);
+}
+
+template <typename Obj>
+void LLBC_TypedObjPool<Obj>::FlushMagazines()
+{
+    LLBC_LockGuard guard(_magazinesLock);
+
+    ReleaseExitedMagazines();
+    for (auto &magazine : _magazines)
+    {
+        magazine->lock.Lock();
+        FlushMagazine(magazine, magazine->objCount);
+        magazine->lock.Unlock();
+    }
+}
+
+template <typename Obj>
+void LLBC_TypedObjPool<Obj>::ReleaseExitedMagazines()
+{
+    // Owner thread exited magazines already drained, keep statistics and release them.
+    for (size_t i = 0; i < _magazines.size();)
+    {
+        auto &magazine = _magazines[i];
+        if (!magazine->threadExited.load(std::memory_order_acquire))
+        {
+            ++i;
+            continue;
+        }
+
+        _releasedMagazineHits += magazine->hits;
+        _releasedMagazineMisses += magazine->misses;
+        _releasedMagazineFlushes += magazine->flushes;
+
+        LLBC_ObjPool::ReleaseMagazine(magazine);
+        magazine = _magazines.back();
+        _magazines.pop_back();
+    }
+}
+
+#endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
 template <typename Obj>
 LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics(LLBC_Json::MemoryPoolAllocator<> &jsonAlloc) const
 {
+    // Statistic magazines(lock order: magazine -> typed object pool).
+    size_t magazineCount = 0;
+    size_t magazineObjCount = 0;
+    size_t magazineMem = 0;
+    uint64 magazineHits = 0, magazineMisses = 0, magazineFlushes = 0;
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    _magazinesLock.Lock();
+    magazineHits = _releasedMagazineHits;
+    magazineMisses = _releasedMagazineMisses;
+    magazineFlushes = _releasedMagazineFlushes;
+    for (auto &magazine : _magazines)
+    {
+        magazine->lock.Lock();
+
+        if (!magazine->threadExited.load(std::memory_order_acquire))
+            ++magazineCount;
+        magazineObjCount += magazine->objCount;
+        magazineHits += magazine->hits;
+        magazineMisses += magazine->misses;
+        magazineFlushes += magazine->flushes;
+    }
+    magazineMem = sizeof(LLBC_ObjPoolMagazine) * _magazines.size();
+
+    LLBC_Defer(
+        for (auto &magazine : _magazines)
+            magazine->lock.Unlock();
+        _magazinesLock.Unlock());
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
     __LLBC_INL_LockObjPool();
     LLBC_Defer(__LLBC_INL_UnlockObjPool());
 
+    // Magazines cached objects are using objects in stripes view, correct them.
+    const size_t usingObjCount = _usingObjCount - magazineObjCount;
+    const int reusableObjCount = _reusableObjCount +
+        (LLBC_ObjReflector::IsReusable<Obj>() ? static_cast<int>(magazineObjCount) : 0);
+
     // Meta info:
     // - name.
     LLBC_Json::Value stat(LLBC_Json::kObjectType);
@@ -448,25 +830,42 @@ LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics(LLBC_Json::MemoryPoolAllo
     const auto objCount = objCountPerStripe * _stripes.size();
     stat.AddMember("obj_count", static_cast<uint32>(objCount), jsonAlloc);
     // - using_obj_count.
-    stat.AddMember("using_obj_count", static_cast<uint32>(_usingObjCount), jsonAlloc);
+    stat.AddMember("using_obj_count", static_cast<uint32>(usingObjCount), jsonAlloc);
     // - using_obj_rate.
     stat.AddMember("using_obj_rate",
-                   objCount != 0 ? static_cast<double>(_usingObjCount) / objCount : 0.0,
+                   objCount != 0 ? static_cast<double>(usingObjCount) / objCount : 0.0,
                    jsonAlloc);
     // - reusable_obj_count.
-    stat.AddMember("reusable_obj_count", _reusableObjCount, jsonAlloc);
+    stat.AddMember("reusable_obj_count", reusableObjCount, jsonAlloc);
     // - reusable_obj_rate.
     stat.AddMember("reusable_obj_rate",
-                   objCount != 0 ? static_cast<double>(_reusableObjCount) / objCount : 0.0,
+                   objCount != 0 ? static_cast<double>(reusableObjCount) / objCount : 0.0,
                    jsonAlloc);
     // - free_obj_count.
-    const auto freeObjCount = objCount - _usingObjCount - _reusableObjCount;
+    const auto freeObjCount = objCount - usingObjCount - reusableObjCount;
     stat.AddMember("free_obj_count", static_cast<uint32>(freeObjCount), jsonAlloc);
     // - free_obj_rate.
     stat.AddMember("free_obj_rate",
                    objCount != 0 ? static_cast<double>(freeObjCount) / objCount : 0.0,
                    jsonAlloc);
 
+    // Magazine info:
+    // - magazine_count: alive threads magazine count.
+    stat.AddMember("magazine_count", static_cast<uint32>(magazineCount), jsonAlloc);
+    // - magazine_obj_count: free objects cached in magazines.
+    stat.AddMember("magazine_obj_count", static_cast<uint32>(magazineObjCount), jsonAlloc);
+    // - magazine_hits: acquire hit magazine count.
+    stat.AddMember("magazine_hits", LLBC_Json::Value().SetUint64(magazineHits), jsonAlloc);
+    // - magazine_misses: acquire miss magazine count(refill magazine from stripes).
+    stat.AddMember("magazine_misses", LLBC_Json::Value().SetUint64(magazineMisses), jsonAlloc);
+    // - magazine_hit_rate.
+    stat.AddMember("magazine_hit_rate",
+                   magazineHits + magazineMisses != 0 ?
+                       static_cast<double>(magazineHits) / (magazineHits + magazineMisses) : 0.0,
+                   jsonAlloc);
+    // - magazine_flushes: release flush magazine to stripes count.
+    stat.AddMember("magazine_flushes", LLBC_Json::Value().SetUint64(magazineFlushes), jsonAlloc);
+
     // Stripe info:
     // - stripe_size: stripe size, in bytes.
     const auto stripeSize = sizeof(_ObjStripe) + sizeof(_WrappedObj) * objCountPerStripe;
@@ -478,10 +877,10 @@ LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics(LLBC_Json::MemoryPoolAllo
 
     // Memory info:
     // - using_mem: using memory, in bytes
-    const auto usingMem = sizeof(Obj) * _usingObjCount;
+    const auto usingMem = sizeof(Obj) * usingObjCount;
     stat.AddMember("using_mem", static_cast<uint32>(usingMem), jsonAlloc);
     // - reusable_mem: reusable memory, in bytes.
-    const auto reusableMem = sizeof(Obj) * _reusableObjCount;
+    const auto reusableMem = sizeof(Obj) * reusableObjCount;
     stat.AddMember("reusable_mem", static_cast<uint32>(reusableMem), jsonAlloc);
     // - free_mem: free memory, in bytes.
     const auto totalMem = sizeof(Obj) * objCount;
@@ -492,7 +891,8 @@ LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics(LLBC_Json::MemoryPoolAllo
     stat.AddMember("total_mem2",
                    static_cast<uint32>(sizeof(LLBC_ObjPool) + // LLBC_ObjPool memory
                                            sizeof(_ObjStripe) * _stripes.size() + // stripes memory
-                                           sizeof(_WrappedObj) * objCount), // wrapped object memory
+                                           sizeof(_WrappedObj) * objCount + // wrapped object memory
+                                           magazineMem), // magazines memory
                    jsonAlloc);
 
     return stat;
@@ -501,19 +901,32 @@ LLBC_Json::Value LLBC_TypedObjPool<Obj>::GetStatistics(LLBC_Json::MemoryPoolAllo
 inline LLBC_ObjPool::LLBC_ObjPool(bool threadSafe)
 : _threadSafe(threadSafe)
 
+, _magazineSize(threadSafe ? LLBC_CFG_CORE_OBJPOOL_DFT_MAGAZINE_SIZE : 0)
+
 , _orderedDeleteNodes(nullptr)
 , _orderedDeleteNodeTree(nullptr)
 {
+    // Init type indexed table.
+    memset(const_cast<_TypeIndexedSlot **>(_typeIndexedPages), 0, sizeof(_typeIndexedPages));
+
     // Init objPool name.
     thread_local int curSubId = 0;
     _name.format("ObjPool_%d_%s_%d", LLBC_GetCurrentThreadId(), threadSafe ? "safe" : "unsafe", ++curSubId);
 
     // Init lock.
     __LLBC_INL_InitObjPoolLock();
+
+    // Add thread-safe object pool to registry, support TrimAll().
+    if (_threadSafe)
+        AddToRegistry(this);
 }
 
 inline LLBC_ObjPool::~LLBC_ObjPool()
 {
+    // Remove from registry.
+    if (_threadSafe)
+        RemoveFromRegistry(this);
+
     // Lock.
     __LLBC_INL_LockObjPool();
 
@@ -538,6 +951,16 @@ inline LLBC_ObjPool::~LLBC_ObjPool()
         _orderedDeleteNodeTree = nullptr;
     }
 
+    // Delete type indexed table pages.
+    for (auto &page : _typeIndexedPages)
+    {
+        if (page)
+        {
+            free(const_cast<_WrappedTypedObjPool **>(page));
+            page = nullptr;
+        }
+    }
+
     // Unlock & Destroy lock.
     __LLBC_INL_UnlockObjPool();
     __LLBC_INL_DestroyObjPoolLock();
@@ -549,20 +972,20 @@ void LLBC_ObjPool::Release(Obj *obj)
     #if LLBC_CFG_CORE_OBJPOOL_USE_MALLOC_INSTEAD
     delete obj;
     #else // Don't use malloc instead.
-    // Get wrapped object.
-    auto wrappedObj = reinterpret_cast<typename LLBC_TypedObjPool<Obj>::_WrappedObj *>(
-        reinterpret_cast<uint8 *>(obj) - LLBC_TypedObjPool<Obj>::_objOffset);
+    // Get object head(object head always adjacent to object, Obj maybe base class of pooled
+    // object type, don't use Obj's wrapped object layout).
+    auto objHead = reinterpret_cast<typename LLBC_TypedObjPool<Obj>::_ObjHead *>(obj) - 1;
 
     // Execute required checks.
-    ASSERT(wrappedObj->unFlags.flags.inUsing && "Repeated release object");
-    ASSERT(wrappedObj->magicNum == LLBC_CFG_CORE_OBJPOOL_OBJ_MAGIC_NUMBER &&
+    ASSERT(objHead->unFlags.flags.inUsing && "Repeated release object");
+    ASSERT(objHead->magicNum == LLBC_CFG_CORE_OBJPOOL_OBJ_MAGIC_NUMBER &&
            "The object is not a objpool object");
 
     // Release object.
     auto off = _releaseObjMethOffset;
     (*reinterpret_cast<void(**)(void *, void *)>(
-        reinterpret_cast<uint8 *>(wrappedObj->typedObjPool) -
-            off))(wrappedObj->typedObjPool, obj);
+        reinterpret_cast<uint8 *>(objHead->typedObjPool) -
+            off))(objHead->typedObjPool, obj);
     #endif // LLBC_CFG_CORE_OBJPOOL_USE_MALLOC_INSTEAD
 }
 
@@ -583,6 +1006,58 @@ inline void LLBC_ObjPool::Collect(bool deep)
     }
 }
 
+inline void LLBC_ObjPool::SetTrimPolicy(const LLBC_ObjPoolTrimPolicy &policy)
+{
+    __LLBC_INL_LockObjPool();
+    _trimPolicy = policy;
+    __LLBC_INL_UnlockObjPool();
+}
+
+inline LLBC_ObjPoolTrimPolicy LLBC_ObjPool::GetTrimPolicy() const
+{
+    __LLBC_INL_LockObjPool();
+    const auto policy = _trimPolicy;
+    __LLBC_INL_UnlockObjPool();
+
+    return policy;
+}
+
+inline int LLBC_ObjPool::SetMagazineSize(int magazineSize)
+{
+    if (UNLIKELY(!_threadSafe && magazineSize != 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+
+    if (UNLIKELY(magazineSize < 0 || magazineSize > LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    _magazineSize.store(magazineSize, std::memory_order_relaxed);
+
+    return LLBC_OK;
+}
+
+inline size_t LLBC_ObjPool::Trim()
+{
+    // Lock & Defer unlock.
+    __LLBC_INL_LockObjPool();
+    LLBC_Defer(__LLBC_INL_UnlockObjPool());
+
+    // Exec trim.
+    size_t trimmedSize = 0;
+    for (auto &item : _typedObjPools)
+    {
+        auto &wrappedTypedObjPool = item.second;
+        trimmedSize += wrappedTypedObjPool->Trim(wrappedTypedObjPool->typedObjPool, _trimPolicy);
+    }
+
+    return trimmedSize;
+}
+
 inline LLBC_String LLBC_ObjPool::GetStatistics(int statFmt) const
 {
     // Lock & Defer unlock.
@@ -601,7 +1076,9 @@ inline LLBC_String LLBC_ObjPool::GetStatistics(int statFmt) const
                         "reusable_obj_count;reusable_obj_rate;"
                         "free_obj_count;free_obj_rate;"
                         "stripe_size;obj_count_per_stripe;stripe_count;"
-                        "using_mem;reusable_mem;free_mem;total_mem;total_mem2");
+                        "using_mem;reusable_mem;free_mem;total_mem;total_mem2;"
+                        "magazine_count;magazine_obj_count;magazine_hits;magazine_misses;"
+                        "magazine_hit_rate;magazine_flushes");
         }
 
          // Add typed object pools stat.
@@ -614,7 +1091,8 @@ inline LLBC_String LLBC_ObjPool::GetStatistics(int statFmt) const
             stat.append_format("\n%s;%s;%d;"
                                "%u;%u;%u;%u;%.3f;%u;%.3f;%u;%.3f;"
                                "%u;%u;%u;"
-                               "%u;%u;%u;%u;%u",
+                               "%u;%u;%u;%u;%u;"
+                               "%u;%u;%llu;%llu;%.3f;%llu",
                                // Meta info:
                                _name.c_str(),
                                typedObjPoolStat["name"].GetString(),
@@ -638,7 +1116,14 @@ inline LLBC_String LLBC_ObjPool::GetStatistics(int statFmt) const
                                typedObjPoolStat["reusable_mem"].GetUint(),
                                typedObjPoolStat["free_mem"].GetUint(),
                                typedObjPoolStat["total_mem"].GetUint(),
-                               typedObjPoolStat["total_mem2"].GetUint());
+                               typedObjPoolStat["total_mem2"].GetUint(),
+                               // Magazine info(appended, keep existing columns position):
+                               typedObjPoolStat["magazine_count"].GetUint(),
+                               typedObjPoolStat["magazine_obj_count"].GetUint(),
+                               static_cast<unsigned long long>(typedObjPoolStat["magazine_hits"].GetUint64()),
+                               static_cast<unsigned long long>(typedObjPoolStat["magazine_misses"].GetUint64()),
+                               typedObjPoolStat["magazine_hit_rate"].GetDouble(),
+                               static_cast<unsigned long long>(typedObjPoolStat["magazine_flushes"].GetUint64()));
         }
 
         return stat;
@@ -682,6 +1167,19 @@ LLBC_FORCE_INLINE LLBC_TypedObjPool<Obj> *LLBC_ObjPool::GetTypedObjPool()
     typedef LLBC_TypedObjPool<Obj> _TypedObjPool;
     static const LLBC_CString rttiName(typeid(Obj).name());
 
+    // Fast path: lookup type indexed table, no lock required.
+    const int typeIdx = GetTypeIndex<Obj>();
+    if (LIKELY(typeIdx < _MaxTypeIndex))
+    {
+        _TypeIndexedSlot * const page = _typeIndexedPages[typeIdx >> _TypeIndexPageBits];
+        if (LIKELY(page))
+        {
+            _WrappedTypedObjPool * const wrappedTypedObjPool = page[typeIdx & (_TypeIndexPageSize - 1)];
+            if (LIKELY(wrappedTypedObjPool))
+                return reinterpret_cast<_TypedObjPool *>(wrappedTypedObjPool->typedObjPool);
+        }
+    }
+
     // Lock.
     __LLBC_INL_LockObjPool();
 
@@ -689,6 +1187,7 @@ LLBC_FORCE_INLINE LLBC_TypedObjPool<Obj> *LLBC_ObjPool::GetTypedObjPool()
     const auto it = _typedObjPools.find(rttiName);
     if (LIKELY(it != _typedObjPools.end()))
     {
+        AddToTypeIndexedTable(typeIdx, it->second);
         __LLBC_INL_UnlockObjPool();
         return reinterpret_cast<_TypedObjPool *>(it->second->typedObjPool);
     }
@@ -700,9 +1199,11 @@ LLBC_FORCE_INLINE LLBC_TypedObjPool<Obj> *LLBC_ObjPool::GetTypedObjPool()
     wrappedTypedObjPool->ReleaseObj = &_TypedObjPool::ReleaseObj_s;
     wrappedTypedObjPool->Destruct = &_TypedObjPool::Destruct_s;
     wrappedTypedObjPool->Collect = &_TypedObjPool::Collect_s;
+    wrappedTypedObjPool->Trim = &_TypedObjPool::Trim_s;
     wrappedTypedObjPool->GetStatistics = &_TypedObjPool::GetStatistics_s;
     new (wrappedTypedObjPool->typedObjPool) _TypedObjPool(this, _threadSafe);
     _typedObjPools.emplace(rttiName, wrappedTypedObjPool);
+    AddToTypeIndexedTable(typeIdx, wrappedTypedObjPool);
 
     // Unlock.
     __LLBC_INL_UnlockObjPool();
@@ -715,6 +1216,33 @@ LLBC_FORCE_INLINE LLBC_TypedObjPool<Obj> *LLBC_ObjPool::GetTypedObjPool()
     return typedObjPool;
 }
 
+template <typename Obj>
+LLBC_FORCE_INLINE int LLBC_ObjPool::GetTypeIndex()
+{
+    static const int typeIdx = AllocTypeIndex();
+    return typeIdx;
+}
+
+inline void LLBC_ObjPool::AddToTypeIndexedTable(int typeIdx, _WrappedTypedObjPool *wrappedTypedObjPool)
+{
+    // Too many object types, only can lookup by rtti name.
+    if (UNLIKELY(typeIdx >= _MaxTypeIndex))
+        return;
+
+    // Publish page and slot with full barrier, make sure lock-free lookup see constructed typed object pool.
+    _TypeIndexedSlot *page = _typeIndexedPages[typeIdx >> _TypeIndexPageBits];
+    if (!page)
+    {
+        page = LLBC_Malloc(_TypeIndexedSlot, sizeof(_TypeIndexedSlot) * _TypeIndexPageSize);
+        memset(const_cast<_WrappedTypedObjPool **>(page), 0, sizeof(_TypeIndexedSlot) * _TypeIndexPageSize);
+        (void)LLBC_AtomicCompareAndExchange<_TypeIndexedSlot>(
+            &_typeIndexedPages[typeIdx >> _TypeIndexPageBits], page, nullptr);
+    }
+
+    (void)LLBC_AtomicCompareAndExchange<_WrappedTypedObjPool>(
+        &page[typeIdx & (_TypeIndexPageSize - 1)], wrappedTypedObjPool, nullptr);
+}
+
 template <typename ObjA, typename ObjB>
 int LLBC_ObjPool::EnsureDeletionBefore()
 {
@@ -49,6 +49,12 @@ LLBC_EXPORT LLBC_SocketHandle LLBC_CreateTcpSocket();
  */
 LLBC_EXPORT LLBC_SocketHandle LLBC_CreateTcpSocketEx();
 
+/**
+ * Create UDP socket.
+ * @return LLBC_SocketHandle - socket handle, if failed, return LLBC_INVALID_SOCKET_HANDLE.
+ */
+LLBC_EXPORT LLBC_SocketHandle LLBC_CreateUdpSocket();
+
 /**
  * Shutdown socket input.
  * @param[in] handle - socket handle.
@@ -80,6 +86,17 @@ LLBC_EXPORT int LLBC_ShutdownSocketInputOutput(LLBC_SocketHandle handle);
  */
 LLBC_EXPORT int LLBC_Send(LLBC_SocketHandle handle, const void *buf, int len, int flags);
 
+/**
+ * Gather sends data on a connected socket(Non-WIN32 use sendmsg(), WIN32 use non-overlapped WSASend()).
+ * @param[in] handle      - socket handle.
+ * @param[in] buffers     - pointer to array of LLBC_SockBuf structures.
+ * @param[in] bufferCount - number of LLBC_SockBuf structures in the buffers, must be less than or
+ *                          equal to LLBC_SOCK_BUF_MAX_COUNT.
+ * @param[in] flags       - flags.
+ * @return int - if no error occurs, return the total number bytes sent, otherwise return -1.
+ */
+LLBC_EXPORT int LLBC_SendV(LLBC_SocketHandle handle, const LLBC_SockBuf *buffers, int bufferCount, int flags);
+
 /**
  * Send data on a connected socket(WIN32 specific).
  * @param[in]  handle         - socket handle.
@@ -29,6 +29,7 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 class LLBC_ObjPool;
+class LLBC_SharedMessageBlock;
 
 __LLBC_NS_END
 
@@ -227,12 +228,22 @@ public:
 
     /**
      * Adjust the message block's buffer size.
+     * Note:
+     *  If message block attached external buffer, will copy data to new self-owned buffer.
      * @param[in] newSize - new buffer size.
      */
     void Resize(size_t newSize);
 
     LLBC_DISABLE_ASSIGNMENT(LLBC_MessageBlock);
 
+private:
+    /**
+     * Release the shared message block which owned attached buffer(only available for slice block).
+     */
+    void ReleaseSharedOwner();
+
+    friend class LLBC_SharedMessageBlock;
+
 private:
     bool _attach;
     char *_buf;
@@ -245,6 +256,8 @@ private:
     LLBC_MessageBlock *_next;
 
     LLBC_TypedObjPool<LLBC_MessageBlock> *_typedObjPool;
+
+    LLBC_SharedMessageBlock *_sharedOwner;
 };
 
 __LLBC_NS_END
@@ -35,6 +35,8 @@ inline LLBC_MessageBlock::LLBC_MessageBlock(size_t size)
 , _next(nullptr)
 
 , _typedObjPool(nullptr)
+
+, _sharedOwner(nullptr)
 {
     if (LIKELY(size > 0))
         _buf = LLBC_Malloc(char, size);
@@ -52,6 +54,8 @@ inline LLBC_MessageBlock::LLBC_MessageBlock(void *buf, size_t size, bool attach)
 , _next(nullptr)
 
 , _typedObjPool(nullptr)
+
+, _sharedOwner(nullptr)
 {
 }
 
@@ -59,6 +63,8 @@ inline LLBC_MessageBlock::~LLBC_MessageBlock()
 {
     if (_buf && !_attach)
         free(_buf);
+    if (_sharedOwner)
+        ReleaseSharedOwner();
 }
 
 inline int LLBC_MessageBlock::Allocate(size_t size)
@@ -122,6 +128,8 @@ inline void LLBC_MessageBlock::Release()
 
     if (!_attach)
         free(_buf);
+    else if (_sharedOwner)
+        ReleaseSharedOwner();
     _buf = nullptr;
 
     _size = 0;
@@ -133,6 +141,9 @@ inline void LLBC_MessageBlock::Clear()
     _readPos = _writePos = 0;
     if (_attach)
     {
+        if (_sharedOwner)
+            ReleaseSharedOwner();
+
         _buf = 0;
         _size = 0;
         _attach = false;
@@ -265,12 +276,14 @@ inline void LLBC_MessageBlock::Swap(LLBC_MessageBlock *another)
 
     std::swap(_prev, another->_prev);
     std::swap(_next, another->_next);
+
+    std::swap(_sharedOwner, another->_sharedOwner);
 }
 
 inline LLBC_MessageBlock *LLBC_MessageBlock::Clone() const
 {
     LLBC_MessageBlock *clone;
-    if (IsAttach())
+    if (IsAttach() && !_sharedOwner)
     {
         clone = new LLBC_MessageBlock(_buf, _size);
     }
@@ -310,9 +323,25 @@ inline void LLBC_MessageBlock::SetNext(LLBC_MessageBlock *next)
 
 inline void LLBC_MessageBlock::Resize(size_t newSize)
 {
-    ASSERT(!_attach && newSize > _size);
+    ASSERT(newSize > _size);
+
+    // Attached buffer not owned by message block, copy data to self-owned buffer.
+    if (_attach)
+    {
+        char *newBuf = LLBC_Malloc(char, newSize);
+        if (_buf && _size > 0)
+            memcpy(newBuf, _buf, _size);
+
+        _buf = newBuf;
+        _attach = false;
+        if (_sharedOwner)
+            ReleaseSharedOwner();
+    }
+    else
+    {
+        _buf = LLBC_Realloc(char, _buf, newSize);
+    }
 
-    _buf = LLBC_Realloc(char, _buf, newSize);
     _size = newSize;
 }
 
@@ -35,15 +35,57 @@ __LLBC_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The message queue type enumeration.
+ */
+class LLBC_EXPORT LLBC_MessageQueueType
+{
+public:
+    enum ENUM
+    {
+        Begin,
+
+        // Lock based queue, support all push/pop operations.
+        Locked = Begin,
+        // Lock-free intrusive multi-producer/single-consumer queue.
+        // - PushBack() is lock-free, consumer batch fetch pushed blocks and only sleep when queue is empty.
+        // - Only one thread can pop blocks at a time, PushFront()/PopBack() series methods not supported.
+        MPSC,
+
+        End
+    };
+
+    /**
+     * Check given message queue type is valid or not.
+     * @param[in] type - the message queue type.
+     * @return bool - return true if valid, otherwise return false.
+     */
+    static bool IsValid(int type);
+};
+
 /**
  * \brief The thread message queue class encapsulation.
  */
 class LLBC_EXPORT LLBC_MessageQueue
 {
 public:
-    LLBC_MessageQueue();
+    explicit LLBC_MessageQueue(int type = LLBC_MessageQueueType::Locked);
     ~LLBC_MessageQueue();
 
+public:
+    /**
+     * Get message queue type.
+     * @return int - the message queue type, see LLBC_MessageQueueType enumeration.
+     */
+    int GetType() const;
+
+    /**
+     * Set message queue type, only empty queue can change type.
+     * @param[in] type - the message queue type, see LLBC_MessageQueueType enumeration.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetType(int type);
+
 public:
     /**
      * Insert new message block at the begin of the controlled sequence.
@@ -161,6 +203,40 @@ private:
      */
     void PopBackNonLock(LLBC_MessageBlock *&block);
 
+private:
+    /**
+     * Push message block to MPSC queue(lock-free).
+     * @param[in] block - message block.
+     */
+    void MPSCPush(LLBC_MessageBlock *block);
+
+    /**
+     * Pop the first message block of MPSC queue.
+     * @param[out] block    - message block.
+     * @param[in]  interval - interval value, in milliseconds.
+     * @return bool - return true if success, otherwise return false.
+     */
+    bool MPSCPop(LLBC_MessageBlock *&block, int interval);
+
+    /**
+     * Pop all message blocks of MPSC queue.
+     * @param[out] blocks - the message blocks.
+     * @return bool - return true if has block(s), otherwise return false.
+     */
+    bool MPSCPopAll(LLBC_MessageBlock *&blocks);
+
+    /**
+     * Fetch all pushed blocks and append to consumer list in push order, consumer only.
+     * @return bool - return true if consumer list not empty, otherwise return false.
+     */
+    bool MPSCFetch();
+
+    /**
+     * Wait MPSC queue become non-empty, consumer only.
+     * @param[in] interval - interval value, in milliseconds.
+     */
+    void MPSCWait(int interval);
+
 public:
 #if LLBC_TARGET_PLATFORM_NON_WIN32
     LLBC_SimpleLock _lock;
@@ -170,10 +246,18 @@ public:
     LLBC_Semaphore _sem;
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 
+    int _type;
+
     LLBC_MessageBlock *_head;
     LLBC_MessageBlock *_tail;
 
     volatile size_t _size;
+
+    // MPSC queue members: producers push blocks to _pushed stack(reverse order),
+    // consumer fetch all pushed blocks and append to _head/_tail list in push order.
+    LLBC_MessageBlock * volatile _pushed;
+    volatile sint64 _mpscSize;
+    volatile sint32 _mpscWaiting;
 };
 
 __LLBC_NS_END
@@ -24,48 +24,81 @@
 
 __LLBC_NS_BEGIN
 
+inline bool LLBC_MessageQueueType::IsValid(int type)
+{
+    return type >= Begin && type < End;
+}
+
+inline int LLBC_MessageQueue::GetType() const
+{
+    return _type;
+}
+
 inline void LLBC_MessageQueue::PushFront(LLBC_MessageBlock *block)
 {
+    ASSERT(_type == LLBC_MessageQueueType::Locked && "MPSC message queue not support PushFront()");
     Push(block, true);
 }
 
 inline void LLBC_MessageQueue::PushBack(LLBC_MessageBlock *block)
 {
-    Push(block, false);
+    if (_type == LLBC_MessageQueueType::MPSC)
+        MPSCPush(block);
+    else
+        Push(block, false);
 }
 
 inline void LLBC_MessageQueue::PopFront(LLBC_MessageBlock *&block)
 {
-    Pop(block, LLBC_INFINITE, true);
+    if (_type == LLBC_MessageQueueType::MPSC)
+        MPSCPop(block, LLBC_INFINITE);
+    else
+        Pop(block, LLBC_INFINITE, true);
 }
 
 inline void LLBC_MessageQueue::PopBack(LLBC_MessageBlock *&block)
 {
+    ASSERT(_type == LLBC_MessageQueueType::Locked && "MPSC message queue not support PopBack()");
     Pop(block, LLBC_INFINITE, false);
 }
 
 inline bool LLBC_MessageQueue::TryPopFront(LLBC_MessageBlock *&block)
 {
+    if (_type == LLBC_MessageQueueType::MPSC)
+        return MPSCPop(block, 0);
+
     return Pop(block, 0, true);
 }
 
 inline bool LLBC_MessageQueue::TryPopBack(LLBC_MessageBlock *&block)
 {
+    ASSERT(_type == LLBC_MessageQueueType::Locked && "MPSC message queue not support TryPopBack()");
     return Pop(block, 0, false);
 }
 
 inline bool LLBC_MessageQueue::TimedPopFront(LLBC_MessageBlock *&block, int interval)
 {
+    if (_type == LLBC_MessageQueueType::MPSC)
+        return MPSCPop(block, interval);
+
     return Pop(block, interval, true);
 }
 
 inline bool LLBC_MessageQueue::TimedPopBack(LLBC_MessageBlock *&block, int interval)
 {
+    ASSERT(_type == LLBC_MessageQueueType::Locked && "MPSC message queue not support TimedPopBack()");
     return Pop(block, interval, false);
 }
 
 inline size_t LLBC_MessageQueue::GetSize() const
 {
+    if (_type == LLBC_MessageQueueType::MPSC)
+    {
+        // Push publish node before increase size, concurrent pop may see negative size transiently.
+        const sint64 mpscSize = _mpscSize;
+        return mpscSize > 0 ? static_cast<size_t>(mpscSize) : 0;
+    }
+
     return _size;
 }
 
@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/thread/MessageBlock.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The shared(reference counted) message block class encapsulation.
+ *        Shared message block own a message block, and can create slices(attached message blocks)
+ *        that reference part of the block buffer without copy, the shared message block will be
+ *        deleted when the owner and all slices released.
+ * Note:
+ *  - Reference counting is thread safe, slices can be deleted in any thread.
+ *  - Don't reallocate the owned block buffer while slices exist.
+ */
+class LLBC_EXPORT LLBC_SharedMessageBlock
+{
+public:
+    /**
+     * Create shared message block, the created shared message block reference count is 1.
+     * @param[in] size - block init size.
+     */
+    explicit LLBC_SharedMessageBlock(size_t size = LLBC_CFG_THREAD_MSG_BLOCK_DFT_SIZE);
+
+public:
+    /**
+     * Get the owned message block.
+     * @return LLBC_MessageBlock & - the owned message block.
+     */
+    LLBC_MessageBlock &GetBlock();
+    const LLBC_MessageBlock &GetBlock() const;
+
+    /**
+     * Get reference count.
+     * @return sint32 - the reference count.
+     */
+    sint32 GetRefCount() const;
+
+    /**
+     * Increase reference count.
+     */
+    void Retain();
+
+    /**
+     * Decrease reference count, if reference count reach 0, shared message block will be deleted.
+     */
+    void Release();
+
+public:
+    /**
+     * Create slice, slice is an attached message block that reference [offset, offset + len) of
+     * the owned block buffer, and hold one reference of shared message block.
+     * Note:
+     *  - Slice is a normal message block, delete/recycle it will release the held reference.
+     *  - If slice need write more data than len, slice will copy data to self-owned buffer
+     *    and release the held reference.
+     *  - If blockPool specified, slice block will acquire from blockPool(recycle it to release the held
+     *    reference), otherwise slice block will be heap allocated.
+     * @param[in] offset    - the slice offset in owned block buffer.
+     * @param[in] len       - the slice length.
+     * @param[in] blockPool - the slice block pool, optional.
+     * @return LLBC_MessageBlock * - the slice, return nullptr if range invalid.
+     */
+    LLBC_MessageBlock *CreateSlice(size_t offset,
+                                   size_t len,
+                                   LLBC_TypedObjPool<LLBC_MessageBlock> *blockPool = nullptr);
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_SharedMessageBlock);
+
+private:
+    /**
+     * Destructor, use Release() to delete shared message block.
+     */
+    ~LLBC_SharedMessageBlock() = default;
+
+private:
+    volatile sint32 _refCount;
+    LLBC_MessageBlock _block;
+};
+
+__LLBC_NS_END
+
+#include "llbc/core/thread/SharedMessageBlockInl.h"
@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+__LLBC_NS_BEGIN
+
+inline LLBC_SharedMessageBlock::LLBC_SharedMessageBlock(size_t size)
+: _refCount(1)
+, _block(size)
+{
+}
+
+inline LLBC_MessageBlock &LLBC_SharedMessageBlock::GetBlock()
+{
+    return _block;
+}
+
+inline const LLBC_MessageBlock &LLBC_SharedMessageBlock::GetBlock() const
+{
+    return _block;
+}
+
+inline sint32 LLBC_SharedMessageBlock::GetRefCount() const
+{
+    return LLBC_AtomicGet(const_cast<volatile sint32 *>(&_refCount));
+}
+
+inline void LLBC_SharedMessageBlock::Retain()
+{
+    (void)LLBC_AtomicFetchAndAdd(&_refCount, 1);
+}
+
+inline void LLBC_SharedMessageBlock::Release()
+{
+    if (LLBC_AtomicFetchAndSub(&_refCount, 1) == 1)
+        delete this;
+}
+
+__LLBC_NS_END
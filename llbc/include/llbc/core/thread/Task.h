@@ -105,6 +105,20 @@ public:
      */
     LLBC_Handle GetThreadGroupHandle() const;
 
+    /**
+     * Get task message queue type.
+     * @return int - the message queue type, see LLBC_MessageQueueType enumeration.
+     */
+    int GetMessageQueueType() const;
+
+    /**
+     * Set task message queue type, only can set before task activate.
+     * Note: LLBC_MessageQueueType::MPSC queue only support single thread task.
+     * @param[in] type - the message queue type, see LLBC_MessageQueueType enumeration.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetMessageQueueType(int type);
+
 public:
     /**
      * Wait current task.
@@ -55,6 +55,11 @@ inline LLBC_Handle LLBC_Task::GetThreadGroupHandle() const
     return _threadGroupHandle;
 }
 
+inline int LLBC_Task::GetMessageQueueType() const
+{
+    return _msgQueue.GetType();
+}
+
 inline int LLBC_Task::Push(LLBC_MessageBlock *block)
 {
     _msgQueue.PushBack(block);
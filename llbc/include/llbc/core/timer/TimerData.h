@@ -63,6 +63,23 @@ struct LLBC_HIDDEN LLBC_TimerData
 
     // ref count.
     uint8 refCount;
+
+    // Timing wheel slot list links and level, only used in timing wheel scheduler.
+    LLBC_TimerData *wheelNext;
+    LLBC_TimerData **wheelPprev;
+    uint8 wheelLevel;
+
+    /**
+     * Acquire timer data from current thread free list, all fields zero initialized.
+     * @return LLBC_TimerData * - the timer data.
+     */
+    static LLBC_TimerData *Acquire();
+
+    /**
+     * Release timer data to current thread free list.
+     * @param[in] data - the timer data.
+     */
+    static void Release(LLBC_TimerData *data);
 };
 #pragma pack(pop)
 
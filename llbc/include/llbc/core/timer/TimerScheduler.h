@@ -32,6 +32,34 @@ __LLBC_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The timer scheduler type enumeration.
+ */
+class LLBC_EXPORT LLBC_TimerSchedulerType
+{
+public:
+    enum ENUM
+    {
+        Begin,
+
+        // Binary heap scheduler, schedule/cancel are O(log n),
+        // cancelled timers stay in heap until timeout(except long timeout timers).
+        Heap = Begin,
+        // Hierarchical timing wheel scheduler(1 milli-second tick), schedule/cancel are O(1),
+        // cancelled timers removed immediately.
+        TimingWheel,
+
+        End
+    };
+
+    /**
+     * Check given timer scheduler type is valid or not.
+     * @param[in] type - the timer scheduler type.
+     * @return bool - return true if valid, otherwise return false.
+     */
+    static bool IsValid(int type);
+};
+
 /**
  * \brief The timer scheduler class encapsulation.
  */
@@ -44,7 +72,7 @@ class LLBC_EXPORT LLBC_TimerScheduler
                       std::greater<LLBC_NS LLBC_TimerData *> > _Heap;
 
 public:
-    LLBC_TimerScheduler();
+    explicit LLBC_TimerScheduler(int type = LLBC_CFG_CORE_TIMER_DFT_SCHEDULER_TYPE);
     virtual ~LLBC_TimerScheduler();
 
 public:
@@ -78,6 +106,26 @@ public:
      */
     size_t GetTimerCount() const;
 
+    /**
+     * Get the next timer timeout time, in milli-seconds.
+     * Note: The returned time maybe earlier than actual timeout time(eg: the nearest timer cancelled).
+     * @return sint64 - the next timeout time, if scheduler disabled or no timer scheduled, return -1.
+     */
+    sint64 GetNextTimeoutTime() const;
+
+    /**
+     * Get timer scheduler type.
+     * @return int - the timer scheduler type, see LLBC_TimerSchedulerType enumeration.
+     */
+    int GetType() const;
+
+    /**
+     * Set timer scheduler type, only can set when no timer scheduled.
+     * @param[in] type - the timer scheduler type, see LLBC_TimerSchedulerType enumeration.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetType(int type);
+
 public:
     /**
      * Cancel all timers.
@@ -112,16 +160,59 @@ private:
      */
     virtual int Cancel(LLBC_Timer *timer);
 
+private:
+    /**
+     * Call timer timeout, return need reschedule or not.
+     * @param[in] data - the timer data.
+     * @param[in] now  - now time, in milli-seconds.
+     * @return bool - need reschedule flag.
+     */
+    bool HandleTimeout(LLBC_TimerData *data, sint64 now);
+
+    /**
+     * Heap scheduler methods.
+     */
+    void UpdateHeap(sint64 now);
+
+    /**
+     * Timing wheel scheduler methods.
+     */
+    void UpdateWheel(sint64 now);
+    void CascadeWheel(sint64 tick);
+    void AddToWheel(LLBC_TimerData *data);
+    void RemoveFromWheel(LLBC_TimerData *data);
+    sint64 GetWheelNextTimeoutTime() const;
+    static int GetWheelSlotIndex(int level, int slotIdx);
+
 private:
     LLBC_DISABLE_ASSIGNMENT(LLBC_TimerScheduler);
 
 private:
+    int _type;
     LLBC_TimerId _maxTimerId;
     bool _enabled;
     bool _destroying;
     bool _cancelingAll;
 
     _Heap _heap;
+
+    // Timing wheel: level 0 has 256 slots(1 milli-second per slot), level 1~4 have 64 slots,
+    // total covered time range is 2^32 milli-seconds, longer timers are cascaded again when reached.
+    // The last slot is pending slot, hold the timeout timers of current processing tick.
+    enum
+    {
+        _WheelLevelCount = 5,
+        _WheelSlotBits0 = 8,
+        _WheelSlotBitsN = 6,
+        _WheelSlotCount0 = 1 << _WheelSlotBits0,
+        _WheelSlotCountN = 1 << _WheelSlotBitsN,
+        _WheelPendingSlot = _WheelSlotCount0 + (_WheelLevelCount - 1) * _WheelSlotCountN,
+    };
+
+    sint64 _wheelTime; // Next tick to process, all ticks before it have been processed.
+    size_t _wheelTimerCount;
+    size_t _wheelLevelTimerCounts[_WheelLevelCount + 1]; // Include pending slot.
+    LLBC_TimerData *_wheelSlots[_WheelPendingSlot + 1];
 };
 
 __LLBC_NS_END
@@ -34,6 +34,9 @@ struct LLBC_Delegate;
 
 /**
  * @brief The Delegate encapsulation(template specification).
+ *        Callable objects(c-style function, object method, lambda, ...) are stored inline when
+ *        size <= LLBC_CFG_CORE_UTILS_DELEGATE_INLINE_SIZE(and nothrow move constructible), without
+ *        heap allocation, and are called through a direct thunk(no std::function indirection).
  * 
  */
 template <typename Rtn, typename ...Args>
@@ -86,13 +89,14 @@ public:
     /**
      * @brief Construct a delegate object by callable object.
      */
-    template <typename Func>
+    template <typename Func,
+              typename = typename std::enable_if<!std::is_same<typename std::decay<Func>::type, LLBC_Delegate>::value>::type>
     LLBC_Delegate(const Func &func);
 
     /**
      * @brief Destructor.
      */
-    ~LLBC_Delegate() = default;
+    ~LLBC_Delegate();
 
 public:
     /**
@@ -138,7 +142,7 @@ public:
     /**
      * @brief Assignment by stl function.
      */
-    LLBC_Delegate &operator=(StlFunc &&stlFunc) noexcept;
+    LLBC_Delegate &operator=(StlFunc &&stlFunc);
     LLBC_Delegate &operator=(const StlFunc &stlFunc);
 
     /**
@@ -155,8 +159,91 @@ public:
     operator=(const Func &func);
 
 private:
-    CFunc _cfunc;
-    StlFunc _stlFunc;
+    /**
+     * @brief The callable object storage.
+     */
+    union _Storage
+    {
+        void *heapFunc; // Heap allocated callable object.
+        alignas(sint64) char inlineFunc[LLBC_CFG_CORE_UTILS_DELEGATE_INLINE_SIZE]; // Inline stored callable object.
+    };
+
+    /**
+     * @brief The callable object manage operation enumeration.
+     */
+    enum _ManageOp
+    {
+        _ManageOp_Copy,
+        _ManageOp_Move,
+        _ManageOp_Destroy,
+    };
+
+    /**
+     * @brief The callable object invoker(direct thunk) and manager type define.
+     *        Trivially copyable inline stored callable objects have no manager(memcpy copy/move, no destroy).
+     */
+    typedef Rtn(*_Invoker)(const _Storage &storage, Args &&...args);
+    typedef void(*_Manager)(_ManageOp op, _Storage &dst, _Storage *src);
+
+    /**
+     * @brief The object method caller, trivially copyable, always stored inline.
+     */
+    template <typename Obj, typename Meth>
+    struct _MethCaller
+    {
+        Obj *obj;
+        Meth meth;
+
+        Rtn operator()(Args &&...args) const;
+    };
+
+    /**
+     * @brief Check the callable object can be stored inline or not.
+     */
+    template <typename Func>
+    static constexpr bool IsInlineStorable();
+
+    /**
+     * @brief Check the callable object is null or not(null c-style function/member pointer, empty stl function).
+     */
+    template <typename Func>
+    static bool IsNullFunc(const Func &func);
+
+    /**
+     * @brief Store callable object, delegate must be invalidate before store.
+     * @param[in] func - the callable object.
+     */
+    template <typename Func>
+    void Store(Func &&func);
+
+    /**
+     * @brief Move another delegate's callable object to this delegate, this delegate must be invalidate before move.
+     * @param[in] another - the another delegate, will be invalidate after move.
+     */
+    void MoveFrom(LLBC_Delegate &another);
+
+    /**
+     * @brief Destroy the stored callable object and make delegate invalidate.
+     */
+    void Reset();
+
+    /**
+     * @brief The inline/heap stored callable object invoker & manager.
+     */
+    template <typename Func>
+    static Rtn InvokeInline(const _Storage &storage, Args &&...args);
+    template <typename Func>
+    static Rtn InvokeHeap(const _Storage &storage, Args &&...args);
+
+    template <typename Func>
+    static void ManageInline(_ManageOp op, _Storage &dst, _Storage *src);
+    template <typename Func>
+    static void ManageHeap(_ManageOp op, _Storage &dst, _Storage *src);
+
+private:
+    _Storage _storage;
+    _Invoker _invoker;
+    _Manager _manager;
 };
 
 __LLBC_NS_END
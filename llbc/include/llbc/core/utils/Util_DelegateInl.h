@@ -25,103 +25,128 @@ __LLBC_NS_BEGIN
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(std::nullptr_t _)
-: _cfunc(nullptr)
-, _stlFunc()
+: _invoker(nullptr)
+, _manager(nullptr)
 {
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(const CFunc &cfunc)
-: _cfunc(cfunc)
-, _stlFunc()
+: _invoker(nullptr)
+, _manager(nullptr)
 {
+    if (cfunc)
+        Store(cfunc);
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(StlFunc &&stlFunc)
-: _cfunc(nullptr)
-, _stlFunc(std::move(stlFunc))
+: _invoker(nullptr)
+, _manager(nullptr)
 {
+    if (stlFunc)
+        Store(std::move(stlFunc));
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(const StlFunc &stlFunc)
-: _cfunc(nullptr)
-, _stlFunc(stlFunc)
+: _invoker(nullptr)
+, _manager(nullptr)
 {
+    if (stlFunc)
+        Store(stlFunc);
 }
 
 template <typename Rtn, typename ...Args>
 template <typename Obj>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(Obj *obj, Rtn(Obj::*meth)(Args...))
-: _cfunc(nullptr)
-, _stlFunc(LLBC_BindClassMethod(obj, meth))
+: _invoker(nullptr)
+, _manager(nullptr)
 {
+    Store(_MethCaller<Obj, Rtn(Obj::*)(Args...)>{obj, meth});
 }
 
 template <typename Rtn, typename ...Args>
 template <typename Obj>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(Obj *obj, Rtn(Obj::*constMeth)(Args...) const)
-: _cfunc(nullptr)
-, _stlFunc(LLBC_BindClassMethod(obj, constMeth))
+: _invoker(nullptr)
+, _manager(nullptr)
 {
+    Store(_MethCaller<Obj, Rtn(Obj::*)(Args...) const>{obj, constMeth});
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(LLBC_Delegate &&another) noexcept
-: _cfunc(another._cfunc)
-, _stlFunc(std::move(another._stlFunc))
+: _invoker(nullptr)
+, _manager(nullptr)
 {
-    another._cfunc = nullptr;
+    MoveFrom(another);
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(const LLBC_Delegate &another)
-: _cfunc(another._cfunc)
-, _stlFunc(another._stlFunc)
+: _invoker(nullptr)
+, _manager(nullptr)
 {
+    if (another._manager)
+        another._manager(_ManageOp_Copy, _storage, const_cast<_Storage *>(&another._storage));
+    else if (another._invoker)
+        memcpy(&_storage, &another._storage, sizeof(_Storage));
+
+    _invoker = another._invoker;
+    _manager = another._manager;
 }
 
 template <typename Rtn, typename ...Args>
-template <typename Func>
+template <typename Func, typename>
 LLBC_Delegate<Rtn(Args...)>::LLBC_Delegate(const Func &func)
-: _cfunc(nullptr)
-, _stlFunc(func)
+: _invoker(nullptr)
+, _manager(nullptr)
+{
+    // Function reference decay to c-style function pointer.
+    const typename std::decay<Func>::type &decayedFunc = func;
+    if (!IsNullFunc(decayedFunc))
+        Store(decayedFunc);
+}
+
+template <typename Rtn, typename ...Args>
+LLBC_Delegate<Rtn(Args...)>::~LLBC_Delegate()
 {
+    if (_manager)
+        _manager(_ManageOp_Destroy, _storage, nullptr);
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)>::operator bool() const
 {
-    return _cfunc != nullptr || _stlFunc != nullptr;
+    return _invoker != nullptr;
 }
 
 template <typename Rtn, typename ...Args>
 bool LLBC_Delegate<Rtn(Args...)>::operator==(std::nullptr_t _) const
 {
-    return _cfunc == nullptr && _stlFunc == nullptr;
+    return _invoker == nullptr;
 }
 
 template <typename Rtn, typename ...Args>
 bool LLBC_Delegate<Rtn(Args...)>::operator!=(std::nullptr_t _) const
 {
-    return _cfunc != nullptr || _stlFunc != nullptr;
+    return _invoker != nullptr;
 }
 
 template <typename Rtn, typename ...Args>
 Rtn LLBC_Delegate<Rtn(Args...)>::operator()(Args... args) const
 {
-    if (_cfunc)
-        return (*_cfunc)(std::forward<Args>(args)...);
-    else
-        return _stlFunc(std::forward<Args>(args)...);
+    if (UNLIKELY(!_invoker))
+        throw std::bad_function_call();
+
+    return (*_invoker)(_storage, std::forward<Args>(args)...);
 }
 
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(std::nullptr_t _)
 {
-    _cfunc = nullptr;
-    _stlFunc = nullptr;
+    Reset();
 
     return *this;
 }
@@ -129,18 +154,20 @@ LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(std::nullptr
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(const CFunc &cfunc)
 {
-    _cfunc = cfunc;
-    _stlFunc = nullptr;
+    Reset();
+    if (cfunc)
+        Store(cfunc);
 
     return *this;
 }
 
 
 template <typename Rtn, typename ...Args>
-LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(StlFunc &&stlFunc) noexcept
+LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(StlFunc &&stlFunc)
 {
-    _cfunc = nullptr;
-    _stlFunc = std::move(stlFunc);
+    LLBC_Delegate deleg(std::move(stlFunc));
+    Reset();
+    MoveFrom(deleg);
 
     return *this;
 }
@@ -148,8 +175,9 @@ LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(StlFunc &&st
 template <typename Rtn, typename ...Args>
 LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(const StlFunc &stlFunc)
 {
-    _cfunc = nullptr;
-    _stlFunc = stlFunc;
+    LLBC_Delegate deleg(stlFunc);
+    Reset();
+    MoveFrom(deleg);
 
     return *this;
 }
@@ -160,17 +188,8 @@ LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(LLBC_Delegat
     if (UNLIKELY(&another == this))
         return *this;
 
-    if (another._cfunc)
-    {
-        _cfunc = another._cfunc;
-        another._cfunc = nullptr;
-        _stlFunc = nullptr;
-    }
-    else
-    {
-        _stlFunc = std::move(another._stlFunc);
-        _cfunc = nullptr;
-    }
+    Reset();
+    MoveFrom(another);
 
     return *this;
 }
@@ -181,29 +200,153 @@ LLBC_Delegate<Rtn(Args...)> &LLBC_Delegate<Rtn(Args...)>::operator=(const LLBC_D
     if (UNLIKELY(&another == this))
         return *this;
 
-    if (another._cfunc)
+    LLBC_Delegate deleg(another);
+    Reset();
+    MoveFrom(deleg);
+
+    return *this;
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Func>
+typename std::enable_if<!std::is_same<Func, LLBC_Delegate<Rtn(Args...)> >::value, LLBC_Delegate<Rtn(Args...)> &>::type
+LLBC_Delegate<Rtn(Args...)>::operator=(const Func &func)
+{
+    LLBC_Delegate deleg(func);
+    Reset();
+    MoveFrom(deleg);
+
+    return *this;
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Obj, typename Meth>
+Rtn LLBC_Delegate<Rtn(Args...)>::_MethCaller<Obj, Meth>::operator()(Args &&...args) const
+{
+    return (obj->*meth)(std::forward<Args>(args)...);
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Func>
+constexpr bool LLBC_Delegate<Rtn(Args...)>::IsInlineStorable()
+{
+    return sizeof(Func) <= sizeof(_Storage) &&
+           alignof(_Storage) % alignof(Func) == 0 &&
+           std::is_nothrow_move_constructible<Func>::value;
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Func>
+bool LLBC_Delegate<Rtn(Args...)>::IsNullFunc(const Func &func)
+{
+    if constexpr (std::is_pointer<Func>::value ||
+                  std::is_member_pointer<Func>::value)
+        return func == nullptr;
+    else if constexpr (std::is_constructible<bool, const Func &>::value &&
+                       std::is_convertible<std::nullptr_t, Func>::value)
+        return !func; // Empty stl function(or stl function like callable object).
+    else
+        return false;
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Func>
+void LLBC_Delegate<Rtn(Args...)>::Store(Func &&func)
+{
+    typedef typename std::decay<Func>::type _Func;
+    if constexpr (IsInlineStorable<_Func>())
     {
-        _cfunc = another._cfunc;
-        _stlFunc = nullptr;
+        new (_storage.inlineFunc) _Func(std::forward<Func>(func));
+        _invoker = &InvokeInline<_Func>;
+        _manager = std::is_trivially_copyable<_Func>::value ? nullptr : &ManageInline<_Func>;
     }
     else
     {
-        _cfunc = nullptr;
-        _stlFunc = another._stlFunc;
+        _storage.heapFunc = new _Func(std::forward<Func>(func));
+        _invoker = &InvokeHeap<_Func>;
+        _manager = &ManageHeap<_Func>;
     }
+}
 
-    return *this;
+template <typename Rtn, typename ...Args>
+void LLBC_Delegate<Rtn(Args...)>::MoveFrom(LLBC_Delegate &another)
+{
+    if (another._manager)
+        another._manager(_ManageOp_Move, _storage, &another._storage);
+    else if (another._invoker)
+        memcpy(&_storage, &another._storage, sizeof(_Storage));
+
+    _invoker = another._invoker;
+    _manager = another._manager;
+
+    another._invoker = nullptr;
+    another._manager = nullptr;
+}
+
+template <typename Rtn, typename ...Args>
+void LLBC_Delegate<Rtn(Args...)>::Reset()
+{
+    if (_manager)
+    {
+        _manager(_ManageOp_Destroy, _storage, nullptr);
+        _manager = nullptr;
+    }
+
+    _invoker = nullptr;
 }
 
 template <typename Rtn, typename ...Args>
 template <typename Func>
-typename std::enable_if<!std::is_same<Func, LLBC_Delegate<Rtn(Args...)> >::value, LLBC_Delegate<Rtn(Args...)> &>::type
-LLBC_Delegate<Rtn(Args...)>::operator=(const Func &func)
+Rtn LLBC_Delegate<Rtn(Args...)>::InvokeInline(const _Storage &storage, Args &&...args)
 {
-    _cfunc = nullptr;
-    _stlFunc = func;
+    Func &func = *reinterpret_cast<Func *>(const_cast<char *>(storage.inlineFunc));
+    if constexpr (std::is_void<Rtn>::value)
+        std::invoke(func, std::forward<Args>(args)...);
+    else
+        return std::invoke(func, std::forward<Args>(args)...);
+}
 
-    return *this;
+template <typename Rtn, typename ...Args>
+template <typename Func>
+Rtn LLBC_Delegate<Rtn(Args...)>::InvokeHeap(const _Storage &storage, Args &&...args)
+{
+    Func &func = *static_cast<Func *>(storage.heapFunc);
+    if constexpr (std::is_void<Rtn>::value)
+        std::invoke(func, std::forward<Args>(args)...);
+    else
+        return std::invoke(func, std::forward<Args>(args)...);
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Func>
+void LLBC_Delegate<Rtn(Args...)>::ManageInline(_ManageOp op, _Storage &dst, _Storage *src)
+{
+    if (op == _ManageOp_Copy)
+    {
+        new (dst.inlineFunc) Func(*reinterpret_cast<const Func *>(src->inlineFunc));
+    }
+    else if (op == _ManageOp_Move)
+    {
+        Func *srcFunc = reinterpret_cast<Func *>(src->inlineFunc);
+        new (dst.inlineFunc) Func(std::move(*srcFunc));
+        srcFunc->~Func();
+    }
+    else
+    {
+        reinterpret_cast<Func *>(dst.inlineFunc)->~Func();
+    }
+}
+
+template <typename Rtn, typename ...Args>
+template <typename Func>
+void LLBC_Delegate<Rtn(Args...)>::ManageHeap(_ManageOp op, _Storage &dst, _Storage *src)
+{
+    if (op == _ManageOp_Copy)
+        dst.heapFunc = new Func(*static_cast<const Func *>(src->heapFunc));
+    else if (op == _ManageOp_Move)
+        dst.heapFunc = src->heapFunc;
+    else
+        delete static_cast<Func *>(dst.heapFunc);
 }
 
 __LLBC_NS_END
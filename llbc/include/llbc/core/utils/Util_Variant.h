@@ -26,6 +26,8 @@
 __LLBC_NS_BEGIN
 class LLBC_Ini;
 class LLBC_Variant;
+class LLBC_CompactVariant;
+class LLBC_CompactVariantArena;
 __LLBC_NS_END
 
 __LLBC_NS_BEGIN
@@ -73,6 +75,33 @@ public:
      * @param[out] var - the variant object.
      */
     static void Xml2Variant(const LLBC_TINYXML2_NS XMLElement &elem, LLBC_Variant &var);
+
+    /**
+     * Convert ini to compact variant, all memory allocate from arena.
+     * @param[in] ini    - the ini object.
+     * @param[out] var   - the compact variant object.
+     * @param[in] arena  - the compact variant arena.
+     */
+    static void Ini2Variant(const LLBC_Ini &ini, LLBC_CompactVariant &var, LLBC_CompactVariantArena &arena);
+
+    /**
+     * Convert xml document to compact variant, layout same as LLBC_Variant version.
+     * @param[in] doc    - the xml document.
+     * @param[out] var   - the compact variant object.
+     * @param[in] arena  - the compact variant arena.
+     */
+    static void Xml2Variant(const LLBC_TINYXML2_NS XMLDocument &doc,
+                            LLBC_CompactVariant &var,
+                            LLBC_CompactVariantArena &arena);
+    /**
+     * Convert xml element to compact variant, layout same as LLBC_Variant version.
+     * @param[in] elem   - the xml element.
+     * @param[out] var   - the compact variant object.
+     * @param[in] arena  - the compact variant arena.
+     */
+    static void Xml2Variant(const LLBC_TINYXML2_NS XMLElement &elem,
+                            LLBC_CompactVariant &var,
+                            LLBC_CompactVariantArena &arena);
 };
 
 __LLBC_NS_END
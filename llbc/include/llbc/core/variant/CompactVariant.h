@@ -0,0 +1,319 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+class LLBC_Variant;
+class LLBC_CompactVariant;
+struct LLBC_CompactVariantDictEntry;
+
+__LLBC_NS_END
+
+/**
+ * \brief LLBC_CompactVariant stream output function.
+ */
+LLBC_EXPORT std::ostream &operator<<(std::ostream &o, const LLBC_NS LLBC_CompactVariant &var);
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The compact variant arena, a bump allocator that owns all compact variant memory.
+ *        Memory is released only by Reset() or arena destruct, never per object.
+ */
+class LLBC_EXPORT LLBC_CompactVariantArena
+{
+public:
+    explicit LLBC_CompactVariantArena(size_t blockSize = LLBC_CFG_CORE_VARIANT_COMPACT_ARENA_BLOCK_SIZE);
+    ~LLBC_CompactVariantArena();
+
+public:
+    /**
+     * Allocate memory from arena, returned memory is 8 bytes aligned.
+     * Allocation larger than 1/4 block size use dedicated block.
+     * @param[in] size - the allocate size, in bytes.
+     * @return void * - the allocated memory.
+     */
+    void *Allocate(size_t size);
+
+    /**
+     * Free all allocated memory, all compact variants built on this arena become invalid.
+     */
+    void Reset();
+
+    /**
+     * Get allocated(requested, aligned) size, in bytes.
+     */
+    size_t GetUsedSize() const;
+
+    /**
+     * Get reserved(block total) size, in bytes.
+     */
+    size_t GetReservedSize() const;
+
+private:
+    struct _Block
+    {
+        _Block *next;
+        size_t size;
+        size_t used;
+    };
+
+    _Block *NewBlock(size_t size);
+
+private:
+    const size_t _blockSize;
+
+    _Block *_curBlock;
+    size_t _usedSize;
+    size_t _reservedSize;
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_CompactVariantArena);
+};
+
+/**
+ * \brief The compact variant type enumeration.
+ */
+class LLBC_EXPORT LLBC_CompactVariantType
+{
+public:
+    enum ENUM : uint8
+    {
+        Nil,
+
+        Bool,
+        Int,
+        UInt,
+        Double,
+
+        Str,
+
+        Seq,
+        Dict,
+    };
+};
+
+/**
+ * \brief The compact variant, opt-in read-mostly alternative of LLBC_Variant for bulk config loading.
+ *        - 24 bytes per value, trivially copyable, copy is shallow(shares arena data).
+ *        - String not longer than 15 bytes store inline, longer string copy to arena.
+ *        - Dict store as flat entry array, sorted by precomputed key hash after DictSeal().
+ *        - All memory owned by LLBC_CompactVariantArena, variant must not outlive its arena.
+ */
+class LLBC_EXPORT LLBC_CompactVariant
+{
+public:
+    typedef LLBC_CompactVariantDictEntry DictEntry;
+
+    // The inline string max length(not include tailing '\0').
+    static constexpr size_t InlineStrMaxLen = 15;
+
+    // The nil compact variant.
+    static const LLBC_CompactVariant nil;
+
+public:
+    LLBC_CompactVariant();
+
+public:
+    /**
+     * Type query.
+     */
+    LLBC_CompactVariantType::ENUM GetType() const;
+    bool IsNil() const;
+    bool IsBool() const;
+    bool IsInt() const;
+    bool IsUInt() const;
+    bool IsDouble() const;
+    bool IsStr() const;
+    bool IsSeq() const;
+    bool IsDict() const;
+
+    /**
+     * Check string is stored inline or not(only available when type is Str).
+     */
+    bool IsInlineStr() const;
+
+public:
+    /**
+     * Scalar setters.
+     */
+    void SetNil();
+    void SetBool(bool b);
+    void SetInt64(sint64 i64);
+    void SetUInt64(uint64 ui64);
+    void SetDouble(double d);
+
+    /**
+     * Set string value, string not longer than InlineStrMaxLen store inline, otherwise copy to arena.
+     * @param[in] str   - the string.
+     * @param[in] arena - the arena.
+     */
+    void SetStr(const LLBC_CString &str, LLBC_CompactVariantArena &arena);
+
+    /**
+     * Become sequence, all elements initialized to nil.
+     * @param[in] size  - the sequence size.
+     * @param[in] arena - the arena.
+     */
+    void BecomeSeq(size_t size, LLBC_CompactVariantArena &arena);
+
+    /**
+     * Become empty dictionary.
+     * @param[in] capacity - the max entries count, dictionary never grow.
+     * @param[in] arena    - the arena.
+     */
+    void BecomeDict(size_t capacity, LLBC_CompactVariantArena &arena);
+
+    /**
+     * Append dictionary entry, lookup still available before DictSeal() but use linear search.
+     * @param[in] key       - the key string/key string variant(must be Str type, share key data).
+     * @param[in] arena     - the arena.
+     * @return LLBC_CompactVariant & - the entry value, nil if dictionary is full.
+     */
+    LLBC_CompactVariant &DictAppend(const LLBC_CString &key, LLBC_CompactVariantArena &arena);
+    LLBC_CompactVariant &DictAppend(const LLBC_CompactVariant &key);
+
+    /**
+     * Sort dictionary entries by key hash and remove duplicate keys(keep first appended).
+     */
+    void DictSeal();
+
+public:
+    /**
+     * Value getters, string value parse as number when as number type.
+     */
+    bool AsBool() const;
+    sint64 AsInt64() const;
+    uint64 AsUInt64() const;
+    double AsDouble() const;
+    LLBC_CString AsStr() const;
+
+    /**
+     * Get string size/sequence size/dictionary size, return 0 for other types.
+     */
+    size_t Size() const;
+
+    /**
+     * Get the string precomputed hash(only available when type is Str).
+     */
+    uint32 GetStrHash() const;
+
+    /**
+     * Calculate key hash, can precompute and pass to DictFind().
+     */
+    static uint32 HashKey(const LLBC_CString &key);
+
+public:
+    /**
+     * Sequence access.
+     */
+    LLBC_CompactVariant &SeqAt(size_t idx);
+    const LLBC_CompactVariant *SeqBegin() const;
+    const LLBC_CompactVariant *SeqEnd() const;
+
+    /**
+     * Dictionary access.
+     * @return const LLBC_CompactVariant * - the found value, nullptr if not found.
+     */
+    const LLBC_CompactVariant *DictFind(const LLBC_CString &key) const;
+    const LLBC_CompactVariant *DictFind(const LLBC_CString &key, uint32 keyHash) const;
+    const DictEntry *DictBegin() const;
+    const DictEntry *DictEnd() const;
+
+    /**
+     * Subscript access, return nil if not found/type mismatch.
+     */
+    const LLBC_CompactVariant &operator[](size_t idx) const;
+    const LLBC_CompactVariant &operator[](const LLBC_CString &key) const;
+
+public:
+    /**
+     * Convert compact variant to LLBC_Variant(deep copy).
+     * @param[out] var - the variant.
+     */
+    void ToVariant(LLBC_Variant &var) const;
+
+    /**
+     * Build compact variant from LLBC_Variant, non-string dict keys convert by AsStr().
+     * @param[in] var   - the variant.
+     * @param[in] arena - the arena.
+     */
+    void FromVariant(const LLBC_Variant &var, LLBC_CompactVariantArena &arena);
+
+    /**
+     * Get the compact variant string representation.
+     */
+    LLBC_String ToString() const;
+
+private:
+    const char *GetStrData() const;
+    static bool DictEntryLess(const DictEntry &left, const DictEntry &right);
+
+private:
+    union
+    {
+        bool boolVal;
+        sint64 int64Val;
+        uint64 uint64Val;
+        double doubleVal;
+
+        struct
+        {
+            const char *buf;
+            size_t len;
+        } str;
+        char inlStr[InlineStrMaxLen + 1];
+
+        struct
+        {
+            LLBC_CompactVariant *elems;
+            uint32 size;
+        } seq;
+
+        struct
+        {
+            DictEntry *entries;
+            uint32 size;
+            uint32 cap;
+        } dict;
+    } _data;
+
+    uint32 _strHash;
+    uint8 _type;
+    uint8 _inlStrLen;
+    bool _dictSealed;
+};
+
+/**
+ * \brief The compact variant dictionary entry.
+ */
+struct LLBC_EXPORT LLBC_CompactVariantDictEntry
+{
+    LLBC_CompactVariant key;
+    LLBC_CompactVariant value;
+};
+
+__LLBC_NS_END
+
+#include "llbc/core/variant/CompactVariantInl.h"
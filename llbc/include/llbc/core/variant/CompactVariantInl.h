@@ -0,0 +1,210 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "llbc/core/algo/Hash.h"
+
+__LLBC_NS_BEGIN
+
+inline size_t LLBC_CompactVariantArena::GetUsedSize() const
+{
+    return _usedSize;
+}
+
+inline size_t LLBC_CompactVariantArena::GetReservedSize() const
+{
+    return _reservedSize;
+}
+
+inline LLBC_CompactVariant::LLBC_CompactVariant()
+: _strHash(0)
+, _type(LLBC_CompactVariantType::Nil)
+, _inlStrLen(0)
+, _dictSealed(false)
+{
+    _data.uint64Val = 0;
+}
+
+inline LLBC_CompactVariantType::ENUM LLBC_CompactVariant::GetType() const
+{
+    return static_cast<LLBC_CompactVariantType::ENUM>(_type);
+}
+
+inline bool LLBC_CompactVariant::IsNil() const
+{
+    return _type == LLBC_CompactVariantType::Nil;
+}
+
+inline bool LLBC_CompactVariant::IsBool() const
+{
+    return _type == LLBC_CompactVariantType::Bool;
+}
+
+inline bool LLBC_CompactVariant::IsInt() const
+{
+    return _type == LLBC_CompactVariantType::Int;
+}
+
+inline bool LLBC_CompactVariant::IsUInt() const
+{
+    return _type == LLBC_CompactVariantType::UInt;
+}
+
+inline bool LLBC_CompactVariant::IsDouble() const
+{
+    return _type == LLBC_CompactVariantType::Double;
+}
+
+inline bool LLBC_CompactVariant::IsStr() const
+{
+    return _type == LLBC_CompactVariantType::Str;
+}
+
+inline bool LLBC_CompactVariant::IsSeq() const
+{
+    return _type == LLBC_CompactVariantType::Seq;
+}
+
+inline bool LLBC_CompactVariant::IsDict() const
+{
+    return _type == LLBC_CompactVariantType::Dict;
+}
+
+inline bool LLBC_CompactVariant::IsInlineStr() const
+{
+    return IsStr() && _inlStrLen <= InlineStrMaxLen;
+}
+
+inline void LLBC_CompactVariant::SetNil()
+{
+    _type = LLBC_CompactVariantType::Nil;
+    _data.uint64Val = 0;
+}
+
+inline void LLBC_CompactVariant::SetBool(bool b)
+{
+    _type = LLBC_CompactVariantType::Bool;
+    _data.uint64Val = 0;
+    _data.boolVal = b;
+}
+
+inline void LLBC_CompactVariant::SetInt64(sint64 i64)
+{
+    _type = LLBC_CompactVariantType::Int;
+    _data.int64Val = i64;
+}
+
+inline void LLBC_CompactVariant::SetUInt64(uint64 ui64)
+{
+    _type = LLBC_CompactVariantType::UInt;
+    _data.uint64Val = ui64;
+}
+
+inline void LLBC_CompactVariant::SetDouble(double d)
+{
+    _type = LLBC_CompactVariantType::Double;
+    _data.doubleVal = d;
+}
+
+inline LLBC_CString LLBC_CompactVariant::AsStr() const
+{
+    if (!IsStr())
+        return LLBC_CString();
+
+    return LLBC_CString(GetStrData(), IsInlineStr() ? _inlStrLen : _data.str.len);
+}
+
+inline size_t LLBC_CompactVariant::Size() const
+{
+    switch (_type)
+    {
+    case LLBC_CompactVariantType::Str:
+        return IsInlineStr() ? _inlStrLen : _data.str.len;
+    case LLBC_CompactVariantType::Seq:
+        return _data.seq.size;
+    case LLBC_CompactVariantType::Dict:
+        return _data.dict.size;
+    default:
+        return 0;
+    }
+}
+
+inline uint32 LLBC_CompactVariant::GetStrHash() const
+{
+    return IsStr() ? _strHash : 0;
+}
+
+inline uint32 LLBC_CompactVariant::HashKey(const LLBC_CString &key)
+{
+    return LLBC_Hash<>(key.data(), key.size());
+}
+
+inline LLBC_CompactVariant &LLBC_CompactVariant::SeqAt(size_t idx)
+{
+    return _data.seq.elems[idx];
+}
+
+inline const LLBC_CompactVariant *LLBC_CompactVariant::SeqBegin() const
+{
+    return IsSeq() ? _data.seq.elems : nullptr;
+}
+
+inline const LLBC_CompactVariant *LLBC_CompactVariant::SeqEnd() const
+{
+    return IsSeq() ? _data.seq.elems + _data.seq.size : nullptr;
+}
+
+inline const LLBC_CompactVariant *LLBC_CompactVariant::DictFind(const LLBC_CString &key) const
+{
+    return DictFind(key, HashKey(key));
+}
+
+inline const LLBC_CompactVariantDictEntry *LLBC_CompactVariant::DictBegin() const
+{
+    return IsDict() ? _data.dict.entries : nullptr;
+}
+
+inline const LLBC_CompactVariantDictEntry *LLBC_CompactVariant::DictEnd() const
+{
+    return IsDict() ? _data.dict.entries + _data.dict.size : nullptr;
+}
+
+inline const LLBC_CompactVariant &LLBC_CompactVariant::operator[](size_t idx) const
+{
+    if (!IsSeq() || idx >= _data.seq.size)
+        return nil;
+
+    return _data.seq.elems[idx];
+}
+
+inline const LLBC_CompactVariant &LLBC_CompactVariant::operator[](const LLBC_CString &key) const
+{
+    const LLBC_CompactVariant *val = DictFind(key);
+    return val ? *val : nil;
+}
+
+inline const char *LLBC_CompactVariant::GetStrData() const
+{
+    return _inlStrLen <= InlineStrMaxLen ? _data.inlStr : _data.str.buf;
+}
+
+__LLBC_NS_END
@@ -586,11 +586,50 @@ private:
     Dict::size_type DictErase();
     Dict::size_type DictEraseKey(const Dict::key_type &key);
 
+private:
+    /**
+     * \brief String-like key(C string, std::string, LLBC_String, LLBC_CString) check.
+     */
+    template <typename _Key>
+    struct _IsStrKey
+    {
+        typedef typename std::decay<_Key>::type _RawKey;
+        static constexpr bool value = std::is_same<_RawKey, char *>::value ||
+                                      std::is_same<_RawKey, const char *>::value ||
+                                      std::is_base_of<std::string, _RawKey>::value ||
+                                      std::is_same<_RawKey, LLBC_CString>::value;
+    };
+
+    // Borrowed string key variant, see below.
+    class _StrKeyRef;
+
 private:
     struct Holder _holder;
     static Str **_num2StrFastAccessTbl;
 };
 
+/**
+ * \brief Borrowed string key variant, used by dict lookups and string compares.
+ *        LLBC_String keys are referenced directly, other string keys are copied
+ *        into an inline string(short strings need no heap allocation).
+ */
+class LLBC_Variant::_StrKeyRef
+{
+public:
+    template <typename _Key>
+    explicit _StrKeyRef(const _Key &key);
+    ~_StrKeyRef();
+
+    const LLBC_Variant &Get() const;
+
+    LLBC_DISABLE_ASSIGNMENT(_StrKeyRef);
+    LLBC_DISABLE_MOVE_ASSIGNMENT(_StrKeyRef);
+
+private:
+    Str _str;
+    LLBC_Variant _key;
+};
+
 __LLBC_NS_END
 
 #include "llbc/core/variant/VariantInl.h"
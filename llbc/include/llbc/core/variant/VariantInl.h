@@ -828,13 +828,19 @@ std::pair<LLBC_Variant::DictIter, bool> LLBC_Variant::DictInsert(const _Key &key
 template <typename _Key>
 LLBC_Variant::DictIter LLBC_Variant::DictFind(const _Key &key)
 {
-    return this->DictFind(Dict::key_type(key));
+    if constexpr (_IsStrKey<_Key>::value)
+        return this->DictFind(_StrKeyRef(key).Get());
+    else
+        return this->DictFind(Dict::key_type(key));
 }
 
 template <typename _Key>
 LLBC_Variant::DictConstIter LLBC_Variant::DictFind(const _Key &key) const
 {
-    return this->DictFind(Dict::key_type(key));
+    if constexpr (_IsStrKey<_Key>::value)
+        return this->DictFind(_StrKeyRef(key).Get());
+    else
+        return this->DictFind(Dict::key_type(key));
 }
 
 template <typename _Key1, typename... _Keys>
@@ -848,19 +854,29 @@ template <typename _Key1, typename... _Keys>
 typename ::std::enable_if<!::std::is_same<_Key1, LLBC_Variant>::value, typename LLBC_Variant::Dict::size_type>::type
 LLBC_Variant::DictErase(_Key1 &&key1, _Keys &&... keys)
 {
-    return this->DictEraseKey(Dict::key_type(key1)) + this->DictErase(std::forward<_Keys>(keys)...);
+    if constexpr (_IsStrKey<_Key1>::value)
+        return this->DictEraseKey(_StrKeyRef(key1).Get()) + this->DictErase(std::forward<_Keys>(keys)...);
+    else
+        return this->DictEraseKey(Dict::key_type(key1)) + this->DictErase(std::forward<_Keys>(keys)...);
 }
 
 template <typename _Key>
 LLBC_Variant &LLBC_Variant::operator[](const _Key &key)
 {
-    return this->operator[](LLBC_Variant(key));
+    // Dict insertion copies the key, so borrowed string key is safe here.
+    if constexpr (_IsStrKey<_Key>::value)
+        return this->operator[](_StrKeyRef(key).Get());
+    else
+        return this->operator[](LLBC_Variant(key));
 }
 
 template <typename _Key>
 const LLBC_Variant &LLBC_Variant::operator[](const _Key &key) const
 {
-    return this->operator[](LLBC_Variant(key));
+    if constexpr (_IsStrKey<_Key>::value)
+        return this->operator[](_StrKeyRef(key).Get());
+    else
+        return this->operator[](LLBC_Variant(key));
 }
 
 template <typename _T,
@@ -972,13 +988,19 @@ inline bool LLBC_Variant::operator>=(const LLBC_Variant &another) const
 template <typename _T>
 bool LLBC_Variant::operator==(const _T &another) const
 {
-    return operator==(LLBC_Variant(another));
+    if constexpr (_IsStrKey<_T>::value)
+        return operator==(_StrKeyRef(another).Get());
+    else
+        return operator==(LLBC_Variant(another));
 }
 
 template <typename _T>
 bool LLBC_Variant::operator!=(const _T &another) const
 {
-    return operator!=(LLBC_Variant(another));
+    if constexpr (_IsStrKey<_T>::value)
+        return operator!=(_StrKeyRef(another).Get());
+    else
+        return operator!=(LLBC_Variant(another));
 }
 
 template <typename _T>
@@ -1248,6 +1270,45 @@ inline LLBC_Variant::Dict::size_type LLBC_Variant::DictErase()
     return 0;
 }
 
+template <typename _Key>
+LLBC_Variant::_StrKeyRef::_StrKeyRef(const _Key &key)
+{
+    _key._holder.type = LLBC_VariantType::STR_DFT;
+    if constexpr (std::is_base_of<Str, _Key>::value)
+    {
+        // Empty string keep nullptr, same as LLBC_Variant(const LLBC_String &).
+        if (!key.empty())
+            _key._holder.data.obj.str = const_cast<Str *>(static_cast<const Str *>(&key));
+    }
+    else
+    {
+        if constexpr (std::is_pointer<typename std::decay<_Key>::type>::value)
+        {
+            const char *str = key;
+            if (str)
+                _str.assign(str, strlen(str));
+        }
+        else
+        {
+            _str.assign(key.data(), key.size());
+        }
+
+        if (!_str.empty())
+            _key._holder.data.obj.str = &_str;
+    }
+}
+
+inline LLBC_Variant::_StrKeyRef::~_StrKeyRef()
+{
+    // Detach borrowed string, make sure key variant never delete it.
+    _key._holder.data.raw.int64Val = 0;
+}
+
+inline const LLBC_Variant &LLBC_Variant::_StrKeyRef::Get() const
+{
+    return _key;
+}
+
 __LLBC_NS_END
 
 namespace std
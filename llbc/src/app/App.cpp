@@ -72,6 +72,8 @@ LLBC_App::LLBC_App()
 , _services(*LLBC_ServiceMgrSingleton)
 
 , _loading(0)
+, _cfg(new LLBC_Variant)
+, _cfgVersion(0)
 , _cfgType(LLBC_AppConfigType::End)
 {
     ASSERT(!_thisApp && "Not allow create more than one application object");
@@ -118,10 +120,7 @@ bool LLBC_App::HasConfig() const
 
 LLBC_Variant LLBC_App::GetConfig() const
 {
-    LLBC_LockGuard guard(_loadLock);
-    LLBC_Variant cfg = _cfg;
-
-    return cfg;
+    return *GetConfigSnapshot();
 }
 
 LLBC_String LLBC_App::GetConfigPath() const
@@ -218,7 +217,7 @@ int LLBC_App::Start(int argc, char *argv[], const LLBC_String &name)
     // Define app start failed defer.
     int ret = LLBC_FAILED;
     LLBC_Defer(if (ret != LLBC_OK) {
-        _cfg.BecomeNil();
+        ReplaceConfig(new LLBC_Variant);
         _cfgPath.clear();
         _cfgType = LLBC_AppConfigType::End;
 
@@ -427,7 +426,7 @@ void LLBC_App::Stop()
     // Cleanup members.
     _cfgPath.clear();
     _cfgType = LLBC_AppConfigType::End;
-    _cfg.BecomeNil();
+    ReplaceConfig(new LLBC_Variant);
 
     _startThreadId = LLBC_INVALID_NATIVE_THREAD_ID;
 
@@ -578,7 +577,8 @@ int LLBC_App::ReloadImpl(bool checkAppStarted, bool callEvMeth)
     LLBC_ReturnIf(_cfgType != LLBC_AppConfigType::End && ReloadConfig() != LLBC_OK, LLBC_FAILED);
 
     // - Reload application fps.
-    for (auto cfgItem : _cfg.AsDict())
+    const LLBC_AppConfigSnapshot cfg = GetConfigSnapshot();
+    for (auto &cfgItem : cfg->AsDict())
     {
         if (_cfgType == LLBC_AppConfigType::Ini)
         {
@@ -586,7 +586,7 @@ int LLBC_App::ReloadImpl(bool checkAppStarted, bool callEvMeth)
             if (sectionName != "app" && sectionName != "application")
                 break;
 
-            for (auto cfgSecItem : cfgItem.second.AsDict())
+            for (auto &cfgSecItem : cfgItem.second.AsDict())
             {
                 if (cfgSecItem.first.AsStr().tolower() == "fps")
                 {
@@ -618,7 +618,7 @@ int LLBC_App::ReloadImpl(bool checkAppStarted, bool callEvMeth)
             auto svc = _services.GetService(svcId);
             LLBC_ContinueIf(!svc);
 
-            svc->Push(LLBC_SvcEvUtil::BuildAppReloadedEv(_cfgType, _cfg));
+            svc->Push(LLBC_SvcEvUtil::BuildAppReloadedEv(_cfgType, cfg));
         }
     }
 
@@ -630,25 +630,49 @@ int LLBC_App::ReloadConfig()
     // Check config file exist or not.
     LLBC_SetErrAndReturnIf(!LLBC_File::Exists(_cfgPath), LLBC_ERROR_NOT_FOUND, LLBC_FAILED);
 
-    // Reload llbc framework supported config type files.
-    LLBC_DoIf(_cfgType == LLBC_AppConfigType::Ini, return ReloadIniConfig());
-    LLBC_DoIf(_cfgType == LLBC_AppConfigType::Xml, return ReloadXmlConfig());
-    LLBC_DoIf(_cfgType == LLBC_AppConfigType::Property, return ReloadPropertyConfig());
-    
-    LLBC_SetLastError(LLBC_ERROR_NOT_SUPPORT);
-    return LLBC_FAILED;
+    // Reload llbc framework supported config type files(load to new config object).
+    int ret;
+    LLBC_Variant *cfg = new LLBC_Variant;
+    if (_cfgType == LLBC_AppConfigType::Ini)
+        ret = ReloadIniConfig(*cfg);
+    else if (_cfgType == LLBC_AppConfigType::Xml)
+        ret = ReloadXmlConfig(*cfg);
+    else if (_cfgType == LLBC_AppConfigType::Property)
+        ret = ReloadPropertyConfig(*cfg);
+    else
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_SUPPORT);
+        ret = LLBC_FAILED;
+    }
+
+    if (ret != LLBC_OK)
+    {
+        delete cfg;
+        return LLBC_FAILED;
+    }
+
+    ReplaceConfig(cfg);
+
+    return LLBC_OK;
+}
+
+void LLBC_App::ReplaceConfig(LLBC_Variant *cfg)
+{
+    // Replace config snapshot, then increase config version.
+    std::atomic_store(&_cfg, LLBC_AppConfigSnapshot(cfg));
+    LLBC_AtomicFetchAndAdd(&_cfgVersion, 1);
 }
 
-int LLBC_App::ReloadIniConfig()
+int LLBC_App::ReloadIniConfig(LLBC_Variant &cfg)
 {
     LLBC_Ini ini;
     LLBC_ReturnIf(ini.LoadFromFile(_cfgPath) != LLBC_OK, LLBC_FAILED);
 
-    LLBC_VariantUtil::Ini2Variant(ini, _cfg);
+    LLBC_VariantUtil::Ini2Variant(ini, cfg);
     return LLBC_OK;
 }
 
-int LLBC_App::ReloadXmlConfig()
+int LLBC_App::ReloadXmlConfig(LLBC_Variant &cfg)
 {
     LLBC_TINYXML2_NS XMLDocument doc;
     const auto xmlLoadRet = doc.LoadFile(_cfgPath.c_str());
@@ -661,14 +685,13 @@ int LLBC_App::ReloadXmlConfig()
         return LLBC_FAILED;
     }
 
-    LLBC_VariantUtil::Xml2Variant(doc, _cfg);
+    LLBC_VariantUtil::Xml2Variant(doc, cfg);
     return LLBC_OK;
 }
 
-int LLBC_App::ReloadPropertyConfig()
+int LLBC_App::ReloadPropertyConfig(LLBC_Variant &cfg)
 {
-    _cfg.BecomeNil();
-    return LLBC_Properties::LoadFromFile(_cfgPath, _cfg);
+    return LLBC_Properties::LoadFromFile(_cfgPath, cfg);
 }
 
 void LLBC_App::HandleEvents()
@@ -727,11 +750,11 @@ void LLBC_App::FireAppPhaseChangeEvToServices(bool willStart,
                                               bool startFinished,
                                               bool willStop)
 {
-    LLBC_Variant cfg;
+    LLBC_AppConfigSnapshot cfg;
     int cfgType = LLBC_AppConfigType::End;
     if (startFinished)
     {
-        cfg = _cfg;
+        cfg = GetConfigSnapshot();
         cfgType = _cfgType;
     }
 
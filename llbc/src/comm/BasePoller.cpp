@@ -53,7 +53,8 @@ This::_Handler This::_handlers[LLBC_PollerEvent::End] =
     &This::HandleEv_Close,
     &This::HandleEv_Monitor,
     &This::HandleEv_TakeOverSession,
-    &This::HandleEv_CtrlProtocolStack
+    &This::HandleEv_CtrlProtocolStack,
+    &This::HandleEv_Multicast
 };
 
 LLBC_BasePoller::LLBC_BasePoller()
@@ -63,7 +64,11 @@ LLBC_BasePoller::LLBC_BasePoller()
 , _brotherCount(0)
 , _svc(nullptr)
 , _pollerMgr(nullptr)
+, _evBlockAllocator(nullptr)
 {
+    #if LLBC_CFG_COMM_USE_MPSC_MSG_QUEUE
+    SetMessageQueueType(LLBC_MessageQueueType::MPSC);
+    #endif // LLBC_CFG_COMM_USE_MPSC_MSG_QUEUE
 }
 
 LLBC_BasePoller::~LLBC_BasePoller()
@@ -114,6 +119,7 @@ void LLBC_BasePoller::SetBrothersCount(int count)
 void LLBC_BasePoller::SetService(LLBC_Service *svc)
 {
     _svc = svc;
+    _evBlockAllocator = &_svc->GetEvBlockAllocator();
 }
 
 void LLBC_BasePoller::SetPollerMgr(LLBC_PollerMgr *mgr)
@@ -150,7 +156,7 @@ void LLBC_BasePoller::Cleanup()
         block->Read(&ev, sizeof(LLBC_PollerEvent));
         LLBC_PollerEvUtil::DestroyEv(ev);
 
-        delete block;
+        LLBC_EvBlockAllocator::Release(block);
     }
 
     // Delete all sessions.
@@ -184,7 +190,7 @@ void LLBC_BasePoller::HandleQueuedEvents(int waitTime)
 
         (this->*_handlers[ev.type])(ev);
 
-        delete block;
+        LLBC_EvBlockAllocator::Release(block);
     }
 }
 
@@ -281,6 +287,34 @@ void LLBC_BasePoller::HandleEv_CtrlProtocolStack(LLBC_PollerEvent &ev)
     }
 }
 
+void LLBC_BasePoller::HandleEv_Multicast(LLBC_PollerEvent &ev)
+{
+    // All sessions share the same encoded data, each session send a slice of it(no copy).
+    LLBC_SharedMessageBlock *sharedBlock = ev.un.multicastInfo.block;
+    const LLBC_MessageBlock &block = sharedBlock->GetBlock();
+    const size_t dataPos = block.GetReadPos();
+    const size_t dataLen = block.GetReadableSize();
+
+    const int *sessionIds = reinterpret_cast<const int *>(&ev + 1);
+    LLBC_TypedObjPool<LLBC_MessageBlock> *sliceBlockPool = _evBlockAllocator->GetSliceBlockPool();
+    for (int i = 0; i < ev.un.multicastInfo.sessionCount; ++i)
+    {
+        _Sessions::iterator it = _sessions.find(sessionIds[i]);
+        if (it == _sessions.end())
+            continue;
+
+        LLBC_Session *session = it->second;
+        if (UNLIKELY(session->IsListen()))
+            continue;
+
+        if (UNLIKELY(session->Send(sharedBlock->CreateSlice(dataPos, dataLen, sliceBlockPool)) != LLBC_OK))
+            session->OnClose();
+    }
+
+    sharedBlock->Release();
+    ev.un.multicastInfo.block = nullptr;
+}
+
 LLBC_Session *LLBC_BasePoller::CreateSession(LLBC_Socket *socket,
                                              int sessionId,
                                              const LLBC_SessionOpts &sessionOpts,
@@ -312,7 +346,7 @@ void LLBC_BasePoller::AddToPoller(LLBC_Session *session)
     else
     {
         LLBC_MessageBlock *ev = 
-            LLBC_PollerEvUtil::BuildTakeOverSessionEv(session);
+            LLBC_PollerEvUtil::BuildTakeOverSessionEv(session, _evBlockAllocator);
         if (_pollerMgr->PushMsgToPoller(hash, ev) != LLBC_OK)
         {
             trace("LLBC_BasePoller::AddToPoller() could not found poller, hash val: %d\n", hash);
@@ -347,7 +381,8 @@ void LLBC_BasePoller::AddSession(LLBC_Session *session, bool needAddToIocp)
                                                                     sock->IsListen(),
                                                                     session->GetId(),
                                                                     session->GetAcceptId(),
-                                                                    sock->Handle());
+                                                                    sock->Handle(),
+                                                                    _evBlockAllocator);
 
     _svc->Push(block);
 }
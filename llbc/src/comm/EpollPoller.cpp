@@ -27,7 +27,9 @@
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/PollerType.h"
 #include "llbc/comm/EpollPoller.h"
+#if !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 #include "llbc/comm/PollerMonitor.h"
+#endif // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 #include "llbc/comm/Service.h"
 
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
@@ -37,11 +39,26 @@ namespace
     typedef LLBC_NS LLBC_BasePoller Base;
 }
 
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+__LLBC_INTERNAL_NS_BEGIN
+
+// Wakeup fd closing flag, stored in wakeup refs high bit.
+static const LLBC_NS sint32 __wakeupFdClosing = 0x40000000;
+
+__LLBC_INTERNAL_NS_END
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
 __LLBC_NS_BEGIN
 
 LLBC_EpollPoller::LLBC_EpollPoller()
 : _epoll(LLBC_INVALID_HANDLE)
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+, _wakeupFd(LLBC_INVALID_HANDLE)
+, _wakeupPending(0)
+, _wakeupRefs(LLBC_INL_NS __wakeupFdClosing)
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 , _monitor(nullptr)
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 {
 }
 
@@ -62,7 +79,11 @@ int LLBC_EpollPoller::Start()
             LLBC_CFG_EPOLL_MAX_LISTEN_FD_SIZE)) == LLBC_INVALID_HANDLE)
         return LLBC_FAILED;
 
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    if (CreateWakeupFd() != LLBC_OK)
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     if (StartupMonitor() != LLBC_OK)
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     {
         LLBC_EpollClose(_epoll);
         _epoll = LLBC_INVALID_HANDLE;
@@ -72,7 +93,11 @@ int LLBC_EpollPoller::Start()
 
     if (Activate(1) != LLBC_OK)
     {
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+        CloseWakeupFd();
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
         StopMonitor();
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
         LLBC_EpollClose(_epoll);
         _epoll = LLBC_INVALID_HANDLE;
 
@@ -87,20 +112,45 @@ void LLBC_EpollPoller::Stop()
     if (!IsActivated() || _stopping)
         return;
 
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    _stopping = true;
+    Wakeup();
+
+    Wait();
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     StopMonitor();
 
     LLBC_BasePoller::Stop();
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 }
 
 void LLBC_EpollPoller::Svc()
 {
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    while (!_stopping)
+    {
+        const int ret = LLBC_EpollWait(_epoll,
+                                       _events,
+                                       LLBC_CFG_COMM_MAX_EVENT_COUNT,
+                                       50);
+        if (ret > 0)
+            HandleEpollEvents(_events, ret);
+
+        HandleQueuedEvents(0);
+    }
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     while (!_stopping)
         HandleQueuedEvents(20);
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 }
 
 void LLBC_EpollPoller::Cleanup()
 {
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    CloseWakeupFd();
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
     StopMonitor();
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 
     LLBC_EpollClose(_epoll);
     _epoll = LLBC_INVALID_HANDLE;
@@ -108,6 +158,16 @@ void LLBC_EpollPoller::Cleanup()
     Base::Cleanup();
 }
 
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+int LLBC_EpollPoller::Push(LLBC_MessageBlock *block)
+{
+    const int ret = Base::Push(block);
+    Wakeup();
+
+    return ret;
+}
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
 void LLBC_EpollPoller::HandleEv_AddSock(LLBC_PollerEvent &ev)
 {
     Base::HandleEv_AddSock(ev);
@@ -123,7 +183,7 @@ void LLBC_EpollPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
     if (sock->Connect(ev.peerAddr) == LLBC_OK)
     {
         _svc->Push(LLBC_SvcEvUtil::
-                BuildAsyncConnResultEv(ev.sessionId, true, "Success", ev.peerAddr));
+                BuildAsyncConnResultEv(ev.sessionId, true, "Success", ev.peerAddr, _evBlockAllocator));
 
         SetConnectedSocketOpts(sock, *ev.sessionOpts);
         AddSession(CreateSession(sock, ev.sessionId, *ev.sessionOpts, nullptr));
@@ -149,7 +209,11 @@ void LLBC_EpollPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
     else
     {
         const LLBC_String &reason = LLBC_FormatLastError();
-        _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(ev.sessionId, false, reason, ev.peerAddr));
+        _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(ev.sessionId,
+                                                          false,
+                                                          reason,
+                                                          ev.peerAddr,
+                                                          _evBlockAllocator));
 
         delete sock;
         LLBC_XDelete(ev.sessionOpts);
@@ -179,66 +243,10 @@ void LLBC_EpollPoller::HandleEv_Close(LLBC_PollerEvent &ev)
 void LLBC_EpollPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
 {
     const int count = *reinterpret_cast<int *>(ev.un.monitorEv);
-    LLBC_EpollEvent *evs = 
+    const LLBC_EpollEvent *evs = 
         reinterpret_cast<LLBC_EpollEvent *>(ev.un.monitorEv + sizeof(int));
 
-    for (int i = 0; i < count; ++i)
-    {
-        const LLBC_EpollEvent &epev = evs[i];
-        const LLBC_SocketHandle handle = static_cast<int>(epev.data.u64 & 0xffffffffull);
-        if (HandleConnecting(handle, epev.events))
-            continue;
-
-        const int sessionId = static_cast<int>(epev.data.u64 >> 32);
-        _Sessions::iterator it = _sessions.find(sessionId);
-        if (UNLIKELY(it == _sessions.end()))
-            continue;
-
-        LLBC_Session *session = it->second;
-        if (epev.events & (EPOLLHUP | EPOLLERR))
-        {
-            LLBC_Socket *sock = session->GetSocket();
-
-            int sockErr;
-            LLBC_SessionCloseInfo *closeInfo;
-            if (sock->GetPendingError(sockErr) != LLBC_OK)
-            {
-                closeInfo = new LLBC_SessionCloseInfo;
-            }
-            else
-            {
-                closeInfo = new LLBC_SessionCloseInfo(LLBC_ERROR_CLIB, sockErr);
-            }
-
-            session->OnClose(closeInfo);
-        }
-        else
-        {
-            if (epev.events & EPOLLIN)
-            {
-                if (session->IsListen())
-                {
-                    Accept(session);
-                    continue;
-                }
-                else
-                {
-                    session->OnRecv();
-                }
-            }
-            if (epev.events & EPOLLOUT)
-            {
-                // Maybe in session removed while calling OnRecv() method.
-                if ((epev.events & EPOLLIN) &&
-                        UNLIKELY(_sessions.find(sessionId) == _sessions.end()))
-                    continue;
-
-                session->OnSend();
-            }
-       }
-    }
-
-    free(ev.un.monitorEv);
+    HandleEpollEvents(evs, count);
 }
 
 void LLBC_EpollPoller::HandleEv_TakeOverSession(LLBC_PollerEvent &ev)
@@ -264,6 +272,20 @@ void LLBC_EpollPoller::HandleEv_CtrlProtocolStack(LLBC_PollerEvent &ev)
     session->OnSend();
 }
 
+void LLBC_EpollPoller::HandleEv_Multicast(LLBC_PollerEvent &ev)
+{
+    Base::HandleEv_Multicast(ev);
+
+    // In LINUX or ANDROID platform, if use EPOLL ET mode, we must force call OnSend() one time.
+    const int *sessionIds = reinterpret_cast<const int *>(&ev + 1);
+    for (int i = 0; i < ev.un.multicastInfo.sessionCount; ++i)
+    {
+        _Sessions::iterator it = _sessions.find(sessionIds[i]);
+        if (it != _sessions.end() && !it->second->IsListen())
+            it->second->OnSend();
+    }
+}
+
 void LLBC_EpollPoller::AddSession(LLBC_Session *session)
 {
     Base::AddSession(session);
@@ -291,6 +313,77 @@ void LLBC_EpollPoller::RemoveSession(LLBC_Session *session)
     Base::RemoveSession(session);
 }
 
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+int LLBC_EpollPoller::CreateWakeupFd()
+{
+    if ((_wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1)
+    {
+        _wakeupFd = LLBC_INVALID_HANDLE;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+
+        return LLBC_FAILED;
+    }
+
+    // Wakeup fd event data only store fd, poller will check it before check session.
+    LLBC_EpollEvent epev;
+    epev.events = EPOLLIN;
+    epev.data.u64 = static_cast<uint64>(_wakeupFd);
+    if (LLBC_EpollCtl(_epoll, EPOLL_CTL_ADD, _wakeupFd, &epev) != LLBC_OK)
+    {
+        CloseWakeupFd();
+        return LLBC_FAILED;
+    }
+
+    _wakeupPending = 0;
+    (void)LLBC_AtomicSet(&_wakeupRefs, 0);
+
+    return LLBC_OK;
+}
+
+void LLBC_EpollPoller::CloseWakeupFd()
+{
+    if (_wakeupFd == LLBC_INVALID_HANDLE)
+        return;
+
+    // Mark closing, new wakers will not touch wakeup fd, then wait in-flight wakers finished,
+    // avoid wakers write to closed(and maybe reused) fd.
+    const sint32 closing = LLBC_INL_NS __wakeupFdClosing;
+    (void)LLBC_AtomicFetchAndOr(&_wakeupRefs, closing);
+    while (LLBC_AtomicGet(&_wakeupRefs) != closing)
+        LLBC_CPURelax();
+
+    close(_wakeupFd);
+    _wakeupFd = LLBC_INVALID_HANDLE;
+}
+
+void LLBC_EpollPoller::Wakeup()
+{
+    // Only first pusher need write eventfd before poller thread reset wakeup.
+    if (LLBC_AtomicCompareAndExchange(&_wakeupPending, 1, 0) != 0)
+        return;
+
+    // Hold wakeup fd reference, if wakeup fd closing, don't write it.
+    if (LLBC_AtomicFetchAndAdd(&_wakeupRefs, 1) & LLBC_INL_NS __wakeupFdClosing)
+    {
+        (void)LLBC_AtomicFetchAndSub(&_wakeupRefs, 1);
+        return;
+    }
+
+    const uint64 val = 1;
+    while (write(_wakeupFd, &val, sizeof(val)) == -1 && errno == EINTR);
+
+    (void)LLBC_AtomicFetchAndSub(&_wakeupRefs, 1);
+}
+
+void LLBC_EpollPoller::ResetWakeup()
+{
+    uint64 val;
+    while (read(_wakeupFd, &val, sizeof(val)) == -1 && errno == EINTR);
+
+    // Reset pending flag before handle queued events, makesure new pushed events can wakeup poller again.
+    LLBC_AtomicCompareAndExchange(&_wakeupPending, 0, 1);
+}
+#else // !LLBC_CFG_COMM_EPOLL_INLINE_WAIT
 int LLBC_EpollPoller::StartupMonitor()
 {
     const LLBC_Delegate<void()> deleg(this, &LLBC_EpollPoller::MonitorSvc);
@@ -318,7 +411,75 @@ void LLBC_EpollPoller::MonitorSvc()
     if (ret <= 0)
         return;
 
-    Push(LLBC_PollerEvUtil::BuildEpollMonitorEv(_events, ret));
+    Push(LLBC_PollerEvUtil::BuildEpollMonitorEv(_events, ret, _evBlockAllocator));
+}
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
+void LLBC_EpollPoller::HandleEpollEvents(const LLBC_EpollEvent *evs, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const LLBC_EpollEvent &epev = evs[i];
+        const LLBC_SocketHandle handle = static_cast<int>(epev.data.u64 & 0xffffffffull);
+#if LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+        if (UNLIKELY(handle == _wakeupFd))
+        {
+            ResetWakeup();
+            continue;
+        }
+#endif // LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
+        if (HandleConnecting(handle, epev.events))
+            continue;
+
+        const int sessionId = static_cast<int>(epev.data.u64 >> 32);
+        _Sessions::iterator it = _sessions.find(sessionId);
+        if (UNLIKELY(it == _sessions.end()))
+            continue;
+
+        LLBC_Session *session = it->second;
+        if (epev.events & (EPOLLHUP | EPOLLERR))
+        {
+            LLBC_Socket *sock = session->GetSocket();
+
+            int sockErr;
+            LLBC_SessionCloseInfo *closeInfo;
+            if (sock->GetPendingError(sockErr) != LLBC_OK)
+            {
+                closeInfo = new LLBC_SessionCloseInfo;
+            }
+            else
+            {
+                closeInfo = new LLBC_SessionCloseInfo(LLBC_ERROR_CLIB, sockErr);
+            }
+
+            session->OnClose(closeInfo);
+        }
+        else
+        {
+            if (epev.events & EPOLLIN)
+            {
+                if (session->IsListen())
+                {
+                    Accept(session);
+                    continue;
+                }
+                else
+                {
+                    session->OnRecv();
+                }
+            }
+            if (epev.events & EPOLLOUT)
+            {
+                // Maybe in session removed while calling OnRecv() method.
+                if ((epev.events & EPOLLIN) &&
+                        UNLIKELY(_sessions.find(sessionId) == _sessions.end()))
+                    continue;
+
+                session->OnSend();
+            }
+       }
+    }
 }
 
 bool LLBC_EpollPoller::HandleConnecting(LLBC_SocketHandle handle, int events)
@@ -345,7 +506,8 @@ bool LLBC_EpollPoller::HandleConnecting(LLBC_SocketHandle handle, int events)
     _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(asyncInfo.sessionId,
                                                       connected,
                                                       connected ? "Success" : LLBC_FormatLastError(),
-                                                      asyncInfo.peerAddr));
+                                                      asyncInfo.peerAddr,
+                                                      _evBlockAllocator));
 
     LLBC_EpollEvent epev;
     epev.events = EPOLLOUT | EPOLLET;
@@ -164,7 +164,7 @@ void LLBC_IocpPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
 
     if (!succeed)
         _svc->Push(LLBC_SvcEvUtil::
-                BuildAsyncConnResultEv(ev.sessionId, succeed, reason, ev.peerAddr));
+                BuildAsyncConnResultEv(ev.sessionId, succeed, reason, ev.peerAddr, _evBlockAllocator));
 
     LLBC_XDelete(ev.sessionOpts);
 }
@@ -194,8 +194,6 @@ void LLBC_IocpPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
     off += sizeof(int);
     int subErrNo = *reinterpret_cast<int *>(ev.un.monitorEv + off);
 
-    free(ev.un.monitorEv);
-
     if (HandleConnecting(waitRet, ol, errNo, subErrNo))
         return;
 
@@ -290,7 +288,7 @@ void LLBC_IocpPoller::MonitorSvc()
             subErrNo = LLBC_GetSubErrorNo();
         }
 
-        Push(LLBC_PollerEvUtil::BuildIocpMonitorEv(ret, ol, errNo, subErrNo));
+        Push(LLBC_PollerEvUtil::BuildIocpMonitorEv(ret, ol, errNo, subErrNo, _evBlockAllocator));
     }
 }
 
@@ -311,14 +309,14 @@ bool LLBC_IocpPoller::HandleConnecting(int waitRet, LLBC_POverlapped ol, int err
         SetConnectedSocketOpts(sock, asyncInfo.sessionOpts);
 
         _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(
-            asyncInfo.sessionId, true, LLBC_StrError(LLBC_ERROR_SUCCESS), asyncInfo.peerAddr));
+            asyncInfo.sessionId, true, LLBC_StrError(LLBC_ERROR_SUCCESS), asyncInfo.peerAddr, _evBlockAllocator));
 
         AddSession(CreateSession(sock, asyncInfo.sessionId, asyncInfo.sessionOpts, nullptr), false);
     }
     else
     {
         _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(
-                asyncInfo.sessionId, false, LLBC_StrErrorEx(errNo, subErrNo), asyncInfo.peerAddr));
+                asyncInfo.sessionId, false, LLBC_StrErrorEx(errNo, subErrNo), asyncInfo.peerAddr, _evBlockAllocator));
         delete asyncInfo.socket;
     }
 
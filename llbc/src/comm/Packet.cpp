@@ -68,6 +68,27 @@ void LLBC_Packet::SetPayloadDeleteDeleg(const LLBC_Delegate<void(LLBC_MessageBlo
     _payloadDeleteDeleg = deleg;
 }
 
+int LLBC_Packet::SetPayloadSlice(LLBC_SharedMessageBlock *sharedBlock,
+                                 size_t offset,
+                                 size_t len,
+                                 LLBC_TypedObjPool<LLBC_MessageBlock> *blockPool)
+{
+    if (UNLIKELY(!sharedBlock))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_MessageBlock *slice = sharedBlock->CreateSlice(offset, len, blockPool);
+    if (UNLIKELY(!slice))
+        return LLBC_FAILED;
+
+    CleanupPayload();
+    _payload = slice;
+
+    return LLBC_OK;
+}
+
 void LLBC_Packet::Clear()
 {
     // Clear payload.
@@ -76,6 +97,7 @@ void LLBC_Packet::Clear()
         if (_payloadDeleteDeleg)
         {
             _payloadDeleteDeleg(_payload);
+            _payloadDeleteDeleg = nullptr;
             _payload = nullptr;
         }
         else
@@ -208,6 +230,10 @@ LLBC_MessageBlock *LLBC_Packet::GiveUpPayload()
     if (!_payload)
         return nullptr;
 
+    // Payload owned by delete delegate, giveup a self-owned copy.
+    if (UNLIKELY(_payloadDeleteDeleg))
+        return CopyAndCleanupPayload();
+
     LLBC_MessageBlock *block = _payload;
     _payload = nullptr;
 
@@ -281,4 +307,22 @@ void LLBC_Packet::CleanupPayload()
     _payload = nullptr;
 }
 
+LLBC_MessageBlock *LLBC_Packet::CopyAndCleanupPayload()
+{
+    if (!_payload)
+    {
+        _payloadDeleteDeleg = nullptr;
+        return nullptr;
+    }
+
+    const size_t payloadLen = _payload->GetReadableSize();
+    LLBC_MessageBlock *copied = _typedObjPool ?
+        _typedObjPool->GetObjPool()->Acquire<LLBC_MessageBlock>() : new LLBC_MessageBlock(payloadLen);
+    copied->Write(_payload->GetDataStartWithReadPos(), payloadLen);
+
+    CleanupPayload();
+
+    return copied;
+}
+
 __LLBC_NS_END
@@ -26,6 +26,7 @@
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
 #include "llbc/comm/PollerEvent.h"
+#include "llbc/comm/ServiceEvent.h"
 
 namespace
 {
@@ -39,9 +40,10 @@ __LLBC_NS_BEGIN
 
 LLBC_MessageBlock *LLBC_PollerEvUtil::BuildAddSockEv(LLBC_Socket *sock,
                                                      int sessionId,
-                                                     const LLBC_SessionOpts &sessionOpts)
+                                                     const LLBC_SessionOpts &sessionOpts,
+                                                     LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::AddSock;
     ev.un.socket = sock;
@@ -54,9 +56,10 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildAddSockEv(LLBC_Socket *sock,
 
 LLBC_MessageBlock *LLBC_PollerEvUtil::BuildAsyncConnEv(int sessionId,
                                                        const LLBC_SessionOpts &sessionOpts,
-                                                       const LLBC_SockAddr_IN &peerAddr)
+                                                       const LLBC_SockAddr_IN &peerAddr,
+                                                       LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::AsyncConn;
     ev.sessionId = sessionId;
@@ -67,9 +70,10 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildAsyncConnEv(int sessionId,
     return block;
 }
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildSendEv(LLBC_Packet *packet)
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildSendEv(LLBC_Packet *packet,
+                                                  LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::Send;
     ev.un.packet = packet;
@@ -78,9 +82,11 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildSendEv(LLBC_Packet *packet)
     return block;
 }
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildCloseEv(int sessionId, const char *reason)
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildCloseEv(int sessionId,
+                                                   const char *reason,
+                                                   LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::Close;
     ev.sessionId = sessionId;
@@ -104,12 +110,15 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildCloseEv(int sessionId, const char *re
 LLBC_MessageBlock *LLBC_PollerEvUtil::BuildIocpMonitorEv(int ret, 
                                                          LLBC_POverlapped ol, 
                                                          int errNo, 
-                                                         int subErrNo)
+                                                         int subErrNo,
+                                                         LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    // Monitor data store after event structure.
+    const size_t evSize = sizeof(_Ev) + sizeof(int) + sizeof(LLBC_POverlapped) + sizeof(int) * 2;
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, evSize);
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::Monitor;
-    ev.un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_POverlapped) + sizeof(int) * 2);
+    ev.un.monitorEv = reinterpret_cast<char *>(block->GetData()) + sizeof(_Ev);
 
     size_t off = 0;
     // Wait return value.
@@ -121,32 +130,37 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildIocpMonitorEv(int ret,
     // Sub error no.
     memcpy(ev.un.monitorEv + off, &subErrNo, sizeof(int));
 
-    block->SetWritePos(sizeof(_Ev));
+    block->SetWritePos(evSize);
     return block;
 }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildEpollMonitorEv(const LLBC_EpollEvent *evs, int count)
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildEpollMonitorEv(const LLBC_EpollEvent *evs,
+                                                          int count,
+                                                          LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    // Monitor data store after event structure.
+    const size_t evSize = sizeof(_Ev) + sizeof(int) + sizeof(LLBC_EpollEvent) * count;
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, evSize);
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::Monitor;
-    ev.un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_EpollEvent) * count);
+    ev.un.monitorEv = reinterpret_cast<char *>(block->GetData()) + sizeof(_Ev);
 
     // Write count.
     memcpy(ev.un.monitorEv, &count, sizeof(int));
     // Write events.
     memcpy(ev.un.monitorEv + sizeof(int), evs, sizeof(LLBC_EpollEvent) * count);
 
-    block->SetWritePos(sizeof(_Ev));
+    block->SetWritePos(evSize);
     return block;
 }
 #endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildTakeOverSessionEv(LLBC_Session *session)
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildTakeOverSessionEv(LLBC_Session *session,
+                                                             LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::TakeOverSession;
     ev.un.session = session;
@@ -155,11 +169,12 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildTakeOverSessionEv(LLBC_Session *sessi
     return block;
 }
 
-LLBC_MessageBlock * LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(int sessionId,
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(int sessionId,
                                                                 int ctrlCmd,
-                                                                const LLBC_Variant &ctrlData)
+                                                                const LLBC_Variant &ctrlData,
+                                                                LLBC_EvBlockAllocator *allocator)
 {
-    _Block *block = new _Block(sizeof(_Ev));
+    _Block *block = LLBC_EvBlockAllocator::Acquire(allocator, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
 
     LLBC_Stream ctrlDataStream;
@@ -175,6 +190,25 @@ LLBC_MessageBlock * LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(int sessionId,
     return block;
 }
 
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildMulticastEv(LLBC_SharedMessageBlock *block,
+                                                       const int *sessionIds,
+                                                       int sessionCount,
+                                                       LLBC_EvBlockAllocator *allocator)
+{
+    const size_t evSize = sizeof(_Ev) + sizeof(int) * sessionCount;
+    _Block *evBlock = LLBC_EvBlockAllocator::Acquire(allocator, evSize);
+    _Ev &ev = *reinterpret_cast<_Ev *>(evBlock->GetData());
+    ev.type = _Ev::Multicast;
+    ev.un.multicastInfo.block = block;
+    ev.un.multicastInfo.sessionCount = sessionCount;
+
+    // Write sessionIds.
+    memcpy(reinterpret_cast<char *>(evBlock->GetData()) + sizeof(_Ev), sessionIds, sizeof(int) * sessionCount);
+
+    evBlock->SetWritePos(evSize);
+    return evBlock;
+}
+
 void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
 {
     switch (ev.type)
@@ -196,10 +230,6 @@ void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
         LLBC_XFree(ev.un.closeReason);
         break;
 
-    case _Ev::Monitor:
-        LLBC_XFree(ev.un.monitorEv);
-        break;
-
     case _Ev::TakeOverSession:
         delete ev.un.session;
         break;
@@ -208,6 +238,11 @@ void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
         delete ev.un.protocolStackCtrlInfo.ctrlData;
         break;
 
+    case _Ev::Multicast:
+        if (ev.un.multicastInfo.block)
+            ev.un.multicastInfo.block->Release();
+        break;
+
     default:
         break;
     }
@@ -218,7 +253,7 @@ void LLBC_PollerEvUtil::DestroyEv(LLBC_MessageBlock *block)
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     This::DestroyEv(ev);
 
-    LLBC_Recycle(block);
+    LLBC_EvBlockAllocator::Release(block);
 }
 
 __LLBC_NS_END
@@ -55,6 +55,7 @@ __LLBC_NS_BEGIN
 LLBC_PollerMgr::LLBC_PollerMgr()
 : _type(LLBC_PollerType::End)
 , _svc(nullptr)
+, _evBlockAllocator(nullptr)
 , _maxSessionId(1)
 
 , _inited(false)
@@ -75,6 +76,7 @@ void LLBC_PollerMgr::SetPollerType(int type)
 void LLBC_PollerMgr::SetService(LLBC_Service *svc)
 {
     _svc = svc;
+    _evBlockAllocator = &_svc->GetEvBlockAllocator();
 }
 
 int LLBC_PollerMgr::Init(int pollerCount)
@@ -157,7 +159,8 @@ int LLBC_PollerMgr::Start()
          _pollers[pendingAddSockItem.first % _pollers.size()]->Push(
              LLBC_PollerEvUtil::BuildAddSockEv(pendingAddSockItem.second.first, 
                                                     pendingAddSockItem.first,
-                                                    pendingAddSockItem.second.second));
+                                                    pendingAddSockItem.second.second,
+                                                    _evBlockAllocator));
     _pendingAddSocks.clear();
 
     // Process Async-connections.
@@ -166,7 +169,8 @@ int LLBC_PollerMgr::Start()
         _pollers[pendingAsyncConnItem.first % _pollers.size()]->Push(
             LLBC_PollerEvUtil::BuildAsyncConnEv(pendingAsyncConnItem.first,
                                                      pendingAsyncConnItem.second.second,
-                                                     pendingAsyncConnItem.second.first));
+                                                     pendingAsyncConnItem.second.first,
+                                                     _evBlockAllocator));
     }
     _pendingAsyncConns.clear();
 
@@ -224,7 +228,7 @@ int LLBC_PollerMgr::Listen(const char *ip, uint16 port, LLBC_IProtocolFactory *p
     // Add to poller or pending.
     if (LIKELY(_started))
         _pollers[sessionId % _pollers.size()]->Push(
-                LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts));
+                LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts, _evBlockAllocator));
     else
         _pendingAddSocks.insert(std::make_pair(sessionId, std::make_pair(sock, sessionOpts)));
 
@@ -266,7 +270,7 @@ int LLBC_PollerMgr::Connect(const char *ip,
     // Add to poller or pending.
     if (LIKELY(_started))
         _pollers[sessionId % _pollers.size()]->Push(
-            LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts));
+            LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts, _evBlockAllocator));
     else
         _pendingAddSocks.insert(
             std::make_pair(sessionId, std::make_pair(sock, sessionOpts)));
@@ -293,7 +297,7 @@ int LLBC_PollerMgr::AsyncConn(const char *ip,
 
     if (LIKELY(_started))
         _pollers[sessionId % _pollers.size()]->Push(
-            LLBC_PollerEvUtil::BuildAsyncConnEv(sessionId, sessionOpts, peer));
+            LLBC_PollerEvUtil::BuildAsyncConnEv(sessionId, sessionOpts, peer, _evBlockAllocator));
     else
         _pendingAsyncConns.insert(
             std::make_pair(sessionId, std::make_pair(peer, sessionOpts)));
@@ -306,14 +310,45 @@ int LLBC_PollerMgr::AsyncConn(const char *ip,
 int LLBC_PollerMgr::Send(LLBC_Packet *packet)
 {
     _pollers[packet->GetSessionId() % 
-        _pollers.size()]->Push(LLBC_PollerEvUtil::BuildSendEv(packet));
+        _pollers.size()]->Push(LLBC_PollerEvUtil::BuildSendEv(packet, _evBlockAllocator));
+    return LLBC_OK;
+}
+
+int LLBC_PollerMgr::Multicast(LLBC_SharedMessageBlock *block, const LLBC_SessionIds &sessionIds)
+{
+    // Group sessionIds by poller.
+    const size_t pollerCount = _pollers.size();
+    thread_local std::vector<LLBC_SessionIds> pollerSessionIds;
+    if (pollerSessionIds.size() < pollerCount)
+        pollerSessionIds.resize(pollerCount);
+
+    const auto sessionIdsEndIt = sessionIds.end();
+    for (auto sessionIt = sessionIds.begin();
+         sessionIt != sessionIdsEndIt;
+         ++sessionIt)
+        pollerSessionIds[*sessionIt % pollerCount].push_back(*sessionIt);
+
+    // Post one multicast event to each poller, event hold one reference of shared block.
+    for (size_t i = 0; i < pollerCount; ++i)
+    {
+        LLBC_SessionIds &ids = pollerSessionIds[i];
+        if (ids.empty())
+            continue;
+
+        block->Retain();
+        _pollers[i]->Push(LLBC_PollerEvUtil::BuildMulticastEv(
+            block, ids.data(), static_cast<int>(ids.size()), _evBlockAllocator));
+
+        ids.clear();
+    }
+
     return LLBC_OK;
 }
 
 void LLBC_PollerMgr::Close(int sessionId, const char *reason)
 {
     _pollers[sessionId % _pollers.size()]->Push(
-        LLBC_PollerEvUtil::BuildCloseEv(sessionId, reason));
+        LLBC_PollerEvUtil::BuildCloseEv(sessionId, reason, _evBlockAllocator));
 }
 
 void LLBC_PollerMgr::CtrlProtocolStack(int sessionId,
@@ -321,7 +356,7 @@ void LLBC_PollerMgr::CtrlProtocolStack(int sessionId,
                                        const LLBC_Variant &ctrlData)
 {
     _pollers[sessionId % _pollers.size()]->Push(
-        LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(sessionId, ctrlCmd, ctrlData));
+        LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(sessionId, ctrlCmd, ctrlData, _evBlockAllocator));
 }
 
 int LLBC_PollerMgr::AllocSessionId()
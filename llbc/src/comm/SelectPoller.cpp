@@ -195,7 +195,7 @@ void LLBC_SelectPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
     if (socket->Connect(ev.peerAddr) == LLBC_OK)
     {
         _svc->Push(LLBC_SvcEvUtil::
-                BuildAsyncConnResultEv(ev.sessionId, true, "Success", ev.peerAddr));
+                BuildAsyncConnResultEv(ev.sessionId, true, "Success", ev.peerAddr, _evBlockAllocator));
 
         SetConnectedSocketOpts(socket, *ev.sessionOpts);
         AddSession(CreateSession(socket, ev.sessionId, *ev.sessionOpts, nullptr));
@@ -224,7 +224,7 @@ void LLBC_SelectPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
         LLBC_XDelete(ev.sessionOpts);
 
         _svc->Push(LLBC_SvcEvUtil::
-                BuildAsyncConnResultEv(ev.sessionId, false, LLBC_FormatLastError(), ev.peerAddr));
+                BuildAsyncConnResultEv(ev.sessionId, false, LLBC_FormatLastError(), ev.peerAddr, _evBlockAllocator));
     }
 }
 
@@ -370,7 +370,11 @@ int LLBC_SelectPoller::HandleConnecting(LLBC_FdSet &writes, LLBC_FdSet &excepts)
         }
 
         // Build async connect event and push it to service.
-        _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(asyncInfo.sessionId, connected, reason, asyncInfo.peerAddr));
+        _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(asyncInfo.sessionId,
+                                                          connected,
+                                                          reason,
+                                                          asyncInfo.peerAddr,
+                                                          _evBlockAllocator));
 
         if (connected)
         {
@@ -30,10 +30,11 @@
 namespace
 {
     template <typename Ev>
-    static inline LLBC_NS LLBC_MessageBlock *__CreateEvBlock(Ev *&ev)
+    static inline LLBC_NS LLBC_MessageBlock *__CreateEvBlock(Ev *&ev, LLBC_NS LLBC_EvBlockAllocator *allocator)
     {
-        ev = new Ev;
-        auto block = new LLBC_NS LLBC_MessageBlock(ev, sizeof(Ev));
+        auto block = LLBC_NS LLBC_EvBlockAllocator::Acquire(allocator, sizeof(Ev));
+        ev = new (block->GetData()) Ev;
+        block->SetWritePos(sizeof(Ev));
 
         return block;
     }
@@ -41,15 +42,65 @@ namespace
 
 __LLBC_NS_BEGIN
 
+LLBC_EvBlockAllocator::LLBC_EvBlockAllocator(LLBC_ObjPool &objPool, LLBC_ObjPool &sliceObjPool)
+: _blockPool(objPool.GetTypedObjPool<LLBC_MessageBlock>())
+, _sliceBlockPool(sliceObjPool.GetTypedObjPool<LLBC_MessageBlock>())
+, _acquiredCount(0)
+, _heapAllocCount(0)
+{
+}
+
+LLBC_MessageBlock *LLBC_EvBlockAllocator::Acquire(LLBC_EvBlockAllocator *allocator, size_t size)
+{
+    #if LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+    if (LIKELY(allocator))
+    {
+        (void)LLBC_AtomicFetchAndAdd(&allocator->_acquiredCount, 1);
+
+        // Pooled block buffer only grow(at least double, variable size events will converge quickly),
+        // after warm up, acquire will not trigger heap allocation.
+        LLBC_MessageBlock *block = allocator->_blockPool->Acquire();
+        if (UNLIKELY(block->GetSize() < size))
+        {
+            block->Resize(MAX(size, block->GetSize() * 2));
+            (void)LLBC_AtomicFetchAndAdd(&allocator->_heapAllocCount, 1);
+        }
+
+        return block;
+    }
+    #endif // LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+
+    if (allocator)
+    {
+        (void)LLBC_AtomicFetchAndAdd(&allocator->_acquiredCount, 1);
+        (void)LLBC_AtomicFetchAndAdd(&allocator->_heapAllocCount, 1);
+    }
+
+    return new LLBC_MessageBlock(size);
+}
+
+void LLBC_EvBlockAllocator::Release(LLBC_MessageBlock *block)
+{
+    #if LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+    // Don't keep big event block buffer in pool, next acquire will reallocate it on demand.
+    if (UNLIKELY(block->GetSize() > LLBC_CFG_COMM_POOLED_EVENT_BLOCK_MAX_KEEP_SIZE) &&
+        block->GetTypedObjPool())
+        block->Release();
+    #endif // LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+
+    LLBC_Recycle(block);
+}
+
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionCreateEv(const LLBC_SockAddr_IN &local,
                                                         const LLBC_SockAddr_IN &peer,
                                                         bool isListen,
                                                         int sessionId,
                                                         int acceptSessionId,
-                                                        LLBC_SocketHandle handle)
+                                                        LLBC_SocketHandle handle,
+                                                        LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_SessionCreate *ev;
-    auto evBlock = __CreateEvBlock(ev);
+    auto evBlock = __CreateEvBlock(ev, allocator);
     ev->isListen = isListen;
     ev->sessionId = sessionId;
     ev->acceptSessionId = acceptSessionId;
@@ -66,10 +117,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionDestroyEv(const LLBC_SockAddr_IN
                                                          int sessionId,
                                                          int acceptSessionId,
                                                          LLBC_SocketHandle handle,
-                                                         LLBC_SessionCloseInfo *closeInfo)
+                                                         LLBC_SessionCloseInfo *closeInfo,
+                                                         LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_SessionDestroy *ev;
-    auto evBlock = __CreateEvBlock(ev);
+    auto evBlock = __CreateEvBlock(ev, allocator);
     ev->local = local;
     ev->peer = peer;
     ev->sessionId = sessionId;
@@ -85,10 +137,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionDestroyEv(const LLBC_SockAddr_IN
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAsyncConnResultEv(int sessionId,
                                                           bool connected,
                                                           const LLBC_String &reason,
-                                                          const LLBC_SockAddr_IN &peer)
+                                                          const LLBC_SockAddr_IN &peer,
+                                                          LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_AsyncConn *ev;
-    auto evBlock = __CreateEvBlock(ev);
+    auto evBlock = __CreateEvBlock(ev, allocator);
     ev->sessionId = sessionId;
     ev->connected = connected;
     ev->reason.append(reason);
@@ -97,11 +150,20 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAsyncConnResultEv(int sessionId,
     return evBlock;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildDataArrivalEv(LLBC_Packet *packet)
+LLBC_MessageBlock *LLBC_SvcEvUtil::BuildDataArrivalEv(LLBC_Packet * const *packets,
+                                                      size_t packetCount,
+                                                      LLBC_EvBlockAllocator *allocator)
 {
-    LLBC_SvcEv_DataArrival *ev;
-    auto evBlock = __CreateEvBlock(ev);
-    ev->packet = packet;
+    // Packet pointers store after event structure.
+    typedef LLBC_SvcEv_DataArrival _Ev;
+    const size_t evSize = sizeof(_Ev) + sizeof(LLBC_Packet *) * packetCount;
+    auto evBlock = LLBC_EvBlockAllocator::Acquire(allocator, evSize);
+    _Ev *ev = new (evBlock->GetData()) _Ev;
+    ev->packets = reinterpret_cast<LLBC_Packet **>(reinterpret_cast<char *>(evBlock->GetData()) + sizeof(_Ev));
+    ev->packetCount = packetCount;
+    memcpy(ev->packets, packets, sizeof(LLBC_Packet *) * packetCount);
+
+    evBlock->SetWritePos(evSize);
 
     return evBlock;
 }
@@ -110,10 +172,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildProtoReportEv(int sessionId,
                                                       int opcode,
                                                       int layer,
                                                       int level,
-                                                      const LLBC_String &report)
+                                                      const LLBC_String &report,
+                                                      LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_ProtoReport *ev;
-    auto evBlock = __CreateEvBlock(ev);
+    auto evBlock = __CreateEvBlock(ev, allocator);
     ev->sessionId = sessionId;
     ev->opcode = opcode;
     ev->layer = layer;
@@ -126,10 +189,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildProtoReportEv(int sessionId,
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSubscribeEventEv(int id,
                                                          const LLBC_ListenerStub &stub,
                                                          const LLBC_Delegate<void(LLBC_Event &)> &deleg,
-                                                         LLBC_EventListener *listener)
+                                                         LLBC_EventListener *listener,
+                                                         LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_SubscribeEv *ev;
-    auto evBlock = __CreateEvBlock(ev);
+    auto evBlock = __CreateEvBlock(ev, allocator);
     ev->id = id;
     ev->stub = stub;
     if (deleg)
@@ -140,10 +204,12 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSubscribeEventEv(int id,
     return evBlock;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildUnsubscribeEventEv(int id, const LLBC_ListenerStub &stub)
+LLBC_MessageBlock *LLBC_SvcEvUtil::BuildUnsubscribeEventEv(int id,
+                                                           const LLBC_ListenerStub &stub,
+                                                           LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_UnsubscribeEv *ev;
-    auto evBlock = __CreateEvBlock(ev);
+    auto evBlock = __CreateEvBlock(ev, allocator);
     ev->id = id;
     ev->stub = stub;
 
@@ -151,10 +217,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildUnsubscribeEventEv(int id, const LLBC_Li
 }
 
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildFireEventEv(LLBC_Event *ev,
-                                                    const LLBC_Delegate<void(LLBC_Event *)> &dequeueHandler)
+                                                    const LLBC_Delegate<void(LLBC_Event *)> &dequeueHandler,
+                                                    LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_FireEv *wrapEv;
-    auto evBlock = __CreateEvBlock(wrapEv);
+    auto evBlock = __CreateEvBlock(wrapEv, allocator);
     wrapEv->ev = ev;
     if (dequeueHandler)
         wrapEv->dequeueHandler = dequeueHandler;
@@ -167,10 +234,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAppPhaseEv(bool willStart,
                                                    bool startFinished,
                                                    bool willStop,
                                                    int cfgType,
-                                                   const LLBC_Variant &cfg)
+                                                   const std::shared_ptr<const LLBC_Variant> &cfg,
+                                                   LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_AppPhaseEv *wrapEv;
-    auto evBlock = __CreateEvBlock(wrapEv);
+    auto evBlock = __CreateEvBlock(wrapEv, allocator);
     wrapEv->willStart = willStart;
     wrapEv->startFailed = startFailed;
     wrapEv->startFinished = startFinished;
@@ -183,10 +251,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAppPhaseEv(bool willStart,
 }
 
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAppReloadedEv(int cfgType,
-                                                      const LLBC_Variant &cfg)
+                                                      const std::shared_ptr<const LLBC_Variant> &cfg,
+                                                      LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_AppReloadedEv *wrapEv;
-    auto evBlock = __CreateEvBlock(wrapEv);
+    auto evBlock = __CreateEvBlock(wrapEv, allocator);
     wrapEv->cfgType = cfgType;
     wrapEv->cfg = cfg;
 
@@ -194,10 +263,11 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAppReloadedEv(int cfgType,
 }
 
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildComponentEventEv(int eventType,
-                                                         const LLBC_Variant &eventParams)
+                                                         const LLBC_Variant &eventParams,
+                                                         LLBC_EvBlockAllocator *allocator)
 {
     LLBC_SvcEv_ComponentEventEv *wrapEv;
-    auto evBlock = __CreateEvBlock(wrapEv);
+    auto evBlock = __CreateEvBlock(wrapEv, allocator);
     wrapEv->eventType = eventType;
     wrapEv->eventParams = eventParams;
 
@@ -206,8 +276,8 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildComponentEventEv(int eventType,
 
 void LLBC_SvcEvUtil::DestroyEvBlock(LLBC_MessageBlock *block)
 {
-    delete reinterpret_cast<LLBC_ServiceEvent *>(block->GetData());
-    delete block;
+    reinterpret_cast<LLBC_ServiceEvent *>(block->GetData())->~LLBC_ServiceEvent();
+    LLBC_EvBlockAllocator::Release(block);
 }
 
 __LLBC_NS_END
@@ -115,15 +115,21 @@ LLBC_ServiceImpl::LLBC_ServiceImpl(const LLBC_String &name,
 , _pollerCount(0)
 , _suppressedCoderNotFoundWarning(false)
 , _dftProtocolFactory(dftProtocolFactory)
+, _multicastStack(nullptr)
+, _readySessionInfos(LLBC_CFG_COMM_READY_SESSION_INIT_SLOT_COUNT)
 
 , _fps(LLBC_CFG_COMM_DFT_SERVICE_FPS)
+, _eventWakeup(LLBC_CFG_COMM_DFT_SERVICE_EVENT_WAKEUP != 0)
 , _begSvcTime(0)
 
 // Service extend functions about members.
 , _releasePoolStack(nullptr)
 
+, _sliceBlockObjPool(true)
 , _threadSafeObjPool(true)
 , _threadUnsafeObjPool(false)
+, _lastTrimObjPoolsTime(0)
+, _evBlockAllocator(_threadSafeObjPool, _sliceBlockObjPool)
 
 , _timerScheduler(nullptr)
 {
@@ -143,6 +149,11 @@ LLBC_ServiceImpl::LLBC_ServiceImpl(const LLBC_String &name,
 
     _pollerMgr.SetService(this);
     _pollerMgr.SetPollerType(pollerType);
+
+    // Use lock-free message queue, if enabled.
+    #if LLBC_CFG_COMM_USE_MPSC_MSG_QUEUE
+    SetMessageQueueType(LLBC_MessageQueueType::MPSC);
+    #endif // LLBC_CFG_COMM_USE_MPSC_MSG_QUEUE
 }
 
 LLBC_ServiceImpl::~LLBC_ServiceImpl()
@@ -160,7 +171,14 @@ LLBC_ServiceImpl::~LLBC_ServiceImpl()
     Stop(true);
     DestroyComps(false);
 
+    // Destroy all not-process events(eg: events pushed before service start),
+    // event blocks must be recycled before object pool destroy.
+    LLBC_MessageBlock *block;
+    while (TryPop(block) == LLBC_OK)
+        LLBC_SvcEvUtil::DestroyEvBlock(block);
+
     // Clear members.
+    LLBC_XDelete(_multicastStack);
     LLBC_STLHelper::DeleteContainer(_coderFactories);
     LLBC_STLHelper::DeleteContainer(_sessionProtoFactory);
     LLBC_XDelete(_dftProtocolFactory);
@@ -353,6 +371,15 @@ int LLBC_ServiceImpl::SetFPS(int fps)
     return LLBC_OK;
 }
 
+int LLBC_ServiceImpl::SetEventWakeup(bool eventWakeup)
+{
+    LLBC_LockGuard guard(_lock);
+
+    _eventWakeup = eventWakeup;
+
+    return LLBC_OK;
+}
+
 int LLBC_ServiceImpl::Listen(const char *ip,
                              uint16 port,
                              LLBC_IProtocolFactory *protoFactory,
@@ -417,11 +444,8 @@ bool LLBC_ServiceImpl::IsSessionValidate(int sessionId)
     if (UNLIKELY(sessionId == 0))
         return false;
 
-    _readySessionInfosLock.Lock();
-    const bool valid = _readySessionInfos.find(sessionId) != _readySessionInfos.end();
-    _readySessionInfosLock.Unlock();
-
-    return valid;
+    bool isListenSession;
+    return _readySessionInfos.IsReady(sessionId, isListenSession);
 }
 
 int LLBC_ServiceImpl::Send(LLBC_Packet *packet)
@@ -456,23 +480,8 @@ int LLBC_ServiceImpl::Multicast(const LLBC_SessionIds &sessionIds,
         return LLBC_FAILED;
     }
 
-    // Foreach to call internal method LockableSend() to complete.
-    // lock = false
-    // checkRunningPhase = false
-    // checkSessionValidity = true
-    const auto sessionIdsEndIt = sessionIds.end();
-    for (auto sessionIt = sessionIds.begin();
-         sessionIt != sessionIdsEndIt;
-         ++sessionIt)
-        LockableSend(*sessionIt, // sessionId
-                     opcode, // opcode
-                     bytes, // bytes
-                     len, // len
-                     status, // status
-                     flags, // flags
-                     false, // lock
-                     false, // checkRunningPhase
-                     true); // checkSessionValidity
+    // Call internal method LockedMulticast() to complete.
+    LockedMulticast(sessionIds, opcode, bytes, len, status, flags, true);
 
     return LLBC_OK;
 }
@@ -494,16 +503,13 @@ int LLBC_ServiceImpl::Broadcast(int opcode,
 
     // Get all non-listen sessionIds.
     thread_local LLBC_SessionIds sessionIds;
+    sessionIds.clear();
 
     _readySessionInfosLock.Lock();
-    const auto readySessionInfosEndIt = _readySessionInfos.end();
-    for (auto it = _readySessionInfos.begin();
-         it != readySessionInfosEndIt;
-         ++it)
+    for (const _ReadySessionInfo *readySInfo : _readySessionInfos.GetSessionInfos())
     {
-        const _ReadySessionInfo &readySessionInfo = *it->second;
-        if (!readySessionInfo.isListenSession)
-            sessionIds.push_back(readySessionInfo.sessionId);
+        if (!readySInfo->isListenSession)
+            sessionIds.push_back(readySInfo->sessionId);
     }
     _readySessionInfosLock.Unlock();
 
@@ -511,23 +517,8 @@ int LLBC_ServiceImpl::Broadcast(int opcode,
     if (sessionIds.empty())
         return LLBC_OK;
 
-    // Foreach to call internal method LockableSend() to compolete.
-    // lock = false
-    // checkRunningPhase = false
-    // checkSessionValidity = false
-    const auto sessionIdsEndIt = sessionIds.end();
-    for (auto sessionIt = sessionIds.begin();
-         sessionIt != sessionIdsEndIt;
-         ++sessionIt)
-        LockableSend(*sessionIt, // sessionId
-                     opcode, // opcode
-                     bytes, // bytes
-                     len, // len
-                     status, // status
-                     flags, // flags
-                     false, // lock
-                     false, // checkRunningPhase
-                     false); // checkSessionValidity
+    // Call internal method LockedMulticast() to complete.
+    LockedMulticast(sessionIds, opcode, bytes, len, status, flags, false);
 
     return LLBC_OK;
 }
@@ -538,8 +529,8 @@ int LLBC_ServiceImpl::RemoveSession(int sessionId, const char *reason)
         InitingComps, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
 
     LLBC_LockGuard readySInfosGuard(_readySessionInfosLock);
-    auto readySInfoIt = _readySessionInfos.find(sessionId);
-    if (readySInfoIt == _readySessionInfos.end())
+    _ReadySessionInfo *readySInfo = _readySessionInfos.Erase(sessionId);
+    if (!readySInfo)
     {
         LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
         return LLBC_FAILED;
@@ -547,8 +538,7 @@ int LLBC_ServiceImpl::RemoveSession(int sessionId, const char *reason)
 
     _pollerMgr.Close(sessionId, reason);
 
-    delete readySInfoIt->second;
-    _readySessionInfos.erase(readySInfoIt);
+    delete readySInfo;
 
     return LLBC_OK;
 }
@@ -561,8 +551,8 @@ int LLBC_ServiceImpl::CtrlProtocolStack(int sessionId,
         InitingComps, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
 
     _readySessionInfosLock.Lock();
-    auto readySInfoIt = _readySessionInfos.find(sessionId);
-    if (readySInfoIt == _readySessionInfos.end())
+    const _ReadySessionInfo *readySInfo = _readySessionInfos.Find(sessionId);
+    if (!readySInfo)
     {
         _readySessionInfosLock.Unlock();
         LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
@@ -573,7 +563,6 @@ int LLBC_ServiceImpl::CtrlProtocolStack(int sessionId,
     if (!_fullStack)
     {
         bool removeSession = false;
-        const _ReadySessionInfo * const &readySInfo = readySInfoIt->second;
         if (!readySInfo->codecStack->CtrlStackCodec(ctrlCmd, ctrlData, removeSession))
         {
             _readySessionInfosLock.Unlock();
@@ -782,12 +771,15 @@ int LLBC_ServiceImpl::Subscribe(int opcode, const LLBC_Delegate<void(LLBC_Packet
     __LLBC_INL_CHECK_RUNNING_PHASE_LE(
         InitingComps, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
 
-    if (!_handlers.insert(std::make_pair(opcode, deleg)).second)
+    auto &handlers = GetOrCreatePacketHandlers(opcode);
+    if (handlers.handler)
     {
         LLBC_SetLastError(LLBC_ERROR_REPEAT);
         return LLBC_FAILED;
     }
 
+    handlers.handler = deleg;
+
     return LLBC_OK;
 }
 
@@ -802,12 +794,15 @@ int LLBC_ServiceImpl::PreSubscribe(int opcode, const LLBC_Delegate<bool(LLBC_Pac
     __LLBC_INL_CHECK_RUNNING_PHASE_LE(
         InitingComps, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
 
-    if (!_preHandlers.insert(std::make_pair(opcode, deleg)).second)
+    auto &handlers = GetOrCreatePacketHandlers(opcode);
+    if (handlers.preHandler)
     {
         LLBC_SetLastError(LLBC_ERROR_REPEAT);
         return LLBC_FAILED;
     }
 
+    handlers.preHandler = deleg;
+
     return LLBC_OK;
 }
 
@@ -847,7 +842,7 @@ int LLBC_ServiceImpl::SubscribeStatus(int opcode, int status, const LLBC_Delegat
     __LLBC_INL_CHECK_RUNNING_PHASE_LE(
         InitingComps, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
 
-    auto &stHandlers = _statusHandlers[opcode];
+    auto &stHandlers = GetOrCreatePacketHandlers(opcode).statusHandlers;
     if (!stHandlers.insert(std::make_pair(status, deleg)).second)
     {
         LLBC_SetLastError(LLBC_ERROR_REPEAT);
@@ -896,7 +891,11 @@ LLBC_ListenerStub LLBC_ServiceImpl::SubscribeEvent(int event, const LLBC_Delegat
         return 0;
     }
 
-    Push(LLBC_SvcEvUtil::BuildSubscribeEventEv(event, ++_evManagerMaxListenerStub, deleg, nullptr));
+    Push(LLBC_SvcEvUtil::BuildSubscribeEventEv(event,
+                                               ++_evManagerMaxListenerStub,
+                                               deleg,
+                                               nullptr,
+                                               &_evBlockAllocator));
 
     return _evManagerMaxListenerStub;
 }
@@ -909,7 +908,11 @@ LLBC_ListenerStub LLBC_ServiceImpl::SubscribeEvent(int event, LLBC_EventListener
         return 0;
     }
 
-    Push(LLBC_SvcEvUtil::BuildSubscribeEventEv(event, ++_evManagerMaxListenerStub, nullptr, listener));
+    Push(LLBC_SvcEvUtil::BuildSubscribeEventEv(event,
+                                               ++_evManagerMaxListenerStub,
+                                               nullptr,
+                                               listener,
+                                               &_evBlockAllocator));
 
     return _evManagerMaxListenerStub;
 }
@@ -917,20 +920,20 @@ LLBC_ListenerStub LLBC_ServiceImpl::SubscribeEvent(int event, LLBC_EventListener
 void LLBC_ServiceImpl::UnsubscribeEvent(int event)
 {
     Push(LLBC_SvcEvUtil::
-        BuildUnsubscribeEventEv(event, 0));
+        BuildUnsubscribeEventEv(event, 0, &_evBlockAllocator));
 }
 
 void LLBC_ServiceImpl::UnsubscribeEvent(const LLBC_ListenerStub &stub)
 {
     Push(LLBC_SvcEvUtil::
-        BuildUnsubscribeEventEv(0, stub));
+        BuildUnsubscribeEventEv(0, stub, &_evBlockAllocator));
 }
 
 void LLBC_ServiceImpl::FireEvent(LLBC_Event *ev,
                                  const LLBC_Delegate<void(LLBC_Event *)> &enqueueHandler,
                                  const LLBC_Delegate<void(LLBC_Event *)> &dequeueHandler)
 {
-    Push(LLBC_SvcEvUtil::BuildFireEventEv(ev, dequeueHandler));
+    Push(LLBC_SvcEvUtil::BuildFireEventEv(ev, dequeueHandler, &_evBlockAllocator));
     if (enqueueHandler)
         enqueueHandler(ev);
 }
@@ -952,7 +955,7 @@ int LLBC_ServiceImpl::AddComponentEvent(int eventType, const LLBC_Variant &event
         return LLBC_FAILED;
     }
 
-    return Push(LLBC_SvcEvUtil::BuildComponentEventEv(eventType, eventParams));
+    return Push(LLBC_SvcEvUtil::BuildComponentEventEv(eventType, eventParams, &_evBlockAllocator));
 }
 
 int LLBC_ServiceImpl::Post(const LLBC_Delegate<void(LLBC_Service *)> &runnable)
@@ -981,9 +984,8 @@ const LLBC_ProtocolStack *LLBC_ServiceImpl::GetCodecProtocolStack(int sessionId)
 
     // Not enabled full-stack option, return session codec protocol-stack.
     _readySessionInfosLock.Lock();
-    auto it = _readySessionInfos.find(sessionId);
-    const LLBC_ProtocolStack *codecStack =
-        it != _readySessionInfos.end() ? it->second->codecStack : nullptr;
+    const _ReadySessionInfo *readySInfo = _readySessionInfos.Find(sessionId);
+    const LLBC_ProtocolStack *codecStack = readySInfo ? readySInfo->codecStack : nullptr;
     _readySessionInfosLock.Unlock();
 
     if (!codecStack)
@@ -1023,6 +1025,14 @@ void LLBC_ServiceImpl::OnSvc(bool fullFrame)
     // Process queued events.
     HandleQueuedEvents();
 
+    // Reclaim retired ready session slots(service loop is the quiescent point of ready session table).
+    if (UNLIKELY(_readySessionInfos.HasRetiredSlots()))
+    {
+        _readySessionInfosLock.Lock();
+        _readySessionInfos.ReclaimRetiredSlots();
+        _readySessionInfosLock.Unlock();
+    }
+
     // Update all components.
     UpdateComps();
     LateUpdateComps();
@@ -1036,12 +1046,24 @@ void LLBC_ServiceImpl::OnSvc(bool fullFrame)
     if (fullFrame)
         ProcessIdle();
 
+    // Trim object pools.
+    #if LLBC_CFG_COMM_OBJPOOL_TRIM_INTERVAL > 0
+    if (fullFrame)
+        TrimObjPools();
+    #endif // LLBC_CFG_COMM_OBJPOOL_TRIM_INTERVAL > 0
+
     // Sleep FrameInterval - ElapsedTime milli-seconds, if need.
+    // If is event wakeup, wait and handle queued events until frame end.
     if (fullFrame)
     {
         const sint64 elapsed = LLBC_GetMilliseconds() - _begSvcTime;
         if (elapsed >= 0 && elapsed < frameInterval)
-            LLBC_Sleep(static_cast<int>(frameInterval - elapsed));
+        {
+            if (_eventWakeup && _runningPhase == LLBC_ServiceRunningPhase::Started)
+                WaitQueuedEvents(_begSvcTime + frameInterval);
+            else
+                LLBC_Sleep(static_cast<int>(frameInterval - elapsed));
+        }
     }
 
     // If in stopping phases(StoppingComp/Stopping) and is ExternalDrive mode, Exec cleanup.
@@ -1178,8 +1200,7 @@ void LLBC_ServiceImpl::AddReadySession(int sessionId,
     if (repeatCheck)
     {
         _readySessionInfosLock.Lock();
-        const auto readySInfoIt = _readySessionInfos.find(sessionId);
-        if (readySInfoIt != _readySessionInfos.end())
+        if (_readySessionInfos.Find(sessionId))
         {
             _readySessionInfosLock.Unlock();
             return;
@@ -1189,8 +1210,11 @@ void LLBC_ServiceImpl::AddReadySession(int sessionId,
                                                               0,
                                                               isListenSession,
                                                               _fullStack ? nullptr : CreateCodecStack(sessionId, acceptSessionId, nullptr));
-        _readySessionInfos.insert(std::make_pair(sessionId, readySInfo));
+        const int ret = _readySessionInfos.Insert(readySInfo);
         _readySessionInfosLock.Unlock();
+
+        if (UNLIKELY(ret != LLBC_OK))
+            delete readySInfo;
     }
     else
     {
@@ -1199,8 +1223,11 @@ void LLBC_ServiceImpl::AddReadySession(int sessionId,
                                                               isListenSession,
                                                               _fullStack ? nullptr : CreateCodecStack(sessionId, acceptSessionId, nullptr));
         _readySessionInfosLock.Lock();
-        _readySessionInfos.insert(std::make_pair(sessionId, readySInfo));
+        const int ret = _readySessionInfos.Insert(readySInfo);
         _readySessionInfosLock.Unlock();
+
+        if (UNLIKELY(ret != LLBC_OK))
+            delete readySInfo;
     }
 }
 
@@ -1209,18 +1236,14 @@ void LLBC_ServiceImpl::RemoveReadySession(int sessionId)
     // Lock.
     _readySessionInfosLock.Lock();
 
-    // Find ready session info, if not found, return.
-    auto readySInfoIt = _readySessionInfos.find(sessionId);
-    if (readySInfoIt == _readySessionInfos.end())
+    // Erase ready session info, if not found, return.
+    _ReadySessionInfo *readySInfo = _readySessionInfos.Erase(sessionId);
+    if (!readySInfo)
     {
         _readySessionInfosLock.Unlock();
         return;
     }
 
-    // Erase from dict.
-    _ReadySessionInfo *readySInfo = readySInfoIt->second;
-    _readySessionInfos.erase(readySInfoIt);
-
     // Unlock.
     _readySessionInfosLock.Unlock();
 
@@ -1231,7 +1254,10 @@ void LLBC_ServiceImpl::RemoveReadySession(int sessionId)
 void LLBC_ServiceImpl::RemoveAllReadySessions()
 {
     _readySessionInfosLock.Lock();
-    LLBC_STLHelper::DeleteContainer(_readySessionInfos);
+    for (_ReadySessionInfo *readySInfo : _readySessionInfos.GetSessionInfos())
+        delete readySInfo;
+
+    _readySessionInfos.Clear();
     _readySessionInfosLock.Unlock();
 }
 
@@ -1355,7 +1381,7 @@ void LLBC_ServiceImpl::UpdateServiceCfg(int appCfgType, const LLBC_Variant &appC
 
     // After config update, read recognizable service config.
     // - Update service fps:
-    for (auto cfgItem : _cfg.AsDict())
+    for (auto &cfgItem : _cfg.AsDict())
     {
         if (cfgItem.first.AsStr().tolower() == "fps")
         {
@@ -1461,7 +1487,7 @@ int LLBC_ServiceImpl::PreStart()
     if (app)
     {
         app->PreventReload();
-        UpdateServiceCfg(app->GetConfigType(), app->GetConfigUnsafe());
+        UpdateServiceCfg(app->GetConfigType(), *app->GetConfigSnapshot());
         app->CancelPreventReload();
     }
 
@@ -1534,9 +1560,17 @@ LLBC_FORCE_INLINE void LLBC_ServiceImpl::HandlePosts()
         (*it)(this);
 }
 
+LLBC_FORCE_INLINE void LLBC_ServiceImpl::HandleQueuedEvent(LLBC_MessageBlock *block)
+{
+    LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+    (this->*_evHandlers[ev->type])(*ev);
+
+    ev->~LLBC_ServiceEvent();
+    LLBC_EvBlockAllocator::Release(block);
+}
+
 void LLBC_ServiceImpl::HandleQueuedEvents()
 {
-    LLBC_ServiceEvent *ev;
     LLBC_MessageBlock *block, *blocks;
     if (PopAll(blocks) == LLBC_OK)
     {
@@ -1545,11 +1579,39 @@ void LLBC_ServiceImpl::HandleQueuedEvents()
             block = blocks;
             blocks = blocks->GetNext();
 
-            ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
-            (this->*_evHandlers[ev->type])(*ev);
+            HandleQueuedEvent(block);
+        }
+    }
+}
+
+void LLBC_ServiceImpl::WaitQueuedEvents(sint64 frameEndTime)
+{
+    LLBC_MessageBlock *block;
+    while (LIKELY(_runningPhase == LLBC_ServiceRunningPhase::Started))
+    {
+        // Calculate wait deadline, deadline is the earlier one of frame end time and next timer timeout time.
+        const sint64 now = LLBC_GetMilliseconds();
+        if (now >= frameEndTime)
+            break;
+
+        sint64 deadline = frameEndTime;
+        const sint64 nextTimeoutTime = _timerScheduler->GetNextTimeoutTime();
+        if (nextTimeoutTime >= 0 && nextTimeoutTime < deadline)
+            deadline = nextTimeoutTime;
 
-            delete ev;
-            delete block;
+        // Timers due, update timer scheduler.
+        if (now >= deadline)
+        {
+            UpdateTimerScheduler();
+            continue;
+        }
+
+        // Wait queued event, once event arrived, handle all queued events immediately.
+        if (TimedPop(block, static_cast<int>(deadline - now)) == LLBC_OK)
+        {
+            HandleQueuedEvent(block);
+            HandleQueuedEvents();
+            HandlePosts();
         }
     }
 }
@@ -1647,65 +1709,90 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
 {
     typedef LLBC_SvcEv_DataArrival _Ev;
     _Ev &ev = static_cast<_Ev &>(_);
-    LLBC_Packet *packet = ev.packet;
+    if (UNLIKELY(ev.packetCount == 0))
+        return;
 
-    // Makesure session in connected sessionId set.
-    const int sessionId = packet->GetSessionId();
+    // Makesure session in connected sessionId set(all packets belong to same session).
+    const int sessionId = ev.packets[0]->GetSessionId();
 
-    _readySessionInfosLock.Lock();
-    auto readySInfoIt = _readySessionInfos.find(sessionId);
-    if (readySInfoIt == _readySessionInfos.end())
+    // If full stack, only check session is ready(lock-free).
+    size_t packetCount = ev.packetCount;
+    bool removeSession = false;
+    if (_fullStack)
     {
-        _readySessionInfosLock.Unlock();
-        return;
+        bool isListenSession;
+        if (!_readySessionInfos.IsReady(sessionId, isListenSession))
+            return;
     }
-
-    ev.packet = nullptr;
-
-    if (!_fullStack)
+    else // If not full stack, decode all packets in one lock round-trip.
     {
-        bool removeSession;
-        const _ReadySessionInfo * const &readySInfo = readySInfoIt->second;
-        if (UNLIKELY(readySInfo->codecStack->RecvCodec(packet, packet, removeSession) != LLBC_OK))
+        _readySessionInfosLock.Lock();
+        const _ReadySessionInfo *readySInfo = _readySessionInfos.Find(sessionId);
+        if (!readySInfo)
         {
             _readySessionInfosLock.Unlock();
-            if (removeSession)
-                RemoveSession(sessionId);
-
             return;
         }
+
+        for (size_t i = 0; i < packetCount; ++i)
+        {
+            LLBC_Packet *&packet = ev.packets[i];
+            if (UNLIKELY(readySInfo->codecStack->RecvCodec(packet, packet, removeSession) != LLBC_OK))
+            {
+                // Decode failed packet has been taken by codec stack, only drop this packet.
+                // If codec stack require remove session, remaining packets recycle by event.
+                packet = nullptr;
+                if (removeSession)
+                {
+                    packetCount = i;
+                    break;
+                }
+            }
+        }
+
+        _readySessionInfosLock.Unlock();
     }
 
-    _readySessionInfosLock.Unlock();
+    // Handle all decoded packets(skip decode failed packets).
+    for (size_t i = 0; i < packetCount; ++i)
+    {
+        LLBC_Packet *packet = ev.packets[i];
+        if (UNLIKELY(!packet))
+            continue;
+
+        ev.packets[i] = nullptr;
+        HandleArrivedPacket(packet);
+    }
+
+    if (removeSession)
+        RemoveSession(sessionId);
+}
+
+void LLBC_ServiceImpl::HandleArrivedPacket(LLBC_Packet *packet)
+{
+    // Find opcode's packet handlers(pre-handler, handler and status handlers).
+    _PacketHandlers *handlers = FindPacketHandlers(packet->GetOpcode());
 
-    const int opcode = packet->GetOpcode();
     #if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
     const int status = packet->GetStatus();
-    if (status != 0)
+    if (status != 0 && handlers)
     {
-        # if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
-        auto stHandlersIt = _statusHandlers.find(opcode);
-        if (stHandlersIt != _statusHandlers.end())
+        auto &stHandlers = handlers->statusHandlers;
+        auto stHandlerIt = stHandlers.find(status);
+        if (stHandlerIt != stHandlers.end())
         {
-            auto &stHandlers = stHandlersIt->second;
-            auto stHandlerIt = stHandlers.find(status);
-            if (stHandlerIt != stHandlers.end())
-            {
-                stHandlerIt->second(*packet);
-                LLBC_Recycle(packet);
-                return;
-            }
+            stHandlerIt->second(*packet);
+            LLBC_Recycle(packet);
+            return;
         }
-        # endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
     }
     #endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
 
     // Firstly, we recognize specified opcode's pre-handler, if registered, call it.
     bool preHandled = false;
-    auto preIt = _preHandlers.find(opcode);
-    if (preIt != _preHandlers.end())
+    if (handlers && handlers->preHandler)
     {
-        if (!preIt->second(*packet))
+        if (!handlers->preHandler(*packet))
         {
             LLBC_Recycle(packet);
             return;
@@ -1727,10 +1814,9 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
 
     // Finally, search packet handler to handle,
     // if not found any packet handler, dispatch unhandled-packet event to all comps.
-    auto it = _handlers.find(opcode);
-    if (it != _handlers.end())
+    if (handlers && handlers->handler)
     {
-        it->second(*packet);
+        handlers->handler(*packet);
     }
     else
     {
@@ -1746,6 +1832,20 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
     LLBC_Recycle(packet);
 }
 
+LLBC_ServiceImpl::_PacketHandlers &LLBC_ServiceImpl::GetOrCreatePacketHandlers(int opcode)
+{
+    auto &handlers = _packetHandlers[opcode];
+    if (opcode >= 0 && opcode < LLBC_CFG_COMM_PACKET_HANDLERS_DIRECT_INDEX_LIMIT)
+    {
+        // Grow direct-indexed table on demand(only grow to max subscribed opcode).
+        if (static_cast<size_t>(opcode) >= _directIndexedPacketHandlers.size())
+            _directIndexedPacketHandlers.resize(opcode + 1, nullptr);
+        _directIndexedPacketHandlers[opcode] = &handlers;
+    }
+
+    return handlers;
+}
+
 void LLBC_ServiceImpl::HandleEv_ProtoReport(LLBC_ServiceEvent &_)
 {
     typedef LLBC_SvcEv_ProtoReport _Ev;
@@ -1834,8 +1934,8 @@ void LLBC_ServiceImpl::HandleEv_AppPhaseEv(LLBC_ServiceEvent &_)
     }
     else if (ev.startFinished)
     {
-        if (_cfgType == LLBC_AppConfigType::End)
-            UpdateServiceCfg(ev.cfgType, ev.cfg);
+        if (_cfgType == LLBC_AppConfigType::End && ev.cfg)
+            UpdateServiceCfg(ev.cfgType, *ev.cfg);
 
         for(auto &comp : _compList)
         {
@@ -1857,7 +1957,7 @@ void LLBC_ServiceImpl::HandleEv_AppReloaded(LLBC_ServiceEvent &_)
 {
     // Update service config.
     auto &ev = static_cast<LLBC_SvcEv_AppReloadedEv &>(_);
-    UpdateServiceCfg(ev.cfgType, ev.cfg);
+    UpdateServiceCfg(ev.cfgType, *ev.cfg);
 
     // Update all components config.
     for (auto &compItem : _name2Comps)
@@ -2231,6 +2331,26 @@ void LLBC_ServiceImpl::ProcessIdle()
     }
 }
 
+void LLBC_ServiceImpl::TrimObjPools()
+{
+    const sint64 now = LLBC_GetMilliseconds();
+    if (now - _lastTrimObjPoolsTime < LLBC_CFG_COMM_OBJPOOL_TRIM_INTERVAL)
+        return;
+
+    _lastTrimObjPoolsTime = now;
+
+    // Trim service object pools.
+    _sliceBlockObjPool.Trim();
+    _threadSafeObjPool.Trim();
+    _threadUnsafeObjPool.Trim();
+
+    // Trim current thread object pools.
+    if (LLBC_ObjPool *safeObjPool = LLBC_ThreadSpecObjPool::GetSafeObjPool())
+        safeObjPool->Trim();
+    if (LLBC_ObjPool *unsafeObjPool = LLBC_ThreadSpecObjPool::GetUnsafeObjPool())
+        unsafeObjPool->Trim();
+}
+
 LLBC_FORCE_INLINE int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
                                                      bool lock,
                                                      bool checkRunningPhase,
@@ -2261,14 +2381,26 @@ LLBC_FORCE_INLINE int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
     const int sessionId = packet->GetSessionId();
     if (!_fullStack || checkSessionValidity)
     {
-        decltype(_readySessionInfos)::const_iterator readySInfoIt;
-
         // Check _ReadySessionInfo exist or not.
-        _readySessionInfosLock.Lock();
-        if ((readySInfoIt = _readySessionInfos.find(sessionId)) == _readySessionInfos.end())
+        // - full-stack: lock-free check, codec stack not required.
+        // - half-stack: lock ready session infos, codec stack must be used in lock.
+        bool found, isListenSession = false;
+        if (_fullStack)
         {
-            _readySessionInfosLock.Unlock();
+            found = _readySessionInfos.IsReady(sessionId, isListenSession);
+        }
+        else
+        {
+            _readySessionInfosLock.Lock();
+            if ((readySInfo = _readySessionInfos.Find(sessionId)) != nullptr)
+                isListenSession = readySInfo->isListenSession;
+            else
+                _readySessionInfosLock.Unlock();
+            found = readySInfo != nullptr;
+        }
 
+        if (UNLIKELY(!found))
+        {
             if (lock)
                 _lock.Unlock();
 
@@ -2279,10 +2411,10 @@ LLBC_FORCE_INLINE int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
         }
 
         // Listen session check(not allow send packet to listen session).
-        readySInfo = readySInfoIt->second;
-        if (UNLIKELY(readySInfo->isListenSession))
+        if (UNLIKELY(isListenSession))
         {
-            _readySessionInfosLock.Unlock();
+            if (!_fullStack)
+                _readySessionInfosLock.Unlock();
 
             if (lock)
                 _lock.Unlock();
@@ -2292,10 +2424,6 @@ LLBC_FORCE_INLINE int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
 
             return LLBC_FAILED;
         }
-
-        // If enabled full-stack option, unlock _readySessionInfosLock.
-        if (_fullStack)
-            _readySessionInfosLock.Unlock();
     }
 
     // If enabled full-stack option, send packet and return.
@@ -2357,6 +2485,128 @@ LLBC_FORCE_INLINE int LLBC_ServiceImpl::LockableSend(int sessionId,
     return LockableSend(packet, lock, checkRunningPhase, checkSessionValidity);
 }
 
+void LLBC_ServiceImpl::LockedMulticast(const LLBC_SessionIds &sessionIds,
+                                       int opcode,
+                                       const void *bytes,
+                                       size_t len,
+                                       int status,
+                                       uint32 flags,
+                                       bool checkSessionValidity)
+{
+#if LLBC_CFG_COMM_USE_ENCODE_ONCE_MULTICAST
+    // Split sessionIds to shared-encode sessions and per-session-encode sessions.
+    // Only the sessions which use default protocol factory and the factory send logic is stateless
+    // can share the encoded data.
+    thread_local LLBC_SessionIds sharedSessionIds;
+    thread_local LLBC_SessionIds perSessionIds;
+    sharedSessionIds.clear();
+    perSessionIds.clear();
+
+    const bool dftStatelessSend = _dftProtocolFactory->IsStatelessSend();
+
+    _readySessionInfosLock.Lock();
+    _protoLock.Lock();
+    const bool hasSessionProtoFactory = !_sessionProtoFactory.empty();
+
+    const auto sessionIdsEndIt = sessionIds.end();
+    for (auto sessionIt = sessionIds.begin();
+         sessionIt != sessionIdsEndIt;
+         ++sessionIt)
+    {
+        const _ReadySessionInfo *readySInfoPtr = _readySessionInfos.Find(*sessionIt);
+        if (!readySInfoPtr || readySInfoPtr->isListenSession)
+            continue;
+
+        const _ReadySessionInfo &readySInfo = *readySInfoPtr;
+
+        const int protoFactoryKey =
+            readySInfo.acceptSessionId != 0 ? readySInfo.acceptSessionId : readySInfo.sessionId;
+        if (!dftStatelessSend ||
+            (hasSessionProtoFactory &&
+             _sessionProtoFactory.find(protoFactoryKey) != _sessionProtoFactory.end()))
+            perSessionIds.push_back(*sessionIt);
+        else
+            sharedSessionIds.push_back(*sessionIt);
+    }
+
+    _protoLock.Unlock();
+    _readySessionInfosLock.Unlock();
+
+    // Encode packet once, and multicast the encoded data to shared-encode sessions.
+    if (!sharedSessionIds.empty())
+    {
+        if (!_multicastStack)
+            _multicastStack = CreateFullStack(0, 0);
+
+        // Use attached payload, protocol stack will copy it to encoded data.
+        LLBC_Packet *packet = _threadSafeObjPool.Acquire<LLBC_Packet>();
+        packet->SetHeader(0, opcode, status, flags);
+        if (bytes && len > 0)
+        {
+            LLBC_MessageBlock *payload = new LLBC_MessageBlock(const_cast<void *>(bytes), len);
+            payload->SetWritePos(len);
+            packet->SetPayload(payload);
+        }
+
+        bool removeSession;
+        LLBC_MessageBlock *encoded = nullptr;
+        if (_multicastStack->Send(packet, encoded, removeSession) == LLBC_OK && encoded)
+        {
+            // Move encoded data to shared block, if encoded data still reference the payload bytes, copy it.
+            LLBC_SharedMessageBlock *sharedBlock;
+            if (encoded->IsAttach())
+            {
+                sharedBlock = new LLBC_SharedMessageBlock(encoded->GetReadableSize());
+                sharedBlock->GetBlock().Write(encoded->GetDataStartWithReadPos(), encoded->GetReadableSize());
+            }
+            else
+            {
+                sharedBlock = new LLBC_SharedMessageBlock(0);
+                sharedBlock->GetBlock().Swap(encoded);
+            }
+            LLBC_Recycle(encoded);
+
+            _pollerMgr.Multicast(sharedBlock, sharedSessionIds);
+            sharedBlock->Release();
+        }
+    }
+
+    // Foreach to call internal method LockableSend() to complete the per-session-encode sessions.
+    // lock = false
+    // checkRunningPhase = false
+    const auto perSessionIdsEndIt = perSessionIds.end();
+    for (auto sessionIt = perSessionIds.begin();
+         sessionIt != perSessionIdsEndIt;
+         ++sessionIt)
+        LockableSend(*sessionIt, // sessionId
+                     opcode, // opcode
+                     bytes, // bytes
+                     len, // len
+                     status, // status
+                     flags, // flags
+                     false, // lock
+                     false, // checkRunningPhase
+                     checkSessionValidity); // checkSessionValidity
+#else // !LLBC_CFG_COMM_USE_ENCODE_ONCE_MULTICAST
+    // Foreach to call internal method LockableSend() to complete.
+    // lock = false
+    // checkRunningPhase = false
+    const auto sessionIdsEndIt = sessionIds.end();
+    for (auto sessionIt = sessionIds.begin();
+         sessionIt != sessionIdsEndIt;
+         ++sessionIt)
+        LockableSend(*sessionIt, // sessionId
+                     opcode, // opcode
+                     bytes, // bytes
+                     len, // len
+                     status, // status
+                     flags, // flags
+                     false, // lock
+                     false, // checkRunningPhase
+                     checkSessionValidity); // checkSessionValidity
+#endif // LLBC_CFG_COMM_USE_ENCODE_ONCE_MULTICAST
+}
+
 LLBC_ServiceImpl::_ReadySessionInfo::_ReadySessionInfo(int sessionId,
                                                        int acceptSessionId,
                                                        bool isListenSession,
@@ -2365,6 +2615,7 @@ LLBC_ServiceImpl::_ReadySessionInfo::_ReadySessionInfo(int sessionId,
 , acceptSessionId(acceptSessionId)
 , isListenSession(isListenSession)
 , codecStack(codecStack)
+, listIndex(0)
 {
 }
 
@@ -235,7 +235,8 @@ void LLBC_Session::OnClose(LLBC_SessionCloseInfo *closeInfo)
                                                      _id,
                                                      _acceptId,
                                                      sockHandle,
-                                                     closeInfo));
+                                                     closeInfo,
+                                                     &_svc->GetEvBlockAllocator()));
 
     // Let poller remove self.
     _poller->RemoveSession(this);
@@ -260,6 +261,25 @@ bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved)
     else
         recvRet = _protoStack->RecvRaw(block, _recvedPackets, removeSession);
 
+    // Deliver all recved packets to service in one data-arrival event.
+    // Note: If recv failed and need remove session, packets decoded before the failed one still be delivered,
+    //       before session close(same as service decoding in half-stack mode).
+    if (!_recvedPackets.empty())
+    {
+        LLBC_Packet *packet;
+        for (size_t i = 0; i < _recvedPackets.size(); ++i)
+        {
+            packet = _recvedPackets[i];
+            packet->SetSessionId(_id);
+            packet->SetLocalAddr(_socket->GetLocalAddress());
+            packet->SetPeerAddr(_socket->GetPeerAddress());
+        }
+
+        _svc->Push(LLBC_SvcEvUtil::BuildDataArrivalEv(_recvedPackets.data(),
+                                                      _recvedPackets.size(),
+                                                      &_svc->GetEvBlockAllocator()));
+    }
+
     if (UNLIKELY(recvRet != LLBC_OK))
     {
         if (removeSession)
@@ -268,17 +288,6 @@ bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved)
         return false;
     }
 
-    LLBC_Packet *packet;
-    for (size_t i = 0; i < _recvedPackets.size(); ++i)
-    {
-        packet = _recvedPackets[i];
-        packet->SetSessionId(_id);
-        packet->SetLocalAddr(_socket->GetLocalAddress());
-        packet->SetPeerAddr(_socket->GetPeerAddress());
-
-        _svc->Push(LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
-    }
-
     return true;
 }
 
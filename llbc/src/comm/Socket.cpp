@@ -66,6 +66,8 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 
 , _maxPacketSize(LLBC_CFG_COMM_DFT_MAX_PACKET_SIZE)
 
+, _recvBuf(nullptr)
+
 #if LLBC_TARGET_PLATFORM_WIN32
 , _nonBlocking(false)
 
@@ -87,6 +89,8 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 LLBC_Socket::~LLBC_Socket()
 {
     Close();
+    if (_recvBuf)
+        _recvBuf->Release();
 }
 
 void LLBC_Socket::SetSession(LLBC_Session *session)
@@ -283,6 +287,16 @@ int LLBC_Socket::SetMaxPacketSize(size_t size)
     return 0;
 }
 
+bool LLBC_Socket::IsRecvBuf(const LLBC_MessageBlock *block) const
+{
+    return block && _recvBuf && block == &_recvBuf->GetBlock();
+}
+
+LLBC_SharedMessageBlock *LLBC_Socket::GetRecvBuf() const
+{
+    return _recvBuf;
+}
+
 int LLBC_Socket::BindTo(const char *ip, uint16 port)
 {
     return BindTo(LLBC_SockAddr_IN(ip, port));
@@ -533,6 +547,37 @@ void LLBC_Socket::OnSend()
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
     int len = 0, totalLen = 0;
+#if LLBC_CFG_COMM_USE_GATHER_SEND
+    // Gather all pending blocks(limited by max buffer count) and send it in one system call.
+    constexpr int maxBufCount = MIN(LLBC_CFG_COMM_GATHER_SEND_MAX_BUF_COUNT, LLBC_SOCK_BUF_MAX_COUNT);
+    LLBC_SockBuf bufs[maxBufCount];
+
+    const LLBC_MessageBlock *block = _willSend.FirstBlock();
+    while (block)
+    {
+        int bufCount = 0;
+        for (; block && bufCount < maxBufCount; block = block->GetNext())
+        {
+            const size_t readableSize = block->GetReadableSize();
+            if (readableSize == 0)
+                continue;
+
+            LLBC_SockBuf &buf = bufs[bufCount++];
+            buf.buf = reinterpret_cast<char *>(block->GetDataStartWithReadPos());
+            buf.len = static_cast<decltype(buf.len)>(readableSize);
+        }
+
+        if (bufCount == 0)
+            break;
+
+        if ((len = LLBC_SendV(_handle, bufs, bufCount, 0)) < 0)
+            break;
+
+        totalLen += len;
+        _willSend.Remove(len);
+        block = _willSend.FirstBlock();
+    }
+#else // !LLBC_CFG_COMM_USE_GATHER_SEND
     const LLBC_MessageBlock *firstBlock = _willSend.FirstBlock();
     while (firstBlock)
     {
@@ -545,6 +590,7 @@ void LLBC_Socket::OnSend()
         _willSend.Remove(len);
         firstBlock = _willSend.FirstBlock();
     }
+#endif // LLBC_CFG_COMM_USE_GATHER_SEND
 
     if (len < 0 && LLBC_GetLastError() != LLBC_ERROR_WBLOCK
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -603,7 +649,8 @@ void LLBC_Socket::OnSend()
     if (ret != LLBC_OK && LLBC_GetLastError() != LLBC_ERROR_PENDING)
     {
         trace("LLBC_Socket::OnSend() call LLBC_SendEx() failed, reason: %s\n", LLBC_FormatLastError());
-        delete reinterpret_cast<LLBC_MessageBlock *>(ol->data);
+        if (ol->data)
+            LLBC_Recycle(reinterpret_cast<LLBC_MessageBlock *>(ol->data));
 
         delete ol;
         _session->OnClose();
@@ -630,11 +677,24 @@ void LLBC_Socket::OnRecv()
 
     int len;
     bool recvFlag = false;
+    const LLBC_SessionOpts &sessionOpts = _session->GetSessionOpts();
+    const bool reuseRecvBuf = sessionOpts.IsSessionRecvBufReuse();
+    LLBC_MessageBlock *block;
+    if (reuseRecvBuf)
+    {
+        if (!_recvBuf)
+            _recvBuf = new LLBC_SharedMessageBlock(sessionOpts.GetSessionRecvBufSize());
+        block = &_recvBuf->GetBlock();
+    }
+    else
+    {
     #if LLBC_CFG_COMM_SESSION_RECV_BUF_USE_OBJ_POOL
-    LLBC_MessageBlock *block = _msgBlockPoolInst->GetObject();
+        block = _msgBlockPoolInst->GetObject();
     #else
-    LLBC_MessageBlock *block = new LLBC_MessageBlock(_session->GetSessionOpts().GetSessionRecvBufSize());
+        block = new LLBC_MessageBlock(sessionOpts.GetSessionRecvBufSize());
     #endif
+    }
+
     while ((len = LLBC_Recv(_handle,
                             block->GetDataStartWithWritePos(),
                             static_cast<int>(block->GetWritableSize()),
@@ -688,6 +748,9 @@ void LLBC_Socket::OnRecv()
         bool sessionRemoved;
         if (!_session->OnRecved(block, sessionRemoved))
         {
+            if (!sessionRemoved && _recvBuf)
+                ResetRecvBuf(sessionOpts.GetSessionRecvBufSize());
+
             #if LLBC_TARGET_PLATFORM_WIN32
             if (sessionRemoved)
                 return;
@@ -703,8 +766,12 @@ void LLBC_Socket::OnRecv()
 
             return;
         }
+
+        // Received data has been parsed(or saved by protocols), reset reusable recv buffer.
+        if (_recvBuf)
+            ResetRecvBuf(sessionOpts.GetSessionRecvBufSize());
     }
-    else
+    else if (!reuseRecvBuf)
     {
         LLBC_Recycle(block);
     }
@@ -804,6 +871,23 @@ size_t LLBC_Socket::GetIocpSendingDataSize() const
 }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+void LLBC_Socket::ResetRecvBuf(size_t recvBufSize)
+{
+    // Recv buffer still referenced by payload slices or expanded too large, release it,
+    // will recreate in next recv operation.
+    LLBC_MessageBlock &block = _recvBuf->GetBlock();
+    if (_recvBuf->GetRefCount() > 1 ||
+        block.GetSize() > MAX(recvBufSize, static_cast<size_t>(LLBC_CFG_COMM_SESSION_RECV_BUF_REUSE_MAX_SIZE)))
+    {
+        _recvBuf->Release();
+        _recvBuf = nullptr;
+        return;
+    }
+
+    block.SetReadPos(0);
+    block.SetWritePos(0);
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 int LLBC_Socket::PostZeroWSARecv()
 {
@@ -22,8 +22,11 @@
 
 #include "llbc/common/Export.h"
 
+#include "llbc/comm/Packet.h"
+#include "llbc/comm/Socket.h"
 #include "llbc/comm/Service.h"
 #include "llbc/comm/Session.h"
+#include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/protocol/IProtocol.h"
 #include "llbc/comm/protocol/ProtocolStack.h"
 
@@ -38,6 +41,7 @@ LLBC_IProtocol::LLBC_IProtocol()
 , _filter(nullptr)
 , _coders(nullptr)
 , _pktObjPool(nullptr)
+, _sliceBlockPool(nullptr)
 {
 }
 
@@ -70,6 +74,19 @@ const LLBC_IProtocol::Coders *LLBC_IProtocol::GetCoders() const
     return _coders;
 }
 
+void LLBC_IProtocol::SetRecvPayload(LLBC_Packet *packet, LLBC_MessageBlock *block, size_t len)
+{
+#if LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE > 0
+    LLBC_Socket *sock = _session->GetSocket();
+    if (len >= LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE &&
+        sock->IsRecvBuf(block) &&
+        packet->SetPayloadSlice(sock->GetRecvBuf(), block->GetReadPos(), len, _sliceBlockPool) == LLBC_OK)
+        return;
+#endif // LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE > 0
+
+    packet->Write(block->GetDataStartWithReadPos(), len);
+}
+
 bool LLBC_IProtocol::Ctrl(int cmd, const LLBC_Variant &ctrlData, bool &removeSession)
 {
     return true;
@@ -88,6 +105,7 @@ void LLBC_IProtocol::SetStack(LLBC_ProtocolStack *stack)
     _stack = stack;
     _svc = _stack->GetService();
     _pktObjPool = _svc->GetThreadSafeObjPool().GetTypedObjPool<LLBC_Packet>();
+    _sliceBlockPool = _svc->GetEvBlockAllocator().GetSliceBlockPool();
 }
 
 void LLBC_IProtocol::SetFilter(LLBC_IProtocolFilter *filter)
@@ -48,4 +48,9 @@ LLBC_IProtocol *LLBC_NormalProtocolFactory::Create(int layer) const
     }
 }
 
+bool LLBC_NormalProtocolFactory::IsStatelessSend() const
+{
+    return true;
+}
+
 __LLBC_NS_END
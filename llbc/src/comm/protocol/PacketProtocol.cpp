@@ -123,9 +123,11 @@ int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
 {
     out = nullptr;
     LLBC_MessageBlock *block = reinterpret_cast<LLBC_MessageBlock *>(in);
-    const size_t maxPacketLen = _session->GetSocket()->GetMaxPacketSize();
+    LLBC_Socket *sock = _session->GetSocket();
+    const size_t maxPacketLen = sock->GetMaxPacketSize();
 
-    LLBC_Defer(LLBC_Recycle(block));
+    // Socket reusable recv buffer owned by socket, don't recycle it.
+    LLBC_Defer(LLBC_DoIf(!sock->IsRecvBuf(block), LLBC_Recycle(block)));
 
     size_t readableSize;
     while ((readableSize = block->GetReadableSize()) > 0)
@@ -192,7 +194,11 @@ int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
         }
 
         // Readable data size >= content need receive size.
-        _packet->Write(readableBuf, contentNeedRecv);
+        // If whole payload in block, set it as payload(maybe recv buffer slice), otherwise copy remaining part.
+        if (_payloadRecved == 0)
+            SetRecvPayload(_packet, block, contentNeedRecv);
+        else
+            _packet->Write(readableBuf, contentNeedRecv);
         if (!out)
             out = new LLBC_MessageBlock(sizeof(LLBC_Packet *));
         (reinterpret_cast<LLBC_MessageBlock *>(out))->Write(&_packet, sizeof(LLBC_Packet *));
@@ -279,7 +279,12 @@ int LLBC_ProtocolStack::Recv(LLBC_MessageBlock *block, std::vector<LLBC_Packet *
         LLBC_Packet *packet;
         if (RecvCodec(_rawPackets[i], packet, removeSession) != LLBC_OK)
         {
-            LLBC_STLHelper::RecycleContainer(packets);
+            // Decode failed packet has been taken by codec layers, if not need remove session, only drop this packet.
+            if (!removeSession)
+                continue;
+
+            // Need remove session: keep the packets decoded before the failed one(caller will deliver them, same as
+            // service decoding in half-stack mode), drop the remaining raw packets.
             for (++i; i < _rawPackets.size(); ++i)
                 LLBC_Recycle(_rawPackets[i]);
 
@@ -23,6 +23,8 @@
 #include "llbc/common/Export.h"
 
 #include "llbc/comm/Packet.h"
+#include "llbc/comm/Session.h"
+#include "llbc/comm/Socket.h"
 
 #include "llbc/comm/protocol/ProtocolLayer.h"
 #include "llbc/comm/protocol/RawProtocol.h"
@@ -68,7 +70,13 @@ int LLBC_RawProtocol::Recv(void *in, void *&out, bool &removeSession)
 
     packet->SetLength(readableSize);
     packet->SetSessionId(_sessionId);
-    packet->SetPayload(block);
+
+    // Raw protocol use recv block as packet payload directly, if block is socket reusable recv buffer,
+    // use the slice of it(large payload) or copy it(small payload, keep recv buffer reusable).
+    if (_session->GetSocket()->IsRecvBuf(block))
+        SetRecvPayload(packet, block, readableSize);
+    else
+        packet->SetPayload(block);
 
     // Create output.
     out = new LLBC_MessageBlock(sizeof(LLBC_Packet *));
@@ -40,4 +40,9 @@ LLBC_IProtocol *LLBC_RawProtocolFactory::Create(int layer) const
     }
 }
 
+bool LLBC_RawProtocolFactory::IsStatelessSend() const
+{
+    return true;
+}
+
 __LLBC_NS_END
@@ -113,6 +113,9 @@ LLBC_String LLBC_GetVersionInfo(bool verbose)
     // Append communication info.
     desc.append_format("communication info: \n");
     desc.append_format("  poller model: %s\n", LLBC_CFG_COMM_POLLER_MODEL);
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    desc.append_format("  epoll poller inline wait: %s\n", LLBC_CFG_COMM_EPOLL_INLINE_WAIT ? "true" : "false");
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
     desc.append_format("  default service FPS: %d\n", LLBC_CFG_COMM_DFT_SERVICE_FPS);
     desc.append_format("  per thread max drive services count: %d\n", LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT);
     desc.append_format("  enabled register status code handler support: %s\n", LLBC_CFG_COMM_ENABLE_STATUS_HANDLER ? "true" : "false");
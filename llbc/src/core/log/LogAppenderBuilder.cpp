@@ -25,6 +25,7 @@
 #include "llbc/core/log/LogConsoleAppender.h"
 #include "llbc/core/log/LogFileAppender.h"
 #include "llbc/core/log/LogNetworkAppender.h"
+#include "llbc/core/log/LogBinaryFileAppender.h"
 
 #include "llbc/core/log/LogAppenderBuilder.h"
 
@@ -55,6 +56,10 @@ LLBC_BaseLogAppender *LLBC_LogAppenderBuilder::BuildAppender(int type) const
         appender = new LLBC_LogNetworkAppender;
         break;
 
+    case LLBC_LogAppenderType::BinaryFile:
+        appender = new LLBC_LogBinaryFileAppender;
+        break;
+
     default:
         break;
     }
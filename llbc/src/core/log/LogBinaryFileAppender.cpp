@@ -0,0 +1,258 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/core/os/OS_Process.h"
+#include "llbc/core/file/Directory.h"
+
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/Logger.h"
+#include "llbc/core/log/LogBinaryFileAppender.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * Binary log file format magic & version.
+ */
+static const char __g_binLogMagic[] = "LLBCBLOG";
+static const LLBC_NS uint8 __g_binLogVersion = 1;
+
+/**
+ * Binary log record types.
+ */
+enum __BinLogRecordType
+{
+    __BinLogRecordType_Session = 1,
+    __BinLogRecordType_Dict = 2,
+    __BinLogRecordType_Log = 3,
+};
+
+/**
+ * Encode LEB128 varint, return encoded length.
+ */
+static size_t __EncodeVarint(char (&varint)[10], LLBC_NS uint64 val)
+{
+    size_t len = 0;
+    while (val >= 0x80)
+    {
+        varint[len++] = static_cast<char>((val & 0x7f) | 0x80);
+        val >>= 7;
+    }
+    varint[len++] = static_cast<char>(val);
+
+    return len;
+}
+
+/**
+ * Get LEB128 varint encoded length.
+ */
+static size_t __VarintSize(LLBC_NS uint64 val)
+{
+    size_t len = 1;
+    while (val >= 0x80)
+    {
+        val >>= 7;
+        ++len;
+    }
+
+    return len;
+}
+
+/**
+ * Get length-prefixed string encoded length.
+ */
+static size_t __StrSize(size_t strLen)
+{
+    return __VarintSize(strLen) + strLen;
+}
+
+/**
+ * Append LEB128 varint to buf.
+ */
+static void __AppendVarint(LLBC_NS LLBC_String &buf, LLBC_NS uint64 val)
+{
+    char varint[10];
+    buf.append(varint, __EncodeVarint(varint, val));
+}
+
+/**
+ * Append length-prefixed string to buf.
+ */
+static void __AppendStr(LLBC_NS LLBC_String &buf, const char *str, size_t strLen)
+{
+    __AppendVarint(buf, strLen);
+    buf.append(str, strLen);
+}
+
+/**
+ * Begin binary log record, append record length prefix(record type + record body) and record type.
+ * Note: record body length must be computed before append record body, record never be moved after appended.
+ */
+static void __BeginRecord(LLBC_NS LLBC_String &buf, int recordType, size_t bodyLen)
+{
+    __AppendVarint(buf, bodyLen + 1);
+    buf.append(1, static_cast<char>(recordType));
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_LogBinaryFileAppender::LLBC_LogBinaryFileAppender()
+: _sessionBegan(false)
+, _lastLogTime(0)
+{
+}
+
+LLBC_LogBinaryFileAppender::~LLBC_LogBinaryFileAppender()
+{
+    Finalize();
+}
+
+int LLBC_LogBinaryFileAppender::GetType() const
+{
+    return LLBC_LogAppenderType::BinaryFile;
+}
+
+int LLBC_LogBinaryFileAppender::Initialize(const LLBC_LogAppenderInitInfo &initInfo)
+{
+    // Save pattern first, file maybe opened in base appender initialize.
+    _pattern = initInfo.pattern;
+    if (_Base::Initialize(initInfo) != LLBC_OK)
+    {
+        _pattern.clear();
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+void LLBC_LogBinaryFileAppender::Finalize()
+{
+    _Base::Finalize();
+
+    _pattern.clear();
+
+    _sessionBegan = false;
+    _lastLogTime = 0;
+
+    _internedStrIds.clear();
+    _internedStrs.clear();
+}
+
+void LLBC_LogBinaryFileAppender::FormatLogData(const LLBC_LogData &data, LLBC_String &buf)
+{
+    // Begin session, if not began.
+    if (UNLIKELY(!_sessionBegan))
+        AppendSessionRecord(data, buf);
+
+    // Intern file/function/tag strings(dict records will be appended before log record).
+    const uint32 fileId = InternString(data.file, data.fileLen, buf);
+    const uint32 funcId = InternString(data.func, data.funcLen, buf);
+    const uint32 tagId = InternString(data.tag, data.tagLen, buf);
+
+    // Append log record.
+    const sint64 timeDelta = data.logTime - _lastLogTime;
+    _lastLogTime = data.logTime;
+    const uint64 zigzagTimeDelta = (static_cast<uint64>(timeDelta) << 1) ^ static_cast<uint64>(timeDelta >> 63);
+    const uint32 threadId = static_cast<uint32>(data.threadId);
+    const uint32 line = static_cast<uint32>(data.line);
+
+    const size_t bodyLen = LLBC_INL_NS __VarintSize(zigzagTimeDelta) +
+                           1 + // Log level.
+                           LLBC_INL_NS __VarintSize(threadId) +
+                           LLBC_INL_NS __VarintSize(fileId) +
+                           LLBC_INL_NS __VarintSize(line) +
+                           LLBC_INL_NS __VarintSize(funcId) +
+                           LLBC_INL_NS __VarintSize(tagId) +
+                           data.msgLen;
+    LLBC_INL_NS __BeginRecord(buf, LLBC_INL_NS __BinLogRecordType_Log, bodyLen);
+
+    LLBC_INL_NS __AppendVarint(buf, zigzagTimeDelta);
+    buf.append(1, static_cast<char>(data.level));
+    LLBC_INL_NS __AppendVarint(buf, threadId);
+    LLBC_INL_NS __AppendVarint(buf, fileId);
+    LLBC_INL_NS __AppendVarint(buf, line);
+    LLBC_INL_NS __AppendVarint(buf, funcId);
+    LLBC_INL_NS __AppendVarint(buf, tagId);
+    buf.append(data.msg, data.msgLen);
+}
+
+void LLBC_LogBinaryFileAppender::OnLogFileOpened()
+{
+    // New log file opened, begin new session at next log output.
+    _sessionBegan = false;
+    _lastLogTime = 0;
+
+    _internedStrIds.clear();
+    _internedStrs.clear();
+}
+
+uint32 LLBC_LogBinaryFileAppender::InternString(const char *str, int strLen, LLBC_String &buf)
+{
+    if (strLen <= 0)
+        return 0;
+
+    const std::string_view strView(str, strLen);
+    const auto it = _internedStrIds.find(strView);
+    if (LIKELY(it != _internedStrIds.end()))
+        return it->second;
+
+    const uint32 strId = static_cast<uint32>(_internedStrs.size() + 1);
+    const std::string &internedStr = _internedStrs.emplace_back(str, strLen);
+    _internedStrIds.emplace(std::string_view(internedStr.data(), internedStr.size()), strId);
+
+    LLBC_INL_NS __BeginRecord(buf,
+                              LLBC_INL_NS __BinLogRecordType_Dict,
+                              LLBC_INL_NS __VarintSize(strId) + LLBC_INL_NS __StrSize(strLen));
+    LLBC_INL_NS __AppendVarint(buf, strId);
+    LLBC_INL_NS __AppendStr(buf, str, strLen);
+
+    return strId;
+}
+
+void LLBC_LogBinaryFileAppender::AppendSessionRecord(const LLBC_LogData &data, LLBC_String &buf)
+{
+    const uint32 pid = static_cast<uint32>(LLBC_GetCurrentProcessId());
+    const LLBC_String execName = LLBC_Directory::SplitExt(LLBC_Directory::ModuleFileName())[0];
+    const LLBC_String &loggerName = data.logger ? data.logger->GetLoggerName() : LLBC_String();
+
+    const size_t bodyLen = sizeof(LLBC_INL_NS __g_binLogMagic) - 1 +
+                           1 + // Version.
+                           LLBC_INL_NS __VarintSize(pid) +
+                           LLBC_INL_NS __StrSize(execName.size()) +
+                           LLBC_INL_NS __StrSize(loggerName.size()) +
+                           LLBC_INL_NS __StrSize(_pattern.size());
+    LLBC_INL_NS __BeginRecord(buf, LLBC_INL_NS __BinLogRecordType_Session, bodyLen);
+
+    buf.append(LLBC_INL_NS __g_binLogMagic, sizeof(LLBC_INL_NS __g_binLogMagic) - 1);
+    buf.append(1, static_cast<char>(LLBC_INL_NS __g_binLogVersion));
+    LLBC_INL_NS __AppendVarint(buf, pid);
+    LLBC_INL_NS __AppendStr(buf, execName.data(), execName.size());
+    LLBC_INL_NS __AppendStr(buf, loggerName.data(), loggerName.size());
+    LLBC_INL_NS __AppendStr(buf, _pattern.data(), _pattern.size());
+
+    _sessionBegan = true;
+}
+
+__LLBC_NS_END
@@ -46,6 +46,11 @@ LLBC_LogData::LLBC_LogData()
 
 // , threadId(LLBC_INVALID_NATIVE_THREAD_ID)
 
+, next(nullptr)
+
+, fmt(nullptr)
+, deferredFormatter(nullptr)
+
 , _typedObjPool(nullptr)
 {
 }
@@ -82,6 +87,43 @@ void LLBC_LogData::Reuse()
     // line = 0;
 
     // threadId = LLBC_INVALID_NATIVE_THREAD_ID;
+
+    fmt = nullptr;
+    deferredFormatter = nullptr;
+}
+
+void LLBC_LogData::FormatDeferredMsg()
+{
+    if (!deferredFormatter)
+        return;
+
+    // Format message to tls format buffer(msg still hold the encoded arguments record).
+    __LLBC_LibTls *libTls = __LLBC_GetLibTls();
+    int len = deferredFormatter(fmt,
+                                msg,
+                                libTls->coreTls.loggerFmtBuf,
+                                sizeof(libTls->coreTls.loggerFmtBuf));
+
+    fmt = nullptr;
+    deferredFormatter = nullptr;
+
+    // Normalize length.
+    if (UNLIKELY(len < 0))
+        len = 0;
+    else if (UNLIKELY(len > static_cast<int>(sizeof(libTls->coreTls.loggerFmtBuf) - 1)))
+        len = static_cast<int>(sizeof(libTls->coreTls.loggerFmtBuf) - 1);
+
+    // Copy formatted message to msg.
+    if (msgCap < len + 1)
+    {
+        msgCap = MAX(len + 1, 192);
+        msg = LLBC_Realloc(char, msg, msgCap);
+    }
+
+    msgLen = len;
+    if (LIKELY(len > 0))
+        memcpy(msg, libTls->coreTls.loggerFmtBuf, len);
+    msg[len] = '\0';
 }
 
 LLBC_TypedObjPool<LLBC_LogData> *LLBC_LogData::GetTypedObjPool() const
@@ -22,6 +22,11 @@
 
 #include "llbc/common/Export.h"
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ #include <fcntl.h>
+ #include <sys/mman.h>
+#endif // Non-Win32
+
 #include "llbc/core/os/OS_Time.h"
 #include "llbc/core/os/OS_Console.h"
 
@@ -33,10 +38,12 @@
 #include "llbc/core/log/LogLevel.h"
 #include "llbc/core/log/LogRollingMode.h"
 #include "llbc/core/log/LogTokenChain.h"
+#include "llbc/core/log/LoggerMgr.h"
 #include "llbc/core/log/LogFileAppender.h"
 
 __LLBC_INTERNAL_NS_BEGIN
 const static int __LogFileCheckInterval = 500000; // In micro-seconds.
+const static char __MmapPosFileSuffix[] = ".mmpos"; // Mmap log file position file suffix.
 __LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
@@ -48,9 +55,17 @@ LLBC_LogFileAppender::LLBC_LogFileAppender()
 , _maxFileSize(LONG_MAX)
 , _maxBackupIndex(INT_MAX)
 
+, _mmapSegmentSize(0)
+
 , _file(nullptr)
 , _fileSize(0)
 
+, _mmapSeg(nullptr)
+, _mmapSegOffset(0)
+
+, _mmapPosFd(-1)
+, _mmapPos(nullptr)
+
 , _notFlushLogCount(0)
 , _logFileLastCheckTime(0)
 {
@@ -102,6 +117,28 @@ int LLBC_LogFileAppender::Initialize(const LLBC_LogAppenderInitInfo &initInfo)
     _maxFileSize = initInfo.maxFileSize > 0 ? initInfo.maxFileSize : LONG_MAX;
     _maxBackupIndex = MAX(0, initInfo.maxBackupIndex);
 
+    // Mmap log file only supported in Non-Win32 platform, segment size must be multiple of page size,
+    // and file buffer is useless in mmap mode(never write log file through stdio).
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (initInfo.mmapSegmentSize > 0)
+    {
+        const sint64 pageSize = sysconf(_SC_PAGESIZE);
+        _mmapSegmentSize = (initInfo.mmapSegmentSize + pageSize - 1) / pageSize * pageSize;
+        _fileBufferSize = 0;
+    }
+#else // Win32
+    if (initInfo.mmapSegmentSize > 0)
+        LLBC_LoggerMgrSingleton->UnInitOutput(LLBC_LogLevel::Warn,
+                                              nullptr,
+                                              __FILE__,
+                                              __LINE__,
+                                              __FUNCTION__,
+                                              "Mmap log file not supported in Win32 platform, "
+                                              "ignore mmapSegmentSize:%lld, log file:%s",
+                                              initInfo.mmapSegmentSize,
+                                              initInfo.filePath.c_str());
+#endif // Non-Win32
+
     // If lazy create log file, return it.
     if (initInfo.lazyCreateLogFile)
         return LLBC_OK;
@@ -124,8 +161,8 @@ void LLBC_LogFileAppender::Finalize()
     _maxFileSize = LONG_MAX;
     _maxBackupIndex = INT_MAX;
 
-    _file.Close();
-    _fileSize = 0;
+    CloseFile();
+    _mmapSegmentSize = 0;
 
     _notFlushLogCount = 0;
     _logFileLastCheckTime = 0;
@@ -149,13 +186,12 @@ int LLBC_LogFileAppender::Output(const LLBC_LogData &data)
 
     auto &logFmtBuf = GetLogFormatBuf();
     logFmtBuf.clear();
-    chain->Format(data, logFmtBuf);
+    FormatLogData(data, logFmtBuf);
 
     const sint64 actuallyWrote = 
-        _file.Write(logFmtBuf.data(), logFmtBuf.size());
+        WriteFile(logFmtBuf.data(), logFmtBuf.size());
     if (actuallyWrote != -1)
     {
-        _fileSize += actuallyWrote;
         if (_fileBufferSize > 0) // If file buffered, process flush logic
         {
             _notFlushLogCount += 1;
@@ -184,6 +220,15 @@ void LLBC_LogFileAppender::Flush()
     _notFlushLogCount = 0;
 }
 
+void LLBC_LogFileAppender::FormatLogData(const LLBC_LogData &data, LLBC_String &buf)
+{
+    GetTokenChain()->Format(data, buf);
+}
+
+void LLBC_LogFileAppender::OnLogFileOpened()
+{
+}
+
 void LLBC_LogFileAppender::CheckAndUpdateLogFile(sint64 now)
 {
     // Is need check?
@@ -263,7 +308,9 @@ bool LLBC_LogFileAppender::IsNeedReOpenFile(const LLBC_String &newFilePath,
 
         return true;
     }
-    else if (!LLBC_File::Exists(newFilePath))
+    // In mmap mode, skip log file exists check(avoid file system path lookup in log thread every check
+    // interval), log file deleted externally will be recreated in next rolling.
+    else if (_mmapSegmentSize == 0 && !LLBC_File::Exists(newFilePath))
     {
         backup = false;
         clear = true;
@@ -278,17 +325,17 @@ int LLBC_LogFileAppender::ReOpenFile(const LLBC_String &newFileName, bool clear)
 {
     // Close old file.
     if (LIKELY(_file.IsOpened()))
-    {
-        _file.Close();
-        _fileSize = 0;
-    }
+        CloseFile();
 
     // Reset not flush log count variables.
     _notFlushLogCount = 0;
 
-    // Do reopen file.
-    const int openMode = clear ?
-        LLBC_FileMode::BinaryWrite : LLBC_FileMode::BinaryAppendWrite;
+    // Do reopen file(mmap requires file opened for read & write).
+    int openMode;
+    if (_mmapSegmentSize > 0)
+        openMode = clear ? LLBC_FileMode::BinaryReadWrite : LLBC_FileMode::BinaryAppendReadWrite;
+    else
+        openMode = clear ? LLBC_FileMode::BinaryWrite : LLBC_FileMode::BinaryAppendWrite;
     int openRet = _file.Open(newFileName, openMode);
     if (UNLIKELY(openRet != LLBC_OK))
     {
@@ -324,6 +371,22 @@ int LLBC_LogFileAppender::ReOpenFile(const LLBC_String &newFileName, bool clear)
     _fileSize = _file.GetFileSize();
     UpdateFileBufferInfo();
 
+    // In mmap mode, open position file, and recover logical file size(if last process crashed).
+    if (_mmapSegmentSize > 0 && OpenMmapPosFile() != LLBC_OK)
+    {
+        #ifdef LLBC_DEBUG
+        traceline("LLBC_LogFileAppender::ReOpenFile(): "
+                  "Open mmap position file failed, name:%s, reason:%s",
+                  newFileName.c_str(), LLBC_FormatLastError());
+        #endif
+        CloseFile();
+
+        return LLBC_FAILED;
+    }
+
+    // Notify log file opened.
+    OnLogFileOpened();
+
     return LLBC_OK;
 }
 
@@ -333,8 +396,7 @@ void LLBC_LogFileAppender::BackupFiles()
         return;
 
     const LLBC_String filePath = _file.GetFilePath();
-    _file.Close();
-    _fileSize = 0;
+    CloseFile();
 
     const LLBC_String filePathNoSuffix = 
         filePath.substr(0, filePath.size() - _fileSuffix.size());
@@ -395,4 +457,205 @@ int LLBC_LogFileAppender::GetBackupFilesCount(const LLBC_String &logFileName) co
     return backupFilesCount;
 }
 
+sint64 LLBC_LogFileAppender::WriteFile(const void *buf, size_t size)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (_mmapSegmentSize > 0)
+    {
+        size_t wrote = 0;
+        while (wrote < size)
+        {
+            // Map next file segment, if current segment used up.
+            if (UNLIKELY(!_mmapSeg || _fileSize >= _mmapSegOffset + _mmapSegmentSize))
+            {
+                if (MapFileSegment(_fileSize) != LLBC_OK)
+                    return wrote > 0 ? static_cast<sint64>(wrote) : -1;
+            }
+
+            const size_t copySize =
+                MIN(size - wrote, static_cast<size_t>(_mmapSegOffset + _mmapSegmentSize - _fileSize));
+            memcpy(_mmapSeg + (_fileSize - _mmapSegOffset), reinterpret_cast<const char *>(buf) + wrote, copySize);
+
+            wrote += copySize;
+            _fileSize += copySize;
+
+            // Persist logical file size.
+            *_mmapPos = _fileSize;
+        }
+
+        return static_cast<sint64>(wrote);
+    }
+#endif // Non-Win32
+
+    const sint64 actuallyWrote = _file.Write(buf, size);
+    if (actuallyWrote != -1)
+        _fileSize += actuallyWrote;
+
+    return actuallyWrote;
+}
+
+void LLBC_LogFileAppender::CloseFile()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (_mmapSegmentSize > 0 && _file.IsOpened())
+    {
+        // Unmap file segment and truncate unused preallocated file space.
+        UnmapFileSegment();
+        if (ftruncate(_file.GetFileNo(), _fileSize) != 0)
+        {
+            #ifdef LLBC_DEBUG
+            traceline("LLBC_LogFileAppender::CloseFile(): Truncate file failed, name:%s, size:%lld, reason:%s",
+                      _file.GetFilePath().c_str(), static_cast<long long>(_fileSize), strerror(errno));
+            #endif
+        }
+
+        CloseMmapPosFile();
+    }
+#endif // Non-Win32
+
+    _file.Close();
+    _fileSize = 0;
+}
+
+int LLBC_LogFileAppender::MapFileSegment(sint64 offset)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    UnmapFileSegment();
+    if (UNLIKELY(!_file.IsOpened()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_OPEN);
+        return LLBC_FAILED;
+    }
+
+    // Segment begin offset must be multiple of page size.
+    const int fileNo = _file.GetFileNo();
+    const sint64 segOffset = offset - offset % sysconf(_SC_PAGESIZE);
+
+    // Preallocate segment file space.
+    #if LLBC_TARGET_PLATFORM_LINUX
+    const int allocRet = posix_fallocate(fileNo, segOffset, _mmapSegmentSize);
+    if (allocRet != 0)
+    {
+        errno = allocRet;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+    #else // Non-Linux
+    struct stat fileStat;
+    if (fstat(fileNo, &fileStat) != 0 ||
+        (fileStat.st_size < segOffset + _mmapSegmentSize &&
+         ftruncate(fileNo, segOffset + _mmapSegmentSize) != 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+    #endif // Linux
+
+    // Map segment.
+    void *seg = mmap(nullptr, _mmapSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileNo, segOffset);
+    if (seg == MAP_FAILED)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    _mmapSeg = reinterpret_cast<char *>(seg);
+    _mmapSegOffset = segOffset;
+
+    return LLBC_OK;
+#else // Win32
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // Non-Win32
+}
+
+void LLBC_LogFileAppender::UnmapFileSegment()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (!_mmapSeg)
+        return;
+
+    munmap(_mmapSeg, _mmapSegmentSize);
+    _mmapSeg = nullptr;
+    _mmapSegOffset = 0;
+#endif // Non-Win32
+}
+
+int LLBC_LogFileAppender::OpenMmapPosFile()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Open position file, if exist, it is left by crashed process.
+    const LLBC_String posFilePath = _file.GetFilePath() + LLBC_INL_NS __MmapPosFileSuffix;
+    _mmapPosFd = open(posFilePath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (_mmapPosFd == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    struct stat posFileStat;
+    if (fstat(_mmapPosFd, &posFileStat) != 0 ||
+        (posFileStat.st_size < static_cast<off_t>(sizeof(sint64)) &&
+         ftruncate(_mmapPosFd, sizeof(sint64)) != 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        CloseMmapPosFile();
+        return LLBC_FAILED;
+    }
+
+    void *pos = mmap(nullptr, sizeof(sint64), PROT_READ | PROT_WRITE, MAP_SHARED, _mmapPosFd, 0);
+    if (pos == MAP_FAILED)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        CloseMmapPosFile();
+        return LLBC_FAILED;
+    }
+
+    _mmapPos = reinterpret_cast<volatile sint64 *>(pos);
+
+    // Truncate log file to persisted logical file size(the preallocated tail and partial written record
+    // after the persisted size are discarded).
+    // Note: if position file not exist(eg: OS crashed), keep the file size, the decoder skip zero tail.
+    if (posFileStat.st_size >= static_cast<off_t>(sizeof(sint64)) &&
+        *_mmapPos >= 0 &&
+        *_mmapPos < _fileSize)
+    {
+        if (ftruncate(_file.GetFileNo(), *_mmapPos) != 0)
+        {
+            LLBC_SetLastError(LLBC_ERROR_CLIB);
+            CloseMmapPosFile();
+            return LLBC_FAILED;
+        }
+
+        _fileSize = *_mmapPos;
+    }
+
+    *_mmapPos = _fileSize;
+
+    return LLBC_OK;
+#else // Win32
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // Non-Win32
+}
+
+void LLBC_LogFileAppender::CloseMmapPosFile()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (_mmapPos)
+    {
+        munmap(const_cast<sint64 *>(_mmapPos), sizeof(sint64));
+        _mmapPos = nullptr;
+    }
+
+    if (_mmapPosFd != -1)
+    {
+        close(_mmapPosFd);
+        _mmapPosFd = -1;
+
+        unlink((_file.GetFilePath() + LLBC_INL_NS __MmapPosFileSuffix).c_str());
+    }
+#endif // Non-Win32
+}
+
 __LLBC_NS_END
@@ -22,13 +22,55 @@
 
 #include "llbc/common/Export.h"
 
+#include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Socket.h"
+#include "llbc/core/os/OS_Thread.h"
+
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogTokenChain.h"
 #include "llbc/core/log/LogNetworkAppender.h"
 
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * Network log frame header size(payload length, 4 bytes, big-endian).
+ */
+static const size_t __g_frameHeaderSize = 4;
+
+/**
+ * Network log send flags, avoid SIGPIPE when collector closed connection.
+ */
+#if defined(MSG_NOSIGNAL)
+static const int __g_sendFlags = MSG_NOSIGNAL;
+#else
+static const int __g_sendFlags = 0;
+#endif
+
+__LLBC_INTERNAL_NS_END
+
 __LLBC_NS_BEGIN
 
 LLBC_LogNetworkAppender::LLBC_LogNetworkAppender()
 : _ip("127.0.0.1")
 , _port(0)
+, _udp(false)
+
+, _frameSize(LLBC_CFG_LOG_DEFAULT_NETWORK_FRAME_SIZE)
+, _bufferSize(LLBC_CFG_LOG_DEFAULT_NETWORK_BUFFER_SIZE)
+, _flushInterval(LLBC_CFG_LOG_DEFAULT_LOG_FLUSH_INTERVAL)
+
+, _sock(LLBC_INVALID_SOCKET_HANDLE)
+, _connState(Disconnected)
+, _connBeginTime(0)
+, _nextConnTime(0)
+, _reconnInterval(LLBC_CFG_LOG_NETWORK_MIN_RECONNECT_INTERVAL)
+
+, _lastFrameSealed(true)
+, _frontFrameSent(0)
+, _bufferedSize(0)
+, _lastSendTime(0)
+, _droppedCount(0)
 {
 }
 
@@ -44,22 +86,315 @@ int LLBC_LogNetworkAppender::GetType() const
 
 int LLBC_LogNetworkAppender::Initialize(const LLBC_LogAppenderInitInfo &initInfo)
 {
-    _ip = "127.0.0.1";
-    _port = 0;
+    // Init info check.
+    if (initInfo.ip.empty() || initInfo.port == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Init base appender.
+    if (_Base::Initialize(initInfo) != LLBC_OK)
+        return LLBC_FAILED;
 
-    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
-    return LLBC_FAILED;
+    // Save network appender config to members.
+    _ip = initInfo.ip;
+    _port = initInfo.port;
+    _udp = initInfo.udp;
+
+    _frameSize = MAX(initInfo.frameSize, 1024);
+    if (_udp)
+        _frameSize = MIN(_frameSize, static_cast<size_t>(LLBC_CFG_LOG_MAX_NETWORK_UDP_FRAME_SIZE));
+    _bufferSize = MAX(static_cast<size_t>(MAX(initInfo.networkBufferSize, 0)), _frameSize);
+    _flushInterval = MAX(0, initInfo.flushInterval);
+
+    // Try connect to collector(non-blocking, if failed, will reconnect when output/flush).
+    _lastSendTime = LLBC_GetMilliseconds();
+    TryConnect(_lastSendTime);
+
+    return LLBC_OK;
 }
 
 void LLBC_LogNetworkAppender::Finalize()
 {
+    // Send pending frames, wait at most LLBC_CFG_LOG_NETWORK_FINALIZE_SEND_TIMEOUT milli-seconds.
+    if (!_frames.empty())
+    {
+        _nextConnTime = 0;
+        const sint64 deadline = LLBC_GetMilliseconds() + LLBC_CFG_LOG_NETWORK_FINALIZE_SEND_TIMEOUT;
+        for (sint64 now = LLBC_GetMilliseconds(); now < deadline; now = LLBC_GetMilliseconds())
+        {
+            TrySend(now, true);
+            if (_frames.empty() || _connState == Disconnected)
+                break;
+
+            LLBC_Sleep(1);
+        }
+    }
+
+    if (_sock != LLBC_INVALID_SOCKET_HANDLE)
+    {
+        LLBC_CloseSocket(_sock);
+        _sock = LLBC_INVALID_SOCKET_HANDLE;
+    }
+
+    _connState = Disconnected;
+    _connBeginTime = 0;
+    _nextConnTime = 0;
+    _reconnInterval = LLBC_CFG_LOG_NETWORK_MIN_RECONNECT_INTERVAL;
+
+    _frames.clear();
+    _lastFrameSealed = true;
+    _frontFrameSent = 0;
+    _bufferedSize = 0;
+    _lastSendTime = 0;
+    _droppedCount = 0;
+
     _Base::Finalize();
 }
 
 int LLBC_LogNetworkAppender::Output(const LLBC_LogData &data)
 {
-    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
-    return LLBC_FAILED;
+    LLBC_LogTokenChain *chain = GetTokenChain();
+    if (UNLIKELY(!chain))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    if (data.level < GetLogLevel())
+        return LLBC_OK;
+
+    // Format log record.
+    auto &logFmtBuf = GetLogFormatBuf();
+    logFmtBuf.clear();
+    chain->Format(data, logFmtBuf);
+
+    // UDP datagram may be lost/reordered, so every frame must be self-contained:
+    // truncate the record larger than frame payload size(keep tailing line break).
+    if (_udp && logFmtBuf.size() > _frameSize - LLBC_INL_NS __g_frameHeaderSize)
+    {
+        const bool endWithLineBreak = logFmtBuf[logFmtBuf.size() - 1] == '\n';
+        logFmtBuf.resize(_frameSize - LLBC_INL_NS __g_frameHeaderSize);
+        if (endWithLineBreak)
+            logFmtBuf[logFmtBuf.size() - 1] = '\n';
+    }
+
+    // Build dropped notice record, if has dropped log records.
+    char notice[128];
+    size_t noticeLen = 0;
+    if (UNLIKELY(_droppedCount > 0))
+        noticeLen = snprintf(notice,
+                             sizeof(notice),
+                             "<%lld log record(s) dropped by network log appender>\n",
+                             static_cast<long long>(_droppedCount));
+
+    // Check buffer limit(include dropped notice), if buffer usage reach limit, drop log record(never block log thread).
+    const sint64 now = data.logTime / 1000;
+    const size_t recordLen = logFmtBuf.size();
+    const size_t bufferLimit = data.level >= LLBC_CFG_LOG_NETWORK_BUFFER_KEEP_LEVEL ?
+        _bufferSize : _bufferSize / 100 * LLBC_CFG_LOG_NETWORK_BUFFER_DROP_WATERMARK;
+    if (_bufferedSize + noticeLen + recordLen > bufferLimit)
+    {
+        ++_droppedCount;
+        TrySend(now, false);
+
+        return LLBC_OK;
+    }
+
+    // Append dropped notice record and log record.
+    if (UNLIKELY(noticeLen > 0))
+    {
+        AppendRecord(notice, noticeLen);
+        _droppedCount = 0;
+    }
+
+    AppendRecord(logFmtBuf.data(), recordLen);
+
+    // Send frames, if has sealed frame or reach flush interval.
+    const bool reachFlushInterval = now - _lastSendTime >= _flushInterval || now < _lastSendTime;
+    if (_frames.size() > 1 || reachFlushInterval)
+        TrySend(now, reachFlushInterval);
+
+    return LLBC_OK;
+}
+
+void LLBC_LogNetworkAppender::Flush()
+{
+    TrySend(LLBC_GetMilliseconds(), true);
+}
+
+void LLBC_LogNetworkAppender::AppendRecord(const char *record, size_t recordLen)
+{
+    while (recordLen > 0)
+    {
+        // Open new frame, if current frame sealed or current non-empty frame can't hold the record.
+        if (_lastFrameSealed ||
+            (_frames.back().size() + recordLen > _frameSize &&
+             _frames.back().size() > LLBC_INL_NS __g_frameHeaderSize))
+        {
+            if (!_lastFrameSealed)
+                SealFrame();
+
+            _frames.emplace_back(LLBC_INL_NS __g_frameHeaderSize, '\0');
+            _bufferedSize += LLBC_INL_NS __g_frameHeaderSize;
+            _lastFrameSealed = false;
+        }
+
+        // Append record to current frame, the record larger than frame payload will be split to next frame(s)
+        // (TCP only, UDP record has been truncated to frame payload size).
+        LLBC_String &frame = _frames.back();
+        const size_t appendLen = MIN(recordLen, _frameSize - frame.size());
+        frame.append(record, appendLen);
+        _bufferedSize += appendLen;
+
+        record += appendLen;
+        recordLen -= appendLen;
+    }
+}
+
+void LLBC_LogNetworkAppender::SealFrame()
+{
+    LLBC_String &frame = _frames.back();
+    const uint32 payloadLen = static_cast<uint32>(frame.size() - LLBC_INL_NS __g_frameHeaderSize);
+    frame[0] = static_cast<char>((payloadLen >> 24) & 0xff);
+    frame[1] = static_cast<char>((payloadLen >> 16) & 0xff);
+    frame[2] = static_cast<char>((payloadLen >> 8) & 0xff);
+    frame[3] = static_cast<char>(payloadLen & 0xff);
+
+    _lastFrameSealed = true;
+}
+
+void LLBC_LogNetworkAppender::TrySend(sint64 now, bool sealFrame)
+{
+    _lastSendTime = now;
+    if (_frames.empty())
+        return;
+
+    // Connect to collector, if not connected.
+    if (_connState != Connected && !TryConnect(now))
+        return;
+
+    // Seal current frame, if required.
+    if (sealFrame && !_lastFrameSealed)
+        SealFrame();
+
+    // Send sealed frames, until socket send buffer full.
+    while (!_frames.empty())
+    {
+        if (_frames.size() == 1 && !_lastFrameSealed)
+            break;
+
+        LLBC_String &frame = _frames.front();
+        const int ret = LLBC_Send(_sock,
+                                  frame.data() + _frontFrameSent,
+                                  static_cast<int>(frame.size() - _frontFrameSent),
+                                  LLBC_INL_NS __g_sendFlags);
+        if (ret < 0)
+        {
+            const int errNo = LLBC_GetLastError();
+            if (errNo != LLBC_ERROR_WBLOCK && errNo != LLBC_ERROR_AGAIN)
+                Disconnect(now);
+
+            break;
+        }
+
+        _frontFrameSent += ret;
+        if (_frontFrameSent == frame.size())
+        {
+            _bufferedSize -= frame.size();
+            _frames.pop_front();
+            _frontFrameSent = 0;
+        }
+    }
+}
+
+bool LLBC_LogNetworkAppender::TryConnect(sint64 now)
+{
+    if (_connState == Connected)
+        return true;
+
+    // Create socket and begin connect, if disconnected and reach reconnect time.
+    if (_connState == Disconnected)
+    {
+        if (now < _nextConnTime)
+            return false;
+
+        _sock = _udp ? LLBC_CreateUdpSocket() : LLBC_CreateTcpSocket();
+        if (_sock == LLBC_INVALID_SOCKET_HANDLE ||
+            LLBC_SetNonBlocking(_sock) != LLBC_OK)
+        {
+            Disconnect(now);
+            return false;
+        }
+
+        #if defined(SO_NOSIGPIPE)
+        const int noSigPipe = 1;
+        LLBC_SetSocketOption(_sock, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+        #endif
+
+        if (LLBC_ConnectToPeer(_sock, LLBC_SockAddr_IN(_ip.c_str(), _port)) != LLBC_OK)
+        {
+            if (LLBC_GetLastError() != LLBC_ERROR_WBLOCK)
+            {
+                Disconnect(now);
+                return false;
+            }
+
+            _connState = Connecting;
+            _connBeginTime = now;
+        }
+        else
+        {
+            _connState = Connected;
+        }
+    }
+
+    // Check connect result, if connecting.
+    if (_connState == Connecting)
+    {
+        int sockErr = 0;
+        LLBC_SocketLen sockErrLen = sizeof(sockErr);
+        if (LLBC_GetSocketOption(_sock, SOL_SOCKET, SO_ERROR, &sockErr, &sockErrLen) != LLBC_OK ||
+            sockErr != 0)
+        {
+            Disconnect(now);
+            return false;
+        }
+
+        LLBC_SockAddr_IN peerAddr;
+        if (LLBC_GetPeerSocketName(_sock, peerAddr) != LLBC_OK)
+        {
+            if (now - _connBeginTime >= LLBC_CFG_LOG_NETWORK_CONNECT_TIMEOUT || now < _connBeginTime)
+                Disconnect(now);
+
+            return false;
+        }
+
+        _connState = Connected;
+    }
+
+    // Connected, reset reconnect interval, and resend front frame(maybe partial sent in old connection).
+    _reconnInterval = LLBC_CFG_LOG_NETWORK_MIN_RECONNECT_INTERVAL;
+    _frontFrameSent = 0;
+
+    return true;
+}
+
+void LLBC_LogNetworkAppender::Disconnect(sint64 now)
+{
+    if (_sock != LLBC_INVALID_SOCKET_HANDLE)
+    {
+        LLBC_CloseSocket(_sock);
+        _sock = LLBC_INVALID_SOCKET_HANDLE;
+    }
+
+    _connState = Disconnected;
+    _frontFrameSent = 0;
+
+    // Schedule reconnect(exponential backoff).
+    _nextConnTime = now + _reconnInterval;
+    _reconnInterval = MIN(_reconnInterval * 2, LLBC_CFG_LOG_NETWORK_MAX_RECONNECT_INTERVAL);
 }
 
 __LLBC_NS_END
@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/core/utils/Util_Text.h"
+#include "llbc/core/log/LogQueueFullPolicy.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const LLBC_NS LLBC_CString __queueFullPolicy2StrRepr[LLBC_NS LLBC_LogQueueFullPolicy::End + 1] =
+{
+    "BLOCK", // Block
+    "DROPLOWLEVEL", // Drop Low Level
+    "SYNCOUTPUT", // Sync Output
+
+    "UKNQUEUEFULLPOLICY" // Unknown Queue Full Policy
+};
+
+static const LLBC_NS LLBC_CString __queueFullPolicy2StrAliasRepr[LLBC_NS LLBC_LogQueueFullPolicy::End + 1] =
+{
+    "BLOCK", // Block
+    "DROP", // Drop Low Level
+    "SYNC", // Sync Output
+
+    "UKNQUEUEFULLPOLICY" // Unknown Queue Full Policy
+};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const LLBC_CString &LLBC_LogQueueFullPolicy::GetPolicyStr(int policy)
+{
+    return IsValid(policy) ?
+        LLBC_INTERNAL_NS __queueFullPolicy2StrRepr[policy] :
+            LLBC_INTERNAL_NS __queueFullPolicy2StrRepr[End];
+}
+
+int LLBC_LogQueueFullPolicy::Str2Policy(const LLBC_CString &policyStr)
+{
+    const LLBC_String upperPolicyStr = LLBC_ToUpper(policyStr.c_str());
+    for (int policy = Begin; policy != End; ++policy)
+    {
+        if (LLBC_INTERNAL_NS __queueFullPolicy2StrRepr[policy] == upperPolicyStr ||
+            LLBC_INTERNAL_NS __queueFullPolicy2StrAliasRepr[policy] == upperPolicyStr)
+            return policy;
+    }
+
+    return End;
+}
+
+bool LLBC_LogQueueFullPolicy::IsValid(int policy)
+{
+    return policy >= Begin && policy < End;
+}
+
+__LLBC_NS_END
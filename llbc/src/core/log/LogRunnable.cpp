@@ -20,22 +20,43 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 
+
 #include "llbc/common/Export.h"
 
 #include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/os/OS_Thread.h"
 #include "llbc/core/objpool/ObjPool.h"
 
 #include "llbc/core/log/LogData.h"
 #include "llbc/core/log/Logger.h"
+#include "llbc/core/log/LogQueueFullPolicy.h"
 #include "llbc/core/log/LogRunnable.h"
 
+namespace
+{
+    // Max allocated log queue shard index.
+    volatile LLBC_NS sint32 __g_maxLogQueueShardIndex = -1;
+    // Per log queue shard capacity.
+    constexpr LLBC_NS sint32 __g_logQueueShardCapacity =
+        MAX(1, LLBC_CFG_LOG_ASYNC_QUEUE_CAPACITY / LLBC_CFG_LOG_ASYNC_QUEUE_SHARD_COUNT);
+    // Block policy producer wait space timeout, in milli-seconds, use to recheck log runnable stopping.
+    constexpr int __g_blockedProducerWaitTimeout = 10;
+}
+
 __LLBC_NS_BEGIN
 
 LLBC_LogRunnable::LLBC_LogRunnable()
 : _stopping(false)
+, _svcThreadId(LLBC_INVALID_NATIVE_THREAD_ID)
+, _waiting(0)
+, _blockedProducers(0)
 {
-    for (size_t i = 0; i < sizeof(_logDatas) / sizeof(_logDatas[0]); ++i)
-        _logDatas[i].reserve(4096);
+    for (auto &shard : _shards)
+    {
+        shard.head = nullptr;
+        shard.count = 0;
+    }
 }
 
 LLBC_LogRunnable::~LLBC_LogRunnable()
@@ -65,8 +86,9 @@ void LLBC_LogRunnable::Stop()
 {
     LLBC_ReturnIf(GetTaskState() == LLBC_TaskState::NotActivated, void());
 
-    // Mask stopping and waiting for thread stopped.
+    // Mask stopping, wakeup and waiting for thread stopped.
     _stopping = true;
+    _waitSem.Post();
     LLBC_ReturnIf(Wait() == LLBC_OK, void());
 
     // If Wait() call failed, maybe call LogRunnable::Stop() in difference thread(eg: in crash hook),
@@ -75,11 +97,14 @@ void LLBC_LogRunnable::Stop()
         LLBC_Sleep(10);
 }
 
-void LLBC_LogRunnable::PushLogData(LLBC_LogData *logData)
+int LLBC_LogRunnable::PushLogData(LLBC_LogData *logData, int queueFullPolicy)
 {
-    _logDataLock.Lock();
-    _logDatas[0].push_back(logData);
-    _logDataLock.Unlock();
+    if (UNLIKELY(!TryPushLogData(logData)))
+        return HandleQueueFull(logData, queueFullPolicy);
+
+    WakeupIfWaiting();
+
+    return LLBC_OK;
 }
 
 void LLBC_LogRunnable::Cleanup()
@@ -89,46 +114,232 @@ void LLBC_LogRunnable::Cleanup()
     FlushLoggers(true, 0);
     _loggers.clear();
 
+    _svcThreadId = LLBC_INVALID_NATIVE_THREAD_ID;
     _stopping = false;
 }
 
 void LLBC_LogRunnable::Svc()
 {
+    _svcThreadId = LLBC_GetCurrentThreadId();
+
+    const int idleWaitTimeout = GetIdleWaitTimeout();
     while (LIKELY(!_stopping))
     {
         if (!TryPopAndProcLogDatas())
-            LLBC_Sleep(1);
+            WaitLogDatas(idleWaitTimeout);
 
         FlushLoggers(false, LLBC_GetMilliseconds());
     }
 }
 
-LLBC_FORCE_INLINE bool LLBC_LogRunnable::TryPopAndProcLogDatas()
+bool LLBC_LogRunnable::TryPopAndProcLogDatas()
 {
-    _logDataLock.Lock();
-    std::swap(_logDatas[0], _logDatas[1]);
-    _logDataLock.Unlock();
+    // Detach all log queue shards, and reverse detached stacks to FIFO order.
+    int listCount = 0;
+    LLBC_LogData *lists[LLBC_CFG_LOG_ASYNC_QUEUE_SHARD_COUNT];
+    for (auto &shard : _shards)
+    {
+        if (!shard.head)
+            continue;
+
+        LLBC_LogData *head;
+        do
+        {
+            head = shard.head;
+        } while (LLBC_AtomicCompareAndExchange<LLBC_LogData>(&shard.head, nullptr, head) != head);
+
+        sint32 count = 0;
+        LLBC_LogData *reversed = nullptr;
+        while (head)
+        {
+            LLBC_LogData *next = head->next;
+            head->next = reversed;
+            reversed = head;
+            head = next;
+
+            ++count;
+        }
+
+        (void)LLBC_AtomicFetchAndSub(&shard.count, count);
+        lists[listCount++] = reversed;
+    }
 
-    auto &logDatas = _logDatas[1];
-    if (logDatas.empty())
+    if (listCount == 0)
         return false;
 
-    for (auto &logData : logDatas)
+    // Log queue shards space freed, wakeup blocked producers.
+    WakeupBlockedProducers();
+
+    // Merge detached lists by log time, and output the log datas of same logger under one output lock.
+    LLBC_Logger *lockedLogger = nullptr;
+    while (listCount > 0)
     {
-        logData->logger->OutputLogData(*logData);
+        int minIdx = 0;
+        for (int i = 1; i < listCount; ++i)
+        {
+            if (lists[i]->logTime < lists[minIdx]->logTime)
+                minIdx = i;
+        }
+
+        LLBC_LogData *logData = lists[minIdx];
+        if (!(lists[minIdx] = logData->next))
+            lists[minIdx] = lists[--listCount];
+
+        if (logData->logger != lockedLogger)
+        {
+            if (lockedLogger)
+                lockedLogger->_outputLock.Unlock();
+
+            lockedLogger = logData->logger;
+            lockedLogger->_outputLock.Lock();
+        }
+
+        lockedLogger->OutputLogData(*logData);
         LLBC_Recycle(logData);
     }
 
-    logDatas.clear();
+    if (lockedLogger)
+        lockedLogger->_outputLock.Unlock();
+
+    return true;
+}
+
+LLBC_FORCE_INLINE bool LLBC_LogRunnable::TryPushLogData(LLBC_LogData *logData)
+{
+    _LogQueueShard &shard = _shards[GetThreadShardIndex()];
+    if (UNLIKELY(LLBC_AtomicFetchAndAdd(&shard.count, 1) >= __g_logQueueShardCapacity))
+    {
+        (void)LLBC_AtomicFetchAndSub(&shard.count, 1);
+        return false;
+    }
+
+    LLBC_LogData *head;
+    do
+    {
+        head = shard.head;
+        logData->next = head;
+    } while (LLBC_AtomicCompareAndExchange(&shard.head, logData, head) != head);
 
     return true;
 }
 
+int LLBC_LogRunnable::HandleQueueFull(LLBC_LogData *logData, int queueFullPolicy)
+{
+    // DropLowLevel policy: drop the log data which level lower than keep level.
+    if (queueFullPolicy == LLBC_LogQueueFullPolicy::DropLowLevel &&
+        logData->level < LLBC_CFG_LOG_ASYNC_QUEUE_FULL_KEEP_LEVEL)
+    {
+        LLBC_Recycle(logData);
+        return LLBC_OK;
+    }
+
+    // SyncOutput policy, or log in log runnable thread(can't block self), output log data directly.
+    if (queueFullPolicy == LLBC_LogQueueFullPolicy::SyncOutput ||
+        LLBC_GetCurrentThreadId() == _svcThreadId)
+        return SyncOutputLogData(logData);
+
+    // Block policy: wait until log queue shard has free space.
+    while (!TryPushLogData(logData))
+    {
+        // Log runnable stopping/stopped, the log queue maybe never be consumed, output log data directly.
+        if (_stopping || !IsActivated())
+            return SyncOutputLogData(logData);
+
+        // Mask blocked(full barrier), and recheck log queue before wait, log runnable thread will
+        // post space semaphore after log queue shards detached.
+        (void)LLBC_AtomicFetchAndAdd(&_blockedProducers, 1);
+        WakeupIfWaiting();
+        if (TryPushLogData(logData))
+            break;
+
+        (void)_spaceSem.TimedWait(__g_blockedProducerWaitTimeout);
+    }
+
+    WakeupIfWaiting();
+
+    return LLBC_OK;
+}
+
+int LLBC_LogRunnable::SyncOutputLogData(LLBC_LogData *logData)
+{
+    LLBC_Logger *logger = logData->logger;
+
+    logger->_outputLock.Lock();
+    const int ret = logger->OutputLogData(*logData);
+    logger->_outputLock.Unlock();
+
+    LLBC_Recycle(logData);
+
+    return ret;
+}
+
+LLBC_FORCE_INLINE bool LLBC_LogRunnable::HasLogDatas() const
+{
+    for (auto &shard : _shards)
+    {
+        if (shard.head)
+            return true;
+    }
+
+    return false;
+}
+
+void LLBC_LogRunnable::WaitLogDatas(int timeout)
+{
+    // Mask waiting(full barrier), and recheck log queue before wait, producers will
+    // post semaphore only if it reset the waiting flag.
+    (void)LLBC_AtomicCompareAndExchange(&_waiting, 1, 0);
+    if (!HasLogDatas() && !_stopping)
+        (void)_waitSem.TimedWait(timeout);
+
+    (void)LLBC_AtomicCompareAndExchange(&_waiting, 0, 1);
+}
+
+LLBC_FORCE_INLINE void LLBC_LogRunnable::WakeupIfWaiting()
+{
+    if (_waiting && LLBC_AtomicCompareAndExchange(&_waiting, 0, 1) == 1)
+        _waitSem.Post();
+}
+
+LLBC_FORCE_INLINE void LLBC_LogRunnable::WakeupBlockedProducers()
+{
+    // Extra posted signal(eg: producer pushed success when rechecking) is harmless, it just makes
+    // some blocked producer recheck log queue once more.
+    if (_blockedProducers)
+    {
+        const sint32 blockedProducers = LLBC_AtomicSet(&_blockedProducers, 0);
+        if (blockedProducers > 0)
+            _spaceSem.Post(blockedProducers);
+    }
+}
+
+int LLBC_LogRunnable::GetIdleWaitTimeout() const
+{
+    sint64 timeout = LLBC_CFG_LOG_DEFAULT_LOG_FLUSH_INTERVAL;
+    for (auto &logger : _loggers)
+        timeout = MIN(timeout, logger->_flushInterval);
+
+    return static_cast<int>(MAX(1, timeout));
+}
+
+int LLBC_LogRunnable::GetThreadShardIndex()
+{
+    static thread_local int threadShardIdx =
+        (LLBC_AtomicFetchAndAdd(&__g_maxLogQueueShardIndex, 1) + 1) % LLBC_CFG_LOG_ASYNC_QUEUE_SHARD_COUNT;
+    return threadShardIdx;
+}
+
 LLBC_FORCE_INLINE void LLBC_LogRunnable::FlushLoggers(bool force, sint64 now)
 {
     const size_t loggerCnt = _loggers.size();
     for (size_t i = 0; i < loggerCnt; ++i)
-        _loggers[i]->Flush(false, now);
+    {
+        LLBC_Logger *logger = _loggers[i];
+
+        logger->_outputLock.Lock();
+        logger->Flush(false, now);
+        logger->_outputLock.Unlock();
+    }
 }
 
 __LLBC_NS_END
@@ -36,6 +36,7 @@
 #include "llbc/core/log/LogRunnable.h"
 
 #include "llbc/core/log/Logger.h"
+#include "llbc/core/log/LoggerMgr.h"
 
 #if LLBC_TARGET_PLATFORM_WIN32
 #pragma warning(disable:4996)
@@ -129,6 +130,7 @@ int LLBC_Logger::Initialize(const LLBC_LoggerConfigInfo *config, LLBC_LogRunnabl
         appenderInitInfo.maxFileSize = _config->GetMaxFileSize();
         appenderInitInfo.maxBackupIndex = _config->GetMaxBackupIndex();
         appenderInitInfo.lazyCreateLogFile = _config->IsLazyCreateLogFile();
+        appenderInitInfo.mmapSegmentSize = _config->IsMmapLogFile() ? _config->GetMmapSegmentSize() : 0;
 
         if (!_config->IsAsyncMode())
             appenderInitInfo.fileBufferSize = 0;
@@ -136,7 +138,34 @@ int LLBC_Logger::Initialize(const LLBC_LoggerConfigInfo *config, LLBC_LogRunnabl
             appenderInitInfo.fileBufferSize = _config->GetFileBufferSize();
 
         LLBC_BaseLogAppender *appender =
-            LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::File);
+            LLBC_LogAppenderBuilderSingleton->BuildAppender(_config->IsBinaryLogFile() ?
+                LLBC_LogAppenderType::BinaryFile : LLBC_LogAppenderType::File);
+        if (appender->Initialize(appenderInitInfo) != LLBC_OK)
+        {
+            LLBC_XDelete(appender);
+            ClearNonRunnableMembers();
+
+            return LLBC_FAILED;
+        }
+
+        AddAppender(appender);
+    }
+
+    // Create network appender, if acquire.
+    if (_config->IsLogToNetwork())
+    {
+        LLBC_LogAppenderInitInfo appenderInitInfo;
+        appenderInitInfo.logLevel = _config->GetNetworkLogLevel();
+        appenderInitInfo.pattern = _config->GetNetworkPattern();
+        appenderInitInfo.ip = _config->GetNetworkIp();
+        appenderInitInfo.port = _config->GetNetworkPort();
+        appenderInitInfo.udp = _config->IsNetworkUdp();
+        appenderInitInfo.frameSize = _config->GetNetworkFrameSize();
+        appenderInitInfo.networkBufferSize = _config->GetNetworkBufferSize();
+        appenderInitInfo.flushInterval = _flushInterval;
+
+        LLBC_BaseLogAppender *appender =
+            LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::Network);
         if (appender->Initialize(appenderInitInfo) != LLBC_OK)
         {
             LLBC_XDelete(appender);
@@ -239,6 +268,9 @@ int LLBC_Logger::SetAppenderLogLevel(int appenderType, int logLevel)
         appender = appender->GetAppenderNext();
     }
 
+    // Invalidate log call site caches.
+    LLBC_LoggerMgr::UpdateLogLevelVersion();
+
     return LLBC_OK;
 }
 
@@ -320,9 +352,7 @@ int LLBC_Logger::VOutput(int level,
         return ret;
     }
 
-    _logRunnable->PushLogData(data);
-
-    return LLBC_OK;
+    return _logRunnable->PushLogData(data, _config->GetAsyncQueueFullPolicy());
 }
 
 int LLBC_Logger::NonFormatOutput(int level,
@@ -359,9 +389,7 @@ int LLBC_Logger::NonFormatOutput(int level,
         return ret;
     }
 
-    _logRunnable->PushLogData(data);
-
-    return LLBC_OK;
+    return _logRunnable->PushLogData(data, _config->GetAsyncQueueFullPolicy());
 }
 
 LLBC_FORCE_INLINE LLBC_LogData *LLBC_Logger::BuildLogData(int level,
@@ -463,6 +491,61 @@ LLBC_FORCE_INLINE LLBC_LogData *LLBC_Logger::BuildLogData(int level,
     return data;
 }
 
+LLBC_LogData *LLBC_Logger::BuildDeferredLogData(int level,
+                                                const char *tag,
+                                                const char *file,
+                                                int line,
+                                                const char *func,
+                                                const char *fmt,
+                                                size_t recordSize)
+{
+    // Alloc new LogData, and adjust message capacity to hold the arguments record.
+    LLBC_LogData *data = _logDataTypedObjPool.Acquire();
+    const int msgCap = MAX(static_cast<int>(recordSize), 192);
+    if (data->msgCap < msgCap)
+    {
+        data->msgCap = msgCap;
+        data->msg = LLBC_Realloc(char, data->msg, msgCap);
+    }
+
+    data->fmt = fmt;
+
+    // Fill LogData other members.
+    FillLogDataNonMsgMembers(level,
+                             tag,
+                             file,
+                             line,
+                             func,
+                             LLBC_GetMicroseconds(),
+                             data,
+                             __LLBC_GetLibTls());
+
+    return data;
+}
+
+int LLBC_Logger::OutputDeferredLogData(LLBC_LogData *data)
+{
+    // Log hooks need formatted message.
+    if (_logHooks[data->level])
+    {
+        data->FormatDeferredMsg();
+        _logHooks[data->level](data);
+    }
+
+    if (!_config->IsAsyncMode())
+    {
+        _lock.Lock();
+        const int ret = OutputLogData(*data);
+        _lock.Unlock();
+
+        LLBC_Recycle(data);
+
+        return ret;
+    }
+
+    return _logRunnable->PushLogData(data, _config->GetAsyncQueueFullPolicy());
+}
+
 LLBC_FORCE_INLINE void LLBC_Logger::FillLogDataNonMsgMembers(int level,
                                                              const char *tag,
                                                              const char *file,
@@ -563,12 +646,16 @@ void LLBC_Logger::AddAppender(LLBC_BaseLogAppender *appender)
     tmpAppender->SetAppenderNext(appender);
 }
 
-int LLBC_Logger::OutputLogData(const LLBC_LogData &data)
+int LLBC_Logger::OutputLogData(LLBC_LogData &data)
 {
     LLBC_BaseLogAppender *appender = _appenders;
     if (!appender)
         return LLBC_OK;
 
+    // Format deferred formatting message, if is deferred formatting log data.
+    if (data.deferredFormatter)
+        data.FormatDeferredMsg();
+
     while (appender)
     {
         if (appender->Output(data) != LLBC_OK)
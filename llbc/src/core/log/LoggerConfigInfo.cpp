@@ -29,6 +29,7 @@
 
 #include "llbc/core/log/LogLevel.h"
 #include "llbc/core/log/LogRollingMode.h"
+#include "llbc/core/log/LogQueueFullPolicy.h"
 #include "llbc/core/log/BaseLogAppender.h"
 #include "llbc/core/log/LoggerConfigInfo.h"
 
@@ -49,6 +50,7 @@ LLBC_LoggerConfigInfo::LLBC_LoggerConfigInfo()
 , _asyncMode(false)
 , _independentThread(false)
 , _flushInterval(0)
+, _asyncQueueFullPolicy(LLBC_CFG_LOG_DEFAULT_ASYNC_QUEUE_FULL_POLICY)
 
 , _addTimestampInJsonLog(0)
 
@@ -65,6 +67,16 @@ LLBC_LoggerConfigInfo::LLBC_LoggerConfigInfo()
 , _maxBackupIndex(0)
 , _fileBufferSize(0)
 , _lazyCreateLogFile(false)
+, _binaryLogFile(false)
+, _mmapLogFile(false)
+, _mmapSegmentSize(LLBC_CFG_LOG_DEFAULT_MMAP_SEGMENT_SIZE)
+
+, _logToNetwork(false)
+, _networkLogLevel(LLBC_LogLevel::End)
+, _networkUdp(false)
+, _networkPort(0)
+, _networkFrameSize(LLBC_CFG_LOG_DEFAULT_NETWORK_FRAME_SIZE)
+, _networkBufferSize(LLBC_CFG_LOG_DEFAULT_NETWORK_BUFFER_SIZE)
 
 , _takeOver(false)
 {
@@ -94,8 +106,18 @@ int LLBC_LoggerConfigInfo::Initialize(const LLBC_String &loggerName,
     _asyncMode = __LLBC_GetLogCfg(
         "asynchronous", ASYNC_MODE, IsAsyncMode, AsLooseBool);
     if (_asyncMode)
+    {
         _independentThread = __LLBC_GetLogCfg(
             "independentThread", INDEPENDENT_THREAD, IsIndependentThread, AsLooseBool);
+
+        if (cfg["asyncQueueFullPolicy"])
+            _asyncQueueFullPolicy = LLBC_LogQueueFullPolicy::Str2Policy(cfg["asyncQueueFullPolicy"].AsStr());
+        else
+            _asyncQueueFullPolicy = _notConfigUseRoot ?
+                rootCfg->GetAsyncQueueFullPolicy() : LLBC_CFG_LOG_DEFAULT_ASYNC_QUEUE_FULL_POLICY;
+        if (!LLBC_LogQueueFullPolicy::IsValid(_asyncQueueFullPolicy))
+            _asyncQueueFullPolicy = LLBC_CFG_LOG_DEFAULT_ASYNC_QUEUE_FULL_POLICY;
+    }
      _flushInterval = __LLBC_GetLogCfg(
          "flushInterval", LOG_FLUSH_INTERVAL, GetFlushInterval, AsInt32);
 
@@ -206,12 +228,70 @@ int LLBC_LoggerConfigInfo::Initialize(const LLBC_String &loggerName,
         _lazyCreateLogFile = __LLBC_GetLogCfg2(
             "lazyCreateLogFile", LLBC_CFG_LOG_LAZY_CREATE_LOG_FILE, IsLazyCreateLogFile, AsLooseBool);
 
+        // Binary log file.
+        _binaryLogFile = __LLBC_GetLogCfg(
+            "binaryLogFile", BINARY_LOG_FILE, IsBinaryLogFile, AsLooseBool);
+
+        // Mmap log file & mmap segment size.
+        _mmapLogFile = __LLBC_GetLogCfg(
+            "mmapLogFile", MMAP_LOG_FILE, IsMmapLogFile, AsLooseBool);
+        if (cfg["mmapSegmentSize"])
+            _mmapSegmentSize = NormalizeLogFileSize(cfg["mmapSegmentSize"]);
+        else
+            _mmapSegmentSize = _notConfigUseRoot ?
+                rootCfg->GetMmapSegmentSize() : LLBC_CFG_LOG_DEFAULT_MMAP_SEGMENT_SIZE;
+
         // File buffer size.
         if (_asyncMode)
             _fileBufferSize = __LLBC_GetLogCfg(
                 "fileBufferSize", LOG_FILE_BUFFER_SIZE, GetFileBufferSize, AsInt32);
     }
 
+    // Network log configs.
+    _logToNetwork = __LLBC_GetLogCfg("logToNetwork", LOG_TO_NETWORK, IsLogToNetwork, AsLooseBool);
+    if (_logToNetwork)
+    {
+        // Network log level.
+        if (cfg["networkLogLevel"])
+            _networkLogLevel = LLBC_LogLevel::GetLevelEnum(cfg["networkLogLevel"].AsStr().c_str());
+        else
+            _networkLogLevel = _notConfigUseRoot ? rootCfg->GetNetworkLogLevel() : LLBC_CFG_LOG_DEFAULT_LEVEL;
+
+        // Network log pattern.
+        if (cfg["networkPattern"])
+            _networkPattern = cfg["networkPattern"].AsStr();
+        else
+            _networkPattern = _notConfigUseRoot ?
+                rootCfg->GetNetworkPattern().c_str() : LLBC_CFG_LOG_DEFAULT_NETWORK_LOG_PATTERN;
+
+        // Network protocol.
+        if (cfg["networkProtocol"])
+            _networkUdp = cfg["networkProtocol"].AsStr().strip().tolower() == "udp";
+        else
+            _networkUdp = _notConfigUseRoot ?
+                rootCfg->IsNetworkUdp() : LLBC_String(LLBC_CFG_LOG_DEFAULT_NETWORK_PROTOCOL).tolower() == "udp";
+
+        // Network log collector address.
+        _networkIp = __LLBC_GetLogCfg2("networkIp", "", GetNetworkIp, AsStr).strip();
+        _networkPort = __LLBC_GetLogCfg2("networkPort", 0, GetNetworkPort, AsUInt16);
+
+        // Network frame size & buffer size.
+        if (cfg["networkFrameSize"])
+            _networkFrameSize = static_cast<int>(MIN(NormalizeLogFileSize(cfg["networkFrameSize"]), INT_MAX));
+        else
+            _networkFrameSize = _notConfigUseRoot ?
+                rootCfg->GetNetworkFrameSize() : LLBC_CFG_LOG_DEFAULT_NETWORK_FRAME_SIZE;
+        if (_networkUdp)
+            _networkFrameSize = MIN(_networkFrameSize, LLBC_CFG_LOG_MAX_NETWORK_UDP_FRAME_SIZE);
+
+        if (cfg["networkBufferSize"])
+            _networkBufferSize = static_cast<int>(MIN(NormalizeLogFileSize(cfg["networkBufferSize"]), INT_MAX));
+        else
+            _networkBufferSize = _notConfigUseRoot ?
+                rootCfg->GetNetworkBufferSize() : LLBC_CFG_LOG_DEFAULT_NETWORK_BUFFER_SIZE;
+        _networkBufferSize = MAX(_networkBufferSize, _networkFrameSize);
+    }
+
     // Misc configs.
     if (!rootCfg)
         _takeOver = __LLBC_GetLogCfg2(
@@ -238,10 +318,15 @@ int LLBC_LoggerConfigInfo::GetAppenderLogLevel(int appenderType) const
     {
         return GetConsoleLogLevel();
     }
-    else if (appenderType == LLBC_LogAppenderType::File)
+    else if (appenderType == LLBC_LogAppenderType::File ||
+             appenderType == LLBC_LogAppenderType::BinaryFile)
     {
         return GetFileLogLevel();
     }
+    else if (appenderType == LLBC_LogAppenderType::Network)
+    {
+        return GetNetworkLogLevel();
+    }
     else
     {
         LLBC_SetLastError(LLBC_ERROR_INVALID);
@@ -192,7 +192,7 @@ int LLBC_LoggerConfigurator::ReConfig(LLBC_Logger *logger) const
     // Re-Config Update appender(s):
     const LLBC_LoggerConfigInfo *info = it->second;
     for (int appenderType = LLBC_LogAppenderType::Begin;
-         appenderType != LLBC_LogAppenderType::Network; // Note: <Network> appender is not supported for now.
+         appenderType != LLBC_LogAppenderType::End;
          ++appenderType)
     {
         // - Appender log level:
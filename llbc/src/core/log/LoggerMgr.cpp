@@ -24,6 +24,7 @@
 
 #include "llbc/core/time/Time.h"
 
+#include "llbc/core/os/OS_Atomic.h"
 #include "llbc/core/os/OS_Console.h"
 
 #include "llbc/core/helper/STLHelper.h"
@@ -39,6 +40,7 @@
 __LLBC_NS_BEGIN
 
 LLBC_FastLock LLBC_LoggerMgr::_uninitColorfulOutputLock;
+volatile sint32 LLBC_LoggerMgr::_logLevelVersion = 1;
 
 LLBC_LoggerMgr::LLBC_LoggerMgr()
 : _sharedLogRunnable(nullptr)
@@ -122,6 +124,9 @@ int LLBC_LoggerMgr::Initialize(const LLBC_String &cfgFilePath)
     if (_sharedLogRunnable)
         _sharedLogRunnable->Activate(1, LLBC_ThreadPriority::BelowNormal);
 
+    // Invalidate log call site caches.
+    UpdateLogLevelVersion();
+
     return LLBC_OK;
 }
 
@@ -143,6 +148,9 @@ int LLBC_LoggerMgr::Reload(const LLBC_String &newCfgFilePath)
             !newCfgFilePath.empty() ? newCfgFilePath : _cfgFilePath) != LLBC_OK)
         return LLBC_FAILED;
 
+    // Loggers log level maybe changed, invalidate log call site caches after reconfig.
+    LLBC_Defer(UpdateLogLevelVersion());
+
     // Re-Config root logger.
     if (logConfigurator->ReConfig(_rootLogger) != LLBC_OK)
         return LLBC_FAILED;
@@ -185,6 +193,15 @@ void LLBC_LoggerMgr::Finalize()
 
     // Clear _cfgFilePath.
     _cfgFilePath.clear();
+
+    // Invalidate log call site caches.
+    UpdateLogLevelVersion();
+}
+
+void LLBC_LoggerMgr::UpdateLogLevelVersion()
+{
+    // Skip the version which version key is 0(reserved for never refreshed log call site).
+    while (((static_cast<uint32>(LLBC_AtomicFetchAndAdd(&_logLevelVersion, 1)) + 1) & LogLevelVersionKeyMask) == 0);
 }
 
 LLBC_Logger *LLBC_LoggerMgr::GetRootLogger() const
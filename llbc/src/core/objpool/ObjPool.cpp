@@ -0,0 +1,191 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/objpool/ObjPool.h"
+
+namespace
+{
+    // Max allocated object type index.
+    volatile LLBC_NS sint32 __g_maxObjTypeIndex = -1;
+
+    // The thread-safe object pools registry.
+    struct __LLBC_ObjPoolRegistry
+    {
+        LLBC_NS LLBC_SpinLock lock;
+        std::set<LLBC_NS LLBC_ObjPool *> objPools;
+
+        int maxMagazineIdx = -1; // Max allocated thread magazine index.
+        std::vector<int> freeMagazineIdxs; // Freed thread magazine indexes, reuse them first.
+    };
+
+    __LLBC_ObjPoolRegistry &__LLBC_GetObjPoolRegistry()
+    {
+        // Construct when first thread-safe object pool construct, destroy after it.
+        static __LLBC_ObjPoolRegistry registry;
+        return registry;
+    }
+
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    // Release magazine reference, delete magazine if no reference.
+    void __LLBC_ReleaseMagazine(LLBC_NS LLBC_ObjPoolMagazine *magazine)
+    {
+        if (magazine->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete magazine;
+    }
+
+    // Thread magazines destroyed flag, after destroyed, objects acquire/release from/to stripes directly.
+    thread_local bool __g_threadMagazinesDestroyed = false;
+
+    // The thread magazines, indexed by typed object pool magazine index.
+    struct __LLBC_ThreadMagazines
+    {
+        std::vector<LLBC_NS LLBC_ObjPoolMagazine *> magazines;
+
+        ~__LLBC_ThreadMagazines()
+        {
+            // Thread exit, drain magazines to it's typed object pools(if not destroyed).
+            for (auto &magazine : magazines)
+            {
+                if (!magazine)
+                    continue;
+
+                magazine->lock.Lock();
+                void *typedObjPool = magazine->typedObjPool.load(std::memory_order_acquire);
+                if (typedObjPool)
+                    magazine->Drain(typedObjPool, magazine);
+                magazine->threadExited.store(true, std::memory_order_release);
+                magazine->lock.Unlock();
+
+                __LLBC_ReleaseMagazine(magazine);
+            }
+
+            magazines.clear();
+            __g_threadMagazinesDestroyed = true;
+        }
+    };
+
+    thread_local __LLBC_ThreadMagazines __g_threadMagazines;
+    #endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+}
+
+__LLBC_NS_BEGIN
+
+int LLBC_ObjPool::AllocTypeIndex()
+{
+    return LLBC_AtomicFetchAndAdd(&__g_maxObjTypeIndex, 1) + 1;
+}
+
+size_t LLBC_ObjPool::TrimAll()
+{
+    auto &registry = __LLBC_GetObjPoolRegistry();
+    LLBC_LockGuard guard(registry.lock);
+
+    size_t trimmedSize = 0;
+    for (auto &objPool : registry.objPools)
+        trimmedSize += objPool->Trim();
+
+    return trimmedSize;
+}
+
+void LLBC_ObjPool::AddToRegistry(LLBC_ObjPool *objPool)
+{
+    auto &registry = __LLBC_GetObjPoolRegistry();
+    LLBC_LockGuard guard(registry.lock);
+    registry.objPools.insert(objPool);
+}
+
+void LLBC_ObjPool::RemoveFromRegistry(LLBC_ObjPool *objPool)
+{
+    auto &registry = __LLBC_GetObjPoolRegistry();
+    LLBC_LockGuard guard(registry.lock);
+    registry.objPools.erase(objPool);
+}
+
+#if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+int LLBC_ObjPool::AllocMagazineIndex()
+{
+    auto &registry = __LLBC_GetObjPoolRegistry();
+    LLBC_LockGuard guard(registry.lock);
+    if (registry.freeMagazineIdxs.empty())
+        return ++registry.maxMagazineIdx;
+
+    const int magazineIdx = registry.freeMagazineIdxs.back();
+    registry.freeMagazineIdxs.pop_back();
+
+    return magazineIdx;
+}
+
+void LLBC_ObjPool::FreeMagazineIndex(int magazineIdx)
+{
+    auto &registry = __LLBC_GetObjPoolRegistry();
+    LLBC_LockGuard guard(registry.lock);
+    registry.freeMagazineIdxs.push_back(magazineIdx);
+}
+
+LLBC_ObjPoolMagazine *LLBC_ObjPool::GetThreadMagazine(int magazineIdx)
+{
+    if (UNLIKELY(__g_threadMagazinesDestroyed))
+        return nullptr;
+
+    auto &magazines = __g_threadMagazines.magazines;
+    return static_cast<size_t>(magazineIdx) < magazines.size() ? magazines[magazineIdx] : nullptr;
+}
+
+LLBC_ObjPoolMagazine *LLBC_ObjPool::CreateThreadMagazine(int magazineIdx,
+                                                         void *typedObjPool,
+                                                         void (*drain)(void *, LLBC_ObjPoolMagazine *))
+{
+    if (UNLIKELY(__g_threadMagazinesDestroyed))
+        return nullptr;
+
+    auto &magazines = __g_threadMagazines.magazines;
+    if (static_cast<size_t>(magazineIdx) >= magazines.size())
+        magazines.resize(magazineIdx + 1, nullptr);
+
+    // Release old magazine(detached from destroyed typed object pool).
+    auto &magazine = magazines[magazineIdx];
+    if (magazine)
+        __LLBC_ReleaseMagazine(magazine);
+
+    // Create magazine, referenced by current thread and typed object pool.
+    magazine = new LLBC_ObjPoolMagazine;
+    magazine->typedObjPool.store(typedObjPool, std::memory_order_relaxed);
+    magazine->Drain = drain;
+    magazine->refCount.store(2, std::memory_order_relaxed);
+    magazine->threadExited.store(false, std::memory_order_relaxed);
+    magazine->objCount = 0;
+    magazine->hits = magazine->misses = magazine->flushes = 0;
+
+    return magazine;
+}
+
+void LLBC_ObjPool::ReleaseMagazine(LLBC_ObjPoolMagazine *magazine)
+{
+    __LLBC_ReleaseMagazine(magazine);
+}
+#endif // LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+
+__LLBC_NS_END
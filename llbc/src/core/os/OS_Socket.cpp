@@ -204,6 +204,27 @@ LLBC_SocketHandle LLBC_CreateTcpSocketEx()
 #endif // LLBC_TARGET_PLATFORM_WIN32
 }
 
+LLBC_SocketHandle LLBC_CreateUdpSocket()
+{
+    LLBC_SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (handle == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+    }
+
+    return handle;
+#else // LLBC_TARGET_PLATFORM_WIN32
+    if (handle == INVALID_SOCKET)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+    }
+
+    return handle;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 int LLBC_ShutdownSocketInput(LLBC_SocketHandle handle)
 {
     if (UNLIKELY(handle == LLBC_INVALID_SOCKET_HANDLE))
@@ -336,6 +357,64 @@ int LLBC_Send(LLBC_SocketHandle handle, const void *buf, int len, int flags)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+int LLBC_SendV(LLBC_SocketHandle handle, const LLBC_SockBuf *buffers, int bufferCount, int flags)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    static_assert(sizeof(LLBC_SockBuf) == sizeof(struct iovec) &&
+                  offsetof(LLBC_SockBuf, buf) == offsetof(struct iovec, iov_base) &&
+                  offsetof(LLBC_SockBuf, len) == offsetof(struct iovec, iov_len),
+                  "LLBC_SockBuf memory layout must be compatible with struct iovec");
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = reinterpret_cast<struct iovec *>(const_cast<LLBC_SockBuf *>(buffers));
+    msg.msg_iovlen = bufferCount;
+
+    ssize_t ret;
+    while ((ret = sendmsg(handle, &msg, flags)) < 0 && errno == EINTR);
+    if (ret == -1)
+    {
+        if (errno == EWOULDBLOCK)
+        {
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+            return LLBC_FAILED;
+        }
+        else if (errno == EAGAIN)
+        {
+            LLBC_SetLastError(LLBC_ERROR_AGAIN);
+            return LLBC_FAILED;
+        }
+
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    return static_cast<int>(ret);
+#else // LLBC_TARGET_PLATFORM_WIN32
+    DWORD bytesSent = 0;
+    int ret = ::WSASend(handle,
+                        const_cast<LLBC_SockBuf *>(buffers),
+                        static_cast<DWORD>(bufferCount),
+                        &bytesSent,
+                        static_cast<DWORD>(flags),
+                        nullptr,
+                        nullptr);
+    if (ret == SOCKET_ERROR)
+    {
+        if (::WSAGetLastError() == WSAEWOULDBLOCK)
+        {
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+            return LLBC_FAILED;
+        }
+
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+        return LLBC_FAILED;
+    }
+
+    return static_cast<int>(bytesSent);
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 int LLBC_SendEx(LLBC_SocketHandle handle,
                 LLBC_SockBuf *buffers,
                 ulong bufferCount,
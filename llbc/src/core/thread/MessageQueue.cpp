@@ -22,6 +22,7 @@
 
 #include "llbc/common/Export.h"
 
+#include "llbc/core/os/OS_Atomic.h"
 #include "llbc/core/objpool/ObjPool.h"
 
 #include "llbc/core/thread/MessageBlock.h"
@@ -29,11 +30,17 @@
 
 __LLBC_NS_BEGIN
 
-LLBC_MessageQueue::LLBC_MessageQueue()
-: _head(nullptr)
+LLBC_MessageQueue::LLBC_MessageQueue(int type)
+: _type(LLBC_MessageQueueType::IsValid(type) ? type : LLBC_MessageQueueType::Locked)
+
+, _head(nullptr)
 , _tail(nullptr)
 
 , _size(0)
+
+, _pushed(nullptr)
+, _mpscSize(0)
+, _mpscWaiting(0)
 {
 }
 
@@ -42,8 +49,33 @@ LLBC_MessageQueue::~LLBC_MessageQueue()
     Cleanup();
 }
 
+int LLBC_MessageQueue::SetType(int type)
+{
+    if (UNLIKELY(!LLBC_MessageQueueType::IsValid(type)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    if (type == _type)
+        return LLBC_OK;
+
+    if (_head || _pushed)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+
+    _type = type;
+
+    return LLBC_OK;
+}
+
 bool LLBC_MessageQueue::PopAll(LLBC_MessageBlock *&blocks)
 {
+    if (_type == LLBC_MessageQueueType::MPSC)
+        return MPSCPopAll(blocks);
+
     _lock.Lock();
     if (_head)
     {
@@ -62,6 +94,24 @@ bool LLBC_MessageQueue::PopAll(LLBC_MessageBlock *&blocks)
 
 void LLBC_MessageQueue::Cleanup()
 {
+    if (_type == LLBC_MessageQueueType::MPSC)
+    {
+        MPSCFetch();
+        while (_head)
+        {
+            LLBC_MessageBlock *block = _head;
+            _head = _head->GetNext();
+
+            LLBC_Recycle(block);
+        }
+
+        _tail = nullptr;
+        (void)LLBC_AtomicFetchAndSub(&_mpscSize, static_cast<sint64>(_size));
+        _size = 0;
+
+        return;
+    }
+
     _lock.Lock();
 
     if (!_head)
@@ -278,4 +328,134 @@ LLBC_FORCE_INLINE void LLBC_MessageQueue::PopBackNonLock(LLBC_MessageBlock *&blo
     _size -= 1;
 }
 
+void LLBC_MessageQueue::MPSCPush(LLBC_MessageBlock *block)
+{
+    // Push block to pushed stack.
+    LLBC_MessageBlock *pushed = _pushed;
+    while (true)
+    {
+        block->SetNext(pushed);
+        LLBC_MessageBlock *prevPushed = LLBC_AtomicCompareAndExchange(&_pushed, block, pushed);
+        if (prevPushed == pushed)
+            break;
+
+        pushed = prevPushed;
+    }
+
+    (void)LLBC_AtomicFetchAndAdd(&_mpscSize, 1);
+
+    // If consumer waiting, wakeup it.
+    if (_mpscWaiting != 0)
+    {
+        #if LLBC_TARGET_PLATFORM_NON_WIN32
+        _lock.Lock();
+        _cond.Notify();
+        _lock.Unlock();
+        #else // LLBC_TARGET_PLATFORM_WIN32
+        _sem.Post();
+        #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+    }
+}
+
+bool LLBC_MessageQueue::MPSCPop(LLBC_MessageBlock *&block, int interval)
+{
+    if (!MPSCFetch())
+    {
+        if (interval == 0)
+            return false;
+
+        do
+        {
+            MPSCWait(interval);
+            if (MPSCFetch())
+                break;
+        } while (interval == static_cast<int>(LLBC_INFINITE));
+
+        if (!_head)
+            return false;
+    }
+
+    block = _head;
+    if (!(_head = _head->GetNext()))
+        _tail = nullptr;
+    block->SetNext(nullptr);
+
+    _size -= 1;
+    (void)LLBC_AtomicFetchAndSub(&_mpscSize, 1);
+
+    return true;
+}
+
+bool LLBC_MessageQueue::MPSCPopAll(LLBC_MessageBlock *&blocks)
+{
+    if (!MPSCFetch())
+        return false;
+
+    blocks = _head;
+    _head = _tail = nullptr;
+
+    (void)LLBC_AtomicFetchAndSub(&_mpscSize, static_cast<sint64>(_size));
+    _size = 0;
+
+    return true;
+}
+
+bool LLBC_MessageQueue::MPSCFetch()
+{
+    if (!_pushed)
+        return _head != nullptr;
+
+    // Take all pushed blocks.
+    LLBC_MessageBlock *pushed = _pushed;
+    LLBC_MessageBlock *prevPushed;
+    while ((prevPushed = LLBC_AtomicCompareAndExchange(&_pushed,
+                                                       static_cast<LLBC_MessageBlock *>(nullptr),
+                                                       pushed)) != pushed)
+        pushed = prevPushed;
+
+    // Reverse to push order.
+    LLBC_MessageBlock *first = nullptr;
+    LLBC_MessageBlock * const last = pushed;
+    while (pushed)
+    {
+        LLBC_MessageBlock *next = pushed->GetNext();
+        pushed->SetNext(first);
+        first = pushed;
+        pushed = next;
+
+        _size += 1;
+    }
+
+    // Append to consumer list.
+    if (_tail)
+        _tail->SetNext(first);
+    else
+        _head = first;
+    _tail = last;
+
+    return true;
+}
+
+void LLBC_MessageQueue::MPSCWait(int interval)
+{
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    _lock.Lock();
+    (void)LLBC_AtomicFetchAndAdd(&_mpscWaiting, 1);
+    if (!_pushed)
+        _cond.TimedWait(_lock, interval);
+    (void)LLBC_AtomicFetchAndSub(&_mpscWaiting, 1);
+    _lock.Unlock();
+    #else // LLBC_TARGET_PLATFORM_WIN32
+    (void)LLBC_AtomicFetchAndAdd(&_mpscWaiting, 1);
+    if (!_pushed)
+    {
+        if (interval == static_cast<int>(LLBC_INFINITE))
+            _sem.Wait();
+        else
+            (void)_sem.TimedWait(interval);
+    }
+    (void)LLBC_AtomicFetchAndSub(&_mpscWaiting, 1);
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 __LLBC_NS_END
@@ -0,0 +1,74 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/core/objpool/ObjPool.h"
+#include "llbc/core/thread/SharedMessageBlock.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_MessageBlock *LLBC_SharedMessageBlock::CreateSlice(size_t offset,
+                                                        size_t len,
+                                                        LLBC_TypedObjPool<LLBC_MessageBlock> *blockPool)
+{
+    if (UNLIKELY(offset + len > _block.GetSize()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_RANGE);
+        return nullptr;
+    }
+
+    Retain();
+    char *sliceBuf = reinterpret_cast<char *>(_block.GetData()) + offset;
+
+    LLBC_MessageBlock *slice;
+    if (blockPool)
+    {
+        // Recycled slice block is bufferless, only the first acquired block need free self-owned buffer.
+        slice = blockPool->Acquire();
+        slice->Release();
+
+        slice->_attach = true;
+        slice->_buf = sliceBuf;
+        slice->_size = len;
+    }
+    else
+    {
+        slice = new LLBC_MessageBlock(sliceBuf, len, true);
+    }
+
+    slice->SetWritePos(len);
+    slice->_sharedOwner = this;
+
+    return slice;
+}
+
+void LLBC_MessageBlock::ReleaseSharedOwner()
+{
+    LLBC_SharedMessageBlock *sharedOwner = _sharedOwner;
+    _sharedOwner = nullptr;
+
+    sharedOwner->Release();
+}
+
+__LLBC_NS_END
@@ -54,6 +54,10 @@ int LLBC_Task::Activate(int threadNum,
 {
     // Parameters check.
     LLBC_SetErrAndReturnIf(threadNum <= 0, LLBC_ERROR_ARG, LLBC_FAILED);
+    // MPSC message queue only support single consumer thread.
+    LLBC_SetErrAndReturnIf(threadNum > 1 && _msgQueue.GetType() == LLBC_MessageQueueType::MPSC,
+                           LLBC_ERROR_NOT_ALLOW,
+                           LLBC_FAILED);
 
     // Lock.
     _lock.Lock();
@@ -106,6 +110,14 @@ int LLBC_Task::Activate(int threadNum,
     return LLBC_OK;
 }
 
+int LLBC_Task::SetMessageQueueType(int type)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_taskState != LLBC_TaskState::NotActivated, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
+
+    return _msgQueue.SetType(type);
+}
+
 int LLBC_Task::Wait()
 {
     // Task state check.
@@ -49,7 +49,7 @@ LLBC_Timer::~LLBC_Timer()
     {
         Cancel();
         if (--_timerData->refCount == 0)
-            delete _timerData;
+            LLBC_TimerData::Release(_timerData);
     }
 
     if (_data)
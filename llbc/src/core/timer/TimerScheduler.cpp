@@ -28,14 +28,90 @@
 #include "llbc/core/timer/TimerData.h"
 #include "llbc/core/timer/TimerScheduler.h"
 
+namespace
+{
+
+/**
+ * \brief The thread timer data free list.
+ */
+struct __LLBC_TimerDataFreeList
+{
+    LLBC_NS LLBC_TimerData *head = nullptr;
+    size_t size = 0;
+    bool destroyed = false;
+
+    ~__LLBC_TimerDataFreeList()
+    {
+        while (head)
+        {
+            LLBC_NS LLBC_TimerData *data = head;
+            head = head->wheelNext;
+            delete data;
+        }
+
+        size = 0;
+        destroyed = true;
+    }
+};
+
+thread_local __LLBC_TimerDataFreeList __g_timerDataFreeList;
+
+}
+
 __LLBC_NS_BEGIN
 
-LLBC_TimerScheduler::LLBC_TimerScheduler()
-: _maxTimerId(0)
+LLBC_TimerData *LLBC_TimerData::Acquire()
+{
+    __LLBC_TimerDataFreeList &freeList = __g_timerDataFreeList;
+
+    LLBC_TimerData *data = freeList.head;
+    if (data)
+    {
+        freeList.head = data->wheelNext;
+        --freeList.size;
+    }
+    else
+    {
+        data = new LLBC_TimerData;
+    }
+
+    memset(data, 0, sizeof(LLBC_TimerData));
+
+    return data;
+}
+
+void LLBC_TimerData::Release(LLBC_TimerData *data)
+{
+    __LLBC_TimerDataFreeList &freeList = __g_timerDataFreeList;
+    if (UNLIKELY(freeList.destroyed ||
+                 freeList.size >= LLBC_CFG_CORE_TIMER_DATA_FREE_LIST_LIMIT))
+    {
+        delete data;
+        return;
+    }
+
+    data->wheelNext = freeList.head;
+    freeList.head = data;
+    ++freeList.size;
+}
+
+bool LLBC_TimerSchedulerType::IsValid(int type)
+{
+    return type >= Begin && type < End;
+}
+
+LLBC_TimerScheduler::LLBC_TimerScheduler(int type)
+: _type(LLBC_TimerSchedulerType::IsValid(type) ? type : LLBC_TimerSchedulerType::Heap)
+, _maxTimerId(0)
 , _enabled(true)
 , _destroying(false)
 , _cancelingAll(false)
+
+, _wheelTime(LLBC_GetMilliseconds())
+, _wheelTimerCount(0)
 {
+    memset(_wheelLevelTimerCounts, 0, sizeof(_wheelLevelTimerCounts));
+    memset(_wheelSlots, 0, sizeof(_wheelSlots));
 }
 
 LLBC_TimerScheduler::~LLBC_TimerScheduler()
@@ -53,7 +129,26 @@ LLBC_TimerScheduler::~LLBC_TimerScheduler()
         }
 
         if (--data->refCount == 0)
-            delete data;
+            LLBC_TimerData::Release(data);
+    }
+
+    for (auto &slot : _wheelSlots)
+    {
+        while (slot)
+        {
+            LLBC_TimerData *data = slot;
+            RemoveFromWheel(data);
+            if (data->validate)
+            {
+                data->validate = false;
+                data->cancelling = true;
+                data->timer->OnCancel();
+                data->cancelling = false;
+            }
+
+            if (--data->refCount == 0)
+                LLBC_TimerData::Release(data);
+        }
     }
 }
 
@@ -65,74 +160,15 @@ LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetCurrentThreadScheduler()
 
 void LLBC_TimerScheduler::Update()
 {
-    LLBC_ReturnIf(_enabled == false || _heap.empty(), void());
-
-    sint64 now = LLBC_GetMilliseconds();
-    while (_heap.empty() == false)
+    if (_type == LLBC_TimerSchedulerType::Heap)
     {
-        LLBC_TimerData *data = _heap.top();
-        if(data == nullptr)
-        {
-            _heap.pop();
-            continue;
-        }
-
-        if (now < data->handle)
-            break;
-
-        _heap.pop();
-        if (!data->validate)
-        {
-            if (--data->refCount == 0)
-                delete data;
-
-            continue;
-        }
-
-        data->timeouting = true;
-
-        bool reSchedule = true;
-        LLBC_Timer *timer = data->timer;
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        sint64 pseudoNow = now;
-        while (pseudoNow >= data->handle)
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        {
-            ++data->repeatTimes;
-            timer->OnTimeout();
-
-            // Cancel() or Schedule() called.
-            if (!data->validate)
-            {
-                reSchedule = false;
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-                break;
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-            }
-
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-            if (data->period == 0)
-                break;
-
-            if (UNLIKELY(pseudoNow < data->period))
-                break;
-
-            pseudoNow -= data->period;
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        }
-
-        data->timeouting = false;
-        if (reSchedule)
-        {
-            sint64 delay = (data->period != 0) ? (now - data->handle) % data->period : 0;
-            data->handle = now + data->period - delay;
-            _heap.push(data);
-        }
-        else
-        {
-            if (--data->refCount == 0)
-                delete data;
-        }
+        LLBC_ReturnIf(_enabled == false || _heap.empty(), void());
+        UpdateHeap(LLBC_GetMilliseconds());
+    }
+    else
+    {
+        LLBC_ReturnIf(_enabled == false, void());
+        UpdateWheel(LLBC_GetMilliseconds());
     }
 }
 
@@ -148,7 +184,47 @@ void LLBC_TimerScheduler::SetEnabled(bool enabled)
 
 size_t LLBC_TimerScheduler::GetTimerCount() const
 {
-    return _heap.size();
+    return _type == LLBC_TimerSchedulerType::Heap ? _heap.size() : _wheelTimerCount;
+}
+
+sint64 LLBC_TimerScheduler::GetNextTimeoutTime() const
+{
+    if (_type == LLBC_TimerSchedulerType::TimingWheel)
+        return _enabled ? GetWheelNextTimeoutTime() : -1;
+
+    if (!_enabled || _heap.empty())
+        return -1;
+
+    const LLBC_TimerData *data = _heap.top();
+    return data ? data->handle : 0;
+}
+
+int LLBC_TimerScheduler::GetType() const
+{
+    return _type;
+}
+
+int LLBC_TimerScheduler::SetType(int type)
+{
+    if (UNLIKELY(!LLBC_TimerSchedulerType::IsValid(type)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    if (type == _type)
+        return LLBC_OK;
+
+    if (!_heap.empty() || _wheelTimerCount != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+
+    _type = type;
+    _wheelTime = LLBC_GetMilliseconds();
+
+    return LLBC_OK;
 }
 
 bool LLBC_TimerScheduler::IsDestroyed() const
@@ -169,9 +245,9 @@ int LLBC_TimerScheduler::Schedule(LLBC_Timer *timer, sint64 dueTime, sint64 peri
         return LLBC_FAILED;
     }
 
-    auto *data = new LLBC_TimerData;
-    memset(data, 0, sizeof(LLBC_TimerData));
-    data->handle = LLBC_GetMilliseconds() + dueTime;
+    const sint64 now = LLBC_GetMilliseconds();
+    auto *data = LLBC_TimerData::Acquire();
+    data->handle = now + dueTime;
     data->timerId = ++_maxTimerId;
     data->dueTime = dueTime;
     data->period = period;
@@ -182,11 +258,22 @@ int LLBC_TimerScheduler::Schedule(LLBC_Timer *timer, sint64 dueTime, sint64 peri
     if (timer->_timerData)
     {
         if (--timer->_timerData->refCount == 0)
-            delete timer->_timerData;
+            LLBC_TimerData::Release(timer->_timerData);
     }
 
     timer->_timerData = data;
-    _heap.push(data);
+    if (_type == LLBC_TimerSchedulerType::Heap)
+    {
+        _heap.push(data);
+    }
+    else
+    {
+        // No timer in wheel, fast forward wheel time, avoid catch up idle ticks in next update.
+        if (_wheelTimerCount == 0 && _wheelTime < now)
+            _wheelTime = now;
+
+        AddToWheel(data);
+    }
 
     return LLBC_OK;
 }
@@ -211,13 +298,30 @@ int LLBC_TimerScheduler::Cancel(LLBC_Timer *timer)
     if (data->timeouting)
         return LLBC_OK;
 
+    // Timing wheel scheduler always remove timer immediately.
+    if (_type == LLBC_TimerSchedulerType::TimingWheel)
+    {
+        // Maybe already removed(OnCancel() reentry Cancel()).
+        if (!data->wheelPprev)
+            return LLBC_OK;
+
+        RemoveFromWheel(data);
+        if (--data->refCount == 0)
+        {
+            LLBC_TimerData::Release(data);
+            timer->_timerData = nullptr;
+        }
+
+        return LLBC_OK;
+    }
+
     if (!_cancelingAll &&
         data->handle - LLBC_GetMilliseconds() >= LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME)
     {
         _heap.erase(data);
         if (--data->refCount == 0)
         {
-            delete data;
+            LLBC_TimerData::Release(data);
             timer->_timerData = nullptr;
         }
     }
@@ -231,14 +335,301 @@ void LLBC_TimerScheduler::CancelAll()
         return;
 
     _cancelingAll = true;
-    for(auto &elem : _heap)
+    if (_type == LLBC_TimerSchedulerType::Heap)
     {
-        LLBC_TimerData *data = elem;
-        if (LIKELY(data->validate))
-            data->timer->Cancel();
+        for(auto &elem : _heap)
+        {
+            LLBC_TimerData *data = elem;
+            if (LIKELY(data->validate))
+                data->timer->Cancel();
+        }
+    }
+    else
+    {
+        // Wheel timers removed from slot when cancelled.
+        for (auto &slot : _wheelSlots)
+        {
+            while (slot)
+                slot->timer->Cancel();
+        }
     }
 
     _cancelingAll = false;
 }
 
+bool LLBC_TimerScheduler::HandleTimeout(LLBC_TimerData *data, sint64 now)
+{
+    data->timeouting = true;
+
+    bool reSchedule = true;
+    LLBC_Timer *timer = data->timer;
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+    sint64 pseudoNow = now;
+    while (pseudoNow >= data->handle)
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+    {
+        ++data->repeatTimes;
+        timer->OnTimeout();
+
+        // Cancel() or Schedule() called.
+        if (!data->validate)
+        {
+            reSchedule = false;
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+            break;
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+        }
+
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+        if (data->period == 0)
+            break;
+
+        if (UNLIKELY(pseudoNow < data->period))
+            break;
+
+        pseudoNow -= data->period;
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+    }
+
+    data->timeouting = false;
+    if (reSchedule)
+    {
+        sint64 delay = (data->period != 0) ? (now - data->handle) % data->period : 0;
+        data->handle = now + data->period - delay;
+    }
+
+    return reSchedule;
+}
+
+void LLBC_TimerScheduler::UpdateHeap(sint64 now)
+{
+    while (_heap.empty() == false)
+    {
+        LLBC_TimerData *data = _heap.top();
+        if(data == nullptr)
+        {
+            _heap.pop();
+            continue;
+        }
+
+        if (now < data->handle)
+            break;
+
+        _heap.pop();
+        if (!data->validate)
+        {
+            if (--data->refCount == 0)
+                LLBC_TimerData::Release(data);
+
+            continue;
+        }
+
+        if (HandleTimeout(data, now))
+        {
+            _heap.push(data);
+        }
+        else
+        {
+            if (--data->refCount == 0)
+                LLBC_TimerData::Release(data);
+        }
+    }
+}
+
+void LLBC_TimerScheduler::UpdateWheel(sint64 now)
+{
+    // No timer in wheel, fast forward wheel time.
+    if (_wheelTimerCount == 0)
+    {
+        if (_wheelTime < now)
+            _wheelTime = now;
+
+        return;
+    }
+
+    while (_wheelTime <= now)
+    {
+        const sint64 tick = _wheelTime;
+        const int slotIdx = static_cast<int>(tick & (_WheelSlotCount0 - 1));
+        if (slotIdx == 0)
+            CascadeWheel(tick);
+
+        // No timer in level 0, skip to next level 0 round.
+        if (_wheelLevelTimerCounts[0] == 0)
+        {
+            _wheelTime = MIN(tick | (_WheelSlotCount0 - 1), now) + 1;
+            continue;
+        }
+
+        // Move current tick timers to pending slot, timers scheduled in timeout
+        // callbacks will be added to next tick or later.
+        LLBC_TimerData *&pending = _wheelSlots[_WheelPendingSlot];
+        LLBC_TimerData *&slot = _wheelSlots[slotIdx];
+        if (slot)
+        {
+            pending = slot;
+            pending->wheelPprev = &pending;
+            slot = nullptr;
+
+            for (LLBC_TimerData *data = pending; data; data = data->wheelNext)
+            {
+                --_wheelLevelTimerCounts[0];
+                ++_wheelLevelTimerCounts[_WheelLevelCount];
+                data->wheelLevel = _WheelLevelCount;
+            }
+        }
+
+        _wheelTime = tick + 1;
+        while (pending)
+        {
+            LLBC_TimerData *data = pending;
+            RemoveFromWheel(data);
+
+            if (HandleTimeout(data, now))
+            {
+                AddToWheel(data);
+            }
+            else
+            {
+                if (--data->refCount == 0)
+                    LLBC_TimerData::Release(data);
+            }
+        }
+    }
+}
+
+void LLBC_TimerScheduler::CascadeWheel(sint64 tick)
+{
+    for (int level = 1; level < _WheelLevelCount; ++level)
+    {
+        const int shift = _WheelSlotBits0 + (level - 1) * _WheelSlotBitsN;
+        const int slotIdx = static_cast<int>((tick >> shift) & (_WheelSlotCountN - 1));
+
+        // Take out slot timers, and readd to wheel.
+        LLBC_TimerData *&slot = _wheelSlots[GetWheelSlotIndex(level, slotIdx)];
+        while (slot)
+        {
+            LLBC_TimerData *data = slot;
+            RemoveFromWheel(data);
+            AddToWheel(data);
+        }
+
+        // Only cascade next level when this level round finished.
+        if (slotIdx != 0)
+            break;
+    }
+}
+
+void LLBC_TimerScheduler::AddToWheel(LLBC_TimerData *data)
+{
+    // Expired timers add to current tick slot.
+    sint64 expires = MAX(data->handle, _wheelTime);
+    sint64 delta = expires - _wheelTime;
+
+    int level;
+    LLBC_TimerData **slot;
+    if (delta < _WheelSlotCount0)
+    {
+        level = 0;
+        slot = &_wheelSlots[expires & (_WheelSlotCount0 - 1)];
+    }
+    else
+    {
+        // Out of wheel range timers add to last level, will be cascaded again when reached.
+        static constexpr sint64 maxDelta = (1ll << (_WheelSlotBits0 + (_WheelLevelCount - 1) * _WheelSlotBitsN)) - 1;
+        if (delta > maxDelta)
+        {
+            delta = maxDelta;
+            expires = _wheelTime + maxDelta;
+        }
+
+        level = 1;
+        int shift = _WheelSlotBits0;
+        while (delta >= (1ll << (shift + _WheelSlotBitsN)))
+        {
+            ++level;
+            shift += _WheelSlotBitsN;
+        }
+
+        slot = &_wheelSlots[GetWheelSlotIndex(level, static_cast<int>((expires >> shift) & (_WheelSlotCountN - 1)))];
+    }
+
+    data->wheelLevel = static_cast<uint8>(level);
+    data->wheelNext = *slot;
+    if (data->wheelNext)
+        data->wheelNext->wheelPprev = &data->wheelNext;
+    data->wheelPprev = slot;
+    *slot = data;
+
+    ++_wheelLevelTimerCounts[level];
+    ++_wheelTimerCount;
+}
+
+void LLBC_TimerScheduler::RemoveFromWheel(LLBC_TimerData *data)
+{
+    *data->wheelPprev = data->wheelNext;
+    if (data->wheelNext)
+        data->wheelNext->wheelPprev = data->wheelPprev;
+
+    data->wheelNext = nullptr;
+    data->wheelPprev = nullptr;
+
+    --_wheelLevelTimerCounts[data->wheelLevel];
+    --_wheelTimerCount;
+}
+
+sint64 LLBC_TimerScheduler::GetWheelNextTimeoutTime() const
+{
+    if (_wheelTimerCount == 0)
+        return -1;
+
+    if (_wheelSlots[_WheelPendingSlot])
+        return _wheelTime - 1;
+
+    // Level 0: exact timeout time.
+    sint64 nextTimeoutTime = -1;
+    if (_wheelLevelTimerCounts[0] != 0)
+    {
+        for (int i = 0; i < _WheelSlotCount0; ++i)
+        {
+            if (_wheelSlots[(_wheelTime + i) & (_WheelSlotCount0 - 1)])
+            {
+                nextTimeoutTime = _wheelTime + i;
+                break;
+            }
+        }
+    }
+
+    // Level 1~N: slot begin time(maybe earlier than actual timeout time).
+    for (int level = 1; level < _WheelLevelCount; ++level)
+    {
+        if (_wheelLevelTimerCounts[level] == 0)
+            continue;
+
+        // If wheel time at current slot begin time, current slot not cascaded yet.
+        const int shift = _WheelSlotBits0 + (level - 1) * _WheelSlotBitsN;
+        const sint64 base = _wheelTime >> shift;
+        const int beginIdx = (_wheelTime & ((1ll << shift) - 1)) == 0 ? 0 : 1;
+        for (int i = beginIdx; i < beginIdx + _WheelSlotCountN; ++i)
+        {
+            if (_wheelSlots[GetWheelSlotIndex(level, static_cast<int>((base + i) & (_WheelSlotCountN - 1)))])
+            {
+                const sint64 slotBeginTime = (base + i) << shift;
+                if (nextTimeoutTime == -1 || slotBeginTime < nextTimeoutTime)
+                    nextTimeoutTime = slotBeginTime;
+
+                break;
+            }
+        }
+    }
+
+    return nextTimeoutTime;
+}
+
+int LLBC_TimerScheduler::GetWheelSlotIndex(int level, int slotIdx)
+{
+    return level == 0 ?
+        slotIdx : _WheelSlotCount0 + (level - 1) * _WheelSlotCountN + slotIdx;
+}
+
 __LLBC_NS_END
@@ -20,9 +20,75 @@
 
 #include "llbc/core/config/Ini.h"
 #include "llbc/core/tinyxml2/tinyxml2.h"
+#include "llbc/core/variant/CompactVariant.h"
 
 #include "llbc/core/utils/Util_Variant.h"
 
+__LLBC_INTERNAL_NS_BEGIN
+
+static void __Xml2VariantChildren(const LLBC_TINYXML2_NS XMLNode &node, LLBC_NS LLBC_Variant &var)
+{
+    auto &childrenVar = var[LLBC_NS LLBC_XMLKeys::Children];
+    childrenVar.BecomeSeq();
+
+    // Build child elements directly in children sequence, avoid temporary variant deep copy.
+    size_t childCount = 0;
+    auto child = node.FirstChildElement();
+    for (; child; child = child->NextSiblingElement())
+        ++childCount;
+
+    if (childCount == 0)
+        return;
+
+    childrenVar.SeqResize(childCount);
+
+    size_t childIdx = 0;
+    for (child = node.FirstChildElement(); child; child = child->NextSiblingElement(), ++childIdx)
+    {
+        auto &childVar = childrenVar[childIdx];
+        LLBC_NS LLBC_VariantUtil::Xml2Variant(*child, childVar);
+
+        const auto &childName = childVar[LLBC_NS LLBC_XMLKeys::Name];
+        if (var.DictFind(childName) == var.DictEnd())
+            var.DictInsert(childName, childVar);
+    }
+}
+
+static void __Xml2CompactVariantChildren(const LLBC_TINYXML2_NS XMLNode &node,
+                                         size_t childCount,
+                                         LLBC_NS LLBC_CompactVariant &var,
+                                         LLBC_NS LLBC_CompactVariantArena &arena)
+{
+    // Caller reserved 1 + childCount entries in var for children sequence and child names.
+    auto &childrenVar = var.DictAppend(LLBC_NS LLBC_XMLKeys::Children, arena);
+    childrenVar.BecomeSeq(childCount, arena);
+
+    size_t childIdx = 0;
+    auto child = node.FirstChildElement();
+    for (; child; child = child->NextSiblingElement(), ++childIdx)
+    {
+        auto &childVar = childrenVar.SeqAt(childIdx);
+        LLBC_NS LLBC_VariantUtil::Xml2Variant(*child, childVar, arena);
+
+        // Duplicate child names removed by DictSeal(), keep the first one as LLBC_Variant version.
+        var.DictAppend(*childVar.DictFind(LLBC_NS LLBC_XMLKeys::Name)) = childVar;
+    }
+
+    var.DictSeal();
+}
+
+static size_t __GetXmlChildCount(const LLBC_TINYXML2_NS XMLNode &node)
+{
+    size_t childCount = 0;
+    auto child = node.FirstChildElement();
+    for (; child; child = child->NextSiblingElement())
+        ++childCount;
+
+    return childCount;
+}
+
+__LLBC_INTERNAL_NS_END
+
 __LLBC_NS_BEGIN
 
 const LLBC_String LLBC_XMLKeys::Name("__name__");
@@ -54,19 +120,7 @@ void LLBC_VariantUtil::Xml2Variant(const LLBC_TINYXML2_NS XMLDocument &doc, LLBC
     else
         var.BecomeDict();
 
-    auto &childrenVar = var[LLBC_XMLKeys::Children];
-    childrenVar.BecomeSeq();
-
-    auto child = doc.FirstChildElement();
-    for (; child; child = child->NextSiblingElement())
-    {
-        LLBC_Variant childVar;
-        Xml2Variant(*child, childVar);
-
-        childrenVar.SeqPushBack(childVar);
-        if (var.DictFind(childVar[LLBC_XMLKeys::Name]) == var.DictEnd())
-            var.DictInsert(childVar[LLBC_XMLKeys::Name], childVar);
-    }
+    LLBC_INL_NS __Xml2VariantChildren(doc, var);
 }
 
 void LLBC_VariantUtil::Xml2Variant(const LLBC_TINYXML2_NS XMLElement &elem, LLBC_Variant &var)
@@ -89,18 +143,63 @@ void LLBC_VariantUtil::Xml2Variant(const LLBC_TINYXML2_NS XMLElement &elem, LLBC
         attrsVar[attr->Name()] = attr->Value();
 
     // Children elements.
-    auto &childrenVar = var[LLBC_XMLKeys::Children];
-    childrenVar.BecomeSeq();
+    LLBC_INL_NS __Xml2VariantChildren(elem, var);
+}
 
-    auto child = elem.FirstChildElement();
-    for (; child; child = child->NextSiblingElement())
+void LLBC_VariantUtil::Ini2Variant(const LLBC_Ini &ini, LLBC_CompactVariant &var, LLBC_CompactVariantArena &arena)
+{
+    auto &sections = ini.GetAllSections();
+    var.BecomeDict(sections.size(), arena);
+    for (auto &section : sections)
     {
-        LLBC_Variant childVar;
-        Xml2Variant(*child, childVar);
-        childrenVar.SeqPushBack(childVar);
-        if (var.DictFind(childVar[LLBC_XMLKeys::Name]) == var.DictEnd())
-            var.DictInsert(childVar[LLBC_XMLKeys::Name], childVar);
+        auto &sectionVar = var.DictAppend(section.first, arena);
+        auto &sectionVals = section.second->GetAllValues();
+        sectionVar.BecomeDict(sectionVals.size(), arena);
+        for (auto &sectionVal : sectionVals)
+            sectionVar.DictAppend(sectionVal.first, arena).FromVariant(sectionVal.second, arena);
+
+        sectionVar.DictSeal();
     }
+
+    var.DictSeal();
+}
+
+void LLBC_VariantUtil::Xml2Variant(const LLBC_TINYXML2_NS XMLDocument &doc,
+                                   LLBC_CompactVariant &var,
+                                   LLBC_CompactVariantArena &arena)
+{
+    const size_t childCount = LLBC_INL_NS __GetXmlChildCount(doc);
+    var.BecomeDict(1 + childCount, arena);
+
+    LLBC_INL_NS __Xml2CompactVariantChildren(doc, childCount, var, arena);
+}
+
+void LLBC_VariantUtil::Xml2Variant(const LLBC_TINYXML2_NS XMLElement &elem,
+                                   LLBC_CompactVariant &var,
+                                   LLBC_CompactVariantArena &arena)
+{
+    // Element entries: name, value, attrs, children, and one entry per child name.
+    const size_t childCount = LLBC_INL_NS __GetXmlChildCount(elem);
+    var.BecomeDict(4 + childCount, arena);
+
+    // Elemment name/value.
+    var.DictAppend(LLBC_XMLKeys::Name, arena).SetStr(elem.Name(), arena);
+    var.DictAppend(LLBC_XMLKeys::Value, arena).SetStr(elem.GetText(), arena);
+
+    // Element attrs.
+    size_t attrCount = 0;
+    auto attr = elem.FirstAttribute();
+    for (; attr; attr = attr->Next())
+        ++attrCount;
+
+    auto &attrsVar = var.DictAppend(LLBC_XMLKeys::Attrs, arena);
+    attrsVar.BecomeDict(attrCount, arena);
+    for (attr = elem.FirstAttribute(); attr; attr = attr->Next())
+        attrsVar.DictAppend(attr->Name(), arena).SetStr(attr->Value(), arena);
+    attrsVar.DictSeal();
+
+    // Children elements.
+    LLBC_INL_NS __Xml2CompactVariantChildren(elem, childCount, var, arena);
 }
 
 __LLBC_NS_END
\ No newline at end of file
@@ -0,0 +1,476 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include <float.h>
+
+#include "llbc/core/utils/Util_Text.h"
+#include "llbc/core/variant/Variant.h"
+#include "llbc/core/variant/CompactVariant.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// The scratch value returned when DictAppend() failed, write to it never affect any dictionary.
+static thread_local LLBC_NS LLBC_CompactVariant __g_dictAppendScratch;
+
+static inline bool __StrEqual(const LLBC_NS LLBC_CString &left, const LLBC_NS LLBC_CString &right)
+{
+    return left.size() == right.size() &&
+           memcmp(left.data(), right.data(), left.size()) == 0;
+}
+
+static LLBC_NS LLBC_CompactVariant &__GetDictAppendScratch(int errNo)
+{
+    LLBC_NS LLBC_SetLastError(errNo);
+    __g_dictAppendScratch.SetNil();
+
+    return __g_dictAppendScratch;
+}
+
+__LLBC_INTERNAL_NS_END
+
+std::ostream &operator<<(std::ostream &o, const LLBC_NS LLBC_CompactVariant &var)
+{
+    LLBC_NS LLBC_String str = var.ToString();
+    o.write(str.c_str(), str.size());
+
+    return o;
+}
+
+__LLBC_NS_BEGIN
+
+LLBC_CompactVariantArena::LLBC_CompactVariantArena(size_t blockSize)
+: _blockSize(MAX(blockSize, static_cast<size_t>(64)))
+, _curBlock(nullptr)
+, _usedSize(0)
+, _reservedSize(0)
+{
+}
+
+LLBC_CompactVariantArena::~LLBC_CompactVariantArena()
+{
+    Reset();
+}
+
+void *LLBC_CompactVariantArena::Allocate(size_t size)
+{
+    size = MAX((size + 7) & ~static_cast<size_t>(7), static_cast<size_t>(8));
+    _usedSize += size;
+
+    // Large allocation: use dedicated block, link it after current block to keep current block's free space.
+    if (size > _blockSize / 4)
+    {
+        _Block *block = NewBlock(size);
+        block->used = size;
+        if (_curBlock)
+        {
+            block->next = _curBlock->next;
+            _curBlock->next = block;
+        }
+        else
+        {
+            _curBlock = block;
+        }
+
+        return reinterpret_cast<char *>(block) + sizeof(_Block);
+    }
+
+    if (!_curBlock || _curBlock->size - _curBlock->used < size)
+    {
+        _Block *block = NewBlock(_blockSize);
+        block->next = _curBlock;
+        _curBlock = block;
+    }
+
+    void *mem = reinterpret_cast<char *>(_curBlock) + sizeof(_Block) + _curBlock->used;
+    _curBlock->used += size;
+
+    return mem;
+}
+
+void LLBC_CompactVariantArena::Reset()
+{
+    while (_curBlock)
+    {
+        _Block *next = _curBlock->next;
+        free(_curBlock);
+        _curBlock = next;
+    }
+
+    _usedSize = 0;
+    _reservedSize = 0;
+}
+
+LLBC_CompactVariantArena::_Block *LLBC_CompactVariantArena::NewBlock(size_t size)
+{
+    _Block *block = LLBC_Malloc(_Block, sizeof(_Block) + size);
+    if (UNLIKELY(!block))
+        throw std::bad_alloc();
+
+    block->next = nullptr;
+    block->size = size;
+    block->used = 0;
+
+    _reservedSize += size;
+
+    return block;
+}
+
+const LLBC_CompactVariant LLBC_CompactVariant::nil;
+
+void LLBC_CompactVariant::SetStr(const LLBC_CString &str, LLBC_CompactVariantArena &arena)
+{
+    _type = LLBC_CompactVariantType::Str;
+    _strHash = HashKey(str);
+
+    const size_t len = str.size();
+    if (len <= InlineStrMaxLen)
+    {
+        if (len > 0)
+            memcpy(_data.inlStr, str.data(), len);
+        _data.inlStr[len] = '\0';
+        _inlStrLen = static_cast<uint8>(len);
+    }
+    else
+    {
+        char *buf = reinterpret_cast<char *>(arena.Allocate(len + 1));
+        memcpy(buf, str.data(), len);
+        buf[len] = '\0';
+
+        _data.str.buf = buf;
+        _data.str.len = len;
+        _inlStrLen = UINT8_MAX;
+    }
+}
+
+void LLBC_CompactVariant::BecomeSeq(size_t size, LLBC_CompactVariantArena &arena)
+{
+    _type = LLBC_CompactVariantType::Seq;
+    _data.seq.size = static_cast<uint32>(size);
+    _data.seq.elems = size > 0 ?
+        reinterpret_cast<LLBC_CompactVariant *>(arena.Allocate(sizeof(LLBC_CompactVariant) * size)) : nullptr;
+    for (size_t i = 0; i < size; ++i)
+        new (_data.seq.elems + i) LLBC_CompactVariant();
+}
+
+void LLBC_CompactVariant::BecomeDict(size_t capacity, LLBC_CompactVariantArena &arena)
+{
+    _type = LLBC_CompactVariantType::Dict;
+    _dictSealed = false;
+    _data.dict.size = 0;
+    _data.dict.cap = static_cast<uint32>(capacity);
+    _data.dict.entries = capacity > 0 ?
+        reinterpret_cast<DictEntry *>(arena.Allocate(sizeof(DictEntry) * capacity)) : nullptr;
+}
+
+LLBC_CompactVariant &LLBC_CompactVariant::DictAppend(const LLBC_CString &key, LLBC_CompactVariantArena &arena)
+{
+    if (UNLIKELY(!IsDict()))
+        return LLBC_INL_NS __GetDictAppendScratch(LLBC_ERROR_INVALID);
+    if (UNLIKELY(_data.dict.size >= _data.dict.cap))
+        return LLBC_INL_NS __GetDictAppendScratch(LLBC_ERROR_LIMIT);
+
+    DictEntry *entry = new (_data.dict.entries + _data.dict.size++) DictEntry();
+    entry->key.SetStr(key, arena);
+    _dictSealed = false;
+
+    return entry->value;
+}
+
+LLBC_CompactVariant &LLBC_CompactVariant::DictAppend(const LLBC_CompactVariant &key)
+{
+    if (UNLIKELY(!IsDict() || !key.IsStr()))
+        return LLBC_INL_NS __GetDictAppendScratch(LLBC_ERROR_INVALID);
+    if (UNLIKELY(_data.dict.size >= _data.dict.cap))
+        return LLBC_INL_NS __GetDictAppendScratch(LLBC_ERROR_LIMIT);
+
+    DictEntry *entry = new (_data.dict.entries + _data.dict.size++) DictEntry();
+    entry->key = key;
+    _dictSealed = false;
+
+    return entry->value;
+}
+
+void LLBC_CompactVariant::DictSeal()
+{
+    if (!IsDict() || _dictSealed)
+        return;
+
+    DictEntry *begin = _data.dict.entries;
+    DictEntry *end = begin + _data.dict.size;
+
+    // Stable sort keep duplicate keys in append order, unique() then keep the first appended one.
+    std::stable_sort(begin, end, &LLBC_CompactVariant::DictEntryLess);
+    end = std::unique(begin, end, [](const DictEntry &left, const DictEntry &right) {
+        return left.key._strHash == right.key._strHash &&
+               LLBC_INL_NS __StrEqual(left.key.AsStr(), right.key.AsStr());
+    });
+
+    _data.dict.size = static_cast<uint32>(end - begin);
+    _dictSealed = true;
+}
+
+bool LLBC_CompactVariant::AsBool() const
+{
+    switch (_type)
+    {
+    case LLBC_CompactVariantType::Bool:
+        return _data.boolVal;
+    case LLBC_CompactVariantType::Int:
+    case LLBC_CompactVariantType::UInt:
+        return _data.uint64Val != 0;
+    case LLBC_CompactVariantType::Double:
+        return std::fabs(_data.doubleVal) >= DBL_EPSILON;
+    case LLBC_CompactVariantType::Str:
+    case LLBC_CompactVariantType::Seq:
+    case LLBC_CompactVariantType::Dict:
+        return Size() != 0;
+    default:
+        return false;
+    }
+}
+
+sint64 LLBC_CompactVariant::AsInt64() const
+{
+    switch (_type)
+    {
+    case LLBC_CompactVariantType::Bool:
+        return _data.boolVal ? 1 : 0;
+    case LLBC_CompactVariantType::Int:
+    case LLBC_CompactVariantType::UInt:
+        return _data.int64Val;
+    case LLBC_CompactVariantType::Double:
+        return static_cast<sint64>(_data.doubleVal);
+    case LLBC_CompactVariantType::Str:
+        {
+            const char *str = GetStrData();
+            if (strchr(str, '.'))
+                return static_cast<sint64>(LLBC_Str2Double(str));
+            return LLBC_Str2Int64(str);
+        }
+    default:
+        return 0;
+    }
+}
+
+uint64 LLBC_CompactVariant::AsUInt64() const
+{
+    switch (_type)
+    {
+    case LLBC_CompactVariantType::Bool:
+        return _data.boolVal ? 1 : 0;
+    case LLBC_CompactVariantType::Int:
+    case LLBC_CompactVariantType::UInt:
+        return _data.uint64Val;
+    case LLBC_CompactVariantType::Double:
+        return static_cast<uint64>(_data.doubleVal);
+    case LLBC_CompactVariantType::Str:
+        {
+            const char *str = GetStrData();
+            if (strchr(str, '.'))
+                return static_cast<uint64>(LLBC_Str2Double(str));
+            return LLBC_Str2UInt64(str);
+        }
+    default:
+        return 0;
+    }
+}
+
+double LLBC_CompactVariant::AsDouble() const
+{
+    switch (_type)
+    {
+    case LLBC_CompactVariantType::Bool:
+        return _data.boolVal ? 1.0 : 0.0;
+    case LLBC_CompactVariantType::Int:
+        return static_cast<double>(_data.int64Val);
+    case LLBC_CompactVariantType::UInt:
+        return static_cast<double>(_data.uint64Val);
+    case LLBC_CompactVariantType::Double:
+        return _data.doubleVal;
+    case LLBC_CompactVariantType::Str:
+        return LLBC_Str2Double(GetStrData());
+    default:
+        return 0.0;
+    }
+}
+
+const LLBC_CompactVariant *LLBC_CompactVariant::DictFind(const LLBC_CString &key, uint32 keyHash) const
+{
+    if (!IsDict() || _data.dict.size == 0)
+        return nullptr;
+
+    const DictEntry *entries = _data.dict.entries;
+    const uint32 size = _data.dict.size;
+
+    uint32 idx = 0;
+    if (_dictSealed)
+    {
+        // Binary search first entry which key hash not less than given hash.
+        uint32 high = size;
+        while (idx < high)
+        {
+            const uint32 mid = idx + (high - idx) / 2;
+            if (entries[mid].key._strHash < keyHash)
+                idx = mid + 1;
+            else
+                high = mid;
+        }
+
+        for (; idx < size && entries[idx].key._strHash == keyHash; ++idx)
+        {
+            if (LLBC_INL_NS __StrEqual(entries[idx].key.AsStr(), key))
+                return &entries[idx].value;
+        }
+
+        return nullptr;
+    }
+
+    for (; idx < size; ++idx)
+    {
+        if (entries[idx].key._strHash == keyHash &&
+            LLBC_INL_NS __StrEqual(entries[idx].key.AsStr(), key))
+            return &entries[idx].value;
+    }
+
+    return nullptr;
+}
+
+void LLBC_CompactVariant::ToVariant(LLBC_Variant &var) const
+{
+    switch (_type)
+    {
+    case LLBC_CompactVariantType::Bool:
+        var = LLBC_Variant(_data.boolVal);
+        break;
+    case LLBC_CompactVariantType::Int:
+        var = LLBC_Variant(_data.int64Val);
+        break;
+    case LLBC_CompactVariantType::UInt:
+        var = LLBC_Variant(_data.uint64Val);
+        break;
+    case LLBC_CompactVariantType::Double:
+        var = LLBC_Variant(_data.doubleVal);
+        break;
+    case LLBC_CompactVariantType::Str:
+        var = LLBC_Variant(AsStr());
+        break;
+    case LLBC_CompactVariantType::Seq:
+        {
+            var.BecomeNil();
+            var.BecomeSeq();
+            var.SeqResize(_data.seq.size);
+            for (uint32 i = 0; i < _data.seq.size; ++i)
+                _data.seq.elems[i].ToVariant(var[i]);
+        }
+        break;
+    case LLBC_CompactVariantType::Dict:
+        {
+            var.BecomeNil();
+            var.BecomeDict();
+            for (const DictEntry *entry = DictBegin(); entry != DictEnd(); ++entry)
+            {
+                // Unsealed dictionary may contain duplicate keys, keep first appended one as DictSeal() does.
+                const LLBC_CString key = entry->key.AsStr();
+                if (!_dictSealed && var.DictFind(key) != var.DictEnd())
+                    continue;
+
+                entry->value.ToVariant(var[key]);
+            }
+        }
+        break;
+    default:
+        var.BecomeNil();
+        break;
+    }
+}
+
+void LLBC_CompactVariant::FromVariant(const LLBC_Variant &var, LLBC_CompactVariantArena &arena)
+{
+    if (var.IsNil())
+    {
+        SetNil();
+    }
+    else if (var.IsRaw())
+    {
+        if (var.IsBool())
+            SetBool(var.AsBool());
+        else if (var.IsFloat() || var.IsDouble())
+            SetDouble(var.AsDouble());
+        else if (var.IsSignedRaw())
+            SetInt64(var.AsInt64());
+        else
+            SetUInt64(var.AsUInt64());
+    }
+    else if (var.IsStr())
+    {
+        const LLBC_String *str = var.GetHolder().data.obj.str;
+        SetStr(str ? LLBC_CString(*str) : LLBC_CString(), arena);
+    }
+    else if (var.IsSeq())
+    {
+        const LLBC_Variant::Seq &seq = var.AsSeq();
+        BecomeSeq(seq.size(), arena);
+        for (size_t i = 0; i < seq.size(); ++i)
+            _data.seq.elems[i].FromVariant(seq[i], arena);
+    }
+    else // Dict
+    {
+        const LLBC_Variant::Dict &dict = var.AsDict();
+        BecomeDict(dict.size(), arena);
+        for (auto &item : dict)
+        {
+            const LLBC_Variant &key = item.first;
+            const LLBC_String *keyStr = key.IsStr() ? key.GetHolder().data.obj.str : nullptr;
+            if (key.IsStr())
+                DictAppend(keyStr ? LLBC_CString(*keyStr) : LLBC_CString(), arena).FromVariant(item.second, arena);
+            else
+                DictAppend(key.AsStr(), arena).FromVariant(item.second, arena);
+        }
+
+        DictSeal();
+    }
+}
+
+LLBC_String LLBC_CompactVariant::ToString() const
+{
+    LLBC_Variant var;
+    ToVariant(var);
+
+    return var.ToString();
+}
+
+bool LLBC_CompactVariant::DictEntryLess(const DictEntry &left, const DictEntry &right)
+{
+    if (left.key._strHash != right.key._strHash)
+        return left.key._strHash < right.key._strHash;
+
+    const LLBC_CString leftKey = left.key.AsStr();
+    const LLBC_CString rightKey = right.key.AsStr();
+    if (leftKey.size() != rightKey.size())
+        return leftKey.size() < rightKey.size();
+
+    return memcmp(leftKey.data(), rightKey.data(), leftKey.size()) < 0;
+}
+
+__LLBC_NS_END
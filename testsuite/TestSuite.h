@@ -55,6 +55,7 @@
 #include "core/config/TestCase_Core_Config_Properties.h"
 #include "core/time/TestCase_Core_Time_Time.h"
 #include "core/timer/TestCase_Core_Timer_Heap.h"
+#include "core/timer/TestCase_Core_Timer_Scheduler.h"
 #include "core/event/TestCase_Core_Event.h"
 #include "core/thread/TestCase_Core_Thread_Lock.h"
 #include "core/thread/TestCase_Core_Thread_RWLock.h"
@@ -92,6 +93,15 @@
 #include "comm/TestCase_Comm_MessageBuffer.h"
 #include "comm/TestCase_Comm_DynLoadComp.h"
 #include "comm/TestCase_Comm_Echo.h"
+#include "comm/TestCase_Comm_ReadySessionTable.h"
+#include "comm/TestCase_Comm_DataArrivalBatch.h"
+#include "comm/TestCase_Comm_PayloadSlice.h"
+#include "comm/TestCase_Comm_EpollInlineWait.h"
+#include "comm/TestCase_Comm_GatherSend.h"
+#include "comm/TestCase_Comm_EncodeOnceMulticast.h"
+#include "comm/TestCase_Comm_SvcEventWakeup.h"
+#include "comm/TestCase_Comm_EvBlockPool.h"
+#include "comm/TestCase_Comm_PacketHandlers.h"
 
 #include "app/TestCase_App_AppTest.h"
 #include "app/TestCase_App_AppCfgTest.h"
@@ -34,6 +34,7 @@ __DEFINE_TEST_CASE(TestCase_Core_Config_Ini)
 __DEFINE_TEST_CASE(TestCase_Core_Config_Properties)
 __DEFINE_TEST_CASE(TestCase_Core_Time_Time)
 __DEFINE_TEST_CASE(TestCase_Core_Timer_Heap)
+__DEFINE_TEST_CASE(TestCase_Core_Timer_Scheduler)
 __DEFINE_TEST_CASE(TestCase_Core_Event)
 __DEFINE_TEST_CASE(TestCase_Core_Thread_Lock)
 __DEFINE_TEST_CASE(TestCase_Core_Thread_RWLock)
@@ -71,6 +72,15 @@ __DEFINE_TEST_CASE(TestCase_Comm_ProtoStackCtrl)
 __DEFINE_TEST_CASE(TestCase_Comm_MessageBuffer)
 __DEFINE_TEST_CASE(TestCase_Comm_DynLoadComp)
 __DEFINE_TEST_CASE(TestCase_Comm_Echo)
+__DEFINE_TEST_CASE(TestCase_Comm_ReadySessionTable)
+__DEFINE_TEST_CASE(TestCase_Comm_DataArrivalBatch)
+__DEFINE_TEST_CASE(TestCase_Comm_PayloadSlice)
+__DEFINE_TEST_CASE(TestCase_Comm_EpollInlineWait)
+__DEFINE_TEST_CASE(TestCase_Comm_GatherSend)
+__DEFINE_TEST_CASE(TestCase_Comm_EncodeOnceMulticast)
+__DEFINE_TEST_CASE(TestCase_Comm_SvcEventWakeup)
+__DEFINE_TEST_CASE(TestCase_Comm_EvBlockPool)
+__DEFINE_TEST_CASE(TestCase_Comm_PacketHandlers)
 __DEFINE_TEST_CASE(TestCase_App_AppTest)
 __DEFINE_TEST_CASE(TestCase_App_AppCfgTest)
 __DEFINE_TEST_CASE(TestCase_App_AppPhaseWaitingTest)
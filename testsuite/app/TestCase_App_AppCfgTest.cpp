@@ -25,14 +25,24 @@ using namespace llbc;
 namespace
 {
 
+// Config reload assertion failed flag.
+bool __appCfgTestFailed = false;
+
 class TestCompA final : public LLBC_Component
 {
+public:
+    TestCompA()
+    : appFpsCfg_("App.fps", -1)
+    {
+    }
+
 public:
     int OnStart(bool &finished) override
     {
         const LLBC_String compName = LLBC_GetTypeName(TestCompA);
         std::cout << "Comp " << compName << " start..." << std::endl;
         std::cout << "- Cfg:\n" << GetConfig().ToString().c_str() << std::endl;
+        std::cout << "- App fps(cached config value):" << appFpsCfg_.Get() << std::endl;
 
         if (GetService()->GetName() == "TestSvc1")
         {
@@ -59,16 +69,65 @@ public:
                   << std::endl;
         std::cout << "- CfgType:" << GetConfigType() << std::endl;
         std::cout << "- Cfg:\n" << GetConfig().ToString().c_str() << std::endl;
+        std::cout << "- App cfg version:" << LLBC_App::ThisApp()->GetConfigVersion()
+                  << ", fps(cached config value):" << appFpsCfg_.Get() << std::endl;
     }
 
 private:
     void OnTimeout_ReloadCfg(LLBC_Timer *timer)
     {
-        LLBC_App::ThisApp()->Reload();
+        // Hold config snapshot, snapshot keep unchanged after reload.
+        LLBC_App *app = LLBC_App::ThisApp();
+        const LLBC_AppConfigSnapshot oldCfg = app->GetConfigSnapshot();
+        const LLBC_Variant oldCfgCopy = *oldCfg;
+        const sint64 oldVer = app->GetConfigVersion();
+        const int oldFps = appFpsCfg_.Get();
+
+        // Modify App.fps in runtime config file, then reload app.
+        const int newFps = oldFps + 1;
+        LLBC_String cfgCnt = LLBC_File::ReadToEnd(app->GetConfigPath());
+        cfgCnt.findreplace(LLBC_String().format("fps = %d", oldFps),
+                           LLBC_String().format("fps = %d", newFps),
+                           1);
+        LLBC_File cfgFile(app->GetConfigPath(), LLBC_FileMode::BinaryWrite);
+        if (cfgFile.Write(cfgCnt.c_str()) != LLBC_OK)
+        {
+            OnTestFailed("write runtime config file failed");
+            return;
+        }
+        cfgFile.Close();
+
+        if (app->Reload() != LLBC_OK)
+        {
+            OnTestFailed("reload app failed");
+            return;
+        }
+
+        std::cout << "App reloaded, old cfg snapshot replaced?:"
+                  << (oldCfg != app->GetConfigSnapshot())
+                  << ", old cfg snapshot section count:" << oldCfg->Size() << std::endl;
+        if (oldCfg == app->GetConfigSnapshot())
+            OnTestFailed("config snapshot not replaced after reload");
+        else if (*oldCfg != oldCfgCopy)
+            OnTestFailed("held config snapshot changed after reload");
+        else if (app->GetConfigVersion() <= oldVer)
+            OnTestFailed("config version not increased after reload");
+        else if (appFpsCfg_.Get() != newFps)
+            OnTestFailed("cached config value not refreshed after reload");
+        else
+            std::cout << "App config reload test passed, fps:" << oldFps << " -> " << newFps << std::endl;
+    }
+
+    static void OnTestFailed(const char *reason)
+    {
+        std::cerr << "App config reload test failed, reason:" << reason << std::endl;
+        __appCfgTestFailed = true;
+        LLBC_App::ThisApp()->Stop();
     }
 
 private:
     LLBC_Timer cfgReloadTimer_;
+    LLBC_AppConfigValue<int> appFpsCfg_;
 };
 
 class TestCompB final : public LLBC_Component
@@ -108,6 +167,7 @@ public:
             std::cout << "- cfg type:" << GetConfigType() << std::endl;
             std::cout << "- cfg path:" << GetConfigPath() << std::endl;
             std::cout << "- cfg cnt:" << GetConfig().ToString() << std::endl;
+            std::cout << "- cfg version:" << GetConfigVersion() << std::endl;
         }
 
         return LLBC_OK;
@@ -208,7 +268,16 @@ int TestCase_App_AppCfgTest::Run(int argc, char *argv[])
     // Set config path.
     // If not specific config path, application will auto reload config(order Ini->Cfg->Xml).
     // - ini format config.
-    app.SetConfigPath("./AppCfgTest.ini");
+    // Reload test will modify config file, copy it to runtime config file first.
+    const LLBC_String cfgCnt = LLBC_File::ReadToEnd("./AppCfgTest.ini");
+    LLBC_ErrorAndReturnIf(cfgCnt.empty(), LLBC_FAILED, "Read ./AppCfgTest.ini failed");
+    LLBC_File runtimeCfgFile("./AppCfgTest_runtime.ini", LLBC_FileMode::BinaryWrite);
+    LLBC_ErrorAndReturnIf(runtimeCfgFile.Write(cfgCnt.c_str()) != LLBC_OK,
+                          LLBC_FAILED,
+                          "Write ./AppCfgTest_runtime.ini failed");
+    runtimeCfgFile.Close();
+
+    app.SetConfigPath("./AppCfgTest_runtime.ini");
     // - properties format config.
     // app.SetConfigPath("./AppCfgTest.cfg");
     // - xml format config.
@@ -222,5 +291,7 @@ int TestCase_App_AppCfgTest::Run(int argc, char *argv[])
         return LLBC_FAILED;
     }
 
+    LLBC_ErrorAndReturnIf(__appCfgTestFailed, LLBC_FAILED, "App config reload test failed");
+
     return LLBC_OK;
 }
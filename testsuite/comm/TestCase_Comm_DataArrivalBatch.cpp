@@ -0,0 +1,253 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_DataArrivalBatch.h"
+
+namespace
+{
+
+const int OPCODE_NORMAL = 1; // Normal packet.
+const int OPCODE_BAD = 2; // Decode failed packet.
+const int OPCODE_FATAL = 3; // Decode failed packet, and require remove session.
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17631;
+
+// Codec protocol, decode failed when opcode is OPCODE_BAD/OPCODE_FATAL.
+class TestCodecProtocol final : public LLBC_IProtocol
+{
+public:
+    int GetLayer() const override
+    {
+        return LLBC_ProtocolLayer::CodecLayer;
+    }
+
+    int Send(void *in, void *&out, bool &removeSession) override
+    {
+        out = in;
+        return LLBC_OK;
+    }
+
+    int Recv(void *in, void *&out, bool &removeSession) override
+    {
+        LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
+        const int opcode = packet->GetOpcode();
+        if (opcode == OPCODE_BAD || opcode == OPCODE_FATAL)
+        {
+            removeSession = opcode == OPCODE_FATAL;
+            LLBC_Recycle(packet);
+            LLBC_SetLastError(LLBC_ERROR_DECODE);
+
+            return LLBC_FAILED;
+        }
+
+        out = packet;
+        return LLBC_OK;
+    }
+};
+
+class TestProtoFactory final : public LLBC_IProtocolFactory
+{
+public:
+    LLBC_IProtocol *Create(int layer) const override
+    {
+        switch (layer)
+        {
+            case LLBC_ProtocolLayer::PackLayer:
+                return new LLBC_PacketProtocol();
+
+            case LLBC_ProtocolLayer::CodecLayer:
+                return new TestCodecProtocol();
+
+            default:
+                return nullptr;
+        }
+    }
+};
+
+class TestComp final : public LLBC_Component
+{
+public:
+    TestComp()
+    : _sessionId(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        sint32 val = 0;
+        packet.Read(&val, sizeof(val));
+
+        LLBC_LockGuard guard(_lock);
+        _sessionId = packet.GetSessionId();
+        _recvedVals.push_back(val);
+    }
+
+    int GetSessionId()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _sessionId;
+    }
+
+    std::vector<sint32> GetRecvedVals()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _recvedVals;
+    }
+
+private:
+    LLBC_SpinLock _lock;
+    int _sessionId;
+    std::vector<sint32> _recvedVals;
+};
+
+// Pack packets(opcode, value) into one byte stream, so server recv them in one batch.
+void PackBatch(const std::vector<std::pair<int, sint32> > &pkts, LLBC_MessageBlock &batch)
+{
+    LLBC_PacketProtocol packProto;
+    for (auto &pkt : pkts)
+    {
+        LLBC_Packet *packet = new LLBC_Packet;
+        packet->SetHeader(0, pkt.first);
+        packet->Write(&pkt.second, sizeof(pkt.second));
+
+        void *out;
+        bool removeSession = false;
+        packProto.Send(packet, out, removeSession);
+
+        LLBC_MessageBlock *block = reinterpret_cast<LLBC_MessageBlock *>(out);
+        batch.Write(block->GetData(), block->GetWritePos());
+        delete block;
+    }
+}
+
+// Format received values.
+LLBC_String ValsToStr(const std::vector<sint32> &vals)
+{
+    LLBC_String str;
+    for (auto &val : vals)
+        str.append_format("%s%d", str.empty() ? "" : ",", val);
+
+    return str;
+}
+
+// Wait server received expect count values.
+bool WaitRecved(TestComp *comp, size_t expectCount)
+{
+    for (int i = 0; i < 300 && comp->GetRecvedVals().size() < expectCount; ++i)
+        LLBC_Sleep(10);
+
+    // Wait a while, make sure no more unexpected values received.
+    LLBC_Sleep(50);
+
+    return comp->GetRecvedVals().size() == expectCount;
+}
+
+}
+
+TestCase_Comm_DataArrivalBatch::TestCase_Comm_DataArrivalBatch()
+{
+}
+
+TestCase_Comm_DataArrivalBatch::~TestCase_Comm_DataArrivalBatch()
+{
+}
+
+int TestCase_Comm_DataArrivalBatch::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service data arrival batch test:");
+
+    LLBC_ReturnIf(DoTest(false) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoTest(true) != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Service data arrival batch test success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_DataArrivalBatch::DoTest(bool fullStack)
+{
+    LLBC_PrintLn("- Test in %s mode", fullStack ? "full stack" : "not full stack");
+
+    // Create server service.
+    LLBC_Service *svr = LLBC_Service::Create("DataArrivalBatchSvr", new TestProtoFactory, fullStack);
+    LLBC_Defer(delete svr);
+
+    TestComp *comp = new TestComp;
+    svr->AddComponent(comp);
+    svr->Subscribe(OPCODE_NORMAL, comp, &TestComp::OnRecv);
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service(raw protocol, send packed bytes directly).
+    LLBC_Service *client = LLBC_Service::Create("DataArrivalBatchClient", new LLBC_RawProtocolFactory);
+    LLBC_Defer(delete client);
+
+    const int clientSid = client->Connect(TEST_IP, TEST_PORT);
+    LLBC_ErrorAndReturnIf(clientSid == 0, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    // Bad packet in the middle of batch, only bad packet dropped.
+    LLBC_MessageBlock batch;
+    PackBatch({{OPCODE_NORMAL, 1}, {OPCODE_NORMAL, 2}, {OPCODE_BAD, 3}, {OPCODE_NORMAL, 4}, {OPCODE_NORMAL, 5}}, batch);
+    client->Send(clientSid, 0, batch.GetData(), batch.GetWritePos());
+
+    LLBC_ErrorAndReturnIf(!WaitRecved(comp, 4), LLBC_FAILED,
+                          "Recved packets count error, count:%lu, expect:4", comp->GetRecvedVals().size());
+    LLBC_ErrorAndReturnIf(comp->GetRecvedVals() != std::vector<sint32>({1, 2, 4, 5}),
+                          LLBC_FAILED,
+                          "Recved packets error(bad packet must be dropped only), recved:%s",
+                          ValsToStr(comp->GetRecvedVals()).c_str());
+
+    const int svrSid = comp->GetSessionId();
+    LLBC_ErrorAndReturnIf(!svr->IsSessionValidate(svrSid), LLBC_FAILED,
+                          "Session removed after bad packet recved, sessionId:%d", svrSid);
+    LLBC_PrintLn("  Bad packet dropped, session still valid, recved:1,2,4,5");
+
+    // Fatal packet in the middle of batch, session removed, remaining packets dropped.
+    // Packets decoded before fatal packet are dispatched, in both full stack and not full stack mode.
+    batch.SetWritePos(0);
+    PackBatch({{OPCODE_NORMAL, 6}, {OPCODE_NORMAL, 7}, {OPCODE_FATAL, 8}, {OPCODE_NORMAL, 9}}, batch);
+    client->Send(clientSid, 0, batch.GetData(), batch.GetWritePos());
+
+    for (int i = 0; i < 300 && svr->IsSessionValidate(svrSid); ++i)
+        LLBC_Sleep(10);
+    LLBC_ErrorAndReturnIf(svr->IsSessionValidate(svrSid), LLBC_FAILED,
+                          "Session not removed after fatal packet recved, sessionId:%d", svrSid);
+
+    const std::vector<sint32> expectVals({1, 2, 4, 5, 6, 7});
+    LLBC_ErrorAndReturnIf(!WaitRecved(comp, expectVals.size()) || comp->GetRecvedVals() != expectVals,
+                          LLBC_FAILED,
+                          "Recved packets error after fatal packet recved, recved:%s",
+                          ValsToStr(comp->GetRecvedVals()).c_str());
+    LLBC_PrintLn("  Fatal packet removed session, recved:1,2,4,5,6,7, remaining packets dropped");
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
@@ -0,0 +1,254 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_EncodeOnceMulticast.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17635; // Sessions use service protocol factory(encode once).
+const uint16 TEST_PORT2 = 17636; // Sessions use custom protocol factory(encode per session).
+
+const int SESSION_COUNT = 6;
+const int SESSION_COUNT2 = 2;
+
+// Custom protocol factory, not stateless send, multicast must encode packet per session.
+class StatefulProtoFactory final : public LLBC_NormalProtocolFactory
+{
+public:
+    bool IsStatelessSend() const override
+    {
+        return false;
+    }
+};
+
+// Record server sessions.
+class ServerComp final : public LLBC_Component
+{
+public:
+    ServerComp()
+    : _listenSessionId2(0)
+    {
+    }
+
+public:
+    void OnEvent(int eventType, const LLBC_Variant &eventParams) override
+    {
+        if (eventType != LLBC_ComponentEventType::SessionCreate)
+            return;
+
+        const LLBC_SessionInfo &sessionInfo = *eventParams.AsPtr<LLBC_SessionInfo>();
+        if (sessionInfo.IsListenSession())
+            return;
+
+        LLBC_LockGuard guard(_lock);
+        if (sessionInfo.GetAcceptSessionId() == _listenSessionId2)
+            _sessionIds2.push_back(sessionInfo.GetSessionId());
+        else
+            _sessionIds.push_back(sessionInfo.GetSessionId());
+    }
+
+    size_t GetSessionCount()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _sessionIds.size() + _sessionIds2.size();
+    }
+
+    LLBC_SessionIds GetSessionIds(bool useSvcProtoFactory)
+    {
+        LLBC_LockGuard guard(_lock);
+        return useSvcProtoFactory ? _sessionIds : _sessionIds2;
+    }
+
+public:
+    int _listenSessionId2;
+
+private:
+    LLBC_SpinLock _lock;
+    LLBC_SessionIds _sessionIds;
+    LLBC_SessionIds _sessionIds2;
+};
+
+// Record client sessions received payloads.
+class ClientComp final : public LLBC_Component
+{
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        LLBC_String payload(reinterpret_cast<const char *>(packet.GetPayload()), packet.GetPayloadLength());
+
+        LLBC_LockGuard guard(_lock);
+        _recvedPayloads[packet.GetSessionId()].push_back(payload);
+        ++_recvCount;
+    }
+
+    int GetRecvCount()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _recvCount;
+    }
+
+    std::map<int, std::vector<LLBC_String> > GetRecvedPayloads()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _recvedPayloads;
+    }
+
+private:
+    LLBC_SpinLock _lock;
+    int _recvCount = 0;
+    std::map<int, std::vector<LLBC_String> > _recvedPayloads;
+};
+
+// Wait client received expect count packets.
+bool WaitRecved(ClientComp *comp, int expectCount)
+{
+    for (int i = 0; i < 300 && comp->GetRecvCount() < expectCount; ++i)
+        LLBC_Sleep(10);
+
+    // Wait a while, make sure no more unexpected packets received.
+    LLBC_Sleep(50);
+
+    return comp->GetRecvCount() == expectCount;
+}
+
+}
+
+TestCase_Comm_EncodeOnceMulticast::TestCase_Comm_EncodeOnceMulticast()
+{
+}
+
+TestCase_Comm_EncodeOnceMulticast::~TestCase_Comm_EncodeOnceMulticast()
+{
+}
+
+int TestCase_Comm_EncodeOnceMulticast::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Encode once multicast/broadcast test:");
+
+    LLBC_ReturnIf(DoTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Encode once multicast/broadcast test success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_EncodeOnceMulticast::DoTest()
+{
+    // Create server service.
+    LLBC_Service *svr = LLBC_Service::Create("EncodeOnceMulticastSvr");
+    LLBC_Defer(delete svr);
+    svr->SuppressCoderNotFoundWarning();
+
+    ServerComp *svrComp = new ServerComp;
+    svr->AddComponent(svrComp);
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    svrComp->_listenSessionId2 = svr->Listen(TEST_IP, TEST_PORT2, new StatefulProtoFactory);
+    LLBC_ErrorAndReturnIf(svrComp->_listenSessionId2 == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT2, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service, and connect to server.
+    LLBC_Service *client = LLBC_Service::Create("EncodeOnceMulticastClient");
+    LLBC_Defer(delete client);
+    client->SuppressCoderNotFoundWarning();
+
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->Subscribe(OPCODE, clientComp, &ClientComp::OnRecv);
+    for (int i = 0; i < SESSION_COUNT + SESSION_COUNT2; ++i)
+    {
+        const uint16 port = i < SESSION_COUNT ? TEST_PORT : TEST_PORT2;
+        LLBC_ErrorAndReturnIf(client->Connect(TEST_IP, port) == 0, LLBC_FAILED,
+                              "Connect to %s:%d failed, err:%s", TEST_IP, port, LLBC_FormatLastError());
+    }
+
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    for (int i = 0; i < 300 && svrComp->GetSessionCount() < SESSION_COUNT + SESSION_COUNT2; ++i)
+        LLBC_Sleep(10);
+    LLBC_ErrorAndReturnIf(svrComp->GetSessionCount() != SESSION_COUNT + SESSION_COUNT2, LLBC_FAILED,
+                          "Wait server sessions create timeout, session count:%lu", svrComp->GetSessionCount());
+
+    // Multicast to half of sessions(include both encode once sessions and encode per session sessions).
+    const LLBC_SessionIds sessionIds = svrComp->GetSessionIds(true);
+    const LLBC_SessionIds sessionIds2 = svrComp->GetSessionIds(false);
+    LLBC_SessionIds multicastSessionIds(sessionIds.begin(), sessionIds.begin() + SESSION_COUNT / 2);
+    multicastSessionIds.push_back(sessionIds2[0]);
+
+    const LLBC_String multicastPayload = "multicast payload";
+    svr->Multicast(multicastSessionIds, OPCODE, multicastPayload.data(), multicastPayload.size());
+    LLBC_ErrorAndReturnIf(!WaitRecved(clientComp, static_cast<int>(multicastSessionIds.size())), LLBC_FAILED,
+                          "Multicast recved packets count error, count:%d, expect:%lu",
+                          clientComp->GetRecvCount(), multicastSessionIds.size());
+
+    // Broadcast twice, every session must recv each broadcast packet once.
+    const LLBC_String broadcastPayload1 = "broadcast payload 1";
+    const LLBC_String broadcastPayload2(LLBC_CFG_COMM_POOLED_EVENT_BLOCK_MAX_KEEP_SIZE * 2, 'b');
+    svr->Broadcast(OPCODE, broadcastPayload1.data(), broadcastPayload1.size());
+    svr->Broadcast(OPCODE, broadcastPayload2.data(), broadcastPayload2.size());
+
+    const int expectRecvCount = static_cast<int>(multicastSessionIds.size()) + (SESSION_COUNT + SESSION_COUNT2) * 2;
+    LLBC_ErrorAndReturnIf(!WaitRecved(clientComp, expectRecvCount), LLBC_FAILED,
+                          "Broadcast recved packets count error, count:%d, expect:%d",
+                          clientComp->GetRecvCount(), expectRecvCount);
+
+    // Check every client session recved payloads.
+    const std::map<int, std::vector<LLBC_String> > recvedPayloads = clientComp->GetRecvedPayloads();
+    LLBC_ErrorAndReturnIf(recvedPayloads.size() != SESSION_COUNT + SESSION_COUNT2, LLBC_FAILED,
+                          "Recved sessions count error, count:%lu, expect:%d",
+                          recvedPayloads.size(), SESSION_COUNT + SESSION_COUNT2);
+
+    int multicastRecvedSessions = 0;
+    for (auto &item : recvedPayloads)
+    {
+        const std::vector<LLBC_String> &payloads = item.second;
+        const bool multicastRecved = payloads.size() == 3;
+        LLBC_ErrorAndReturnIf(payloads.size() != 2 && !multicastRecved, LLBC_FAILED,
+                              "Session recved packets count error, sessionId:%d, count:%lu",
+                              item.first, payloads.size());
+        LLBC_ErrorAndReturnIf((multicastRecved && payloads[0] != multicastPayload) ||
+                              payloads[payloads.size() - 2] != broadcastPayload1 ||
+                              payloads[payloads.size() - 1] != broadcastPayload2,
+                              LLBC_FAILED,
+                              "Session recved payloads error, sessionId:%d", item.first);
+
+        multicastRecvedSessions += multicastRecved ? 1 : 0;
+    }
+
+    LLBC_PrintLn("  Sessions:%d, multicast recved sessions:%d, total recved packets:%d",
+                 SESSION_COUNT + SESSION_COUNT2, multicastRecvedSessions, clientComp->GetRecvCount());
+    LLBC_ErrorAndReturnIf(multicastRecvedSessions != static_cast<int>(multicastSessionIds.size()), LLBC_FAILED,
+                          "Multicast recved sessions count error, count:%d, expect:%lu",
+                          multicastRecvedSessions, multicastSessionIds.size());
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
@@ -0,0 +1,340 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_EpollInlineWait.h"
+
+#if (LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID) && LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
+namespace
+{
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17633;
+
+const size_t SEND_DATA_SIZE = 64;
+
+const int WAKEUP_TEST_TIMES = 100;
+// Poller epoll_wait() timeout is 50ms, if pushed send events not wakeup poller,
+// average send latency will be about 25ms.
+const sint64 MAX_AVG_WAKEUP_LATENCY = 10 * 1000; // In micro-seconds.
+
+const int PUSHER_THREAD_COUNT = 4;
+const int PER_THREAD_SEND_TIMES = 2000;
+
+const int STOP_TEST_ROUNDS = 5;
+
+// Record raw client session Id(client send hello bytes after connected).
+class TestComp final : public LLBC_Component
+{
+public:
+    TestComp()
+    : _sessionId(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        LLBC_AtomicSet(&_sessionId, packet.GetSessionId());
+    }
+
+    int GetSessionId()
+    {
+        return LLBC_AtomicGet(&_sessionId);
+    }
+
+private:
+    volatile sint32 _sessionId;
+};
+
+// Push send events to poller in non-poller threads.
+class PushTask final : public LLBC_Task
+{
+public:
+    PushTask(LLBC_Service *svc, int sessionId, int perThreadSendTimes)
+    : _svc(svc)
+    , _sessionId(sessionId)
+    , _perThreadSendTimes(perThreadSendTimes)
+    , _stop(0)
+    , _sentTimes(0)
+    , _failedTimes(0)
+    {
+    }
+
+public:
+    void Svc() override
+    {
+        char data[SEND_DATA_SIZE];
+        memset(data, 'x', sizeof(data));
+        for (int i = 0; _perThreadSendTimes < 0 || i < _perThreadSendTimes; ++i)
+        {
+            if (LLBC_AtomicGet(&_stop) != 0)
+                break;
+
+            if (_svc->Send(_sessionId, 0, data, sizeof(data)) == LLBC_OK)
+                LLBC_AtomicFetchAndAdd(&_sentTimes, 1);
+            else
+                LLBC_AtomicFetchAndAdd(&_failedTimes, 1);
+        }
+    }
+
+    void Cleanup() override
+    {
+    }
+
+public:
+    LLBC_Service *_svc;
+    const int _sessionId;
+    const int _perThreadSendTimes; // -1 means send until stopped.
+
+    volatile sint32 _stop;
+    volatile sint32 _sentTimes;
+    volatile sint32 _failedTimes;
+};
+
+// Create and start test server service(raw protocol).
+LLBC_Service *StartServer(TestComp *&comp)
+{
+    LLBC_Service *svr = LLBC_Service::Create("EpollInlineWaitSvr", new LLBC_RawProtocolFactory);
+
+    comp = new TestComp;
+    svr->AddComponent(comp);
+    svr->Subscribe(0, comp, &TestComp::OnRecv);
+    if (svr->Listen(TEST_IP, TEST_PORT) == 0 || svr->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start server service failed, err:%s", LLBC_FormatLastError());
+        delete svr;
+
+        return nullptr;
+    }
+
+    return svr;
+}
+
+// Connect to test server by raw blocking socket, and wait server session created.
+LLBC_SocketHandle ConnectServer(TestComp *comp)
+{
+    LLBC_SocketHandle sock = LLBC_CreateTcpSocket();
+    if (sock == LLBC_INVALID_SOCKET_HANDLE)
+        return LLBC_INVALID_SOCKET_HANDLE;
+
+    if (LLBC_ConnectToPeer(sock, LLBC_SockAddr_IN(TEST_IP, TEST_PORT)) != LLBC_OK)
+    {
+        LLBC_CloseSocket(sock);
+        return LLBC_INVALID_SOCKET_HANDLE;
+    }
+
+    // Set recv timeout, avoid test blocking forever.
+    struct timeval recvTimeout;
+    recvTimeout.tv_sec = 5;
+    recvTimeout.tv_usec = 0;
+    LLBC_SetSocketOption(sock, SOL_SOCKET, SO_RCVTIMEO, &recvTimeout, sizeof(recvTimeout));
+
+    LLBC_Send(sock, "hello", 5, 0);
+    for (int i = 0; i < 300 && comp->GetSessionId() == 0; ++i)
+        LLBC_Sleep(10);
+
+    if (comp->GetSessionId() == 0)
+    {
+        LLBC_CloseSocket(sock);
+        return LLBC_INVALID_SOCKET_HANDLE;
+    }
+
+    return sock;
+}
+
+// Recv specific size bytes from raw socket.
+bool RecvFully(LLBC_SocketHandle sock, size_t size)
+{
+    char buf[4096];
+    while (size > 0)
+    {
+        const int recvLen = LLBC_Recv(sock, buf, static_cast<int>(MIN(size, sizeof(buf))), 0);
+        if (recvLen <= 0)
+            return false;
+
+        size -= recvLen;
+    }
+
+    return true;
+}
+
+}
+
+#endif // (LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID) && LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
+TestCase_Comm_EpollInlineWait::TestCase_Comm_EpollInlineWait()
+{
+}
+
+TestCase_Comm_EpollInlineWait::~TestCase_Comm_EpollInlineWait()
+{
+}
+
+int TestCase_Comm_EpollInlineWait::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Epoll poller inline wait test:");
+
+#if (LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID) && LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+    LLBC_ReturnIf(DoWakeupLatencyTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoConcurrentPushTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoStopWithPushersTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Epoll poller inline wait test success");
+#else
+    LLBC_PrintLn("Epoll poller inline wait not enabled in this platform, skip test");
+#endif
+
+    return LLBC_OK;
+}
+
+#if (LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID) && LLBC_CFG_COMM_EPOLL_INLINE_WAIT
+
+int TestCase_Comm_EpollInlineWait::DoWakeupLatencyTest()
+{
+    LLBC_PrintLn("- Wakeup latency test");
+
+    TestComp *comp;
+    LLBC_Service *svr = StartServer(comp);
+    LLBC_ReturnIf(!svr, LLBC_FAILED);
+    LLBC_Defer(delete svr);
+
+    const LLBC_SocketHandle sock = ConnectServer(comp);
+    LLBC_ErrorAndReturnIf(sock == LLBC_INVALID_SOCKET_HANDLE, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_Defer(LLBC_CloseSocket(sock));
+
+    // Send in main thread, the send event must wakeup poller from epoll_wait() immediately.
+    char data[SEND_DATA_SIZE];
+    memset(data, 'x', sizeof(data));
+
+    sint64 totalLatency = 0;
+    for (int i = 0; i < WAKEUP_TEST_TIMES; ++i)
+    {
+        const sint64 begTime = LLBC_GetMicroseconds();
+        LLBC_ErrorAndReturnIf(svr->Send(comp->GetSessionId(), 0, data, sizeof(data)) != LLBC_OK, LLBC_FAILED,
+                              "Send data failed, err:%s", LLBC_FormatLastError());
+        LLBC_ErrorAndReturnIf(!RecvFully(sock, sizeof(data)), LLBC_FAILED,
+                              "Recv data failed, err:%s", LLBC_FormatLastError());
+
+        totalLatency += LLBC_GetMicroseconds() - begTime;
+    }
+
+    const sint64 avgLatency = totalLatency / WAKEUP_TEST_TIMES;
+    LLBC_PrintLn("  Send times:%d, average latency:%lld us", WAKEUP_TEST_TIMES, avgLatency);
+    LLBC_ErrorAndReturnIf(avgLatency > MAX_AVG_WAKEUP_LATENCY, LLBC_FAILED,
+                          "Average latency too large(poller not wakeup by pushed events?), latency:%lld us, max:%lld us",
+                          avgLatency, MAX_AVG_WAKEUP_LATENCY);
+
+    svr->Stop();
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_EpollInlineWait::DoConcurrentPushTest()
+{
+    LLBC_PrintLn("- Concurrent push test");
+
+    TestComp *comp;
+    LLBC_Service *svr = StartServer(comp);
+    LLBC_ReturnIf(!svr, LLBC_FAILED);
+    LLBC_Defer(delete svr);
+
+    const LLBC_SocketHandle sock = ConnectServer(comp);
+    LLBC_ErrorAndReturnIf(sock == LLBC_INVALID_SOCKET_HANDLE, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_Defer(LLBC_CloseSocket(sock));
+
+    // Multi threads push send events concurrently, no event can be lost.
+    PushTask task(svr, comp->GetSessionId(), PER_THREAD_SEND_TIMES);
+    task.Activate(PUSHER_THREAD_COUNT);
+
+    const size_t totalSize = SEND_DATA_SIZE * PUSHER_THREAD_COUNT * PER_THREAD_SEND_TIMES;
+    const bool recvSucc = RecvFully(sock, totalSize);
+    task.Wait();
+
+    LLBC_PrintLn("  Pusher threads:%d, sent times:%d, failed times:%d",
+                 PUSHER_THREAD_COUNT, task._sentTimes, task._failedTimes);
+    LLBC_ErrorAndReturnIf(task._sentTimes != PUSHER_THREAD_COUNT * PER_THREAD_SEND_TIMES, LLBC_FAILED,
+                          "Sent times error, sent times:%d, expect:%d",
+                          task._sentTimes, PUSHER_THREAD_COUNT * PER_THREAD_SEND_TIMES);
+    LLBC_ErrorAndReturnIf(!recvSucc, LLBC_FAILED,
+                          "Recv data failed, expect size:%lu, err:%s", totalSize, LLBC_FormatLastError());
+
+    svr->Stop();
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_EpollInlineWait::DoStopWithPushersTest()
+{
+    LLBC_PrintLn("- Stop with pushers test");
+
+    // Stop service while other threads still pushing events, poller close wakeup fd must
+    // wait all in-flight wakers finished.
+    for (int round = 0; round < STOP_TEST_ROUNDS; ++round)
+    {
+        TestComp *comp;
+        LLBC_Service *svr = StartServer(comp);
+        LLBC_ReturnIf(!svr, LLBC_FAILED);
+        LLBC_Defer(delete svr);
+
+        const LLBC_SocketHandle sock = ConnectServer(comp);
+        LLBC_ErrorAndReturnIf(sock == LLBC_INVALID_SOCKET_HANDLE, LLBC_FAILED,
+                              "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+        LLBC_Defer(LLBC_CloseSocket(sock));
+
+        PushTask task(svr, comp->GetSessionId(), -1);
+        task.Activate(PUSHER_THREAD_COUNT);
+
+        LLBC_Sleep(20);
+        svr->Stop();
+
+        LLBC_AtomicSet(&task._stop, 1);
+        task.Wait();
+
+        LLBC_PrintLn("  Round %d, sent times:%d, failed times:%d", round, task._sentTimes, task._failedTimes);
+        LLBC_ErrorAndReturnIf(task._sentTimes == 0, LLBC_FAILED,
+                              "No data sent before service stopped, round:%d", round);
+    }
+
+    return LLBC_OK;
+}
+
+#else // !((LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID) && LLBC_CFG_COMM_EPOLL_INLINE_WAIT)
+
+int TestCase_Comm_EpollInlineWait::DoWakeupLatencyTest()
+{
+    return LLBC_OK;
+}
+
+int TestCase_Comm_EpollInlineWait::DoConcurrentPushTest()
+{
+    return LLBC_OK;
+}
+
+int TestCase_Comm_EpollInlineWait::DoStopWithPushersTest()
+{
+    return LLBC_OK;
+}
+
+#endif // (LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID) && LLBC_CFG_COMM_EPOLL_INLINE_WAIT
@@ -0,0 +1,156 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_EvBlockPool.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17638;
+
+const int WARM_UP_PING_PONG_TIMES = 500;
+const int PING_PONG_TIMES = 1000;
+
+// Server component: echo packets.
+class ServerComp final : public LLBC_Component
+{
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        GetService()->Send(packet.GetSessionId(), OPCODE, packet.GetPayload(), packet.GetPayloadLength());
+    }
+};
+
+// Client component: notify main thread when pong packet recved.
+class ClientComp final : public LLBC_Component
+{
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _sem.Post();
+    }
+
+public:
+    LLBC_Semaphore _sem;
+};
+
+// Ping-pong specific times.
+int PingPong(LLBC_Service *client, ClientComp *clientComp, int sessionId, int times)
+{
+    char data[64];
+    memset(data, 'x', sizeof(data));
+    for (int i = 0; i < times; ++i)
+    {
+        LLBC_ErrorAndReturnIf(client->Send(sessionId, OPCODE, data, sizeof(data)) != LLBC_OK, LLBC_FAILED,
+                              "Send ping packet failed, err:%s", LLBC_FormatLastError());
+        LLBC_ErrorAndReturnIf(!clientComp->_sem.TimedWait(1000), LLBC_FAILED,
+                              "Wait pong packet timeout, ping-pong times:%d", i);
+    }
+
+    return LLBC_OK;
+}
+
+}
+
+TestCase_Comm_EvBlockPool::TestCase_Comm_EvBlockPool()
+{
+}
+
+TestCase_Comm_EvBlockPool::~TestCase_Comm_EvBlockPool()
+{
+}
+
+int TestCase_Comm_EvBlockPool::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service event block pool test:");
+
+    LLBC_ReturnIf(DoTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Service event block pool test success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_EvBlockPool::DoTest()
+{
+    // Create server service.
+    LLBC_Service *svr = LLBC_Service::Create("EvBlockPoolSvr");
+    LLBC_Defer(delete svr);
+    svr->SuppressCoderNotFoundWarning();
+
+    ServerComp *svrComp = new ServerComp;
+    svr->AddComponent(svrComp);
+    svr->Subscribe(OPCODE, svrComp, &ServerComp::OnRecv);
+    svr->SetEventWakeup(true);
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service.
+    LLBC_Service *client = LLBC_Service::Create("EvBlockPoolClient");
+    LLBC_Defer(delete client);
+    client->SuppressCoderNotFoundWarning();
+
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->Subscribe(OPCODE, clientComp, &ClientComp::OnRecv);
+    client->SetEventWakeup(true);
+    const int sessionId = client->Connect(TEST_IP, TEST_PORT);
+    LLBC_ErrorAndReturnIf(sessionId == 0, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    // Warm up, let pooled event blocks grow to steady size.
+    LLBC_ReturnIf(PingPong(client, clientComp, sessionId, WARM_UP_PING_PONG_TIMES) != LLBC_OK, LLBC_FAILED);
+
+    sint64 begAcquiredCount, begHeapAllocCount;
+    svr->GetEvBlockStatistics(begAcquiredCount, begHeapAllocCount);
+
+    LLBC_ReturnIf(PingPong(client, clientComp, sessionId, PING_PONG_TIMES) != LLBC_OK, LLBC_FAILED);
+
+    sint64 acquiredCount, heapAllocCount;
+    svr->GetEvBlockStatistics(acquiredCount, heapAllocCount);
+    LLBC_PrintLn("  Ping-pong times:%d, server event blocks acquired:%lld, heap allocated:%lld",
+                 PING_PONG_TIMES, acquiredCount - begAcquiredCount, heapAllocCount - begHeapAllocCount);
+
+    // Every ping packet produce poller/service events in server.
+    LLBC_ErrorAndReturnIf(acquiredCount - begAcquiredCount < PING_PONG_TIMES, LLBC_FAILED,
+                          "Server event blocks acquired count error, count:%lld, expect at least:%d",
+                          acquiredCount - begAcquiredCount, PING_PONG_TIMES);
+
+    #if LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+    // In steady state, event blocks come from object pool, no heap allocation.
+    LLBC_ErrorAndReturnIf(heapAllocCount != begHeapAllocCount, LLBC_FAILED,
+                          "Server event blocks heap allocated in steady state, count:%lld",
+                          heapAllocCount - begHeapAllocCount);
+    #endif // LLBC_CFG_COMM_USE_POOLED_EVENT_BLOCK
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
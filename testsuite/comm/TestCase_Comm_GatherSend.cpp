@@ -0,0 +1,264 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_GatherSend.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17634;
+
+// Send packets in one burst, total data size far larger than socket send buffer,
+// so pending blocks will be accumulated and gather sent(maybe partial).
+const int PACKET_COUNT = 2000;
+const size_t MAX_PAYLOAD_SIZE = 16 * 1024;
+
+// Get test packet payload size(exclude sequence).
+size_t GetPayloadSize(int seq)
+{
+    return (seq * 7919) % MAX_PAYLOAD_SIZE + 1;
+}
+
+// Record server session Id.
+class ServerComp final : public LLBC_Component
+{
+public:
+    ServerComp()
+    : _sessionId(0)
+    {
+    }
+
+public:
+    void OnEvent(int eventType, const LLBC_Variant &eventParams) override
+    {
+        if (eventType != LLBC_ComponentEventType::SessionCreate)
+            return;
+
+        const LLBC_SessionInfo &sessionInfo = *eventParams.AsPtr<LLBC_SessionInfo>();
+        if (!sessionInfo.IsListenSession())
+            LLBC_AtomicSet(&_sessionId, sessionInfo.GetSessionId());
+    }
+
+    int GetSessionId()
+    {
+        return LLBC_AtomicGet(&_sessionId);
+    }
+
+private:
+    volatile sint32 _sessionId;
+};
+
+// Check received packets sequence and payload.
+class ClientComp final : public LLBC_Component
+{
+public:
+    ClientComp()
+    : _recvCount(0)
+    , _errorCount(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        // Read sequence, then payload readable data is the sequence specific data.
+        sint32 seq = -1;
+        packet.Read(&seq, sizeof(seq));
+
+        bool succ = seq == _recvCount && packet.GetPayloadLength() == GetPayloadSize(seq);
+        if (succ)
+        {
+            const char *data = reinterpret_cast<const char *>(packet.GetPayload());
+            for (size_t i = 0; i < GetPayloadSize(seq); ++i)
+            {
+                if (data[i] != static_cast<char>(seq + i))
+                {
+                    succ = false;
+                    break;
+                }
+            }
+        }
+
+        if (!succ)
+            LLBC_AtomicFetchAndAdd(&_errorCount, 1);
+        LLBC_AtomicFetchAndAdd(&_recvCount, 1);
+    }
+
+public:
+    volatile sint32 _recvCount;
+    volatile sint32 _errorCount;
+};
+
+}
+
+TestCase_Comm_GatherSend::TestCase_Comm_GatherSend()
+{
+}
+
+TestCase_Comm_GatherSend::~TestCase_Comm_GatherSend()
+{
+}
+
+int TestCase_Comm_GatherSend::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Gather send test:");
+
+    LLBC_ReturnIf(DoSendVTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoServiceGatherSendTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Gather send test success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_GatherSend::DoSendVTest()
+{
+    LLBC_PrintLn("- LLBC_SendV() test");
+
+    // Create connected socket pair.
+    LLBC_SocketHandle listenSock = LLBC_CreateTcpSocket();
+    LLBC_ErrorAndReturnIf(listenSock == LLBC_INVALID_SOCKET_HANDLE, LLBC_FAILED,
+                          "Create listen socket failed, err:%s", LLBC_FormatLastError());
+    LLBC_Defer(LLBC_CloseSocket(listenSock));
+
+    LLBC_EnableAddressReusable(listenSock);
+    LLBC_ErrorAndReturnIf(LLBC_BindToAddress(listenSock, TEST_IP, TEST_PORT) != LLBC_OK ||
+                          LLBC_ListenForConnection(listenSock, 1) != LLBC_OK,
+                          LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+
+    LLBC_SocketHandle sendSock = LLBC_CreateTcpSocket();
+    LLBC_ErrorAndReturnIf(sendSock == LLBC_INVALID_SOCKET_HANDLE, LLBC_FAILED,
+                          "Create send socket failed, err:%s", LLBC_FormatLastError());
+    LLBC_Defer(LLBC_CloseSocket(sendSock));
+    LLBC_ErrorAndReturnIf(LLBC_ConnectToPeer(sendSock, LLBC_SockAddr_IN(TEST_IP, TEST_PORT)) != LLBC_OK,
+                          LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+
+    LLBC_SocketHandle recvSock = LLBC_AcceptClient(listenSock);
+    LLBC_ErrorAndReturnIf(recvSock == LLBC_INVALID_SOCKET_HANDLE, LLBC_FAILED,
+                          "Accept client failed, err:%s", LLBC_FormatLastError());
+    LLBC_Defer(LLBC_CloseSocket(recvSock));
+
+    // Gather send buffers(include empty buffer), the data must be sent in buffers order.
+    char data1[] = "Hello";
+    char data2[] = "";
+    char data3[] = ", gather send!";
+    LLBC_SockBuf bufs[3];
+    bufs[0].buf = data1;
+    bufs[0].len = static_cast<int>(strlen(data1));
+    bufs[1].buf = data2;
+    bufs[1].len = 0;
+    bufs[2].buf = data3;
+    bufs[2].len = static_cast<int>(strlen(data3));
+
+    const LLBC_String expect = LLBC_String(data1) + data2 + data3;
+    const int sentLen = LLBC_SendV(sendSock, bufs, 3, 0);
+    LLBC_ErrorAndReturnIf(sentLen != static_cast<int>(expect.size()), LLBC_FAILED,
+                          "LLBC_SendV() return error, sent len:%d, expect:%lu, err:%s",
+                          sentLen, expect.size(), LLBC_FormatLastError());
+
+    LLBC_String recved;
+    char buf[64];
+    while (recved.size() < expect.size())
+    {
+        const int recvLen = LLBC_Recv(recvSock, buf, sizeof(buf), 0);
+        LLBC_ErrorAndReturnIf(recvLen <= 0, LLBC_FAILED, "Recv failed, err:%s", LLBC_FormatLastError());
+
+        recved.append(buf, recvLen);
+    }
+
+    LLBC_PrintLn("  Sent len:%d, recved:%s", sentLen, recved.c_str());
+    LLBC_ErrorAndReturnIf(recved != expect, LLBC_FAILED,
+                          "Recved data error, recved:%s, expect:%s", recved.c_str(), expect.c_str());
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_GatherSend::DoServiceGatherSendTest()
+{
+    LLBC_PrintLn("- Service gather send test");
+
+    // Create server service.
+    LLBC_Service *svr = LLBC_Service::Create("GatherSendSvr");
+    LLBC_Defer(delete svr);
+    svr->SuppressCoderNotFoundWarning();
+
+    ServerComp *svrComp = new ServerComp;
+    svr->AddComponent(svrComp);
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service.
+    LLBC_Service *client = LLBC_Service::Create("GatherSendClient");
+    LLBC_Defer(delete client);
+    client->SuppressCoderNotFoundWarning();
+
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->Subscribe(OPCODE, clientComp, &ClientComp::OnRecv);
+    LLBC_ErrorAndReturnIf(client->Connect(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    for (int i = 0; i < 300 && svrComp->GetSessionId() == 0; ++i)
+        LLBC_Sleep(10);
+    LLBC_ErrorAndReturnIf(svrComp->GetSessionId() == 0, LLBC_FAILED, "Wait server session create timeout");
+
+    // Send packets in one burst.
+    size_t totalSize = 0;
+    LLBC_String payload;
+    for (sint32 seq = 0; seq < PACKET_COUNT; ++seq)
+    {
+        const size_t payloadSize = GetPayloadSize(seq);
+        payload.resize(sizeof(seq) + payloadSize);
+        memcpy(&payload[0], &seq, sizeof(seq));
+        for (size_t i = 0; i < payloadSize; ++i)
+            payload[sizeof(seq) + i] = static_cast<char>(seq + i);
+
+        LLBC_ErrorAndReturnIf(svr->Send(svrComp->GetSessionId(), OPCODE, payload.data(), payload.size()) != LLBC_OK,
+                              LLBC_FAILED,
+                              "Send packet failed, seq:%d, err:%s", seq, LLBC_FormatLastError());
+        totalSize += payload.size();
+    }
+
+    for (int i = 0; i < 1000 && LLBC_AtomicGet(&clientComp->_recvCount) < PACKET_COUNT; ++i)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLn("  Sent packets:%d(%lu bytes), recved packets:%d, error packets:%d",
+                 PACKET_COUNT, totalSize, clientComp->_recvCount, clientComp->_errorCount);
+    LLBC_ErrorAndReturnIf(clientComp->_recvCount != PACKET_COUNT || clientComp->_errorCount != 0,
+                          LLBC_FAILED,
+                          "Recved packets error, recved:%d, error:%d, expect:%d",
+                          clientComp->_recvCount, clientComp->_errorCount, PACKET_COUNT);
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
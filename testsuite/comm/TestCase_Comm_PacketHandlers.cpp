@@ -0,0 +1,275 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_PacketHandlers.h"
+
+#if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER && LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
+
+namespace
+{
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17639;
+
+const int DIRECT_INDEX_LIMIT = LLBC_CFG_COMM_PACKET_HANDLERS_DIRECT_INDEX_LIMIT;
+
+// Opcodes below direct index limit(dispatch through direct-indexed table).
+const int DIRECT_OPCODE = 10;
+const int LAST_DIRECT_OPCODE = MAX(DIRECT_INDEX_LIMIT - 1, DIRECT_OPCODE + 2);
+// Opcodes above or equal to direct index limit(dispatch through hash table).
+const int BOUNDARY_OPCODE = DIRECT_INDEX_LIMIT;
+const int BIG_OPCODE = DIRECT_INDEX_LIMIT + 1000000;
+const int PRE_ONLY_OPCODE = DIRECT_INDEX_LIMIT + 5;
+// Not subscribed opcodes.
+const int UNSUBSCRIBED_DIRECT_OPCODE = DIRECT_OPCODE + 1;
+const int UNSUBSCRIBED_HASH_OPCODE = BOUNDARY_OPCODE + 1;
+
+const int SUBSCRIBED_STATUS = 1;
+const int UNSUBSCRIBED_STATUS = 2;
+
+// Record packet handlers call sequence, format: <opcode>:<handler type>,
+// handler type: S(status handler), P(pre-handler), U(unify pre-handler), H(handler), N(unhandled).
+class TestComp final : public LLBC_Component
+{
+public:
+    void OnEvent(int eventType, const LLBC_Variant &eventParams) override
+    {
+        if (eventType == LLBC_ComponentEventType::UnHandledPacket)
+            Record(*eventParams.AsPtr<LLBC_Packet>(), 'N');
+    }
+
+public:
+    void Record(const LLBC_Packet &packet, char handlerType)
+    {
+        LLBC_LockGuard guard(_lock);
+        _records.push_back(LLBC_String().format("%d:%c", packet.GetOpcode(), handlerType));
+    }
+
+    std::vector<LLBC_String> GetRecords()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _records;
+    }
+
+private:
+    LLBC_SpinLock _lock;
+    std::vector<LLBC_String> _records;
+};
+
+// Format records.
+LLBC_String RecordsToStr(const std::vector<LLBC_String> &records)
+{
+    LLBC_String str;
+    for (auto &record : records)
+        str.append_format("%s%s", str.empty() ? "" : ",", record.c_str());
+
+    return str;
+}
+
+}
+
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER && LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
+
+TestCase_Comm_PacketHandlers::TestCase_Comm_PacketHandlers()
+{
+}
+
+TestCase_Comm_PacketHandlers::~TestCase_Comm_PacketHandlers()
+{
+}
+
+int TestCase_Comm_PacketHandlers::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service packet handlers test:");
+
+#if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER && LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
+    LLBC_PrintLn("Direct index limit:%d", DIRECT_INDEX_LIMIT);
+
+    LLBC_ReturnIf(DoSubscribeTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoDispatchTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Service packet handlers test success");
+#else
+    LLBC_PrintLn("Status handler or unify pre-subscribe not enabled, skip test");
+#endif
+
+    return LLBC_OK;
+}
+
+#if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER && LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
+
+int TestCase_Comm_PacketHandlers::DoSubscribeTest()
+{
+    LLBC_PrintLn("- Subscribe test");
+
+    LLBC_Service *svc = LLBC_Service::Create("PacketHandlersSubscribeSvc");
+    LLBC_Defer(delete svc);
+
+    const LLBC_Delegate<void(LLBC_Packet &)> handler([](LLBC_Packet &) {});
+    const LLBC_Delegate<bool(LLBC_Packet &)> preHandler([](LLBC_Packet &) { return true; });
+    for (auto &opcode : {DIRECT_OPCODE, LAST_DIRECT_OPCODE, BOUNDARY_OPCODE, BIG_OPCODE, -1})
+    {
+        // Repeat subscribe must be failed, no matter opcode dispatch through direct-indexed table or hash table.
+        LLBC_ErrorAndReturnIf(svc->Subscribe(opcode, handler) != LLBC_OK, LLBC_FAILED,
+                              "Subscribe failed, opcode:%d, err:%s", opcode, LLBC_FormatLastError());
+        LLBC_ErrorAndReturnIf(svc->Subscribe(opcode, handler) == LLBC_OK ||
+                              LLBC_GetLastError() != LLBC_ERROR_REPEAT,
+                              LLBC_FAILED,
+                              "Repeat subscribe not failed, opcode:%d", opcode);
+
+        LLBC_ErrorAndReturnIf(svc->PreSubscribe(opcode, preHandler) != LLBC_OK, LLBC_FAILED,
+                              "PreSubscribe failed, opcode:%d, err:%s", opcode, LLBC_FormatLastError());
+        LLBC_ErrorAndReturnIf(svc->PreSubscribe(opcode, preHandler) == LLBC_OK ||
+                              LLBC_GetLastError() != LLBC_ERROR_REPEAT,
+                              LLBC_FAILED,
+                              "Repeat pre-subscribe not failed, opcode:%d", opcode);
+
+        LLBC_ErrorAndReturnIf(svc->SubscribeStatus(opcode, SUBSCRIBED_STATUS, handler) != LLBC_OK, LLBC_FAILED,
+                              "SubscribeStatus failed, opcode:%d, err:%s", opcode, LLBC_FormatLastError());
+        LLBC_ErrorAndReturnIf(svc->SubscribeStatus(opcode, SUBSCRIBED_STATUS, handler) == LLBC_OK ||
+                              LLBC_GetLastError() != LLBC_ERROR_REPEAT,
+                              LLBC_FAILED,
+                              "Repeat status subscribe not failed, opcode:%d", opcode);
+    }
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_PacketHandlers::DoDispatchTest()
+{
+    LLBC_PrintLn("- Dispatch test");
+
+    // Create server service, subscribe packet handlers.
+    LLBC_Service *svr = LLBC_Service::Create("PacketHandlersSvr");
+    LLBC_Defer(delete svr);
+    svr->SuppressCoderNotFoundWarning();
+
+    TestComp *comp = new TestComp;
+    svr->AddComponent(comp);
+
+    // Handler: record.
+    // Pre-handler: record, and reject the packets which payload value is odd.
+    // Unify pre-handler: record, and accept all packets.
+    const LLBC_Delegate<void(LLBC_Packet &)> handler([comp](LLBC_Packet &packet) {
+        comp->Record(packet, 'H');
+    });
+    const LLBC_Delegate<void(LLBC_Packet &)> statusHandler([comp](LLBC_Packet &packet) {
+        comp->Record(packet, 'S');
+    });
+    const LLBC_Delegate<bool(LLBC_Packet &)> preHandler([comp](LLBC_Packet &packet) {
+        comp->Record(packet, 'P');
+
+        sint32 val = 0;
+        packet.Read(&val, sizeof(val));
+        return val % 2 == 0;
+    });
+
+    for (auto &opcode : {DIRECT_OPCODE, LAST_DIRECT_OPCODE, BOUNDARY_OPCODE, BIG_OPCODE})
+        svr->Subscribe(opcode, handler);
+    for (auto &opcode : {LAST_DIRECT_OPCODE, BIG_OPCODE, PRE_ONLY_OPCODE})
+        svr->PreSubscribe(opcode, preHandler);
+    for (auto &opcode : {DIRECT_OPCODE, BIG_OPCODE})
+        svr->SubscribeStatus(opcode, SUBSCRIBED_STATUS, statusHandler);
+    svr->UnifyPreSubscribe([comp](LLBC_Packet &packet) {
+        comp->Record(packet, 'U');
+        return true;
+    });
+
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service.
+    LLBC_Service *client = LLBC_Service::Create("PacketHandlersClient");
+    LLBC_Defer(delete client);
+    client->SuppressCoderNotFoundWarning();
+
+    const int sessionId = client->Connect(TEST_IP, TEST_PORT);
+    LLBC_ErrorAndReturnIf(sessionId == 0, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    // Send packets(opcode, status, payload value), and build expect records.
+    struct TestPacket
+    {
+        int opcode;
+        int status;
+        sint32 val;
+        const char *handlerTypes;
+    };
+
+    const TestPacket testPackets[] = {
+        {DIRECT_OPCODE, 0, 0, "UH"},
+        {DIRECT_OPCODE, SUBSCRIBED_STATUS, 0, "S"},
+        {DIRECT_OPCODE, UNSUBSCRIBED_STATUS, 0, "UH"},
+        {LAST_DIRECT_OPCODE, 0, 0, "PH"},
+        {LAST_DIRECT_OPCODE, 0, 1, "P"},
+        {BOUNDARY_OPCODE, 0, 0, "UH"},
+        {BIG_OPCODE, 0, 0, "PH"},
+        {BIG_OPCODE, SUBSCRIBED_STATUS, 0, "S"},
+        {BIG_OPCODE, 0, 1, "P"},
+        {PRE_ONLY_OPCODE, 0, 0, "PN"},
+        {UNSUBSCRIBED_DIRECT_OPCODE, 0, 0, "UN"},
+        {UNSUBSCRIBED_HASH_OPCODE, 0, 0, "UN"},
+    };
+
+    std::vector<LLBC_String> expectRecords;
+    for (auto &testPacket : testPackets)
+    {
+        client->Send(sessionId, testPacket.opcode, &testPacket.val, sizeof(testPacket.val), testPacket.status);
+        for (const char *handlerType = testPacket.handlerTypes; *handlerType != '\0'; ++handlerType)
+            expectRecords.push_back(LLBC_String().format("%d:%c", testPacket.opcode, *handlerType));
+    }
+
+    for (int i = 0; i < 300 && comp->GetRecords().size() < expectRecords.size(); ++i)
+        LLBC_Sleep(10);
+
+    // Wait a while, make sure no more unexpected records.
+    LLBC_Sleep(50);
+
+    const std::vector<LLBC_String> records = comp->GetRecords();
+    LLBC_PrintLn("  Records:%s", RecordsToStr(records).c_str());
+    LLBC_ErrorAndReturnIf(records != expectRecords, LLBC_FAILED,
+                          "Packet handlers records error, records:%s, expect:%s",
+                          RecordsToStr(records).c_str(), RecordsToStr(expectRecords).c_str());
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
+
+#else // !(LLBC_CFG_COMM_ENABLE_STATUS_HANDLER && LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE)
+
+int TestCase_Comm_PacketHandlers::DoSubscribeTest()
+{
+    return LLBC_OK;
+}
+
+int TestCase_Comm_PacketHandlers::DoDispatchTest()
+{
+    return LLBC_OK;
+}
+
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER && LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
@@ -0,0 +1,377 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_PayloadSlice.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const size_t LARGE_PAYLOAD_SIZE = LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE * 2;
+const size_t SMALL_PAYLOAD_SIZE = 16;
+const int PACKET_COUNT = 20;
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17632;
+
+// Hold all received payloads(detached from packets).
+class TestComp final : public LLBC_Component
+{
+public:
+    ~TestComp() override
+    {
+        LLBC_STLHelper::RecycleContainer(_payloads);
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        LLBC_MessageBlock *payload = packet.DetachPayload();
+
+        LLBC_LockGuard guard(_lock);
+        _payloads.push_back(payload);
+    }
+
+    size_t GetPayloadCount()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _payloads.size();
+    }
+
+    std::vector<LLBC_MessageBlock *> GetPayloads()
+    {
+        LLBC_LockGuard guard(_lock);
+        return _payloads;
+    }
+
+private:
+    LLBC_SpinLock _lock;
+    std::vector<LLBC_MessageBlock *> _payloads;
+};
+
+// Get test packet payload size.
+size_t GetPayloadSize(int idx)
+{
+    return idx % 2 == 0 ? LARGE_PAYLOAD_SIZE : SMALL_PAYLOAD_SIZE;
+}
+
+}
+
+TestCase_Comm_PayloadSlice::TestCase_Comm_PayloadSlice()
+{
+}
+
+TestCase_Comm_PayloadSlice::~TestCase_Comm_PayloadSlice()
+{
+}
+
+int TestCase_Comm_PayloadSlice::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Packet payload slice test:");
+
+    LLBC_ReturnIf(DoSliceRefCountTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoPooledSliceTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoRecvPayloadSliceTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Packet payload slice test success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_PayloadSlice::DoSliceRefCountTest()
+{
+    LLBC_PrintLn("- Slice reference count test");
+
+    #define __CheckRefCount(sharedBlock, expect)                             \
+        LLBC_ErrorAndReturnIf((sharedBlock)->GetRefCount() != (expect),      \
+                              LLBC_FAILED,                                   \
+                              "Reference count error, count:%d, expect:%d",  \
+                              (sharedBlock)->GetRefCount(), (expect))        \
+
+    LLBC_SharedMessageBlock *sharedBlock = new LLBC_SharedMessageBlock(64);
+    sharedBlock->GetBlock().Write("0123456789abcdef", 16);
+    __CheckRefCount(sharedBlock, 1);
+
+    // Create slice, slice reference owner buffer and hold one reference.
+    LLBC_MessageBlock *slice1 = sharedBlock->CreateSlice(4, 8);
+    LLBC_ErrorAndReturnIf(!slice1, LLBC_FAILED, "Create slice failed");
+    __CheckRefCount(sharedBlock, 2);
+    LLBC_ErrorAndReturnIf(!slice1->IsAttach() ||
+                          slice1->GetData() != reinterpret_cast<char *>(sharedBlock->GetBlock().GetData()) + 4 ||
+                          slice1->GetReadableSize() != 8 ||
+                          memcmp(slice1->GetData(), "456789ab", 8) != 0,
+                          LLBC_FAILED,
+                          "Slice data error");
+
+    // Out of range slice.
+    LLBC_ErrorAndReturnIf(sharedBlock->CreateSlice(60, 8) != nullptr, LLBC_FAILED, "Create out of range slice success");
+    __CheckRefCount(sharedBlock, 2);
+
+    // Owner released, slices keep shared block alive.
+    LLBC_MessageBlock *slice2 = sharedBlock->CreateSlice(0, 4);
+    __CheckRefCount(sharedBlock, 3);
+    sharedBlock->Release();
+    __CheckRefCount(sharedBlock, 2);
+    LLBC_ErrorAndReturnIf(memcmp(slice1->GetData(), "456789ab", 8) != 0, LLBC_FAILED,
+                          "Slice data changed after owner released");
+
+    // Write slice beyond slice length, slice copy data to self-owned buffer and release reference.
+    slice2->Write("x", 1);
+    __CheckRefCount(sharedBlock, 1);
+    LLBC_ErrorAndReturnIf(slice2->IsAttach() ||
+                          slice2->GetReadableSize() != 5 ||
+                          memcmp(slice2->GetData(), "0123x", 5) != 0,
+                          LLBC_FAILED,
+                          "Slice data error after write beyond slice length");
+    delete slice2;
+    __CheckRefCount(sharedBlock, 1);
+
+    // Slice recycled by message buffer release reference.
+    sharedBlock->Retain();
+    {
+        LLBC_MessageBuffer msgBuffer;
+        msgBuffer.Append(slice1);
+        __CheckRefCount(sharedBlock, 2);
+    }
+    __CheckRefCount(sharedBlock, 1);
+
+    // Packet payload slice.
+    {
+        LLBC_Packet packet;
+        LLBC_ErrorAndReturnIf(packet.SetPayloadSlice(sharedBlock, 8, 8) != LLBC_OK, LLBC_FAILED,
+                              "Set payload slice failed");
+        __CheckRefCount(sharedBlock, 2);
+
+        char buf[8];
+        LLBC_ErrorAndReturnIf(packet.GetPayloadLength() != 8 ||
+                              packet.Read(buf, sizeof(buf)) != LLBC_OK ||
+                              memcmp(buf, "89abcdef", 8) != 0,
+                              LLBC_FAILED,
+                              "Packet payload slice data error");
+
+        // Replace payload slice, old slice released.
+        LLBC_ErrorAndReturnIf(packet.SetPayloadSlice(sharedBlock, 0, 8) != LLBC_OK, LLBC_FAILED,
+                              "Set payload slice failed");
+        __CheckRefCount(sharedBlock, 2);
+
+        // Detached payload slice still hold reference.
+        LLBC_MessageBlock *detached = packet.DetachPayload();
+        __CheckRefCount(sharedBlock, 2);
+        delete detached;
+        __CheckRefCount(sharedBlock, 1);
+
+        // Packet destroy release reference.
+        packet.SetPayloadSlice(sharedBlock, 0, 16);
+        __CheckRefCount(sharedBlock, 2);
+    }
+    __CheckRefCount(sharedBlock, 1);
+
+    #undef __CheckRefCount
+
+    sharedBlock->Release();
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_PayloadSlice::DoPooledSliceTest()
+{
+    LLBC_PrintLn("- Pooled slice test");
+
+    #define __CheckRefCount(sharedBlock, expect)                             \
+        LLBC_ErrorAndReturnIf((sharedBlock)->GetRefCount() != (expect),      \
+                              LLBC_FAILED,                                   \
+                              "Reference count error, count:%d, expect:%d",  \
+                              (sharedBlock)->GetRefCount(), (expect))        \
+
+    LLBC_ObjPool objPool(true);
+    LLBC_TypedObjPool<LLBC_MessageBlock> *blockPool = objPool.GetTypedObjPool<LLBC_MessageBlock>();
+
+    LLBC_SharedMessageBlock *sharedBlock = new LLBC_SharedMessageBlock(64);
+    sharedBlock->GetBlock().Write("0123456789abcdef", 16);
+
+    // Create pooled slice, slice block acquired from pool and hold one reference.
+    LLBC_MessageBlock *slice = sharedBlock->CreateSlice(4, 8, blockPool);
+    LLBC_ErrorAndReturnIf(!slice, LLBC_FAILED, "Create pooled slice failed");
+    __CheckRefCount(sharedBlock, 2);
+    LLBC_ErrorAndReturnIf(slice->GetTypedObjPool() != blockPool ||
+                          !slice->IsAttach() ||
+                          slice->GetSize() != 8 ||
+                          slice->GetData() != reinterpret_cast<char *>(sharedBlock->GetBlock().GetData()) + 4 ||
+                          memcmp(slice->GetDataStartWithReadPos(), "456789ab", 8) != 0,
+                          LLBC_FAILED,
+                          "Pooled slice error");
+
+    // Out of range slice, no block acquired, no reference held.
+    LLBC_ErrorAndReturnIf(sharedBlock->CreateSlice(60, 8, blockPool) != nullptr, LLBC_FAILED,
+                          "Create out of range pooled slice success");
+    __CheckRefCount(sharedBlock, 2);
+
+    // Recycle pooled slice release reference, recycled slice block is bufferless(not attached).
+    LLBC_Recycle(slice);
+    __CheckRefCount(sharedBlock, 1);
+
+    LLBC_MessageBlock *block = blockPool->Acquire();
+    LLBC_ErrorAndReturnIf(block->IsAttach(), LLBC_FAILED, "Acquired block from slice pool still attached");
+    blockPool->Release(block);
+
+    // Many pooled slices, every slice hold one reference until recycled.
+    const int sliceCount = 16;
+    LLBC_MessageBlock *slices[sliceCount];
+    for (int i = 0; i < sliceCount; ++i)
+    {
+        slices[i] = sharedBlock->CreateSlice(i, 1, blockPool);
+        LLBC_ErrorAndReturnIf(!slices[i] || slices[i]->GetTypedObjPool() != blockPool, LLBC_FAILED,
+                              "Create pooled slice failed, idx:%d", i);
+    }
+    __CheckRefCount(sharedBlock, sliceCount + 1);
+
+    for (int i = 0; i < sliceCount; ++i)
+    {
+        LLBC_ErrorAndReturnIf(*reinterpret_cast<const char *>(slices[i]->GetData()) != "0123456789abcdef"[i],
+                              LLBC_FAILED,
+                              "Pooled slice data error, idx:%d", i);
+        LLBC_Recycle(slices[i]);
+        __CheckRefCount(sharedBlock, sliceCount - i);
+    }
+
+    // Pooled packet payload slice, packet destroy recycle slice to pool and release reference.
+    {
+        LLBC_Packet packet;
+        LLBC_ErrorAndReturnIf(packet.SetPayloadSlice(sharedBlock, 8, 8, blockPool) != LLBC_OK, LLBC_FAILED,
+                              "Set pooled payload slice failed");
+        __CheckRefCount(sharedBlock, 2);
+
+        char buf[8];
+        LLBC_ErrorAndReturnIf(packet.Read(buf, sizeof(buf)) != LLBC_OK ||
+                              memcmp(buf, "89abcdef", 8) != 0,
+                              LLBC_FAILED,
+                              "Pooled packet payload slice data error");
+    }
+    __CheckRefCount(sharedBlock, 1);
+
+    // Pooled slice write beyond slice length, copy to self-owned buffer, recycle keep buffer in pool,
+    // next pooled slice free it and attach shared block again.
+    slice = sharedBlock->CreateSlice(0, 4, blockPool);
+    slice->Write("x", 1);
+    __CheckRefCount(sharedBlock, 1);
+    LLBC_ErrorAndReturnIf(slice->IsAttach() ||
+                          memcmp(slice->GetData(), "0123x", 5) != 0,
+                          LLBC_FAILED,
+                          "Pooled slice data error after write beyond slice length");
+    LLBC_Recycle(slice);
+
+    slice = sharedBlock->CreateSlice(12, 4, blockPool);
+    __CheckRefCount(sharedBlock, 2);
+    LLBC_ErrorAndReturnIf(!slice->IsAttach() ||
+                          slice->GetSize() != 4 ||
+                          memcmp(slice->GetData(), "cdef", 4) != 0,
+                          LLBC_FAILED,
+                          "Pooled slice data error");
+    LLBC_Recycle(slice);
+    __CheckRefCount(sharedBlock, 1);
+
+    #undef __CheckRefCount
+
+    sharedBlock->Release();
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_PayloadSlice::DoRecvPayloadSliceTest()
+{
+    LLBC_PrintLn("- Recv payload slice test");
+
+    // Create server service(reuse session recv buffer).
+    LLBC_Service *svr = LLBC_Service::Create("PayloadSliceSvr", new LLBC_NormalProtocolFactory);
+    LLBC_Defer(delete svr);
+    svr->SuppressCoderNotFoundWarning();
+
+    TestComp *comp = new TestComp;
+    svr->AddComponent(comp);
+    svr->Subscribe(OPCODE, comp, &TestComp::OnRecv);
+
+    LLBC_SessionOpts sessionOpts;
+    sessionOpts.SetSessionRecvBufReuse(true);
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT, nullptr, sessionOpts) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service.
+    LLBC_Service *client = LLBC_Service::Create("PayloadSliceClient", new LLBC_NormalProtocolFactory);
+    LLBC_Defer(delete client);
+    client->SuppressCoderNotFoundWarning();
+
+    const int sid = client->Connect(TEST_IP, TEST_PORT);
+    LLBC_ErrorAndReturnIf(sid == 0, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    // Send large/small packets alternately, every packet payload filled with different char.
+    for (int i = 0; i < PACKET_COUNT; ++i)
+    {
+        const LLBC_String payload(GetPayloadSize(i), static_cast<char>('a' + i));
+        client->Send(sid, OPCODE, payload.data(), payload.size());
+        LLBC_Sleep(5);
+    }
+
+    for (int i = 0; i < 300 && comp->GetPayloadCount() < PACKET_COUNT; ++i)
+        LLBC_Sleep(10);
+
+    // Check payloads:
+    // - all payloads data unchanged(payload slices keep recv buffer alive, recv buffer not reused).
+    // - small payloads never slice recv buffer(copied, recv buffer can be reused).
+    const std::vector<LLBC_MessageBlock *> payloads = comp->GetPayloads();
+    LLBC_ErrorAndReturnIf(payloads.size() != PACKET_COUNT, LLBC_FAILED,
+                          "Recved packets count error, count:%lu, expect:%d", payloads.size(), PACKET_COUNT);
+
+    int slicedCount = 0;
+    for (int i = 0; i < PACKET_COUNT; ++i)
+    {
+        const LLBC_MessageBlock *payload = payloads[i];
+        const LLBC_String expect(GetPayloadSize(i), static_cast<char>('a' + i));
+        LLBC_ErrorAndReturnIf(payload->GetReadableSize() != expect.size() ||
+                              memcmp(payload->GetDataStartWithReadPos(), expect.data(), expect.size()) != 0,
+                              LLBC_FAILED,
+                              "Payload data error, idx:%d", i);
+
+        if (payload->IsAttach())
+        {
+            LLBC_ErrorAndReturnIf(expect.size() < LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE, LLBC_FAILED,
+                                  "Small payload slice recv buffer, idx:%d, size:%lu", i, expect.size());
+            ++slicedCount;
+        }
+    }
+
+    #if LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE > 0
+    // Large payloads normally received in one recv round, at least one of them must be sliced.
+    LLBC_ErrorAndReturnIf(slicedCount == 0, LLBC_FAILED, "No any large payload slice recv buffer");
+    #endif // LLBC_CFG_COMM_PACKET_PAYLOAD_SLICE_MIN_SIZE > 0
+
+    LLBC_PrintLn("  All payloads checked, sliced payloads:%d", slicedCount);
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
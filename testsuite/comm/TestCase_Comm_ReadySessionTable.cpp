@@ -0,0 +1,354 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/comm/ReadySessionTable.h"
+
+#include "comm/TestCase_Comm_ReadySessionTable.h"
+
+namespace
+{
+
+struct TestReadySessionInfo
+{
+    int sessionId;
+    bool isListenSession;
+    size_t listIndex;
+
+    TestReadySessionInfo(int sessionId, bool isListenSession)
+    : sessionId(sessionId)
+    , isListenSession(isListenSession)
+    , listIndex(0)
+    {
+    }
+};
+
+typedef LLBC_ReadySessionTable<TestReadySessionInfo> TestReadySessionTable;
+
+// Check table content equal to expect session Ids: Find/IsReady/list index/session infos set.
+int CheckReadySessions(const TestReadySessionTable &table, const std::set<int> &expectSessionIds)
+{
+    const std::vector<TestReadySessionInfo *> &sessionInfos = table.GetSessionInfos();
+    LLBC_ErrorAndReturnIf(sessionInfos.size() != expectSessionIds.size(),
+                          LLBC_FAILED,
+                          "Ready session count error, count:%lu, expect:%lu",
+                          sessionInfos.size(), expectSessionIds.size());
+
+    // Broadcast like iterating.
+    std::set<int> iteratedSessionIds;
+    for (size_t i = 0; i < sessionInfos.size(); ++i)
+    {
+        const TestReadySessionInfo *sessionInfo = sessionInfos[i];
+        LLBC_ErrorAndReturnIf(sessionInfo->listIndex != i,
+                              LLBC_FAILED,
+                              "Ready session list index error, sessionId:%d, listIndex:%lu, expect:%lu",
+                              sessionInfo->sessionId, sessionInfo->listIndex, i);
+        LLBC_ErrorAndReturnIf(!iteratedSessionIds.insert(sessionInfo->sessionId).second,
+                              LLBC_FAILED,
+                              "Ready session iterated repeatedly, sessionId:%d",
+                              sessionInfo->sessionId);
+    }
+
+    LLBC_ErrorAndReturnIf(iteratedSessionIds != expectSessionIds,
+                          LLBC_FAILED,
+                          "Iterated ready sessions not equal to expect ready sessions");
+
+    for (auto &sessionId : expectSessionIds)
+    {
+        const TestReadySessionInfo *sessionInfo = table.Find(sessionId);
+        LLBC_ErrorAndReturnIf(!sessionInfo || sessionInfo->sessionId != sessionId,
+                              LLBC_FAILED,
+                              "Find ready session failed, sessionId:%d",
+                              sessionId);
+
+        bool isListenSession = !sessionInfo->isListenSession;
+        LLBC_ErrorAndReturnIf(!table.IsReady(sessionId, isListenSession),
+                              LLBC_FAILED,
+                              "IsReady() return false, sessionId:%d",
+                              sessionId);
+        LLBC_ErrorAndReturnIf(isListenSession != sessionInfo->isListenSession,
+                              LLBC_FAILED,
+                              "IsReady() listen flag error, sessionId:%d",
+                              sessionId);
+    }
+
+    return LLBC_OK;
+}
+
+// Check session not ready.
+int CheckNotReady(const TestReadySessionTable &table, int sessionId)
+{
+    bool isListenSession = false;
+    LLBC_ErrorAndReturnIf(table.Find(sessionId) != nullptr,
+                          LLBC_FAILED,
+                          "Find not ready session success, sessionId:%d",
+                          sessionId);
+    LLBC_ErrorAndReturnIf(table.IsReady(sessionId, isListenSession),
+                          LLBC_FAILED,
+                          "IsReady() return true for not ready session, sessionId:%d",
+                          sessionId);
+
+    return LLBC_OK;
+}
+
+// Lock-free reader task: check stable sessions always ready until stopped.
+class ReadyCheckTask : public LLBC_Task
+{
+public:
+    ReadyCheckTask(const TestReadySessionTable &table, const std::vector<int> &stableSessionIds)
+    : _table(table)
+    , _stableSessionIds(stableSessionIds)
+    , _stop(0)
+    , _checkTimes(0)
+    , _errorTimes(0)
+    {
+    }
+
+public:
+    void Svc() override
+    {
+        bool isListenSession;
+        while (LLBC_AtomicGet(&_stop) == 0)
+        {
+            for (auto &sessionId : _stableSessionIds)
+            {
+                if (!_table.IsReady(sessionId, isListenSession))
+                    LLBC_AtomicFetchAndAdd(&_errorTimes, 1);
+            }
+
+            LLBC_AtomicFetchAndAdd(&_checkTimes, 1);
+        }
+    }
+
+    void Cleanup() override
+    {
+    }
+
+public:
+    const TestReadySessionTable &_table;
+    const std::vector<int> &_stableSessionIds;
+
+    volatile sint32 _stop;
+    volatile sint32 _checkTimes;
+    volatile sint32 _errorTimes;
+};
+
+template <typename InsertFunc, typename EraseFunc>
+int ConcurrentReaderTest(TestReadySessionTable &table,
+                         std::set<int> &readySessionIds,
+                         InsertFunc &insert,
+                         EraseFunc &erase)
+{
+    const std::vector<int> stableSessionIds(readySessionIds.begin(), readySessionIds.end());
+
+    ReadyCheckTask task(table, stableSessionIds);
+    task.Activate(4);
+
+    // Churn in lock, reclaim retired slots at quiescent points.
+    LLBC_SpinLock lock;
+    int reclaimedCount = 0;
+    for (int sessionId = 200000; sessionId < 300000; ++sessionId)
+    {
+        lock.Lock();
+        insert(sessionId, false);
+        if (sessionId % 3 != 0)
+            erase(sessionId);
+        if (sessionId % 64 == 0)
+            reclaimedCount += table.ReclaimRetiredSlots();
+        lock.Unlock();
+    }
+
+    LLBC_AtomicSet(&task._stop, 1);
+    task.Wait();
+
+    lock.Lock();
+    reclaimedCount += table.ReclaimRetiredSlots();
+    lock.Unlock();
+
+    LLBC_PrintLn("  check times:%d, error times:%d, reclaimed slots:%d, slot count:%d",
+                 task._checkTimes, task._errorTimes, reclaimedCount, table.GetSlotCount());
+    LLBC_ErrorAndReturnIf(task._errorTimes != 0,
+                          LLBC_FAILED,
+                          "Stable session not ready in concurrent reader test, error times:%d",
+                          task._errorTimes);
+    LLBC_ErrorAndReturnIf(reclaimedCount == 0 || table.HasRetiredSlots(),
+                          LLBC_FAILED,
+                          "Retired slots not reclaimed in concurrent reader test");
+
+    return LLBC_OK;
+}
+
+}
+
+TestCase_Comm_ReadySessionTable::TestCase_Comm_ReadySessionTable()
+{
+}
+
+TestCase_Comm_ReadySessionTable::~TestCase_Comm_ReadySessionTable()
+{
+}
+
+int TestCase_Comm_ReadySessionTable::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("ReadySessionTable testcase:");
+
+    TestReadySessionTable table(8);
+    std::set<int> readySessionIds;
+    std::vector<TestReadySessionInfo *> allSessionInfos;
+    LLBC_Defer(LLBC_STLHelper::DeleteContainer(allSessionInfos));
+
+    auto insert = [&](int sessionId, bool isListenSession) {
+        TestReadySessionInfo *sessionInfo = new TestReadySessionInfo(sessionId, isListenSession);
+        allSessionInfos.push_back(sessionInfo);
+        if (table.Insert(sessionInfo) != LLBC_OK)
+            return LLBC_FAILED;
+
+        readySessionIds.insert(sessionId);
+        return LLBC_OK;
+    };
+
+    auto erase = [&](int sessionId) {
+        TestReadySessionInfo *sessionInfo = table.Erase(sessionId);
+        if (!sessionInfo || sessionInfo->sessionId != sessionId)
+            return LLBC_FAILED;
+
+        readySessionIds.erase(sessionId);
+        return LLBC_OK;
+    };
+
+    // Empty table.
+    LLBC_PrintLn("- Empty table test");
+    LLBC_ReturnIf(table.GetSlotCount() != 0, LLBC_FAILED);
+    LLBC_ReturnIf(CheckNotReady(table, 1) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(table.Erase(1) != nullptr, LLBC_FAILED);
+
+    // Invalid session Id.
+    LLBC_PrintLn("- Invalid session Id test");
+    LLBC_ErrorAndReturnIf(insert(0, false) == LLBC_OK, LLBC_FAILED, "Insert session Id 0 success");
+    LLBC_ErrorAndReturnIf(insert(-5, false) == LLBC_OK, LLBC_FAILED, "Insert negative session Id success");
+
+    // Insert.
+    LLBC_PrintLn("- Insert test");
+    LLBC_ReturnIf(insert(1, true) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(insert(2, false) != LLBC_OK, LLBC_FAILED);
+    LLBC_ErrorAndReturnIf(table.GetSlotCount() != 8, LLBC_FAILED,
+                          "Slot count error, count:%d", table.GetSlotCount());
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckNotReady(table, 3) != LLBC_OK, LLBC_FAILED);
+
+    // Repeat insert.
+    LLBC_PrintLn("- Repeat insert test");
+    LLBC_ErrorAndReturnIf(insert(1, false) == LLBC_OK, LLBC_FAILED, "Repeat insert success");
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+
+    // Collision: 9/17 home slot equal to 1's home slot.
+    LLBC_PrintLn("- Collision test");
+    LLBC_ReturnIf(insert(9, false) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckNotReady(table, 17) != LLBC_OK, LLBC_FAILED);
+
+    // Erase collided chain head, collided session still can be found.
+    LLBC_PrintLn("- Erase collided session test");
+    LLBC_ReturnIf(erase(1) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckNotReady(table, 1) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(table.Erase(1) != nullptr, LLBC_FAILED);
+
+    // Erased slot reused.
+    LLBC_ReturnIf(insert(17, true) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+    LLBC_ErrorAndReturnIf(table.GetSlotCount() != 8, LLBC_FAILED,
+                          "Slot count error, count:%d", table.GetSlotCount());
+
+    // Grow.
+    LLBC_PrintLn("- Grow test");
+    for (int sessionId = 100; sessionId < 164; ++sessionId)
+        LLBC_ReturnIf(insert(sessionId, sessionId % 3 == 0) != LLBC_OK, LLBC_FAILED);
+    // Max session Id wrap around to first slot in probe sequence.
+    LLBC_ReturnIf(insert(INT_MAX, true) != LLBC_OK, LLBC_FAILED);
+    LLBC_ErrorAndReturnIf(table.GetSlotCount() < static_cast<int>(readySessionIds.size()) * 2,
+                          LLBC_FAILED,
+                          "Slots not grow, slot count:%d, ready session count:%lu",
+                          table.GetSlotCount(), readySessionIds.size());
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+
+    // Swap-remove: erase first/middle/last ones of session info list.
+    LLBC_PrintLn("- Swap-remove test");
+    LLBC_ReturnIf(erase(table.GetSessionInfos().front()->sessionId) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(erase(table.GetSessionInfos()[table.GetSessionInfos().size() / 2]->sessionId) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(erase(table.GetSessionInfos().back()->sessionId) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+
+    // Churn: erase & insert new session Ids(session Id never reused), slots must not grow.
+    LLBC_PrintLn("- Churn test");
+    const int slotCount = table.GetSlotCount();
+    for (int sessionId = 1000; sessionId < 100000; ++sessionId)
+    {
+        LLBC_ReturnIf(erase(*readySessionIds.begin()) != LLBC_OK, LLBC_FAILED);
+        LLBC_ReturnIf(insert(sessionId, false) != LLBC_OK, LLBC_FAILED);
+    }
+    LLBC_ErrorAndReturnIf(table.GetSlotCount() != slotCount,
+                          LLBC_FAILED,
+                          "Slots grow in churn test, slot count:%d, before:%d",
+                          table.GetSlotCount(), slotCount);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckNotReady(table, 1000) != LLBC_OK, LLBC_FAILED);
+
+    // Tombstones count toward rehash trigger, rehash drops tombstones and recomputes max probe length.
+    LLBC_ErrorAndReturnIf((table.GetErasedSlotCount() + readySessionIds.size()) * 2 > static_cast<size_t>(slotCount),
+                          LLBC_FAILED,
+                          "Tombstones pile up, erased slot count:%d, ready session count:%lu, slot count:%d",
+                          table.GetErasedSlotCount(), readySessionIds.size(), slotCount);
+    LLBC_ErrorAndReturnIf(table.GetMaxProbeLen() >= slotCount / 8,
+                          LLBC_FAILED,
+                          "Max probe length keep growing, max probe len:%d, slot count:%d",
+                          table.GetMaxProbeLen(), slotCount);
+
+    // Retired slots reclaim(no lock-free reader now).
+    LLBC_PrintLn("- Retired slots reclaim test");
+    LLBC_ErrorAndReturnIf(!table.HasRetiredSlots(), LLBC_FAILED, "No retired slots after rehash");
+    LLBC_ErrorAndReturnIf(table.ReclaimRetiredSlots() <= 0 || table.HasRetiredSlots(),
+                          LLBC_FAILED,
+                          "Reclaim retired slots failed");
+    LLBC_ErrorAndReturnIf(table.ReclaimRetiredSlots() != 0, LLBC_FAILED, "Reclaim retired slots repeatedly");
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+
+    // Concurrent lock-free readers: stable sessions must always be ready while other sessions churn,
+    // slots rehash and retired slots reclaimed.
+    LLBC_PrintLn("- Concurrent reader test");
+    LLBC_ReturnIf(ConcurrentReaderTest(table, readySessionIds, insert, erase) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+
+    // Clear.
+    LLBC_PrintLn("- Clear test");
+    std::set<int> clearedSessionIds(readySessionIds);
+    table.Clear();
+    readySessionIds.clear();
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+    for (auto &sessionId : clearedSessionIds)
+        LLBC_ReturnIf(CheckNotReady(table, sessionId) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(insert(1, false) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckReadySessions(table, readySessionIds) != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("ReadySessionTable test success");
+
+    return LLBC_OK;
+}
@@ -0,0 +1,230 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_SvcEventWakeup.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+const char *TEST_IP = "127.0.0.1";
+const uint16 TEST_PORT = 17637;
+
+// Low FPS, if service not wakeup by arrived events, round trip time will be about 1~2 frame intervals.
+const int TEST_FPS = 10;
+const int PING_PONG_TIMES = 50;
+const sint64 MAX_AVG_ROUND_TRIP_TIME = 30 * 1000; // In micro-seconds.
+
+// Timer period, less than frame interval.
+const int TIMER_PERIOD = 30;
+
+// Server component: echo packets, count updates and timer timeouts.
+class ServerComp final : public LLBC_Component
+{
+public:
+    ServerComp()
+    : _timer(nullptr)
+    , _updateTimes(0)
+    , _timeoutTimes(0)
+    {
+    }
+
+public:
+    int OnStart(bool &startFinished) override
+    {
+        _timer = new LLBC_Timer([this](LLBC_Timer *) {
+            LLBC_AtomicFetchAndAdd(&_timeoutTimes, 1);
+        });
+        _timer->Schedule(LLBC_TimeSpan::FromMillis(TIMER_PERIOD), LLBC_TimeSpan::FromMillis(TIMER_PERIOD));
+
+        return LLBC_OK;
+    }
+
+    void OnStop(bool &stopFinished) override
+    {
+        LLBC_XDelete(_timer);
+    }
+
+    void OnUpdate() override
+    {
+        LLBC_AtomicFetchAndAdd(&_updateTimes, 1);
+    }
+
+    void OnRecv(LLBC_Packet &packet)
+    {
+        GetService()->Send(packet.GetSessionId(), OPCODE, packet.GetPayload(), packet.GetPayloadLength());
+    }
+
+public:
+    LLBC_Timer *_timer;
+
+    volatile sint32 _updateTimes;
+    volatile sint32 _timeoutTimes;
+};
+
+// Client component: notify main thread when pong packet recved.
+class ClientComp final : public LLBC_Component
+{
+public:
+    ClientComp()
+    : _sem(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _sem.Post();
+    }
+
+public:
+    LLBC_Semaphore _sem;
+};
+
+}
+
+TestCase_Comm_SvcEventWakeup::TestCase_Comm_SvcEventWakeup()
+{
+}
+
+TestCase_Comm_SvcEventWakeup::~TestCase_Comm_SvcEventWakeup()
+{
+}
+
+int TestCase_Comm_SvcEventWakeup::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service event wakeup test:");
+
+    LLBC_ReturnIf(DoEventWakeupOptionTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(DoEventWakeupTest() != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Service event wakeup test success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_SvcEventWakeup::DoEventWakeupOptionTest()
+{
+    LLBC_PrintLn("- Event wakeup option test");
+
+    LLBC_Service *svc = LLBC_Service::Create("EventWakeupOptionSvc");
+    LLBC_Defer(delete svc);
+
+    LLBC_ErrorAndReturnIf(svc->IsEventWakeup() != (LLBC_CFG_COMM_DFT_SERVICE_EVENT_WAKEUP != 0), LLBC_FAILED,
+                          "Default event wakeup option error, eventWakeup:%s", svc->IsEventWakeup() ? "true" : "false");
+
+    LLBC_ErrorAndReturnIf(svc->SetEventWakeup(true) != LLBC_OK || !svc->IsEventWakeup(), LLBC_FAILED,
+                          "Enable event wakeup failed, err:%s", LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svc->SetEventWakeup(false) != LLBC_OK || svc->IsEventWakeup(), LLBC_FAILED,
+                          "Disable event wakeup failed, err:%s", LLBC_FormatLastError());
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_SvcEventWakeup::DoEventWakeupTest()
+{
+    LLBC_PrintLn("- Event wakeup ping-pong test, fps:%d", TEST_FPS);
+
+    // Create server service.
+    LLBC_Service *svr = LLBC_Service::Create("EventWakeupSvr");
+    LLBC_Defer(delete svr);
+    svr->SuppressCoderNotFoundWarning();
+
+    ServerComp *svrComp = new ServerComp;
+    svr->AddComponent(svrComp);
+    svr->Subscribe(OPCODE, svrComp, &ServerComp::OnRecv);
+    svr->SetFPS(TEST_FPS);
+    svr->SetEventWakeup(true);
+    LLBC_ErrorAndReturnIf(svr->Listen(TEST_IP, TEST_PORT) == 0, LLBC_FAILED,
+                          "Listen on %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(svr->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start server service failed, err:%s", LLBC_FormatLastError());
+
+    // Create client service.
+    LLBC_Service *client = LLBC_Service::Create("EventWakeupClient");
+    LLBC_Defer(delete client);
+    client->SuppressCoderNotFoundWarning();
+
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->Subscribe(OPCODE, clientComp, &ClientComp::OnRecv);
+    client->SetFPS(TEST_FPS);
+    client->SetEventWakeup(true);
+    const int sessionId = client->Connect(TEST_IP, TEST_PORT);
+    LLBC_ErrorAndReturnIf(sessionId == 0, LLBC_FAILED,
+                          "Connect to %s:%d failed, err:%s", TEST_IP, TEST_PORT, LLBC_FormatLastError());
+    LLBC_ErrorAndReturnIf(client->Start() != LLBC_OK, LLBC_FAILED,
+                          "Start client service failed, err:%s", LLBC_FormatLastError());
+
+    // Ping-pong, arrived packets must be handled immediately, not at next frame.
+    const sint32 begUpdateTimes = LLBC_AtomicGet(&svrComp->_updateTimes);
+    const sint32 begTimeoutTimes = LLBC_AtomicGet(&svrComp->_timeoutTimes);
+    const sint64 begTime = LLBC_GetMicroseconds();
+
+    sint64 totalRoundTripTime = 0;
+    const char *data = "ping";
+    for (int i = 0; i < PING_PONG_TIMES; ++i)
+    {
+        const sint64 sendTime = LLBC_GetMicroseconds();
+        LLBC_ErrorAndReturnIf(client->Send(sessionId, OPCODE, data, strlen(data)) != LLBC_OK, LLBC_FAILED,
+                              "Send ping packet failed, err:%s", LLBC_FormatLastError());
+        LLBC_ErrorAndReturnIf(!clientComp->_sem.TimedWait(1000), LLBC_FAILED,
+                              "Wait pong packet timeout, ping-pong times:%d", i);
+
+        totalRoundTripTime += LLBC_GetMicroseconds() - sendTime;
+    }
+
+    // Wait a while, let timer timeout some times.
+    LLBC_Sleep(500);
+
+    const sint64 elapsed = (LLBC_GetMicroseconds() - begTime) / 1000;
+    const sint32 updateTimes = LLBC_AtomicGet(&svrComp->_updateTimes) - begUpdateTimes;
+    const sint32 timeoutTimes = LLBC_AtomicGet(&svrComp->_timeoutTimes) - begTimeoutTimes;
+    const sint64 avgRoundTripTime = totalRoundTripTime / PING_PONG_TIMES;
+    LLBC_PrintLn("  Ping-pong times:%d, average round trip time:%lld us, elapsed:%lld ms, "
+                 "server update times:%d, timer timeout times:%d",
+                 PING_PONG_TIMES, avgRoundTripTime, elapsed, updateTimes, timeoutTimes);
+
+    LLBC_ErrorAndReturnIf(avgRoundTripTime > MAX_AVG_ROUND_TRIP_TIME, LLBC_FAILED,
+                          "Average round trip time too large(service not wakeup by arrived events?), "
+                          "time:%lld us, max:%lld us",
+                          avgRoundTripTime, MAX_AVG_ROUND_TRIP_TIME);
+
+    // Components update cadence not changed by arrived events.
+    const sint64 expectUpdateTimes = elapsed * TEST_FPS / 1000;
+    LLBC_ErrorAndReturnIf(updateTimes < expectUpdateTimes / 2 || updateTimes > expectUpdateTimes * 3 / 2 + 2,
+                          LLBC_FAILED,
+                          "Server update times error, update times:%d, expect about:%lld",
+                          updateTimes, expectUpdateTimes);
+
+    // Timers timeout on schedule, not delayed to frame end.
+    const sint64 expectTimeoutTimes = elapsed / TIMER_PERIOD;
+    LLBC_ErrorAndReturnIf(timeoutTimes < expectTimeoutTimes / 2, LLBC_FAILED,
+                          "Timer timeout times error, timeout times:%d, expect about:%lld",
+                          timeoutTimes, expectTimeoutTimes);
+
+    client->Stop();
+    svr->Stop();
+
+    return LLBC_OK;
+}
@@ -23,6 +23,44 @@
 #include "core/log/TestCase_Core_Log.h"
 #include <iomanip>
 
+namespace
+{
+
+/**
+ * Decode binary log file by tools/log_decoder/log_decoder.py(copied to test dir), every decoded log record
+ * rendered as one line and split to fields: level|line|tag|func|file|msg.
+ */
+int DecodeBinLogFile(const LLBC_String &filePath, std::vector<LLBC_Strings> &records)
+{
+    const LLBC_String decoderPath = "log_decoder.py";
+    LLBC_ErrorAndReturnIf(!LLBC_File::Exists(decoderPath),
+                          LLBC_FAILED,
+                          "Binary log decoder %s not found, forgot copy it to test dir?", decoderPath.c_str());
+
+#if LLBC_TARGET_PLATFORM_WIN32
+    const char *pythonExec = "python";
+#else
+    const char *pythonExec = "python3";
+#endif
+    const LLBC_String decodedFile = filePath + ".decoded";
+    const LLBC_String cmd = LLBC_String().format("%s %s --pattern \"%%L|%%l|%%g|%%F|%%f|%%m%%n\" --output %s %s",
+                                                 pythonExec,
+                                                 decoderPath.c_str(),
+                                                 decodedFile.c_str(),
+                                                 filePath.c_str());
+    LLBC_ErrorAndReturnIf(system(cmd.c_str()) != 0,
+                          LLBC_FAILED,
+                          "Execute binary log decoder failed, cmd:%s", cmd.c_str());
+
+    const LLBC_String decoded = LLBC_File::ReadToEnd(decodedFile);
+    for (const auto &line : decoded.split('\n', -1, true))
+        records.emplace_back(line.split('|', 5));
+
+    return LLBC_OK;
+}
+
+}
+
 TestCase_Core_Log::TestCase_Core_Log()
 {
 }
@@ -75,6 +113,9 @@ int TestCase_Core_Log::Run(int argc, char *argv[])
     // Sync logger multi-thread test.
     SyncLoggerMultiThreadTest();
 
+    // Async logger multi-thread test.
+    AsyncLoggerMultiThreadTest();
+
     // Test condition macro log.
     DoConditionMacroLogTest();
 
@@ -136,6 +177,9 @@ int TestCase_Core_Log::Run(int argc, char *argv[])
     getchar();
     DoLogLevelSetTest();
 
+    // Perform log call site level cache test.
+    LLBC_ErrorAndReturnIf(DoLogCallSiteCacheTest() != LLBC_OK, LLBC_FAILED);
+
     // Peform performance test.
     const int perfTestTimes = 3;
     for (int i = 0; i < perfTestTimes; ++i)
@@ -163,6 +207,21 @@ int TestCase_Core_Log::Run(int argc, char *argv[])
     // Test json styled log.
     DoJsonLogTest();
 
+    // Test deferred formatting log.
+    DoDeferredLogTest();
+
+    // Test binary file log.
+    LLBC_ErrorAndReturnIf(DoBinaryFileLogTest() != LLBC_OK, LLBC_FAILED);
+
+    // Test mmap file log.
+    LLBC_ErrorAndReturnIf(DoMmapFileLogTest() != LLBC_OK, LLBC_FAILED);
+
+    // Test network log.
+    LLBC_ErrorAndReturnIf(DoNetworkLogTest() != LLBC_OK, LLBC_FAILED);
+
+    // Test udp network log.
+    LLBC_ErrorAndReturnIf(DoUdpNetworkLogTest() != LLBC_OK, LLBC_FAILED);
+
     // Test logger mgr reload.
     LLBC_ErrorAndReturnIf(DoLoggerMgrReloadTest() != LLBC_OK, LLBC_FAILED);
 
@@ -172,6 +231,52 @@ int TestCase_Core_Log::Run(int argc, char *argv[])
     return 0;
 }
 
+int TestCase_Core_Log::DoLogCallSiteCacheTest()
+{
+    LLBC_PrintLn("Log call site level cache test:");
+
+    auto testLogger = LLBC_LoggerMgrSingleton->GetLogger("test");
+    const int loggerLevel = testLogger->GetLogLevel();
+    LLBC_ErrorAndReturnIf(loggerLevel == LLBC_LogLevel::Begin,
+                          LLBC_FAILED,
+                          "Test logger level must greater than %s",
+                          LLBC_LogLevel::GetLevelStr(LLBC_LogLevel::Begin).c_str());
+
+    // One call site expansion maybe checked with different constant logger name/level pairs
+    // (inlined/unrolled generic LLOG()), disabled pair cached first must not disable other pairs.
+    LLBC_INTERNAL_NS __LLBC_LogCallSite callSite{};
+    LLBC_ErrorAndReturnIf(callSite.IsEnabled("test", loggerLevel - 1),
+                          LLBC_FAILED,
+                          "Call site check disabled level, but return enabled");
+    LLBC_ErrorAndReturnIf(!callSite.IsEnabled("test", loggerLevel),
+                          LLBC_FAILED,
+                          "Call site check enabled level, but return disabled(shared cached state)");
+    LLBC_ErrorAndReturnIf(!callSite.IsEnabled(nullptr, LLBC_LogLevel::Fatal),
+                          LLBC_FAILED,
+                          "Call site check root logger fatal level, but return disabled(shared cached state)");
+    LLBC_ErrorAndReturnIf(callSite.IsEnabled("test", loggerLevel - 1),
+                          LLBC_FAILED,
+                          "Call site check cached disabled level, but return enabled");
+
+    // Log level version updated, version key never be 0(reserved for never refreshed call site),
+    // call site refresh cached state.
+    for (int i = 0; i < 16; ++i)
+    {
+        LLBC_LoggerMgr::UpdateLogLevelVersion();
+        LLBC_ErrorAndReturnIf((static_cast<uint32>(LLBC_LoggerMgr::GetLogLevelVersion()) &
+                                  LLBC_LoggerMgr::LogLevelVersionKeyMask) == 0,
+                              LLBC_FAILED,
+                              "Log level version key is 0 after update");
+        LLBC_ErrorAndReturnIf(callSite.IsEnabled("test", loggerLevel - 1),
+                              LLBC_FAILED,
+                              "Call site check disabled level after version updated, but return enabled");
+    }
+
+    LLBC_PrintLn("Log call site level cache test finished");
+
+    return LLBC_OK;
+}
+
 void TestCase_Core_Log::DoLogLevelSetTest()
 {
     auto testLogger = LLBC_LoggerMgrSingleton->GetLogger("log_level_set_test");
@@ -218,6 +323,15 @@ void TestCase_Core_Log::DoLogLevelSetTest()
 
     testOutput(LLBC_LogAppenderType::Console, LLBC_LogLevel::End);
     testOutput(LLBC_LogAppenderType::File, LLBC_LogLevel::End);
+
+    // Disabled log performance test(per-call-site cached log level check).
+    const int loopLmt = 10000000;
+    LLBC_Stopwatch sw;
+    for (int i = 0; i < loopLmt; ++i)
+        LLOG_TRACE2("log_level_set_test", "This is a disabled TRACE log, idx:%d", i);
+    sw.Pause();
+    LLBC_PrintLn("Disabled log performance test, log times:%d, cost:%s ms, per-log cost:%.3f ns",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt));
 }
 
 void TestCase_Core_Log::DoJsonLogTest()
@@ -400,6 +514,46 @@ void TestCase_Core_Log::SyncLoggerMultiThreadTest()
     LLBC_PrintLn("Sync logger multi-thread test finished");
 }
 
+void TestCase_Core_Log::AsyncLoggerMultiThreadTest()
+{
+    LLBC_PrintLn("Async logger multi-thread test:");
+
+    class _TestTask : public LLBC_Task
+    {
+    public:
+        explicit _TestTask(uint32 testTimes):_testTimes(testTimes), _nowTimes(0) {  }
+
+    public:
+        void Svc() override
+        {
+            sint32 nowTimes;
+            while ((nowTimes = LLBC_AtomicFetchAndAdd(&_nowTimes, 1)) < _testTimes)
+                LLOG_TRACE2("perftest", "[%08u] I am thread %d...", nowTimes, LLBC_GetCurrentThreadId());
+        }
+
+        void Cleanup() override {  }
+
+    public:
+        sint32 _testTimes;
+        sint32 _nowTimes;
+    };
+
+    const int testTimes = 1000000;
+    const int threadNum = 8;
+
+    LLBC_Stopwatch sw;
+    _TestTask task(testTimes);
+    task.Activate(threadNum);
+    task.Wait();
+    sw.Pause();
+
+    LLBC_PrintLn("Async logger multi-thread test finished, threads:%d, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 threadNum,
+                 testTimes,
+                 sw.ToString().c_str(),
+                 sw.ElapsedNanos() / static_cast<double>(testTimes) / 1000.0);
+}
+
 void TestCase_Core_Log::DoConditionMacroLogTest()
 {
     LLBC_LogAndDoIf(true, Error, {});
@@ -434,6 +588,421 @@ void TestCase_Core_Log::DoConditionMacroLogTest()
                                                    1, 3.14, "hello world"); }();
 }
 
+void TestCase_Core_Log::DoDeferredLogTest()
+{
+    LLBC_PrintLn("Deferred formatting log test:");
+
+    // Use root logger to test.
+    const LLBC_String llbcStr = "This is a LLBC_String";
+    char charArr[32] = "This is a char array";
+    LDLOG_DEBUG("Deferred log message, no arguments");
+    LDLOG_INFO("Deferred log message, char:%c, bool:%d, sint16:%d, uint32:%u, sint64:%lld, double:%.3f",
+               'a', true, static_cast<sint16>(-16), 32u, -64ll, 3.14159);
+    LDLOG_WARN3("test_tag", "Deferred log message, c-string:%s, char array:%s, null c-string:%s, pointer:%p",
+                llbcStr.c_str(), charArr, static_cast<const char *>(nullptr), this);
+    LDLOG_ERROR2("test", "Deferred log message, enum:%d", LLBC_LogLevel::Error);
+
+    // Performance compare test.
+    const int loopLmt = 1000000;
+    LLBC_Stopwatch sw;
+    for (int i = 0; i < loopLmt; ++i)
+        LLOG_TRACE2("perftest", "performance test msg, msg idx:%d, str:%s, double:%f", i, "hello", 3.14);
+    sw.Pause();
+    LLBC_PrintLn("Non-deferred log, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt) / 1000.0);
+
+    sw.Restart();
+    for (int i = 0; i < loopLmt; ++i)
+        LDLOG_TRACE2("perftest", "performance test msg, msg idx:%d, str:%s, double:%f", i, "hello", 3.14);
+    sw.Pause();
+    LLBC_PrintLn("Deferred log, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt) / 1000.0);
+
+    LLBC_PrintLn("Deferred formatting log test finished");
+}
+
+int TestCase_Core_Log::DoBinaryFileLogTest()
+{
+    LLBC_PrintLn("Binary file log test:");
+
+    // Round-trip test, output log records(include empty message records) to binroundtrip logger(synchronous,
+    // lazy create log file), then decode binary log file and check decoded records.
+    const LLBC_String roundTripFile = "log/binroundtrip.blog";
+    if (LLBC_File::Exists(roundTripFile))
+        LLBC_File::DeleteFile(roundTripFile);
+
+    const LLBC_String bigMsg(300, 'x'); // Record length prefix more than 1 byte.
+    LLOG_INFO4("binroundtrip", "test_tag", "Binary file log message, int:%d, string:%s", 1, "hello world"); const int line0 = __LINE__;
+    LDLOG_DEBUG4("binroundtrip", "test_tag", "Binary file deferred log message, int:%d", 2); const int line1 = __LINE__;
+    LLOG_WARN2("binroundtrip", "%s", ""); const int line2 = __LINE__;
+    LLOG_ERROR4("binroundtrip", "test_tag", "%s", ""); const int line3 = __LINE__;
+    LLOG_INFO4("binroundtrip", "test_tag", "%s", bigMsg.c_str()); const int line4 = __LINE__;
+
+    struct
+    {
+        int level;
+        int line;
+        const char *tag;
+        const char *msg;
+    } expectRecords[] = {
+        {LLBC_LogLevel::Info, line0, "test_tag", "Binary file log message, int:1, string:hello world"},
+        {LLBC_LogLevel::Debug, line1, "test_tag", "Binary file deferred log message, int:2"},
+        {LLBC_LogLevel::Warn, line2, "", ""}, // Empty message, no tag(record end with tag id 0).
+        {LLBC_LogLevel::Error, line3, "test_tag", ""}, // Empty message.
+        {LLBC_LogLevel::Info, line4, "test_tag", bigMsg.c_str()},
+    };
+
+    std::vector<LLBC_Strings> records;
+    LLBC_ErrorAndReturnIf(DecodeBinLogFile(roundTripFile, records) != LLBC_OK,
+                          LLBC_FAILED,
+                          "Decode binary log file %s failed", roundTripFile.c_str());
+    LLBC_ErrorAndReturnIf(records.size() != sizeof(expectRecords) / sizeof(expectRecords[0]),
+                          LLBC_FAILED,
+                          "Decoded binary log records count mismatch, decoded:%lu",
+                          static_cast<unsigned long>(records.size()));
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const LLBC_Strings &record = records[i];
+        const auto &expectRecord = expectRecords[i];
+        LLBC_ErrorAndReturnIf(record.size() != 6 ||
+                              record[0] != LLBC_LogLevel::GetLevelStr(expectRecord.level).c_str() ||
+                              record[1] != LLBC_NumToStr(expectRecord.line) ||
+                              record[2] != expectRecord.tag ||
+                              record[3].empty() ||
+                              record[4].find("TestCase_Core_Log.cpp") == LLBC_String::npos ||
+                              record[5] != expectRecord.msg,
+                              LLBC_FAILED,
+                              "Decoded binary log record mismatch, idx:%lu, fields:%lu, first field:%s",
+                              static_cast<unsigned long>(i),
+                              static_cast<unsigned long>(record.size()),
+                              record.empty() ? "" : record[0].c_str());
+    }
+
+    LLBC_PrintLn("Binary file log round-trip test finished, decoded records:%lu",
+                 static_cast<unsigned long>(records.size()));
+
+    LLOG_TRACE4("binfiletest", "test_tag", "Binary file log message, int:%d, string:%s", 1, "hello world");
+    LDLOG_INFO4("binfiletest", "test_tag", "Binary file deferred log message, int:%d, string:%s", 2, "hello world");
+    LLOG_WARN2("binfiletest", "Binary file log message, no tag");
+
+    // Performance compare test(text file logger vs binary file logger).
+    const int loopLmt = 1000000;
+    LLBC_Stopwatch sw;
+    for (int i = 0; i < loopLmt; ++i)
+        LLOG_TRACE2("perftest", "performance test msg, msg idx:%d", i);
+    sw.Pause();
+    LLBC_PrintLn("Text file log, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt) / 1000.0);
+
+    sw.Restart();
+    for (int i = 0; i < loopLmt; ++i)
+        LLOG_TRACE2("binfiletest", "performance test msg, msg idx:%d", i);
+    sw.Pause();
+    LLBC_PrintLn("Binary file log, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt) / 1000.0);
+
+    LLBC_PrintLn("Binary file log test finished, use tools/log_decoder/log_decoder.py to decode binfiletest log files");
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Log::DoMmapFileLogTest()
+{
+    LLBC_PrintLn("Mmap file log test:");
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Crash recovery test:
+    // - output records to binmmaptest logger, log file opened with preallocated zero-filled tail.
+    // - copy log file and position file to binmmaprecover logger log file path, simulate process crashed.
+    // - output record to binmmaprecover logger, log file will be truncated to the persisted size, then append.
+    const LLBC_String crashedFile = "log/binmmaptest.blog";
+    const LLBC_String recoverFile = "log/binmmaprecover.blog";
+    for (auto &filePath : {crashedFile, crashedFile + ".mmpos", recoverFile, recoverFile + ".mmpos"})
+    {
+        if (LLBC_File::Exists(filePath))
+            LLBC_File::DeleteFile(filePath);
+    }
+
+    LLOG_INFO4("binmmaptest", "test_tag", "Mmap binary file log message, before crash");
+    LLOG_WARN2("binmmaptest", "%s", ""); // Empty message, no tag(record end with zero byte).
+
+    const LLBC_String crashedPos = LLBC_File::ReadToEnd(crashedFile + ".mmpos");
+    LLBC_ErrorAndReturnIf(crashedPos.size() != sizeof(sint64),
+                          LLBC_FAILED,
+                          "Mmap log file position file not found or invalid, file:%s", crashedFile.c_str());
+    sint64 crashedSize;
+    memcpy(&crashedSize, crashedPos.data(), sizeof(sint64));
+
+    const LLBC_String crashedData = LLBC_File::ReadToEnd(crashedFile);
+    LLBC_ErrorAndReturnIf(crashedSize <= 0 || static_cast<sint64>(crashedData.size()) <= crashedSize,
+                          LLBC_FAILED,
+                          "Mmap log file not preallocated, logical size:%lld, file size:%lu",
+                          static_cast<long long>(crashedSize), static_cast<unsigned long>(crashedData.size()));
+    LLBC_ErrorAndReturnIf(crashedData[crashedSize - 1] != '\0',
+                          LLBC_FAILED,
+                          "Mmap log file last record not end with zero byte");
+
+    LLBC_ErrorAndReturnIf(LLBC_File::CopyFile(crashedFile, recoverFile, true) != LLBC_OK ||
+                          LLBC_File::CopyFile(crashedFile + ".mmpos", recoverFile + ".mmpos", true) != LLBC_OK,
+                          LLBC_FAILED,
+                          "Copy crashed mmap log file failed, err:%s", LLBC_FormatLastError());
+
+    LLOG_INFO2("binmmaprecover", "Mmap binary file log message, after crash");
+
+    // Check recovered log file: records before crash keep unchanged, new session appended at persisted size.
+    const LLBC_String recoveredData = LLBC_File::ReadToEnd(recoverFile);
+    LLBC_ErrorAndReturnIf(static_cast<sint64>(recoveredData.size()) <= crashedSize ||
+                          memcmp(recoveredData.data(), crashedData.data(), static_cast<size_t>(crashedSize)) != 0 ||
+                          recoveredData[crashedSize] == '\0',
+                          LLBC_FAILED,
+                          "Recovered mmap log file not append at persisted size:%lld",
+                          static_cast<long long>(crashedSize));
+
+    std::vector<LLBC_Strings> records;
+    LLBC_ErrorAndReturnIf(DecodeBinLogFile(recoverFile, records) != LLBC_OK,
+                          LLBC_FAILED,
+                          "Decode recovered mmap log file %s failed", recoverFile.c_str());
+    LLBC_ErrorAndReturnIf(records.size() != 3 ||
+                          records[0].size() != 6 || records[0][5] != "Mmap binary file log message, before crash" ||
+                          records[1].size() != 6 || !records[1][5].empty() ||
+                          records[2].size() != 6 || records[2][5] != "Mmap binary file log message, after crash",
+                          LLBC_FAILED,
+                          "Recovered mmap log file records mismatch, records count:%lu",
+                          static_cast<unsigned long>(records.size()));
+
+    LLBC_PrintLn("Mmap file log crash recovery test finished, persisted size:%lld",
+                 static_cast<long long>(crashedSize));
+#endif // Non-Win32
+
+    LLOG_TRACE4("mmapfiletest", "test_tag", "Mmap file log message, int:%d, string:%s", 1, "hello world");
+    LLOG_WARN2("mmapfiletest", "Mmap file log message, no tag");
+
+    // Performance compare test(text file logger vs mmap file logger).
+    const int loopLmt = 1000000;
+    LLBC_Stopwatch sw;
+    for (int i = 0; i < loopLmt; ++i)
+        LLOG_TRACE2("perftest", "performance test msg, msg idx:%d", i);
+    sw.Pause();
+    LLBC_PrintLn("Text file log, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt) / 1000.0);
+
+    sw.Restart();
+    for (int i = 0; i < loopLmt; ++i)
+        LLOG_TRACE2("mmapfiletest", "performance test msg, msg idx:%d", i);
+    sw.Pause();
+    LLBC_PrintLn("Mmap file log, log times:%d, cost:%s ms, per-log cost:%.3f us",
+                 loopLmt, sw.ToString().c_str(), sw.ElapsedNanos() / static_cast<double>(loopLmt) / 1000.0);
+
+    LLBC_PrintLn("Mmap file log test finished");
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Log::DoNetworkLogTest()
+{
+    LLBC_PrintLn("Network log test:");
+
+    // Output some logs before collector listening, nettest logger buffer limit is 8192 bytes,
+    // INFO level log records will be dropped when buffer usage reach drop watermark.
+    const int droppedPhaseLogTimes = 500;
+    for (int i = 0; i < droppedPhaseLogTimes; ++i)
+        LLOG_INFO4("nettest", "test_tag", "Network log message(before collector listening), idx:%d", i);
+    LLBC_Sleep(200);
+
+    // Create log collector listen socket(nettest logger connect to 127.0.0.1:17950).
+    LLBC_SocketHandle listenSock = LLBC_CreateTcpSocket();
+    LLBC_EnableAddressReusable(listenSock);
+    if (LLBC_BindToAddress(listenSock, "127.0.0.1", 17950) != LLBC_OK ||
+        LLBC_ListenForConnection(listenSock, 8) != LLBC_OK)
+    {
+        LLBC_PrintLn("Listen on 127.0.0.1:17950 failed, error:%s", LLBC_FormatLastError());
+        LLBC_CloseSocket(listenSock);
+        return LLBC_FAILED;
+    }
+
+    // Output some logs, logger will reconnect to collector and send log frames.
+    // - the long log record(larger than frame size 1024) will be split to multiple frames.
+    const int longMsgLen = 3000;
+    const LLBC_String longMsg(longMsgLen, 'x');
+    const int sentPhaseLogTimes = 10;
+    for (int i = 0; i < sentPhaseLogTimes; ++i)
+    {
+        LLOG_INFO4("nettest", "test_tag", "Network log message, idx:%d", i);
+        if (i == sentPhaseLogTimes / 2)
+            LLOG_INFO4("nettest", "test_tag", "Network long log message:%s", longMsg.c_str());
+
+        LLBC_Sleep(100);
+    }
+
+    const int logTimes = droppedPhaseLogTimes + sentPhaseLogTimes + 1;
+
+    // Accept and receive log frames.
+    LLBC_SetNonBlocking(listenSock);
+    LLBC_SocketHandle sock = LLBC_INVALID_SOCKET_HANDLE;
+    for (int i = 0; i < 200 && sock == LLBC_INVALID_SOCKET_HANDLE; ++i)
+    {
+        sock = LLBC_AcceptClient(listenSock);
+        if (sock == LLBC_INVALID_SOCKET_HANDLE)
+            LLBC_Sleep(10);
+    }
+
+    LLBC_CloseSocket(listenSock);
+    LLBC_ErrorAndReturnIf(sock == LLBC_INVALID_SOCKET_HANDLE,
+                          LLBC_FAILED,
+                          "Accept network log connection timeout");
+
+    LLBC_SetNonBlocking(sock);
+
+    // Concat frame payloads, and split log records by '\n'.
+    int recvRecords = 0;
+    int droppedRecords = 0;
+    size_t maxRecordLen = 0;
+    LLBC_String recvBuf;
+    LLBC_String payloads;
+    char buf[4096];
+    for (int i = 0; i < 300 && recvRecords + droppedRecords < logTimes; ++i)
+    {
+        const int recvLen = LLBC_Recv(sock, buf, sizeof(buf), 0);
+        if (recvLen <= 0)
+        {
+            LLBC_Sleep(10);
+            continue;
+        }
+
+        recvBuf.append(buf, recvLen);
+        while (recvBuf.size() >= 4)
+        {
+            const uint32 payloadLen = (static_cast<uint8>(recvBuf[0]) << 24) |
+                                      (static_cast<uint8>(recvBuf[1]) << 16) |
+                                      (static_cast<uint8>(recvBuf[2]) << 8) |
+                                      static_cast<uint8>(recvBuf[3]);
+            if (recvBuf.size() < 4 + payloadLen)
+                break;
+
+            LLBC_ErrorAndReturnIf(payloadLen > 1024 - 4,
+                                  LLBC_FAILED,
+                                  "Network log frame payload len exceed frame size, payload len:%u",
+                                  payloadLen);
+
+            payloads.append(recvBuf.data() + 4, payloadLen);
+            recvBuf.erase(0, 4 + payloadLen);
+        }
+
+        for (size_t lineEnd = payloads.find('\n'); lineEnd != LLBC_String::npos; lineEnd = payloads.find('\n'))
+        {
+            const LLBC_String record = payloads.substr(0, lineEnd);
+            payloads.erase(0, lineEnd + 1);
+
+            long long droppedCount = 0;
+            if (sscanf(record.c_str(), "<%lld log record(s) dropped", &droppedCount) == 1)
+            {
+                LLBC_PrintLn("Recv network log dropped notice:%s", record.c_str());
+                droppedRecords += static_cast<int>(droppedCount);
+            }
+            else
+            {
+                ++recvRecords;
+                maxRecordLen = MAX(maxRecordLen, record.size());
+            }
+        }
+    }
+
+    LLBC_CloseSocket(sock);
+
+    LLBC_PrintLn("Network log test finished, log times:%d, received records:%d, dropped records:%d",
+                 logTimes, recvRecords, droppedRecords);
+    LLBC_ErrorAndReturnIf(droppedRecords == 0,
+                          LLBC_FAILED,
+                          "Network log records not dropped when buffer usage reach drop watermark");
+    LLBC_ErrorAndReturnIf(recvRecords + droppedRecords != logTimes,
+                          LLBC_FAILED,
+                          "Network log records lost, log times:%d, received records:%d, dropped records:%d",
+                          logTimes, recvRecords, droppedRecords);
+    LLBC_ErrorAndReturnIf(maxRecordLen < static_cast<size_t>(longMsgLen),
+                          LLBC_FAILED,
+                          "Network long log record truncated, max record len:%lu",
+                          static_cast<unsigned long>(maxRecordLen));
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Log::DoUdpNetworkLogTest()
+{
+    LLBC_PrintLn("Udp network log test:");
+
+    // Create log collector socket(udpnettest logger send datagrams to 127.0.0.1:17951).
+    LLBC_SocketHandle sock = LLBC_CreateUdpSocket();
+    if (LLBC_BindToAddress(sock, "127.0.0.1", 17951) != LLBC_OK)
+    {
+        LLBC_PrintLn("Bind to 127.0.0.1:17951 failed, error:%s", LLBC_FormatLastError());
+        LLBC_CloseSocket(sock);
+        return LLBC_FAILED;
+    }
+
+    // Output some logs, the long log record(larger than frame size 1024) must be truncated
+    // to one datagram, never split across datagrams.
+    const LLBC_String longMsg(3000, 'x');
+    const int logTimes = 21;
+    for (int i = 0; i < logTimes - 1; ++i)
+    {
+        LLOG_INFO4("udpnettest", "test_tag", "Udp network log message, idx:%d", i);
+        if (i == logTimes / 2)
+            LLOG_INFO4("udpnettest", "test_tag", "Udp network long log message:%s", longMsg.c_str());
+    }
+
+    // Receive datagrams, every datagram must be one self-contained frame.
+    LLBC_SetNonBlocking(sock);
+
+    int recvRecords = 0;
+    size_t maxRecordLen = 0;
+    char buf[4096];
+    for (int i = 0; i < 300 && recvRecords < logTimes; ++i)
+    {
+        const int recvLen = LLBC_Recv(sock, buf, sizeof(buf), 0);
+        if (recvLen <= 0)
+        {
+            LLBC_Sleep(10);
+            continue;
+        }
+
+        const uint32 payloadLen = (static_cast<uint8>(buf[0]) << 24) |
+                                  (static_cast<uint8>(buf[1]) << 16) |
+                                  (static_cast<uint8>(buf[2]) << 8) |
+                                  static_cast<uint8>(buf[3]);
+        LLBC_ErrorAndReturnIf(recvLen < 4 || payloadLen != static_cast<uint32>(recvLen - 4) || payloadLen > 1024 - 4,
+                              LLBC_FAILED,
+                              "Udp network log datagram is not a complete frame, datagram len:%d, payload len:%u",
+                              recvLen, payloadLen);
+        LLBC_ErrorAndReturnIf(payloadLen == 0 || buf[recvLen - 1] != '\n',
+                              LLBC_FAILED,
+                              "Udp network log datagram not end with complete record");
+
+        const LLBC_String payload(buf + 4, payloadLen);
+        for (size_t recordBeg = 0, lineEnd = payload.find('\n');
+             lineEnd != LLBC_String::npos;
+             recordBeg = lineEnd + 1, lineEnd = payload.find('\n', recordBeg))
+        {
+            ++recvRecords;
+            maxRecordLen = MAX(maxRecordLen, lineEnd - recordBeg);
+        }
+    }
+
+    LLBC_CloseSocket(sock);
+
+    LLBC_PrintLn("Udp network log test finished, log times:%d, received records:%d, max record len:%lu",
+                 logTimes, recvRecords, static_cast<unsigned long>(maxRecordLen));
+    LLBC_ErrorAndReturnIf(recvRecords != logTimes,
+                          LLBC_FAILED,
+                          "Udp network log records lost, log times:%d, received records:%d",
+                          logTimes, recvRecords);
+    LLBC_ErrorAndReturnIf(maxRecordLen != 1024 - 4 - 1,
+                          LLBC_FAILED,
+                          "Udp network long log record not truncated to frame payload size, max record len:%lu",
+                          static_cast<unsigned long>(maxRecordLen));
+
+    return LLBC_OK;
+}
+
 int TestCase_Core_Log::DoLoggerMgrReloadTest()
 {
     LLBC_PrintLn("LoggerMgr reload test, please modify logger config file, "
@@ -35,10 +35,17 @@ public:
 
 private:
     void DoLogLevelSetTest();
+    int DoLogCallSiteCacheTest();
     void DoJsonLogTest();
     void DoUninitLogTest();
     void SyncLoggerMultiThreadTest();
+    void AsyncLoggerMultiThreadTest();
     void DoConditionMacroLogTest();
+    void DoDeferredLogTest();
+    int DoBinaryFileLogTest();
+    int DoMmapFileLogTest();
+    int DoNetworkLogTest();
+    int DoUdpNetworkLogTest();
     int DoLoggerMgrReloadTest();
 
     void OnLogHook(const LLBC_LogData *logData);
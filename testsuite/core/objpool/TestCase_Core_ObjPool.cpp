@@ -109,6 +109,10 @@ int TestCase_Core_ObjPool::Run(int argc, char *argv[])
     LLBC_ReturnIf(CommonClassTest_Stream() != LLBC_OK, LLBC_FAILED);
     LLBC_ReturnIf(RecycleTest() != LLBC_OK, LLBC_FAILED);
     LLBC_ReturnIf(SafeObjPoolSetNameTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(TypedPoolLookupTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(MagazineTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(TrimTest() != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(AlignTest() != LLBC_OK, LLBC_FAILED);
 
     return LLBC_OK;
 }
@@ -929,3 +933,388 @@ int TestCase_Core_ObjPool::SafeObjPoolSetNameTest()
 
     return LLBC_OK;
 }
+
+int TestCase_Core_ObjPool::TypedPoolLookupTest()
+{
+    LLBC_PrintLn("Typed pool lookup test:");
+
+    LLBC_ObjPool objPool1;
+    LLBC_ObjPool objPool2;
+
+    // Same objpool + same type: Always resolve to the same typed pool.
+    auto strPool = objPool1.GetTypedObjPool<std::string>();
+    for (int i = 0; i < 100; ++i)
+    {
+        LLBC_ErrorAndReturnIf(objPool1.GetTypedObjPool<std::string>() != strPool,
+                              LLBC_FAILED,
+                              "Typed pool lookup not stable, times:%d", i);
+    }
+
+    // Different type/objpool: Resolve to different typed pools.
+    auto vecPool = objPool1.GetTypedObjPool<std::vector<int>>();
+    auto strPool2 = objPool2.GetTypedObjPool<std::string>();
+    LLBC_ErrorAndReturnIf(reinterpret_cast<void *>(vecPool) == reinterpret_cast<void *>(strPool),
+                          LLBC_FAILED,
+                          "Different types resolved to same typed pool");
+    LLBC_ErrorAndReturnIf(strPool2 == strPool,
+                          LLBC_FAILED,
+                          "Different objpools resolved to same typed pool");
+
+    // Concurrent first lookups: Only one typed pool created.
+    struct LookupTask : public LLBC_Task
+    {
+        LLBC_ObjPool objPool{true};
+        LLBC_TypedObjPool<std::map<int, int>> * volatile pools[8] = {};
+        volatile sint32 slot = 0;
+
+        void Svc() override
+        {
+            pools[LLBC_AtomicFetchAndAdd(&slot, 1)] = objPool.GetTypedObjPool<std::map<int, int>>();
+        }
+        void Cleanup() override {}
+    } lookupTask;
+
+    lookupTask.Activate(8);
+    lookupTask.Wait();
+    for (int i = 1; i < 8; ++i)
+    {
+        LLBC_ErrorAndReturnIf(lookupTask.pools[i] != lookupTask.pools[0],
+                              LLBC_FAILED,
+                              "Concurrent typed pool lookup resolved to different pools");
+    }
+
+    // Perf: Acquire/Release round trip.
+    constexpr int testTimes = 1000000;
+    LLBC_Stopwatch sw;
+    for (int i = 0; i < testTimes; ++i)
+        objPool1.Release(objPool1.Acquire<std::string>());
+    sw.Pause();
+    LLBC_PrintLn("- Acquire/Release %d times, cost: %lld us", testTimes, sw.Elapsed().GetTotalMicros());
+
+    LLBC_PrintLn("Typed pool lookup test finished");
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_ObjPool::MagazineTest()
+{
+    LLBC_PrintLn("Magazine test:");
+
+    // Cross thread acquire/release: objects acquired in one task threads, released in other task threads.
+    constexpr int threadNum = 8;
+    constexpr int perThreadObjCount = 10000;
+    struct CrossThreadTask : public LLBC_Task
+    {
+        LLBC_ObjPool &objPool;
+        std::vector<LLBC_String *> &objs;
+        bool acquire;
+        volatile sint32 threadIdx = 0;
+
+        CrossThreadTask(LLBC_ObjPool &objPool, std::vector<LLBC_String *> &objs, bool acquire)
+        : objPool(objPool), objs(objs), acquire(acquire)
+        {
+        }
+
+        void Svc() override
+        {
+            const int idx = LLBC_AtomicFetchAndAdd(&threadIdx, 1);
+            const int beg = (acquire ? idx : (idx + 1) % threadNum) * perThreadObjCount;
+            for (int i = beg; i < beg + perThreadObjCount; ++i)
+            {
+                if (acquire)
+                {
+                    objs[i] = objPool.Acquire<LLBC_String>();
+                    objs[i]->format("%d", i);
+                }
+                else
+                {
+                    objPool.Release(objs[i]);
+                }
+            }
+        }
+        void Cleanup() override {}
+    };
+
+    // Magazine is opt-in, only thread safe pool support.
+    LLBC_ObjPool objPool(true);
+    LLBC_ErrorAndReturnIf(objPool.GetMagazineSize() != LLBC_CFG_CORE_OBJPOOL_DFT_MAGAZINE_SIZE,
+                          LLBC_FAILED,
+                          "Magazine size not default, size:%d", objPool.GetMagazineSize());
+    LLBC_ErrorAndReturnIf(objPool.SetMagazineSize(LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE + 1) == LLBC_OK,
+                          LLBC_FAILED,
+                          "Set magazine size exceed max size success");
+    LLBC_ObjPool unsafeObjPool(false);
+    LLBC_ErrorAndReturnIf(unsafeObjPool.SetMagazineSize(LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE) == LLBC_OK,
+                          LLBC_FAILED,
+                          "Set thread unsafe pool magazine size success");
+    objPool.SetMagazineSize(LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE);
+
+    std::vector<LLBC_String *> objs(threadNum * perThreadObjCount);
+    for (int round = 0; round < 3; ++round)
+    {
+        CrossThreadTask acquireTask(objPool, objs, true);
+        acquireTask.Activate(threadNum);
+        acquireTask.Wait();
+
+        for (int i = 0; i < static_cast<int>(objs.size()); ++i)
+        {
+            LLBC_ErrorAndReturnIf(*objs[i] != LLBC_String().format("%d", i),
+                                  LLBC_FAILED,
+                                  "Object acquired repeatedly, idx:%d", i);
+        }
+
+        CrossThreadTask releaseTask(objPool, objs, false);
+        releaseTask.Activate(threadNum);
+        releaseTask.Wait();
+    }
+
+    // Check statistics.
+    LLBC_Json::Document statDoc;
+    statDoc.Parse(objPool.GetStatistics(LLBC_ObjPoolStatFormat::Json).c_str());
+    auto &stat = statDoc["typed_obj_pools"][0];
+    LLBC_PrintLn("- Stat after cross thread acquire/release: using:%u, magazine objs:%u, hits:%llu, misses:%llu, flushes:%llu",
+                 stat["using_obj_count"].GetUint(),
+                 stat["magazine_obj_count"].GetUint(),
+                 static_cast<unsigned long long>(stat["magazine_hits"].GetUint64()),
+                 static_cast<unsigned long long>(stat["magazine_misses"].GetUint64()),
+                 static_cast<unsigned long long>(stat["magazine_flushes"].GetUint64()));
+    LLBC_ErrorAndReturnIf(stat["using_obj_count"].GetUint() != 0,
+                          LLBC_FAILED,
+                          "Using object count not 0 after all objects released");
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    LLBC_ErrorAndReturnIf(stat["magazine_hits"].GetUint64() == 0,
+                          LLBC_FAILED,
+                          "Magazine never hit");
+    #endif
+
+    // Task threads exited, their magazines drained to stripes.
+    LLBC_ErrorAndReturnIf(stat["magazine_count"].GetUint() != 0 ||
+                          stat["magazine_obj_count"].GetUint() != 0,
+                          LLBC_FAILED,
+                          "Exited threads magazines not drained, magazines:%u, magazine objs:%u",
+                          stat["magazine_count"].GetUint(),
+                          stat["magazine_obj_count"].GetUint());
+
+    // Magazine is per thread: current thread use it's own magazine.
+    objPool.Release(objPool.Acquire<LLBC_String>());
+    statDoc.Parse(objPool.GetStatistics(LLBC_ObjPoolStatFormat::Json).c_str());
+    auto &curThreadStat = statDoc["typed_obj_pools"][0];
+    #if LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE > 0
+    LLBC_ErrorAndReturnIf(curThreadStat["magazine_count"].GetUint() != 1 ||
+                          curThreadStat["magazine_obj_count"].GetUint() == 0,
+                          LLBC_FAILED,
+                          "Current thread magazine error, magazines:%u, magazine objs:%u",
+                          curThreadStat["magazine_count"].GetUint(),
+                          curThreadStat["magazine_obj_count"].GetUint());
+    #endif
+
+    // Deep collect: magazines flushed, all stripes deleted.
+    objPool.Collect(true);
+    statDoc.Parse(objPool.GetStatistics(LLBC_ObjPoolStatFormat::Json).c_str());
+    auto &collectedStat = statDoc["typed_obj_pools"][0];
+    LLBC_ErrorAndReturnIf(collectedStat["magazine_obj_count"].GetUint() != 0 ||
+                          collectedStat["stripe_count"].GetUint() != 0,
+                          LLBC_FAILED,
+                          "Magazines/Stripes not collected");
+
+    // Perf: Thread safe pool acquire/release in multi threads.
+    constexpr int perfTimes = 1000000;
+    struct PerfTask : public LLBC_Task
+    {
+        LLBC_ObjPool &objPool;
+        explicit PerfTask(LLBC_ObjPool &objPool) : objPool(objPool) {  }
+
+        void Svc() override
+        {
+            LLBC_String *objs[16];
+            for (int i = 0; i < perfTimes / 16; ++i)
+            {
+                for (auto &obj : objs)
+                    obj = objPool.Acquire<LLBC_String>();
+                for (auto &obj : objs)
+                    objPool.Release(obj);
+            }
+        }
+        void Cleanup() override {}
+    } perfTask(objPool);
+
+    for (auto &magazineSize : {0, LLBC_CFG_CORE_OBJPOOL_MAX_MAGAZINE_SIZE})
+    {
+        objPool.SetMagazineSize(magazineSize);
+
+        LLBC_Stopwatch sw;
+        perfTask.Activate(4);
+        perfTask.Wait();
+        sw.Pause();
+        LLBC_PrintLn("- 4 threads acquire/release %d times per thread(magazine size:%d), cost: %lld us",
+                     perfTimes, magazineSize, sw.Elapsed().GetTotalMicros());
+    }
+
+    LLBC_PrintLn("Magazine test finished");
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_ObjPool::TrimTest()
+{
+    LLBC_PrintLn("Trim test:");
+
+    auto getStripeCount = [](const LLBC_ObjPool &objPool) {
+        LLBC_Json::Document statDoc;
+        statDoc.Parse(objPool.GetStatistics(LLBC_ObjPoolStatFormat::Json).c_str());
+        return statDoc["typed_obj_pools"][0]["stripe_count"].GetUint();
+    };
+
+    for (int threadSafe = 0; threadSafe < 2; ++threadSafe)
+    {
+        LLBC_ObjPool objPool(threadSafe != 0);
+        LLBC_ObjPoolTrimPolicy policy;
+        policy.idleStripesHighWatermark = 4;
+        policy.idleStripesLowWatermark = 1;
+        objPool.SetTrimPolicy(policy);
+
+        // Acquire 10 stripes objects, hold first object, release others.
+        const int stripeCap = LLBC_CFG_CORE_OBJPOOL_STRIPE_CAPACITY;
+        std::vector<LLBC_String *> objs;
+        for (int i = 0; i < stripeCap * 10; ++i)
+            objs.push_back(objPool.Acquire<LLBC_String>());
+        for (size_t i = 1; i < objs.size(); ++i)
+            objPool.Release(objs[i]);
+
+        LLBC_PrintLn("- %s pool, stripes before trim:%u",
+                     threadSafe ? "Thread-safe" : "Thread-unsafe", getStripeCount(objPool));
+
+        // Trim: 9 idle stripes > high watermark(4), trim down to low watermark(1).
+        const size_t trimmedSize = threadSafe ? LLBC_ObjPool::TrimAll() : objPool.Trim();
+        LLBC_PrintLn("- Trimmed size:%lu, stripes after trim:%u",
+                     static_cast<unsigned long>(trimmedSize), getStripeCount(objPool));
+        LLBC_ErrorAndReturnIf(getStripeCount(objPool) != 2,
+                              LLBC_FAILED,
+                              "Trim by watermark failed, stripes:%u", getStripeCount(objPool));
+
+        // Trim again: idle stripes(1) not exceed high watermark, nothing trimmed.
+        LLBC_ErrorAndReturnIf(objPool.Trim() != 0,
+                              LLBC_FAILED,
+                              "Trim idle stripes under high watermark");
+
+        // Trim by max retained idle bytes: retain nothing.
+        policy.maxRetainedIdleBytes = 1;
+        objPool.SetTrimPolicy(policy);
+        objPool.Trim();
+        LLBC_ErrorAndReturnIf(getStripeCount(objPool) != 1,
+                              LLBC_FAILED,
+                              "Trim by max retained idle bytes failed, stripes:%u", getStripeCount(objPool));
+
+        // Held object still available, pool still available.
+        objs[0]->append("hello");
+        LLBC_ErrorAndReturnIf(*objs[0] != "hello", LLBC_FAILED, "Held object broken after trim");
+        objPool.Release(objs[0]);
+        for (int i = 0; i < stripeCap * 2; ++i)
+            objs[i] = objPool.Acquire<LLBC_String>();
+        for (int i = 0; i < stripeCap * 2; ++i)
+            objPool.Release(objs[i]);
+    }
+
+    LLBC_PrintLn("Trim test finished");
+
+    return LLBC_OK;
+}
+
+namespace
+{
+    struct alignas(64) Align64Obj
+    {
+        sint64 val[3];
+    };
+
+    struct alignas(256) Align256Obj
+    {
+        char buf[300];
+    };
+
+    struct CacheLineIsolatedObj
+    {
+        volatile sint64 counter;
+
+        static constexpr bool IsCacheLineIsolated() { return true; }
+    };
+
+    struct AlignBaseObj
+    {
+        virtual ~AlignBaseObj() = default;
+        sint64 val = 0;
+    };
+
+    struct alignas(64) AlignDerivedObj : public AlignBaseObj
+    {
+        static int dtorTimes;
+        ~AlignDerivedObj() override { ++dtorTimes; }
+        sint64 derivedVal[2] = {0, 0};
+    };
+
+    int AlignDerivedObj::dtorTimes = 0;
+
+    template <typename Obj>
+    int CheckPoolObjsAlign(LLBC_ObjPool &objPool, size_t align, size_t minDistance)
+    {
+        std::vector<Obj *> objs;
+        for (int i = 0; i < 100; ++i)
+            objs.push_back(objPool.Acquire<Obj>());
+
+        std::vector<uintptr_t> addrs;
+        for (auto &obj : objs)
+            addrs.push_back(reinterpret_cast<uintptr_t>(obj));
+        std::sort(addrs.begin(), addrs.end());
+
+        int ret = LLBC_OK;
+        for (size_t i = 0; i < addrs.size(); ++i)
+        {
+            if (addrs[i] % align != 0 ||
+                (i > 0 && addrs[i] - addrs[i - 1] < minDistance))
+            {
+                LLBC_PrintLn("- Object %s misaligned, addr:%p, align:%lu",
+                             LLBC_GetTypeName(Obj),
+                             reinterpret_cast<void *>(addrs[i]),
+                             static_cast<unsigned long>(align));
+                ret = LLBC_FAILED;
+                break;
+            }
+        }
+
+        for (auto &obj : objs)
+            objPool.Release(obj);
+
+        return ret;
+    }
+}
+
+int TestCase_Core_ObjPool::AlignTest()
+{
+    LLBC_PrintLn("Align test:");
+
+    LLBC_ObjPool objPool;
+    LLBC_ReturnIf(CheckPoolObjsAlign<sint64>(objPool, alignof(sint64), sizeof(sint64)) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckPoolObjsAlign<Align64Obj>(objPool, 64, 64) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckPoolObjsAlign<Align256Obj>(objPool, 256, 512) != LLBC_OK, LLBC_FAILED);
+    LLBC_ReturnIf(CheckPoolObjsAlign<CacheLineIsolatedObj>(
+        objPool, LLBC_CFG_CORE_OBJPOOL_CACHE_LINE_SIZE, LLBC_CFG_CORE_OBJPOOL_CACHE_LINE_SIZE * 2) != LLBC_OK,
+        LLBC_FAILED);
+
+    // Release object by base class pointer(base class alignment differ from pooled object type).
+    AlignDerivedObj *derivedObj = objPool.Acquire<AlignDerivedObj>();
+    AlignBaseObj *baseObj = derivedObj;
+    objPool.Release(baseObj);
+    LLBC_ErrorAndReturnIf(AlignDerivedObj::dtorTimes != 1,
+                          LLBC_FAILED,
+                          "Release object by base class pointer failed, dtor times:%d",
+                          AlignDerivedObj::dtorTimes);
+    LLBC_ErrorAndReturnIf(objPool.Acquire<AlignDerivedObj>() != derivedObj,
+                          LLBC_FAILED,
+                          "Object released by base class pointer not recycled");
+    objPool.Release(derivedObj);
+
+    LLBC_PrintLn("- Stat:\n%s", objPool.GetStatistics(LLBC_ObjPoolStatFormat::CSV).c_str());
+    LLBC_PrintLn("Align test finished");
+
+    return LLBC_OK;
+}
@@ -47,6 +47,10 @@ public:
     int CommonClassTest_Stream();
     int RecycleTest();
     int SafeObjPoolSetNameTest();
+    int TypedPoolLookupTest();
+    int MagazineTest();
+    int TrimTest();
+    int AlignTest();
 
     template <typename Obj>
     static void RandAllocAndRelease(LLBC_ObjPool &objPool,
@@ -83,6 +83,109 @@ void BasicTestTask::Cleanup()
     LLBC_PrintLn("Task cleanup, queue size:%lu", GetMessageSize());
 }
 
+/**
+ * \brief MPSC test consumer task, check per-producer message order.
+ */
+class MPSCConsumerTask final : public LLBC_Task
+{
+public:
+    MPSCConsumerTask(int producerNum, int perProducerMsgNum)
+    : _perProducerMsgNum(perProducerMsgNum)
+    , _expectSeqs(producerNum, 0)
+    , _recvNum(0)
+    , _errNum(0)
+    {
+    }
+
+public:
+    void Svc() override
+    {
+        const int totalMsgNum = static_cast<int>(_expectSeqs.size()) * _perProducerMsgNum;
+        while (_recvNum < totalMsgNum)
+        {
+            // Alternately use PopAll()/TimedPop() to fetch messages.
+            LLBC_MessageBlock *blocks;
+            if (_recvNum % 2 == 0 && PopAll(blocks) == LLBC_OK)
+            {
+                while (blocks)
+                {
+                    LLBC_MessageBlock *block = blocks;
+                    blocks = blocks->GetNext();
+
+                    block->SetNext(nullptr);
+                    Check(block);
+                }
+            }
+            else if (TimedPop(blocks, 50) == LLBC_OK)
+            {
+                Check(blocks);
+            }
+        }
+    }
+
+    void Cleanup() override {  }
+
+public:
+    int GetRecvNum() const { return _recvNum; }
+    int GetErrNum() const { return _errNum; }
+
+private:
+    void Check(LLBC_MessageBlock *block)
+    {
+        int producerIdx = 0, seq = 0;
+        block->Read(&producerIdx, sizeof(producerIdx));
+        block->Read(&seq, sizeof(seq));
+        if (producerIdx < 0 ||
+            producerIdx >= static_cast<int>(_expectSeqs.size()) ||
+            _expectSeqs[producerIdx]++ != seq)
+            ++_errNum;
+
+        ++_recvNum;
+        delete block;
+    }
+
+private:
+    const int _perProducerMsgNum;
+    std::vector<int> _expectSeqs;
+    int _recvNum;
+    int _errNum;
+};
+
+/**
+ * \brief MPSC test producer task, every thread is a producer.
+ */
+class MPSCProducerTask final : public LLBC_Task
+{
+public:
+    MPSCProducerTask(LLBC_Task *consumer, int perProducerMsgNum)
+    : _consumer(consumer)
+    , _perProducerMsgNum(perProducerMsgNum)
+    , _producerIdx(0)
+    {
+    }
+
+public:
+    void Svc() override
+    {
+        const int producerIdx = LLBC_AtomicFetchAndAdd(&_producerIdx, 1);
+        for (int seq = 0; seq < _perProducerMsgNum; ++seq)
+        {
+            LLBC_MessageBlock *block = new LLBC_MessageBlock(sizeof(int) * 2);
+            block->Write(&producerIdx, sizeof(producerIdx));
+            block->Write(&seq, sizeof(seq));
+
+            _consumer->Push(block);
+        }
+    }
+
+    void Cleanup() override {  }
+
+private:
+    LLBC_Task *_consumer;
+    const int _perProducerMsgNum;
+    volatile sint32 _producerIdx;
+};
+
 }
 
 TestCase_Core_Thread_Task::TestCase_Core_Thread_Task()
@@ -99,6 +202,7 @@ int TestCase_Core_Thread_Task::Run(int argc, char *argv[])
 
     LLBC_ErrorAndReturnIf(BasicTaskTest() != LLBC_OK, LLBC_FAILED)
     LLBC_ErrorAndReturnIf(EmptyTaskTest() != LLBC_OK, LLBC_FAILED)
+    LLBC_ErrorAndReturnIf(MPSCTaskTest() != LLBC_OK, LLBC_FAILED)
 
     return LLBC_OK;
 }
@@ -172,3 +276,50 @@ int TestCase_Core_Thread_Task::EmptyTaskTest()
     return LLBC_OK;
 }
 
+int TestCase_Core_Thread_Task::MPSCTaskTest()
+{
+    LLBC_PrintLn("MPSC task test:");
+
+    static constexpr int producerNum = 4;
+    static constexpr int perProducerMsgNum = 200000;
+    const int queueTypes[] = {LLBC_MessageQueueType::Locked, LLBC_MessageQueueType::MPSC};
+    for (auto &queueType : queueTypes)
+    {
+        MPSCConsumerTask consumer(producerNum, perProducerMsgNum);
+        LLBC_ErrorAndReturnIf(consumer.SetMessageQueueType(queueType) != LLBC_OK, LLBC_FAILED);
+        LLBC_ErrorAndReturnIf(consumer.GetMessageQueueType() != queueType, LLBC_FAILED);
+        if (queueType == LLBC_MessageQueueType::MPSC)
+        {
+            // MPSC message queue not support multi consumer threads.
+            LLBC_ErrorAndReturnIf(consumer.Activate(2) == LLBC_OK, LLBC_FAILED);
+        }
+
+        const sint64 begTime = LLBC_GetMicroseconds();
+        LLBC_ErrorAndReturnIf(consumer.Activate(1) != LLBC_OK, LLBC_FAILED);
+        // Not allow change message queue type after activated.
+        LLBC_ErrorAndReturnIf(consumer.SetMessageQueueType(queueType) == LLBC_OK, LLBC_FAILED);
+
+        MPSCProducerTask producer(&consumer, perProducerMsgNum);
+        LLBC_ErrorAndReturnIf(producer.Activate(producerNum) != LLBC_OK, LLBC_FAILED);
+
+        producer.Wait();
+        consumer.Wait();
+        const sint64 costTime = LLBC_GetMicroseconds() - begTime;
+
+        LLBC_PrintLn("- queue type:%s, producers:%d, messages:%d, recv:%d, errors:%d, cost:%lld us",
+                     queueType == LLBC_MessageQueueType::MPSC ? "MPSC" : "Locked",
+                     producerNum,
+                     producerNum * perProducerMsgNum,
+                     consumer.GetRecvNum(),
+                     consumer.GetErrNum(),
+                     costTime);
+        LLBC_ErrorAndReturnIf(consumer.GetRecvNum() != producerNum * perProducerMsgNum ||
+                              consumer.GetErrNum() != 0 ||
+                              consumer.GetMessageSize() != 0, LLBC_FAILED);
+    }
+
+    LLBC_PrintLn("Press any key to continue ...");
+    getchar();
+
+    return LLBC_OK;
+}
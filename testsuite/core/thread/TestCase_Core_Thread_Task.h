@@ -36,4 +36,5 @@ public:
 private:
     int BasicTaskTest();
     int EmptyTaskTest();
+    int MPSCTaskTest();
 };
@@ -0,0 +1,180 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "core/timer/TestCase_Core_Timer_Scheduler.h"
+
+namespace
+{
+
+const char *__GetSchedulerTypeStr(int schedulerType)
+{
+    return schedulerType == LLBC_TimerSchedulerType::Heap ? "Heap" : "TimingWheel";
+}
+
+/**
+ * \brief The timeout test timer statistics.
+ */
+struct TimeoutStat
+{
+    sint64 expectTimeoutTime = 0;
+    int timeoutTimes = 0;
+    int earlyTimes = 0;
+    sint64 maxLateness = 0;
+};
+
+}
+
+int TestCase_Core_Timer_Scheduler::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("core/timer/scheduler test:");
+
+    const int schedulerTypes[] = {LLBC_TimerSchedulerType::Heap, LLBC_TimerSchedulerType::TimingWheel};
+    for (auto &schedulerType : schedulerTypes)
+        LLBC_ErrorAndReturnIf(TimeoutTest(schedulerType) != LLBC_OK, LLBC_FAILED);
+
+    for (auto &schedulerType : schedulerTypes)
+        LLBC_ErrorAndReturnIf(BenchmarkTest(schedulerType) != LLBC_OK, LLBC_FAILED);
+
+    LLBC_PrintLn("Press any key to continue ...");
+    getchar();
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Timer_Scheduler::TimeoutTest(int schedulerType)
+{
+    LLBC_PrintLn("Timeout test, scheduler type:%s", __GetSchedulerTypeStr(schedulerType));
+
+    LLBC_TimerScheduler scheduler(schedulerType);
+    LLBC_ErrorAndReturnIf(scheduler.GetType() != schedulerType, LLBC_FAILED);
+
+    // Schedule timers: even timers are one-shot timers, odd timers are cancelled before timeout,
+    // the last timer is period timer, cancel itself after timeout 5 times.
+    static constexpr int timerCount = 10000;
+    static constexpr int periodTimerIdx = timerCount - 1;
+    std::vector<TimeoutStat> stats(timerCount);
+    std::vector<LLBC_Timer *> timers(timerCount);
+    for (int i = 0; i < timerCount; ++i)
+    {
+        timers[i] = new LLBC_Timer([&stats, i](LLBC_Timer *timer) {
+            auto &stat = stats[i];
+            const sint64 now = LLBC_GetMilliseconds();
+            if (now < stat.expectTimeoutTime)
+                ++stat.earlyTimes;
+            else
+                stat.maxLateness = MAX(stat.maxLateness, now - stat.expectTimeoutTime);
+
+            stat.expectTimeoutTime += timer->GetPeriod().GetTotalMillis();
+            if (++stat.timeoutTimes == 5 || i != periodTimerIdx)
+                timer->Cancel();
+        }, nullptr, &scheduler);
+
+        const sint64 dueTime = i == periodTimerIdx ? 20 : i % 500;
+        stats[i].expectTimeoutTime = LLBC_GetMilliseconds() + dueTime;
+        timers[i]->Schedule(LLBC_TimeSpan::FromMillis(dueTime));
+    }
+
+    for (int i = 1; i < timerCount; i += 2)
+    {
+        if (i != periodTimerIdx)
+            timers[i]->Cancel();
+    }
+
+    // Update scheduler, check next timeout time not later than actual timeout time.
+    int errCount = 0;
+    const sint64 begTime = LLBC_GetMilliseconds();
+    while (LLBC_GetMilliseconds() - begTime < 800)
+    {
+        const sint64 nextTimeoutTime = scheduler.GetNextTimeoutTime();
+        for (int i = 0; i < timerCount; ++i)
+        {
+            if (timers[i]->IsScheduling() &&
+                (nextTimeoutTime == -1 || timers[i]->GetTimeoutTime().GetTimestampInMillis() < nextTimeoutTime))
+            {
+                ++errCount;
+                break;
+            }
+        }
+
+        scheduler.Update();
+        LLBC_Sleep(1);
+    }
+
+    // Check timeout statistics.
+    sint64 maxLateness = 0;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        auto &stat = stats[i];
+        maxLateness = MAX(maxLateness, stat.maxLateness);
+        if (stat.earlyTimes != 0)
+            ++errCount;
+        else if (i == periodTimerIdx)
+            errCount += stat.timeoutTimes == 5 ? 0 : 1;
+        else
+            errCount += stat.timeoutTimes == (i % 2 == 0 ? 1 : 0) ? 0 : 1;
+    }
+
+    LLBC_PrintLn("- timers:%d, errors:%d, max lateness:%lld ms, left timer count:%lu",
+                 timerCount, errCount, maxLateness, scheduler.GetTimerCount());
+    LLBC_STLHelper::DeleteContainer(timers);
+
+    return errCount == 0 && scheduler.GetTimerCount() == 0 ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Core_Timer_Scheduler::BenchmarkTest(int schedulerType)
+{
+    LLBC_PrintLn("Benchmark test, scheduler type:%s", __GetSchedulerTypeStr(schedulerType));
+
+    // Simulate entity timers(buffs, cooldowns, ...): schedule 1M timers in [1s, 1h), then cancel all.
+    static constexpr int timerCount = 1000000;
+    LLBC_TimerScheduler scheduler(schedulerType);
+    std::vector<LLBC_Timer *> timers(timerCount);
+    for (auto &timer : timers)
+        timer = new LLBC_Timer([](LLBC_Timer *) {}, nullptr, &scheduler);
+
+    LLBC_Stopwatch sw;
+    for (int i = 0; i < timerCount; ++i)
+        timers[i]->Schedule(LLBC_TimeSpan::FromMillis(1000 + LLBC_Rand(3600 * 1000 - 1000)));
+    const LLBC_TimeSpan scheduleCost = sw.Elapsed();
+
+    sw.Restart();
+    for (int i = 0; i < 100; ++i)
+        scheduler.Update();
+    const LLBC_TimeSpan updateCost = sw.Elapsed();
+
+    sw.Restart();
+    for (auto &timer : timers)
+        timer->Cancel();
+    const LLBC_TimeSpan cancelCost = sw.Elapsed();
+
+    LLBC_PrintLn("- timers:%d, schedule cost:%lld ms, 100 times update cost:%lld us, "
+                 "cancel cost:%lld ms, timer count after cancel:%lu",
+                 timerCount,
+                 scheduleCost.GetTotalMillis(),
+                 updateCost.GetTotalMicros(),
+                 cancelCost.GetTotalMillis(),
+                 scheduler.GetTimerCount());
+
+    LLBC_STLHelper::DeleteContainer(timers);
+
+    return LLBC_OK;
+}
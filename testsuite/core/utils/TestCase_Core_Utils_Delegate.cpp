@@ -58,6 +58,63 @@ namespace
         std::cout <<"\targ3: " <<arg3 <<std::endl;
         std::cout <<"\targ4: " <<arg4 <<std::endl;
     }
+
+    // Callable object with live count, used to test delegate inline/heap storage.
+    template <size_t CaptureSize>
+    struct CountedFunc
+    {
+        static int liveCount;
+        char capture[CaptureSize];
+
+        CountedFunc() { ++liveCount; memset(capture, 0, sizeof(capture)); capture[CaptureSize - 1] = 1; }
+        CountedFunc(const CountedFunc &other) { ++liveCount; memcpy(capture, other.capture, sizeof(capture)); }
+        CountedFunc(CountedFunc &&other) noexcept { ++liveCount; memcpy(capture, other.capture, sizeof(capture)); }
+        ~CountedFunc() { --liveCount; }
+
+        int operator()(int arg) const { return arg + capture[CaptureSize - 1]; }
+    };
+
+    template <size_t CaptureSize>
+    int CountedFunc<CaptureSize>::liveCount = 0;
+
+    template <size_t CaptureSize>
+    bool TestCountedFuncDeleg()
+    {
+        typedef CountedFunc<CaptureSize> _Func;
+        {
+            LLBC_Delegate<int(int)> deleg = _Func();
+            LLBC_Delegate<int(int)> copied(deleg);
+            LLBC_Delegate<int(int)> moved(std::move(copied));
+            LLBC_Delegate<int(int)> assigned;
+            assigned = moved;
+            assigned = deleg;
+            if (deleg(1) != 2 || copied || moved(2) != 3 || assigned(3) != 4 || _Func::liveCount != 3)
+            {
+                std::cerr <<"Counted func(capture size:" <<CaptureSize <<") delegate call/copy/move failed, liveCount:"
+                          <<_Func::liveCount <<std::endl;
+                return false;
+            }
+
+            moved = nullptr;
+            assigned = [](int arg) { return arg; };
+            if (moved || assigned(5) != 5 || _Func::liveCount != 1)
+            {
+                std::cerr <<"Counted func(capture size:" <<CaptureSize <<") delegate reset failed, liveCount:"
+                          <<_Func::liveCount <<std::endl;
+                return false;
+            }
+        }
+
+        if (_Func::liveCount != 0)
+        {
+            std::cerr <<"Counted func(capture size:" <<CaptureSize <<") delegate leaked, liveCount:"
+                      <<_Func::liveCount <<std::endl;
+            return false;
+        }
+
+        std::cout <<"Counted func(capture size:" <<CaptureSize <<") delegate test success" <<std::endl;
+        return true;
+    }
 }
 
 TestCase_Core_Utils_Delegate::TestCase_Core_Utils_Delegate()
@@ -143,6 +200,22 @@ int TestCase_Core_Utils_Delegate::Run(int argc, char *argv[])
     nullDeleg = nullptr;
     std::cout <<"set nullDeleg to nullptr, valid?:" <<!!nullDeleg <<std::endl;
 
+    // Callable object storage test(inline stored & heap allocated).
+    std::cout <<"Callable object storage test:" <<std::endl;
+    if (!TestCountedFuncDeleg<8>() ||
+        !TestCountedFuncDeleg<LLBC_CFG_CORE_UTILS_DELEGATE_INLINE_SIZE>() ||
+        !TestCountedFuncDeleg<LLBC_CFG_CORE_UTILS_DELEGATE_INLINE_SIZE + 1>() ||
+        !TestCountedFuncDeleg<1024>())
+        return LLBC_FAILED;
+
+    LLBC_Delegate<size_t(const std::string &)> strSizeMethPtr(&std::string::size);
+    std::cout <<"call string method pointer delegate, size:" <<strSizeMethPtr(s) <<std::endl;
+
+    LLBC_Delegate<void(int)> emptyStlFuncDeleg = std::function<void(int)>();
+    std::cout <<"empty stl function delegate valid?:" <<!!emptyStlFuncDeleg <<std::endl;
+    if (emptyStlFuncDeleg)
+        return LLBC_FAILED;
+
     // latest, defer test.
     LLBC_Defer(std::cout << "The defered execute statement" << std::endl);
 
@@ -54,6 +54,20 @@ int TestCase_Core_Variant::Run(int argc, char *argv[])
     DictTest();
     std::cout << std::endl;
 
+    StrKeyDictTest();
+    std::cout << std::endl;
+
+    Xml2VariantTest();
+    std::cout << std::endl;
+
+    if (StrKeyRefTest() != LLBC_OK)
+        return LLBC_FAILED;
+    std::cout << std::endl;
+
+    if (CompactVariantTest() != LLBC_OK)
+        return LLBC_FAILED;
+    std::cout << std::endl;
+
     SerializeTest();
     std::cout << std::endl;
 
@@ -635,6 +649,274 @@ void TestCase_Core_Variant::DictTest()
     std::cout <<"- After call DictErase(6):" <<batchEraseTestDict <<std::endl;
 }
 
+void TestCase_Core_Variant::StrKeyDictTest()
+{
+    std::cout <<"String key dict test" <<std::endl;
+
+    const LLBC_String longKey(64, 'k');
+    LLBC_Variant dict;
+    dict["short"] = 1;
+    dict[std::string("std")] = 2;
+    dict[LLBC_String("llbc")] = 3;
+    dict[LLBC_CString("cstr")] = 4;
+    dict[longKey] = 5;
+    dict[""] = 6;
+    std::cout <<"dict: " <<dict <<std::endl;
+
+    const LLBC_Variant &constDict = dict;
+    std::cout <<"- const lookup(const char *): " <<constDict["short"] <<"(should be 1)" <<std::endl;
+    std::cout <<"- const lookup(std::string): " <<constDict[std::string("std")] <<"(should be 2)" <<std::endl;
+    std::cout <<"- const lookup(LLBC_String): " <<constDict[LLBC_String("llbc")] <<"(should be 3)" <<std::endl;
+    std::cout <<"- const lookup(LLBC_CString): " <<constDict[LLBC_CString("cstr")] <<"(should be 4)" <<std::endl;
+    std::cout <<"- const lookup(long key): " <<constDict[longKey.c_str()] <<"(should be 5)" <<std::endl;
+    std::cout <<"- const lookup(empty key): " <<constDict[std::string()] <<"(should be 6)" <<std::endl;
+    std::cout <<"- const lookup(not exist key): " <<constDict["not_exist"] <<"(should be nil)" <<std::endl;
+    std::cout <<"- DictFind(\"llbc\") found ? " <<(dict.DictFind("llbc") != dict.DictEnd()) <<"(should be 1)" <<std::endl;
+    std::cout <<"- const DictFind(\"no\") found ? " <<(constDict.DictFind("no") != constDict.DictEnd()) <<"(should be 0)" <<std::endl;
+
+    // Non-const operator[] must own the inserted key.
+    {
+        std::string tmpKey("temporary key inserted by non-const operator[]");
+        dict[tmpKey] = 8;
+    }
+    std::cout <<"- inserted temporary key value: " <<constDict["temporary key inserted by non-const operator[]"] <<"(should be 8)" <<std::endl;
+
+    std::cout <<"- DictErase(\"short\", std::string(\"std\")) return: "
+              <<dict.DictErase("short", std::string("std")) <<"(should be 2)" <<std::endl;
+
+    LLBC_Variant str("Hello World");
+    std::cout <<"- str == \"Hello World\" ? " <<(str == "Hello World") <<"(should be 1)" <<std::endl;
+    std::cout <<"- str != LLBC_String(\"Hello\") ? " <<(str != LLBC_String("Hello")) <<"(should be 1)" <<std::endl;
+    std::cout <<"- nil str == \"\" ? " <<(LLBC_Variant(LLBC_String()) == "") <<"(should be 1)" <<std::endl;
+    std::cout <<"- int 10 == \"10\" ? " <<(LLBC_Variant(10) == "10") <<"(should be 1)" <<std::endl;
+}
+
+void TestCase_Core_Variant::Xml2VariantTest()
+{
+    std::cout <<"Xml2Variant test" <<std::endl;
+
+    const char *xml = "<Root attr=\"1\"><Item>a</Item><Item>b</Item><Other/></Root><Root2/>";
+    LLBC_TINYXML2_NS XMLDocument doc;
+    doc.Parse(xml);
+
+    LLBC_Variant var;
+    LLBC_VariantUtil::Xml2Variant(doc, var);
+    std::cout <<"xml: " <<xml <<std::endl;
+    std::cout <<"variant: " <<var <<std::endl;
+
+    const LLBC_Variant &root = var["Root"];
+    const LLBC_Variant &children = root[LLBC_XMLKeys::Children];
+    std::cout <<"- root attr: " <<root[LLBC_XMLKeys::Attrs]["attr"] <<"(should be 1)" <<std::endl;
+    std::cout <<"- root children count: " <<children.Size() <<"(should be 3)" <<std::endl;
+    std::cout <<"- children[1] value: " <<children[1][LLBC_XMLKeys::Value] <<"(should be b)" <<std::endl;
+    std::cout <<"- root[Item] value: " <<root["Item"][LLBC_XMLKeys::Value] <<"(should be a, first same name child)" <<std::endl;
+    std::cout <<"- Other children count: " <<root["Other"][LLBC_XMLKeys::Children].Size() <<"(should be 0)" <<std::endl;
+    std::cout <<"- top children count: " <<var[LLBC_XMLKeys::Children].Size() <<"(should be 2)" <<std::endl;
+}
+
+int TestCase_Core_Variant::StrKeyRefTest()
+{
+    std::cout <<"String key ref test" <<std::endl;
+
+    const LLBC_String longKey(64, 'k');
+    LLBC_Variant dict;
+    dict["short"] = 1;
+    dict[std::string("std")] = 2;
+    dict[LLBC_String("llbc")] = 3;
+    dict[LLBC_CString("cstr")] = 4;
+    dict[longKey] = 5;
+    dict[""] = 6;
+
+    // Const lookups/finds go through the non-owning string key ref, no key string will be built.
+    const LLBC_Variant &constDict = dict;
+    LLBC_ErrorAndReturnIf(constDict["short"] != 1, LLBC_FAILED, "const lookup(const char *) failed");
+    LLBC_ErrorAndReturnIf(constDict[std::string("std")] != 2, LLBC_FAILED, "const lookup(std::string) failed");
+    LLBC_ErrorAndReturnIf(constDict[LLBC_String("llbc")] != 3, LLBC_FAILED, "const lookup(LLBC_String) failed");
+    LLBC_ErrorAndReturnIf(constDict[LLBC_CString("cstr")] != 4, LLBC_FAILED, "const lookup(LLBC_CString) failed");
+    LLBC_ErrorAndReturnIf(constDict[longKey.c_str()] != 5, LLBC_FAILED, "const lookup(long key) failed");
+    LLBC_ErrorAndReturnIf(constDict[std::string()] != 6, LLBC_FAILED, "const lookup(empty key) failed");
+    LLBC_ErrorAndReturnIf(!constDict["not_exist"].IsNil(), LLBC_FAILED, "const lookup(not exist key) not nil");
+    LLBC_ErrorAndReturnIf(dict.DictFind("llbc") == dict.DictEnd(), LLBC_FAILED, "DictFind(\"llbc\") not found");
+    LLBC_ErrorAndReturnIf(constDict.DictFind("no") != constDict.DictEnd(), LLBC_FAILED, "const DictFind(\"no\") found");
+
+    // Non-const operator[] must own the inserted key.
+    {
+        std::string tmpKey("temporary key inserted by non-const operator[]");
+        dict[tmpKey] = 8;
+    }
+    LLBC_ErrorAndReturnIf(constDict["temporary key inserted by non-const operator[]"] != 8,
+                          LLBC_FAILED,
+                          "Inserted temporary key value mismatch");
+
+    LLBC_ErrorAndReturnIf(dict.DictErase("short", std::string("std")) != 2,
+                          LLBC_FAILED,
+                          "DictErase(\"short\", std::string(\"std\")) erased count mismatch");
+    LLBC_ErrorAndReturnIf(!constDict["short"].IsNil() || !constDict["std"].IsNil(),
+                          LLBC_FAILED,
+                          "Erased keys still exist");
+
+    LLBC_Variant str("Hello World");
+    LLBC_ErrorAndReturnIf(!(str == "Hello World"), LLBC_FAILED, "str == \"Hello World\" failed");
+    LLBC_ErrorAndReturnIf(!(str != LLBC_String("Hello")), LLBC_FAILED, "str != LLBC_String(\"Hello\") failed");
+    LLBC_ErrorAndReturnIf(!(LLBC_Variant(LLBC_String()) == ""), LLBC_FAILED, "nil str == \"\" failed");
+    LLBC_ErrorAndReturnIf(!(LLBC_Variant(10) == "10"), LLBC_FAILED, "int 10 == \"10\" failed");
+
+    std::cout <<"- All string key ref checks passed" <<std::endl;
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Variant::CompactVariantTest()
+{
+    std::cout <<"Compact variant test" <<std::endl;
+
+    LLBC_ErrorAndReturnIf(sizeof(LLBC_CompactVariant) != 24,
+                          LLBC_FAILED,
+                          "sizeof(LLBC_CompactVariant) is %lu, should be 24",
+                          static_cast<unsigned long>(sizeof(LLBC_CompactVariant)));
+
+    LLBC_CompactVariantArena arena(256);
+
+    // Scalar & string.
+    LLBC_CompactVariant v;
+    LLBC_ErrorAndReturnIf(!v.IsNil(), LLBC_FAILED, "Default compact variant not nil");
+    v.SetInt64(-3);
+    LLBC_ErrorAndReturnIf(v.AsInt64() != -3 || v.AsDouble() != -3.0, LLBC_FAILED, "Int getter mismatch");
+    v.SetDouble(1.5);
+    LLBC_ErrorAndReturnIf(v.AsInt64() != 1 || !v.AsBool(), LLBC_FAILED, "Double getter mismatch");
+
+    v.SetStr("123456789012345", arena);
+    LLBC_ErrorAndReturnIf(!v.IsInlineStr() || v.AsStr() != "123456789012345" || v.AsInt64() != 123456789012345ll,
+                          LLBC_FAILED,
+                          "15 bytes string should store inline");
+    LLBC_ErrorAndReturnIf(arena.GetUsedSize() != 0, LLBC_FAILED, "Inline string should not use arena");
+
+    const LLBC_String longStr(100, 'x');
+    v.SetStr(longStr, arena);
+    LLBC_ErrorAndReturnIf(v.IsInlineStr() || v.AsStr() != longStr || v.Size() != longStr.size(),
+                          LLBC_FAILED,
+                          "Long string should store in arena");
+    LLBC_ErrorAndReturnIf(arena.GetUsedSize() < longStr.size() + 1, LLBC_FAILED, "Long string arena usage mismatch");
+
+    // Dict: lookup before/after seal, duplicate key keep first, precomputed hash lookup.
+    LLBC_CompactVariant dict;
+    dict.BecomeDict(5, arena);
+    for (int i = 0; i < 3; ++i)
+        dict.DictAppend(LLBC_String().format("key_%d", i), arena).SetInt64(i);
+    dict.DictAppend("key_1", arena).SetInt64(100);
+    dict.DictAppend(longStr, arena).SetStr("long key value", arena);
+    LLBC_ErrorAndReturnIf(!dict.DictAppend("full", arena).IsNil() || dict.Size() != 5,
+                          LLBC_FAILED,
+                          "Append to full dict should fail");
+    LLBC_ErrorAndReturnIf(dict["key_1"].AsInt64() != 1, LLBC_FAILED, "Unsealed dict lookup mismatch");
+
+    dict.DictSeal();
+    std::cout <<"compact dict: " <<dict <<std::endl;
+    LLBC_ErrorAndReturnIf(dict.Size() != 4, LLBC_FAILED, "Sealed dict should remove duplicate key");
+    for (int i = 0; i < 3; ++i)
+        LLBC_ErrorAndReturnIf(dict[LLBC_String().format("key_%d", i)].AsInt64() != i,
+                              LLBC_FAILED,
+                              "Sealed dict lookup key_%d mismatch", i);
+    LLBC_ErrorAndReturnIf(dict[longStr].AsStr() != "long key value", LLBC_FAILED, "Long key lookup mismatch");
+    LLBC_ErrorAndReturnIf(!dict["not_exist"].IsNil() || dict.DictFind("key_3"), LLBC_FAILED, "Not exist key found");
+
+    const uint32 keyHash = LLBC_CompactVariant::HashKey("key_2");
+    const LLBC_CompactVariant *found = dict.DictFind("key_2", keyHash);
+    LLBC_ErrorAndReturnIf(!found || found->AsInt64() != 2, LLBC_FAILED, "Precomputed hash lookup mismatch");
+
+    // Precomputed hash must match key, lookup with other key's hash never hit.
+    LLBC_CompactVariant otherKey;
+    otherKey.SetStr("key_0", arena);
+    LLBC_ErrorAndReturnIf(otherKey.GetStrHash() != LLBC_CompactVariant::HashKey("key_0") ||
+                          dict.DictFind("key_1", otherKey.GetStrHash()),
+                          LLBC_FAILED,
+                          "Lookup with other key hash should not found");
+
+    // Seq.
+    LLBC_CompactVariant seq;
+    seq.BecomeSeq(3, arena);
+    seq.SeqAt(0).SetBool(true);
+    seq.SeqAt(1).SetUInt64(UINT64_MAX);
+    seq.SeqAt(2) = dict;
+    LLBC_ErrorAndReturnIf(seq.Size() != 3 || !seq[0].AsBool() || seq[1].AsUInt64() != UINT64_MAX,
+                          LLBC_FAILED,
+                          "Seq element mismatch");
+    LLBC_ErrorAndReturnIf(seq[2]["key_0"].AsInt64() != 0 || !seq[3].IsNil(), LLBC_FAILED, "Seq shallow copy mismatch");
+
+    // LLBC_Variant round trip.
+    LLBC_Variant var;
+    var["int"] = -1;
+    var["uint"] = 1u;
+    var["double"] = 2.5;
+    var["bool"] = true;
+    var["str"] = "short";
+    var["longStr"] = longStr;
+    var["seq"].SeqPushBack(1, "two", 3.0);
+    var["dict"]["nested"] = "value";
+    var[10] = "int key";
+
+    LLBC_CompactVariant compactVar;
+    compactVar.FromVariant(var, arena);
+    LLBC_ErrorAndReturnIf(compactVar["10"].AsStr() != "int key", LLBC_FAILED, "Non-string key should convert by AsStr()");
+    LLBC_ErrorAndReturnIf(compactVar["seq"][1].AsStr() != "two" || compactVar["dict"]["nested"].AsStr() != "value",
+                          LLBC_FAILED,
+                          "FromVariant nested value mismatch");
+
+    LLBC_Variant backVar;
+    compactVar.ToVariant(backVar);
+    var.DictErase(10);
+    backVar.DictErase("10");
+    LLBC_ErrorAndReturnIf(backVar != var, LLBC_FAILED, "Round trip mismatch, var:%s, backVar:%s",
+                          var.ToString().c_str(), backVar.ToString().c_str());
+
+    // Xml2Variant, must produce the same layout as LLBC_Variant version.
+    const char *xml = "<Root attr=\"1\" name=\"a long attribute value string\">"
+                      "<Item>a</Item><Item>b</Item><Other/></Root><Root2/>";
+    LLBC_TINYXML2_NS XMLDocument doc;
+    doc.Parse(xml);
+
+    LLBC_Variant xmlVar;
+    LLBC_VariantUtil::Xml2Variant(doc, xmlVar);
+
+    LLBC_CompactVariant compactXmlVar;
+    LLBC_VariantUtil::Xml2Variant(doc, compactXmlVar, arena);
+    LLBC_ErrorAndReturnIf(compactXmlVar["Root"]["Item"][LLBC_XMLKeys::Value].AsStr() != "a",
+                          LLBC_FAILED,
+                          "Compact xml root[Item] should be first same name child");
+
+    LLBC_Variant compactXmlBackVar;
+    compactXmlVar.ToVariant(compactXmlBackVar);
+    LLBC_ErrorAndReturnIf(compactXmlBackVar != xmlVar, LLBC_FAILED, "Compact Xml2Variant mismatch, var:%s, compact:%s",
+                          xmlVar.ToString().c_str(), compactXmlBackVar.ToString().c_str());
+
+    // Ini2Variant.
+    LLBC_Ini ini;
+    LLBC_ErrorAndReturnIf(ini.LoadFromContent("[sec1]\nkey1=1\nkey2=a value longer than inline capacity\n"
+                                              "[sec2]\nkey3=3.5\n") != LLBC_OK,
+                          LLBC_FAILED,
+                          "Load ini failed");
+
+    LLBC_Variant iniVar;
+    LLBC_VariantUtil::Ini2Variant(ini, iniVar);
+
+    LLBC_CompactVariant compactIniVar;
+    LLBC_VariantUtil::Ini2Variant(ini, compactIniVar, arena);
+    LLBC_ErrorAndReturnIf(compactIniVar["sec2"]["key3"].AsDouble() != 3.5, LLBC_FAILED, "Compact ini value mismatch");
+
+    LLBC_Variant compactIniBackVar;
+    compactIniVar.ToVariant(compactIniBackVar);
+    LLBC_ErrorAndReturnIf(compactIniBackVar != iniVar, LLBC_FAILED, "Compact Ini2Variant mismatch, var:%s, compact:%s",
+                          iniVar.ToString().c_str(), compactIniBackVar.ToString().c_str());
+
+    std::cout <<"- arena used:" <<arena.GetUsedSize() <<", reserved:" <<arena.GetReservedSize() <<std::endl;
+    arena.Reset();
+    LLBC_ErrorAndReturnIf(arena.GetUsedSize() != 0 || arena.GetReservedSize() != 0,
+                          LLBC_FAILED,
+                          "Arena reset failed");
+
+    return LLBC_OK;
+}
+
 void TestCase_Core_Variant::SerializeTest()
 {
     std::cout <<"Serialize test" <<std::endl;
@@ -39,6 +39,10 @@ private:
     void PairTest();
     void SeqTest();
     void DictTest();
+    void StrKeyDictTest();
+    void Xml2VariantTest();
+    int StrKeyRefTest();
+    int CompactVariantTest();
     void SerializeTest();
     void HashTest();
     void ConvertToUnurderedStlContainerTest();
@@ -0,0 +1,331 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+"""
+llbc binary log file decoder, use for render binary log files(logger config: binaryLogFile=true)
+to text, using the file pattern configured in logger(or the pattern specified by --pattern option).
+
+usage: log_decoder.py [--pattern PATTERN] [--output OUTPUT] binary_log_file [binary_log_file ...]
+
+binary log file format see llbc/include/llbc/core/log/LogBinaryFileAppender.h.
+"""
+
+import os
+import sys
+import time
+import argparse
+
+MAGIC = b'LLBCBLOG'
+VERSION = 1
+
+RECORD_SESSION = 1
+RECORD_DICT = 2
+RECORD_LOG = 3
+
+# Default pattern, same as LLBC_LogTokenChain default pattern(used when logger file pattern is empty).
+DEFAULT_PATTERN = '%T [%L] - %m%n'
+
+LEVEL_STRS = (('TRACE', 'T'), ('DEBUG', 'D'), ('INFO', 'I'), ('WARN', 'W'), ('ERROR', 'E'), ('FATAL', 'F'))
+UNKNOWN_LEVEL_STR = ('UNKNOWN', 'U')
+
+
+class DecodeError(Exception):
+    pass
+
+
+class Reader(object):
+    """
+    Binary log bytes reader.
+    """
+    def __init__(self, data, pos=0, end=None):
+        self.data = data
+        self.pos = pos
+        self.end = len(data) if end is None else end
+
+    def eof(self):
+        return self.pos >= self.end
+
+    def peek_byte(self):
+        if self.pos >= self.end:
+            raise DecodeError('unexpected end of record, pos:{0}'.format(self.pos))
+        return bytearray(self.data[self.pos:self.pos + 1])[0]
+
+    def read_byte(self):
+        if self.pos >= self.end:
+            raise DecodeError('unexpected end of record, pos:{0}'.format(self.pos))
+        b = bytearray(self.data[self.pos:self.pos + 1])[0]
+        self.pos += 1
+        return b
+
+    def read_bytes(self, n):
+        if self.pos + n > self.end:
+            raise DecodeError('unexpected end of record, pos:{0}, need:{1}'.format(self.pos, n))
+        b = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return b
+
+    def read_varint(self):
+        val, shift = 0, 0
+        while True:
+            b = self.read_byte()
+            val |= (b & 0x7f) << shift
+            if b < 0x80:
+                return val
+            shift += 7
+            if shift > 63:
+                raise DecodeError('varint too long, pos:{0}'.format(self.pos))
+
+    def read_zigzag(self):
+        val = self.read_varint()
+        return (val >> 1) ^ -(val & 1)
+
+    def read_str(self):
+        return self.read_bytes(self.read_varint())
+
+    def read_rest(self):
+        b = self.data[self.pos:self.end]
+        self.pos = self.end
+        return b
+
+
+class Token(object):
+    """
+    Pattern token, same as LLBC_BaseLogToken(with LLBC_LogFormattingInfo).
+    """
+    def __init__(self, type_, left_align=True, min_len=0, addi_param='', s=b''):
+        self.type = type_
+        self.left_align = left_align
+        self.min_len = min_len
+        self.addi_param = addi_param
+        self.s = s
+
+    def format(self, out, value):
+        if len(value) < self.min_len:
+            fill = b' ' * (self.min_len - len(value))
+            value = value + fill if self.left_align else fill + value
+        out.append(value)
+
+
+def build_tokens(pattern):
+    """
+    Build pattern tokens, same as LLBC_LogTokenChain::Build().
+    """
+    if not pattern:
+        pattern = DEFAULT_PATTERN
+
+    def make_token(ch, left_align, min_len, addi_param):
+        return Token(ch, left_align, min_len, addi_param)
+
+    tokens = []
+    buf = ''
+    left_align, min_len, addi_param = True, 0, ''
+    state = 'normal'
+    i, n = 0, len(pattern)
+    while i < n:
+        ch = pattern[i]
+        i += 1
+        if state == 'normal':
+            if i == n:
+                buf += ch
+            elif ch == '%':
+                if pattern[i] == '%':
+                    buf += ch
+                    i += 1
+                else:
+                    if buf:
+                        tokens.append(Token('', s=buf.encode('utf-8')))
+                    buf = ch
+                    left_align, min_len, addi_param = True, 0, ''
+                    state = 'token'
+            else:
+                buf += ch
+        elif state == 'token':
+            buf += ch
+            if ch.isdigit() or ch == '-':
+                state = 'indent'
+            elif i < n and pattern[i] == '{':
+                state = 'addi_param'
+            else:
+                buf = buf[:buf.rfind('%')]
+                tokens.append(make_token(ch, left_align, min_len, addi_param))
+                left_align, min_len, addi_param = True, 0, ''
+                state = 'normal'
+        elif state == 'indent':
+            if not ch.isdigit() and ch != '-':
+                try:
+                    indent = int(buf[buf.rfind('%') + 1:])
+                except ValueError:
+                    indent = 0
+                left_align = indent < 0
+                min_len = abs(indent)
+                i -= 1
+                state = 'token'
+            else:
+                buf += ch
+        else:  # addi_param
+            if ch == '}':
+                addi_param = buf[buf.rfind('{') + 1:]
+                token_beg = buf.rfind('%')
+                token_pos = token_beg + 1
+                while token_pos < len(buf) - 1 and (buf[token_pos] == '-' or buf[token_pos].isdigit()):
+                    token_pos += 1
+                tokens.append(make_token(buf[token_pos], left_align, min_len, addi_param))
+                left_align, min_len, addi_param = True, 0, ''
+                state = 'normal'
+                buf = buf[:token_beg]
+            else:
+                buf += ch
+
+    if buf:
+        tokens.append(Token('', s=buf.encode('utf-8')))
+
+    return tokens
+
+
+class Session(object):
+    """
+    Binary log session(begin with session record, every (re)opened log file begin a new session).
+    """
+    def __init__(self, pid, exec_name, logger_name, pattern, override_pattern):
+        self.pid = str(pid).encode('utf-8')
+        self.exec_name = exec_name
+        self.logger_name = logger_name
+        self.tokens = build_tokens(override_pattern if override_pattern is not None else pattern.decode('utf-8'))
+        self.strs = {0: b''}
+        self.last_log_time = 0
+        self.fmt_sec = None
+        self.fmt_cache = b''
+
+    def format_time(self, log_time):
+        sec = log_time // 1000000
+        if sec != self.fmt_sec:
+            self.fmt_sec = sec
+            self.fmt_cache = time.strftime('%y-%m-%d %H:%M:%S.', time.localtime(sec)).encode('utf-8')
+        return self.fmt_cache + '{0:06d}'.format(log_time % 1000000).encode('utf-8')
+
+    def render(self, log_time, level, thread_id, file_, line, func, tag, msg):
+        out = []
+        for token in self.tokens:
+            t = token.type
+            if t == '':
+                out.append(token.s)
+            elif t == 'N':
+                token.format(out, self.logger_name)
+            elif t == 'e':
+                token.format(out, self.exec_name)
+            elif t == 'g':
+                if tag:
+                    token.format(out, tag)
+            elif t == 'f':
+                if file_:
+                    token.format(out, file_)
+            elif t == 'l':
+                token.format(out, str(line).encode('utf-8'))
+            elif t == 'F':
+                if func:
+                    token.format(out, func)
+            elif t == 't':
+                token.format(out, str(thread_id).encode('utf-8'))
+            elif t == 'p':
+                token.format(out, self.pid)
+            elif t == 'L':
+                level_strs = LEVEL_STRS[level] if 0 <= level < len(LEVEL_STRS) else UNKNOWN_LEVEL_STR
+                token.format(out, level_strs[1 if token.addi_param.strip().lower() == 'short' else 0].encode('utf-8'))
+            elif t == 'n':
+                token.format(out, b'\n')
+            elif t == 'm':
+                token.format(out, msg)
+            elif t == 'T':
+                token.format(out, self.format_time(log_time))
+            elif t == 'E':
+                # Note: environment value is not recorded in binary log, use decoder's environment.
+                env_val = os.environ.get(token.addi_param, '') if token.addi_param else ''
+                if env_val:
+                    token.format(out, env_val.encode('utf-8'))
+            elif t == '%':
+                token.format(out, b'%')
+
+        return b''.join(out)
+
+
+def decode(data, out, override_pattern=None):
+    """
+    Decode binary log data, write rendered text to out, return decoded log count.
+    """
+    reader = Reader(data)
+    session = None
+    log_count = 0
+    while not reader.eof():
+        record_len = reader.read_varint()
+        if record_len == 0:
+            # Zero-filled space is not log data(the preallocated tail of mmap log file, left by crashed
+            # process), skip it, if no record follows, it is the end of data.
+            while not reader.eof() and reader.peek_byte() == 0:
+                reader.pos += 1
+            continue
+        if reader.pos + record_len > reader.end:
+            # Truncated record(process crashed while writing), ignore it.
+            break
+
+        rec = Reader(data, reader.pos, reader.pos + record_len)
+        reader.pos += record_len
+
+        record_type = rec.read_byte()
+        if record_type == RECORD_SESSION:
+            if rec.read_bytes(len(MAGIC)) != MAGIC:
+                raise DecodeError('invalid session magic, pos:{0}'.format(rec.pos))
+            version = rec.read_byte()
+            if version > VERSION:
+                raise DecodeError('unsupported binary log version:{0}'.format(version))
+            pid = rec.read_varint()
+            exec_name = rec.read_str()
+            logger_name = rec.read_str()
+            pattern = rec.read_str()
+            session = Session(pid, exec_name, logger_name, pattern, override_pattern)
+        elif session is None:
+            raise DecodeError('binary log session not found, pos:{0}'.format(rec.pos))
+        elif record_type == RECORD_DICT:
+            str_id = rec.read_varint()
+            session.strs[str_id] = rec.read_str()
+        elif record_type == RECORD_LOG:
+            session.last_log_time += rec.read_zigzag()
+            level = rec.read_byte()
+            thread_id = rec.read_varint()
+            file_ = session.strs.get(rec.read_varint(), b'')
+            line = rec.read_varint()
+            func = session.strs.get(rec.read_varint(), b'')
+            tag = session.strs.get(rec.read_varint(), b'')
+            msg = rec.read_rest()
+            out.write(session.render(session.last_log_time, level, thread_id, file_, line, func, tag, msg))
+            log_count += 1
+        # Unknown record type, skip it(forward compatible).
+
+    return log_count
+
+
+def main():
+    parser = argparse.ArgumentParser(description='llbc binary log file decoder')
+    parser.add_argument('files', nargs='+', help='binary log file(s)')
+    parser.add_argument('-p', '--pattern', default=None,
+                        help='render pattern, default use the file pattern recorded in binary log file')
+    parser.add_argument('-o', '--output', default=None, help='output file, default output to stdout')
+    args = parser.parse_args()
+
+    out = open(args.output, 'wb') if args.output else getattr(sys.stdout, 'buffer', sys.stdout)
+    try:
+        for f in args.files:
+            with open(f, 'rb') as fp:
+                data = fp.read()
+            try:
+                decode(data, out, args.pattern)
+            except DecodeError as e:
+                sys.stderr.write('decode binary log file {0} failed: {1}\n'.format(f, e))
+                return 1
+    finally:
+        if args.output:
+            out.close()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
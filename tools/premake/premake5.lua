@@ -438,6 +438,7 @@ project "testsuite"
         "app/AppCfgTest.properties",
         "app/AppCfgTest.ini",
         "app/AppCfgTest.xml",
+        "../tools/log_decoder/log_decoder.py",
     }
     filter { "system:windows" }
         for _, test_cfg in pairs(test_cfgs) do